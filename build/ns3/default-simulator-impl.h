@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef DEFAULT_SIMULATOR_IMPL_H
+#define DEFAULT_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "system-mutex.h"
+
+#include "ptr.h"
+
+#include <list>
+#include <map>
+#include <string>
+#include <typeinfo>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::DefaultSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * The default single process simulator implementation.
+ *
+ * When the \c Profiling attribute is set, the wall clock time, the number
+ * of invocations and the event queue size at dispatch are accumulated per
+ * event type.  The event type is the dynamic type of the EventImpl; for
+ * events created with MakeEvent () it identifies the target class and the
+ * signature of the target function.  The profile is written to the
+ * \c ProfileFile at Simulator::Destroy ().
+ */
+class DefaultSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DefaultSimulatorImpl ();
+  /** Destructor. */
+  ~DefaultSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const; 
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Process the next event. */
+  void ProcessOneEvent (void);
+  /** Move events from a different context into the main event queue. */
+  void ProcessEventsWithContext (void);
+  /**
+   * Invoke an event and account its wall clock time, and the event
+   * queue size at dispatch, to the profile entry of its type.
+   *
+   * \param [in] event The event to invoke.
+   */
+  void InvokeProfiled (EventImpl *event);
+  /**
+   * Write the event profile to the configured file.
+   *
+   * Nothing is written if profiling is disabled or if no event
+   * has been profiled.
+   */
+  void WriteProfile (void) const;
+
+  /** Output format of the event profile. */
+  enum ProfileFormat
+  {
+    PROFILE_CSV,   //!< Comma separated values, one row per event type
+    PROFILE_JSON   //!< JSON array, one object per event type
+  };
+
+  /** Accumulated statistics of one event type. */
+  struct ProfileEntry
+  {
+    /** Number of invocations. */
+    uint64_t count;
+    /** Total wall clock time spent in the event, in nanoseconds. */
+    uint64_t totalNs;
+    /** Longest single invocation, in nanoseconds. */
+    uint64_t maxNs;
+    /** Sum of the event queue sizes at dispatch. */
+    uint64_t queueSum;
+    /** Largest event queue size at dispatch. */
+    uint64_t queueMax;
+  };
+  /**
+   * Container type for the event profile, indexed by the dynamic
+   * type of the EventImpl.  The key is the address of the std::type_info,
+   * which is unique per type, so no string is built on the event path.
+   */
+  typedef std::map<const std::type_info *, ProfileEntry> ProfileMap;
+  /** The event profile. */
+  ProfileMap m_profile;
+  /** Flag \c true if the event execution is profiled. */
+  bool m_profiling;
+  /** Name of the file the event profile is written to at Destroy. */
+  std::string m_profileFile;
+  /** Format of the event profile file. */
+  enum ProfileFormat m_profileFormat;
+ 
+  /** Wrap an event with its execution context. */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /** Container type for the events from a different context. */
+  typedef std::list<struct EventWithContext> EventsWithContext;
+  /** The container of events from a different context. */
+  EventsWithContext m_eventsWithContext;
+  /**
+   * Flag \c true if all events with context have been moved to the
+   * primary event queue.
+   */
+  bool m_eventsWithContextEmpty;
+  /** Mutex to control access to the list of events with context. */
+  SystemMutex m_eventsWithContextMutex;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** The event priority queue. */
+  Ptr<Scheduler> m_events;
+
+  /** Next event unique id. */
+  uint32_t m_uid;
+  /** Unique id of the current event. */
+  uint32_t m_currentUid;
+  /** Timestamp of the current event. */
+  uint64_t m_currentTs;
+  /** Execution context of the current event. */
+  uint32_t m_currentContext;
+  /** The event count. */
+  uint64_t m_eventCount;
+  /**
+   * Number of events that have been inserted but not yet scheduled,
+   *  not counting the Destroy events; this is used for validation
+   */
+  int m_unscheduledEvents;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* DEFAULT_SIMULATOR_IMPL_H */
@@ -0,0 +1,246 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DISTRIBUTED_SPECTRUM_CHANNEL_H
+#define DISTRIBUTED_SPECTRUM_CHANNEL_H
+
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/mpi-remote-channel.h>
+#include <ns3/buffer.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/nstime.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class Packet;
+class NetDevice;
+
+/**
+ * \ingroup spectrum
+ *
+ * Serialization of the signal parameters of a given type, other than the
+ * fields of the SpectrumSignalParameters base class, for the
+ * transmissions sent to remote ranks by a DistributedSpectrumChannel.
+ *
+ * The codecs are registered with DistributedSpectrumChannel::AddSignalCodec.
+ */
+class SpectrumSignalParametersCodec : public SimpleRefCount<SpectrumSignalParametersCodec>
+{
+public:
+  virtual ~SpectrumSignalParametersCodec ();
+
+  /**
+   * \return the name of the codec, identifying it in the messages
+   */
+  virtual std::string GetName (void) const = 0;
+  /**
+   * \param params the signal parameters
+   * \return true if the codec serializes this type of signal parameters
+   */
+  virtual bool CanSerialize (Ptr<const SpectrumSignalParameters> params) const = 0;
+  /**
+   * \param params the signal parameters
+   * \return the size of the serialized parameters
+   */
+  virtual uint32_t GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const = 0;
+  /**
+   * \param params the signal parameters
+   * \param start where the parameters are written
+   */
+  virtual void Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator start) const = 0;
+  /**
+   * \param start where the parameters are read
+   * \return new signal parameters, whose base class fields are set by the
+   * caller
+   */
+  virtual Ptr<SpectrumSignalParameters> Deserialize (Buffer::Iterator start) const = 0;
+
+  /**
+   * \param p a packet, or 0
+   * \return the size of the serialized packet
+   */
+  static uint32_t GetSerializedPacketSize (Ptr<const Packet> p);
+  /**
+   * Serialize a packet, with its tags and metadata
+   *
+   * \param p a packet, or 0
+   * \param i where the packet is written, moved after it
+   */
+  static void SerializePacket (Ptr<const Packet> p, Buffer::Iterator &i);
+  /**
+   * \param i where the packet is read, moved after it
+   * \return the packet, or 0
+   */
+  static Ptr<Packet> DeserializePacket (Buffer::Iterator &i);
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * A MultiModelSpectrumChannel whose receivers can be partitioned among
+ * the ranks of a distributed simulation (see the mpi module).
+ *
+ * Each rank creates the same topology, the nodes being owned by the rank
+ * of their system id.  A rank only propagates the signals to the
+ * receivers of its nodes, and ignores the transmissions of the replicas
+ * of the remote nodes: when a local node transmits, the signal is
+ * serialized and sent to the other ranks, which propagate it to their
+ * receivers.  The base fields of the signal parameters (duration, power
+ * spectral density and transmitter) are always sent; the other fields are
+ * serialized by the SpectrumSignalParametersCodec registered for their
+ * type.  On the receiving rank, the transmitter is the replica of the
+ * transmitting PHY when it is attached to the channel as a receiver.
+ *
+ * The messages are received a lookahead after their transmission, which
+ * is the minimum time between a transmission and its reception in the
+ * channel: the ProcessingDelay attribute, added to every reception, and
+ * the propagation delay at the MinimumDistance between a transmitter and a
+ * receiver of different ranks.  The lookahead must not be zero.
+ *
+ * Without MPI, or when the distributed simulator is not used, the channel
+ * behaves as a MultiModelSpectrumChannel whose receptions are delayed by
+ * ProcessingDelay.
+ */
+class DistributedSpectrumChannel : public MultiModelSpectrumChannel, public MpiRemoteChannel
+{
+public:
+  DistributedSpectrumChannel ();
+  virtual ~DistributedSpectrumChannel ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+  // inherited from MpiRemoteChannel
+  virtual void GetRemoteLinks (std::map<uint32_t, Time> &links);
+
+  /**
+   * \return the minimum time between a transmission and its reception by
+   * a receiver of another rank
+   */
+  Time GetLookahead (void) const;
+
+  /**
+   * Register the codec of a type of signal parameters.  The codecs of
+   * SpectrumSignalParameters and of HalfDuplexIdealPhySignalParameters are
+   * always registered.
+   *
+   * \param codec the codec
+   */
+  static void AddSignalCodec (Ptr<SpectrumSignalParametersCodec> codec);
+
+  /**
+   * Serialize the signal parameters, other than the transmitter, with
+   * their codec
+   *
+   * \param params the signal parameters
+   * \param buffer where the parameters are added
+   */
+  static void SerializeSignal (Ptr<const SpectrumSignalParameters> params, Buffer &buffer);
+  /**
+   * \param i where the signal parameters are read
+   * \param model the spectrum model of the power spectral density
+   * \return new signal parameters, without transmitter
+   */
+  static Ptr<SpectrumSignalParameters> DeserializeSignal (Buffer::Iterator i, Ptr<const SpectrumModel> model);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Remote transmitter of a node replica, used when its PHY is not
+   * attached to the channel.
+   */
+  class RemotePhy;
+
+  /**
+   * \param phy a PHY
+   * \return true if the PHY is not attached to a remote node
+   */
+  bool IsLocal (Ptr<const SpectrumPhy> phy) const;
+
+  /**
+   * Record the device and the rank of a receiver
+   *
+   * \param phy a receiver
+   * \return false if its device or node are not known yet
+   */
+  bool Classify (Ptr<SpectrumPhy> phy);
+
+  /**
+   * \param params the signal parameters of a local transmission
+   * \param rank the remote rank
+   * \param signal the serialized signal parameters
+   * \return the message sent to the remote rank
+   */
+  Ptr<Packet> CreateMessage (Ptr<const SpectrumSignalParameters> params, uint32_t rank, const Buffer &signal) const;
+
+  /**
+   * Receive the messages sent to the local rank by all the
+   * DistributedSpectrumChannel instances
+   *
+   * \param p the message
+   */
+  static void ReceiveRemote (Ptr<Packet> p);
+
+  /**
+   * Propagate a transmission of a remote rank to the local receivers
+   *
+   * \param i where the message is read, after the channel id
+   */
+  void DeliverRemote (Buffer::Iterator i);
+
+  /**
+   * \return the registered codecs
+   */
+  static std::vector<Ptr<SpectrumSignalParametersCodec> > & GetCodecs (void);
+
+  /**
+   * \param params signal parameters
+   * \return the codec of these parameters
+   */
+  static Ptr<SpectrumSignalParametersCodec> FindCodec (Ptr<const SpectrumSignalParameters> params);
+
+  /// identifier of a device: node id and interface index
+  typedef std::pair<uint32_t, uint32_t> DeviceId;
+
+  Time m_processingDelay;  //!< delay added to every reception
+  double m_minimumDistance;  //!< minimum distance between nodes of different ranks (m)
+  std::set<Ptr<SpectrumPhy> > m_phys;  //!< receivers attached to the channel, local or not
+  std::vector<Ptr<SpectrumPhy> > m_unclassifiedPhys;  //!< receivers whose node was unknown when attached
+  std::map<DeviceId, Ptr<SpectrumPhy> > m_devicePhys;  //!< first receiver of each device
+  std::map<uint32_t, uint32_t> m_rankReceivers;  //!< number of receivers of each rank
+  std::map<uint32_t, DeviceId> m_gateways;  //!< device receiving the messages of each remote rank
+  Time m_lookahead;  //!< lookahead, once the remote links are known
+  mutable std::set<std::pair<uint32_t, SpectrumModelUid_t> > m_sentModels;  //!< spectrum models sent to each rank
+  std::map<std::pair<uint32_t, SpectrumModelUid_t>, Ptr<const SpectrumModel> > m_remoteModels;  //!< spectrum models received from each rank
+  std::map<DeviceId, Ptr<SpectrumPhy> > m_remotePhys;  //!< transmitters not attached to the channel
+};
+
+} // namespace ns3
+
+#endif /* DISTRIBUTED_SPECTRUM_CHANNEL_H */
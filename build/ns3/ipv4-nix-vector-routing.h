@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 The Georgia Institute of Technology 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Josh Pelkey <jpelkey@gatech.edu>
+ */
+
+#ifndef IPV4_NIX_VECTOR_ROUTING_H
+#define IPV4_NIX_VECTOR_ROUTING_H
+
+#include <map>
+#include <vector>
+
+#include "ns3/channel.h"
+#include "ns3/node-container.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device-container.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/nix-vector.h"
+#include "ns3/bridge-net-device.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \defgroup nix-vector-routing Nix-Vector Routing
+ *
+ * Nix-vector routing is a simulation specific routing protocol and is
+ * intended for large network topologies.
+ */
+
+/**
+ * \ingroup nix-vector-routing
+ * Map of Ipv4Address to NixVector
+ */
+typedef std::map<Ipv4Address, Ptr<NixVector> > NixMap_t;
+/**
+ * \ingroup nix-vector-routing
+ * Map of Ipv4Address to Ipv4Route
+ */
+typedef std::map<Ipv4Address, Ptr<Ipv4Route> > Ipv4RouteMap_t;
+
+/**
+ * \ingroup nix-vector-routing
+ * Nix-vector routing protocol
+ */
+class Ipv4NixVectorRouting : public Ipv4RoutingProtocol
+{
+public:
+  Ipv4NixVectorRouting ();
+  ~Ipv4NixVectorRouting ();
+  /**
+   * @brief The Interface ID of the Global Router interface.
+   * @return The Interface ID
+   * @see Object::GetObject ()
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * @brief Set the Node pointer of the node for which this
+   * routing protocol is to be placed
+   *
+   * @param node Node pointer
+   */
+  void SetNode (Ptr<Node> node);
+
+  /**
+   * @brief Called when run-time link topology change occurs
+   * which flushes the route trees and the nix vector caches
+   * of all the nodes
+   *
+   * \internal
+   * \c const is used here due to need to potentially flush the cache
+   * in const methods such as PrintRoutingTable.  Caches are stored in
+   * mutable variables and flushed in const methods.
+   */
+  void FlushGlobalNixRoutingCache (void) const;
+
+  /**
+   * @brief Compute the route trees towards the given destination nodes
+   *
+   * The route trees are otherwise computed on demand, when a packet is
+   * first sent towards a destination.  Computing them before
+   * Simulator::Run avoids doing so during the simulation; the trees are
+   * computed by \p nThreads threads, if threading is enabled.  The trees
+   * are shared by all the nodes until the next topology change.
+   *
+   * @param destinations the destination nodes
+   * @param nThreads the number of threads used to compute the trees
+   */
+  static void PrecomputeRouteTrees (NodeContainer destinations, uint32_t nThreads = 1);
+
+private:
+
+  /**
+   * Route tree towards a destination node: the node id of the next hop
+   * of each node, or NO_NEXT_HOP if the destination is not reachable.
+   */
+  typedef std::vector<uint32_t> RouteTree_t;
+
+  /// Marker of the nodes without a path to the destination in a RouteTree_t
+  static const uint32_t NO_NEXT_HOP = 0xffffffff;
+
+  /**
+   * Rebuilds, if needed, the adjacency of the nodes that is used to
+   * compute the route trees, and the neighbor indexes of the nodes
+   * that are used to build the nix vectors.
+   */
+  static void UpdateTopology (void);
+
+  /**
+   * Gets the route tree towards a destination node, computing it if
+   * it is not in the cache
+   * \param dest the destination node id
+   * \returns the route tree
+   */
+  static const RouteTree_t & GetRouteTree (uint32_t dest);
+
+  /**
+   * Breadth first search from the destination node, over the links
+   * in reverse direction.  Only uses the adjacency of the nodes, so that
+   * trees can be computed concurrently.
+   * \param [in] predecessors the nodes with a link towards each node
+   * \param [in] dest the destination node id
+   * \param [out] tree the route tree
+   */
+  static void ComputeRouteTree (const std::vector<std::vector<uint32_t> > & predecessors,
+                                uint32_t dest, RouteTree_t & tree);
+
+  /**
+   * Computes a set of route trees; the body of the threads of
+   * PrecomputeRouteTrees
+   * \param predecessors the nodes with a link towards each node
+   * \param trees the destination node ids and their route trees
+   */
+  static void ComputeRouteTrees (const std::vector<std::vector<uint32_t> > *predecessors,
+                                 std::vector<std::pair<uint32_t, RouteTree_t *> > *trees);
+
+  /**
+   * Invalidates the route trees in which a node can reach the destination,
+   * after a change of its interfaces.
+   * \param node the node id
+   */
+  static void InvalidateRouteTrees (uint32_t node);
+
+  /**
+   * Invalidates the caches of all the nodes
+   */
+  static void InvalidateCaches (void);
+
+  /**
+   * Flushes the cache which stores nix-vector based on
+   * destination IP
+   */
+  void FlushNixCache (void) const;
+
+  /**
+   * Flushes the cache which stores the Ipv4 route
+   * based on the destination IP
+   */
+  void FlushIpv4RouteCache (void) const;
+
+  /**
+   * Upon a run-time topology change caches are
+   * flushed and the total number of neighbors is
+   * reset to zero
+   */
+  void ResetTotalNeighbors (void);
+
+  /**
+   * Takes in the source node and dest IP and calls GetNodeByIp,
+   * BFS, accounting for any output interface specified, and finally
+   * BuildNixVector to return the built nix-vector
+   *
+   * \param source Source node
+   * \param dest Destination node address
+   * \param oif Preferred output interface
+   * \returns The NixVector to be used in routing.
+   */
+  Ptr<NixVector> GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif);
+
+  /**
+   * Checks the cache based on dest IP for the nix-vector
+   * \param address Address to check
+   * \returns The NixVector to be used in routing.
+   */
+  Ptr<NixVector> GetNixVectorInCache (Ipv4Address address);
+
+  /**
+   * Checks the cache based on dest IP for the Ipv4Route
+   * \param address Address to check
+   * \returns The cached route.
+   */
+  Ptr<Ipv4Route> GetIpv4RouteInCache (Ipv4Address address);
+
+  /**
+   * Given a net-device returns all the adjacent net-devices,
+   * essentially getting the neighbors on that channel
+   * \param [in] netDevice the NetDevice attached to the channel.
+   * \param [in] channel the channel to check
+   * \param [out] netDeviceContainer the NetDeviceContainer of the NetDevices in the channel.
+   */
+  static void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
+
+  /**
+   * Finds the node corresponding to the given Ipv4Address, from a
+   * map of the addresses of all the nodes
+   * \param dest destination node IP
+   * \return The node with the specified IP.
+   */
+  Ptr<Node> GetNodeByIp (Ipv4Address dest);
+
+  /**
+   * Recurses the parent vector, created by BFS and actually builds the nixvector
+   * \param [in] parentVector Parent vector for retracing routes
+   * \param [in] source Source Node index
+   * \param [in] dest Destination Node index
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns true on success, false otherwise.
+   */
+  bool BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
+
+  /**
+   * Follows the route tree from the source to the destination and builds
+   * the nixvector from the neighbor indexes of the nodes
+   * \param [in] tree Route tree towards the destination
+   * \param [in] source Source Node index
+   * \param [in] dest Destination Node index
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns true on success, false otherwise.
+   */
+  static bool BuildNixVectorFromTree (const RouteTree_t & tree, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
+
+  /**
+   * Adds to the nixvector the neighbor index of a node from its parent
+   * \param [in] parentNode the parent node
+   * \param [in] dest the node id of the neighbor
+   * \param [out] nixVector the NixVector to be used for routing
+   */
+  void AddNixHop (Ptr<Node> parentNode, uint32_t dest, Ptr<NixVector> nixVector);
+
+  /**
+   * Special variation of BuildNixVector for when a node is sending to itself
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns true on success, false otherwise.
+   */
+  bool BuildNixVectorLocal (Ptr<NixVector> nixVector);
+
+  /**
+   * Simple iterates through the nodes net-devices and determines
+   * how many neighbors it has
+   * \returns the number of neighbors.
+   */
+  uint32_t FindTotalNeighbors (void);
+
+  /**
+   * Determine if the NetDevice is bridged
+   * \param nd the NetDevice to check
+   * \returns the bridging NetDevice (or null if the NetDevice is not bridged)
+   */
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
+
+
+  /**
+   * Nix index is with respect to the neighbors.  The net-device index must be
+   * derived from this
+   * \param [in] nodeIndex Nix Node index
+   * \param [out] gatewayIp IP address of the gateway
+   * \returns the index of the NetDevice in the node.
+   */
+  uint32_t FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address & gatewayIp);
+
+  /**
+   * \brief Breadth first search algorithm.
+   * \param [in] numberOfNodes total number of nodes
+   * \param [in] source Source Node
+   * \param [in] dest Destination Node
+   * \param [out] parentVector Parent vector for retracing routes
+   * \param [in] oif specific output interface to use from source node, if not null
+   * \returns false if dest not found, true o.w.
+   */
+  bool BFS (uint32_t numberOfNodes,
+            Ptr<Node> source,
+            Ptr<Node> dest,
+            std::vector< Ptr<Node> > & parentVector,
+            Ptr<NetDevice> oif);
+
+  void DoDispose (void);
+
+  /* From Ipv4RoutingProtocol */
+  virtual Ptr<Ipv4Route> RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr);
+  virtual bool RouteInput (Ptr<const Packet> p, const Ipv4Header &header, Ptr<const NetDevice> idev,
+                           UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                           LocalDeliverCallback lcb, ErrorCallback ecb);
+  virtual void NotifyInterfaceUp (uint32_t interface);
+  virtual void NotifyInterfaceDown (uint32_t interface);
+  virtual void NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void SetIpv4 (Ptr<Ipv4> ipv4);
+  virtual void PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
+ 
+  /**
+   * Flushes routing caches if required.
+   */
+  void CheckCacheStateAndFlush (void) const;
+
+  /**
+   * Version of the caches, incremented when they need to be flushed.
+   * Used for lazy cleanup of caches when there are many topology changes.
+   */
+  static uint32_t g_cacheVersion;
+
+  /** Flag to mark when the adjacency of the nodes needs to be rebuilt */
+  static bool g_isTopologyDirty;
+
+  /** Flag to mark when the map of the addresses needs to be rebuilt */
+  static bool g_isAddressMapDirty;
+
+  /** Nodes with a link towards each node, indexed by node id */
+  static std::vector<std::vector<uint32_t> > g_predecessors;
+
+  /**
+   * Neighbor index of the neighbors of each node, as in the nix vectors,
+   * sorted by neighbor node id and indexed by node id
+   */
+  static std::vector<std::vector<std::pair<uint32_t, uint32_t> > > g_neighborIndexes;
+
+  /** Total neighbors of each node, indexed by node id */
+  static std::vector<uint32_t> g_totalNeighbors;
+
+  /** Route trees shared by all the nodes, indexed by destination node id */
+  static std::map<uint32_t, RouteTree_t> g_routeTrees;
+
+  /** Node id of each address */
+  static std::map<Ipv4Address, uint32_t> g_nodeByAddress;
+
+  /** Version of the caches of this node */
+  mutable uint32_t m_cacheVersion;
+
+  /** Cache stores nix-vectors based on destination ip */
+  mutable NixMap_t m_nixCache;
+
+  /** Cache stores Ipv4Routes based on destination ip */
+  mutable Ipv4RouteMap_t m_ipv4RouteCache;
+
+  Ptr<Ipv4> m_ipv4; //!< IPv4 object
+  Ptr<Node> m_node; //!< Node object
+
+  /** Total neighbors used for nix-vector to determine number of bits */
+  uint32_t m_totalNeighbors;
+};
+} // namespace ns3
+
+#endif /* IPV4_NIX_VECTOR_ROUTING_H */
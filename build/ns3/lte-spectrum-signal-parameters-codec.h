@@ -0,0 +1,65 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_SPECTRUM_SIGNAL_PARAMETERS_CODEC_H
+#define LTE_SPECTRUM_SIGNAL_PARAMETERS_CODEC_H
+
+#include <ns3/distributed-spectrum-channel.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Codec of LteSpectrumSignalParametersSlFrame, sending the sidelink
+ * transmissions to the remote ranks of a DistributedSpectrumChannel.
+ * The control messages of a sidelink frame (SCI, MIB-SL and discovery
+ * messages) are serialized field by field.
+ *
+ * The codec is registered when the lte module is loaded.
+ */
+class LteSpectrumSignalParametersSlFrameCodec : public SpectrumSignalParametersCodec
+{
+public:
+  // inherited from SpectrumSignalParametersCodec
+  virtual std::string GetName (void) const;
+  virtual bool CanSerialize (Ptr<const SpectrumSignalParameters> params) const;
+  virtual uint32_t GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const;
+  virtual void Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator start) const;
+  virtual Ptr<SpectrumSignalParameters> Deserialize (Buffer::Iterator start) const;
+};
+
+/**
+ * \ingroup lte
+ *
+ * Codec of LteSpectrumSignalParametersUlSrsFrame.
+ *
+ * The codec is registered when the lte module is loaded.
+ */
+class LteSpectrumSignalParametersUlSrsFrameCodec : public SpectrumSignalParametersCodec
+{
+public:
+  // inherited from SpectrumSignalParametersCodec
+  virtual std::string GetName (void) const;
+  virtual bool CanSerialize (Ptr<const SpectrumSignalParameters> params) const;
+  virtual uint32_t GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const;
+  virtual void Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator start) const;
+  virtual Ptr<SpectrumSignalParameters> Deserialize (Buffer::Iterator start) const;
+};
+
+}  // namespace ns3
+
+#endif /* LTE_SPECTRUM_SIGNAL_PARAMETERS_CODEC_H */
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_SNAPSHOT_H
+#define MOBILITY_SNAPSHOT_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Snapshot of the positions and velocities of the nodes at the
+ * current simulation time.
+ *
+ * The mobility model aggregated to a node is registered in the snapshot
+ * under the id of the node.  The positions and velocities are stored in
+ * one array per coordinate, indexed by node id, along with the
+ * simulation time at which they were computed.  An entry is computed
+ * again by the mobility model at the first query made at a new
+ * simulation time, and when the model notifies a course change or is
+ * given a new position.  MobilityModel::GetPosition and
+ * MobilityModel::GetVelocity go through the snapshot, so that the
+ * channels and the propagation loss models, which query the position of
+ * a transmitter once per receiver, compute it only once per
+ * transmission.
+ *
+ * A mobility model whose position or velocity can change at the
+ * current time without a course change notification must call
+ * MobilityModel::NotifySnapshotInvalid, or the snapshot must be
+ * disabled with MobilitySnapshot::Disable.
+ */
+class MobilitySnapshot
+{
+public:
+  /**
+   * \param nodeId the id of a node
+   * \returns true if the mobility model of the node is in the snapshot
+   */
+  static bool IsTracked (uint32_t nodeId);
+  /**
+   * \param nodeId the id of a node with a mobility model
+   * \returns the current position of the node
+   */
+  static Vector GetPosition (uint32_t nodeId);
+  /**
+   * \param nodeId the id of a node with a mobility model
+   * \returns the current velocity of the node
+   */
+  static Vector GetVelocity (uint32_t nodeId);
+  /**
+   * Query the current positions of several nodes at once.
+   *
+   * \param nodeIds the ids of nodes with a mobility model
+   * \param positions the current positions of the nodes, in the order
+   *        of nodeIds
+   */
+  static void GetPositions (const std::vector<uint32_t> &nodeIds, std::vector<Vector> &positions);
+  /**
+   * Query the current velocities of several nodes at once.
+   *
+   * \param nodeIds the ids of nodes with a mobility model
+   * \param velocities the current velocities of the nodes, in the
+   *        order of nodeIds
+   */
+  static void GetVelocities (const std::vector<uint32_t> &nodeIds, std::vector<Vector> &velocities);
+  /**
+   * Compute the positions and velocities again at each query, as if
+   * there was no snapshot.
+   */
+  static void Disable (void);
+  /**
+   * Reuse the positions and velocities computed at the current
+   * simulation time.  This is the default.
+   */
+  static void Enable (void);
+  /**
+   * \returns true if the snapshot is enabled
+   */
+  static bool IsEnabled (void);
+
+private:
+  friend class MobilityModel;
+
+  /// Index of a mobility model which is not in the snapshot
+  static const uint32_t NONE = 0xffffffff;
+
+  /**
+   * Register the mobility model aggregated to a node.
+   *
+   * \param model the mobility model
+   * \param nodeId the id of the node
+   */
+  static void Add (MobilityModel *model, uint32_t nodeId);
+  /**
+   * Unregister a mobility model.
+   *
+   * \param model the mobility model
+   * \param nodeId the id of the node of the model
+   */
+  static void Remove (MobilityModel *model, uint32_t nodeId);
+  /**
+   * Forget the position and velocity of a node.
+   *
+   * \param nodeId the id of the node
+   */
+  static void Invalidate (uint32_t nodeId);
+  /**
+   * \param nodeId the id of a node in the snapshot
+   * \returns the current position of the node
+   */
+  static Vector DoGetPosition (uint32_t nodeId);
+  /**
+   * \param nodeId the id of a node in the snapshot
+   * \returns the current velocity of the node
+   */
+  static Vector DoGetVelocity (uint32_t nodeId);
+  /**
+   * \returns the snapshot, created on the first call
+   */
+  static MobilitySnapshot *Get (void);
+  /**
+   * Delete the snapshot, when the simulator is destroyed.
+   */
+  static void Delete (void);
+
+  static MobilitySnapshot *m_snapshot; //!< The snapshot
+  static bool m_enabled;               //!< True if the snapshot is enabled
+
+  std::vector<MobilityModel *> m_models; //!< The mobility models
+  std::vector<double> m_x;               //!< The x coordinates of the positions
+  std::vector<double> m_y;               //!< The y coordinates of the positions
+  std::vector<double> m_z;               //!< The z coordinates of the positions
+  std::vector<int64_t> m_positionTs;     //!< The times of the positions, -1 if invalid
+  std::vector<double> m_vx;              //!< The x coordinates of the velocities
+  std::vector<double> m_vy;              //!< The y coordinates of the velocities
+  std::vector<double> m_vz;              //!< The z coordinates of the velocities
+  std::vector<int64_t> m_velocityTs;     //!< The times of the velocities, -1 if invalid
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_SNAPSHOT_H */
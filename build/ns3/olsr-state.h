@@ -0,0 +1,560 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2004 Francisco J. Ros
+ * Copyright (c) 2007 INESC Porto
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Francisco J. Ros  <fjrm@dif.um.es>
+ *          Gustavo J. A. M. Carneiro <gjc@inescporto.pt>
+ */
+
+
+#ifndef OLSR_STATE_H
+#define OLSR_STATE_H
+
+#include "olsr-repositories.h"
+#include "ns3/duplicate-cache.h"
+#include <unordered_map>
+
+namespace ns3 {
+namespace olsr {
+
+/// \ingroup olsr
+/// Index of the tuples of a set by one of their address fields.
+///
+/// The index follows the tuples appended at the end of the set.  Any other
+/// change to the set must invalidate it, and it is then rebuilt on the next
+/// lookup.
+class OlsrAddressIndex
+{
+public:
+  OlsrAddressIndex ()
+    : m_valid (false)
+  {
+  }
+
+  /**
+   * Finds the tuples of a set with a given address.
+   * \param set The indexed set.
+   * \param field The indexed address field of the tuples.
+   * \param addr The address to look for.
+   * \returns The positions of the matching tuples in the set, in set order.
+   */
+  template <typename Set>
+  const std::vector<uint32_t> & Find (const Set &set,
+                                      Ipv4Address Set::value_type::*field,
+                                      const Ipv4Address &addr)
+  {
+    if (!m_valid)
+      {
+        m_positions.clear ();
+        for (uint32_t i = 0; i < set.size (); i++)
+          {
+            m_positions[set[i].*field].push_back (i);
+          }
+        m_valid = true;
+      }
+    PositionMap::const_iterator it = m_positions.find (addr);
+    if (it == m_positions.end ())
+      {
+        return m_none;
+      }
+    return it->second;
+  }
+
+  /**
+   * Records a tuple appended at the end of the set.
+   * \param addr The indexed address of the tuple.
+   * \param position The position of the tuple in the set.
+   */
+  void Append (const Ipv4Address &addr, uint32_t position)
+  {
+    if (m_valid)
+      {
+        m_positions[addr].push_back (position);
+      }
+  }
+
+  /**
+   * Invalidates the index after a change other than an append.
+   */
+  void Invalidate ()
+  {
+    m_valid = false;
+  }
+
+private:
+  /// Container of the tuple positions, by address.
+  typedef std::unordered_map<Ipv4Address, std::vector<uint32_t>, Ipv4AddressHash> PositionMap;
+  PositionMap m_positions;      //!< Tuple positions, by address.
+  bool m_valid;                 //!< Whether m_positions matches the set.
+  static const std::vector<uint32_t> m_none; //!< Result of a lookup without match.
+};
+
+/// \ingroup olsr
+/// This class encapsulates all data structures needed for maintaining internal state of an OLSR node.
+class OlsrState
+{
+  //  friend class Olsr;
+
+protected:
+  LinkSet m_linkSet;    //!< Link Set (\RFC{3626}, section 4.2.1).
+  NeighborSet m_neighborSet;            //!< Neighbor Set (\RFC{3626}, section 4.3.1).
+  TwoHopNeighborSet m_twoHopNeighborSet;        //!< 2-hop Neighbor Set (\RFC{3626}, section 4.3.2).
+  TopologySet m_topologySet;    //!< Topology Set (\RFC{3626}, section 4.4).
+  MprSet m_mprSet;      //!< MPR Set (\RFC{3626}, section 4.3.3).
+  MprSelectorSet m_mprSelectorSet;      //!< MPR Selector Set (\RFC{3626}, section 4.3.4).
+  DuplicateCache<DuplicateTuple> m_duplicateSet;  //!< Duplicate Set (\RFC{3626}, section 3.4), by (D_addr, D_seq_num).
+  IfaceAssocSet m_ifaceAssocSet;        //!< Interface Association Set (\RFC{3626}, section 4.1).
+  AssociationSet m_associationSet; //!<	Association Set (\RFC{3626}, section12.2). Associations obtained from HNA messages generated by other nodes.
+  Associations m_associations;  //!< The node's local Host Network Associations that will be advertised using HNA messages.
+
+  mutable OlsrAddressIndex m_linkIndex;         //!< Link Set, by L_neighbor_iface_addr.
+  mutable OlsrAddressIndex m_neighborIndex;     //!< Neighbor Set, by N_neighbor_main_addr.
+  mutable OlsrAddressIndex m_twoHopNeighborIndex; //!< 2-hop Neighbor Set, by N_neighbor_main_addr.
+  mutable OlsrAddressIndex m_topologyLastIndex; //!< Topology Set, by T_last_addr.
+  mutable OlsrAddressIndex m_topologyDestIndex; //!< Topology Set, by T_dest_addr.
+  mutable OlsrAddressIndex m_mprSelectorIndex;  //!< MPR Selector Set, by MS_main_addr.
+  mutable OlsrAddressIndex m_ifaceAssocIndex;   //!< Interface Association Set, by I_iface_addr.
+  std::set<Ipv4Address> m_topologyChanges;      //!< Destinations of the topology tuples inserted or erased since the last ClearTopologyChanges ().
+
+public:
+  OlsrState ()
+  {
+  }
+
+  // MPR selector
+
+  /**
+   * Gets the MPR selectors.
+   * \returns The MPR selectors.
+   */
+  const MprSelectorSet & GetMprSelectors () const
+  {
+    return m_mprSelectorSet;
+  }
+
+  /**
+   * Finds a MPR selector tuple.
+   * \param mainAddr The MPR selector main address.
+   * \returns The MPR selector, if found. Else it returns a null pointer.
+   */
+  MprSelectorTuple* FindMprSelectorTuple (const Ipv4Address &mainAddr);
+
+  /**
+   * Erases a MPR selector tuple.
+   * \param tuple The MPR selector tuple.
+   */
+  void EraseMprSelectorTuple (const MprSelectorTuple &tuple);
+
+  /**
+   * Erases all MPR selector tuples belonging to the same address.
+   * \param mainAddr The MPR selector main address.
+   */
+  void EraseMprSelectorTuples (const Ipv4Address &mainAddr);
+
+  /**
+   * Inserts a MPR selector tuple
+   * \param tuple The MPR selector tuple.
+   */
+  void InsertMprSelectorTuple (const MprSelectorTuple &tuple);
+
+  /**
+   * Prints the MPR selector sets.
+   * \return a string with the output data.
+   */
+  std::string PrintMprSelectorSet () const;
+
+  // Neighbor
+
+  /**
+   * Gets the neighbor set.
+   * \returns The neighbor set.
+   */
+  const NeighborSet & GetNeighbors () const
+  {
+    return m_neighborSet;
+  }
+  /**
+   * Gets a mutable reference to the neighbor set.
+   *
+   * The neighbor set index is rebuilt on the next lookup.
+   *
+   * \returns The neighbor set.
+   */
+  NeighborSet & GetNeighborsMutable ()
+  {
+    m_neighborIndex.Invalidate ();
+    return m_neighborSet;
+  }
+
+  /**
+   * Finds a neighbor tuple.
+   * \param mainAddr The neighbor tuple main address.
+   * \returns The neighbor tuple, if found. Else it returns a null pointer.
+   */
+  NeighborTuple* FindNeighborTuple (const Ipv4Address &mainAddr);
+
+  /**
+   * Finds a symmetrical neighbor tuple.
+   * \param mainAddr The neighbor tuple main address.
+   * \returns The neighbor tuple, if found. Else it returns a null pointer.
+   */
+  const NeighborTuple* FindSymNeighborTuple (const Ipv4Address &mainAddr) const;
+
+  /**
+   * Finds a neighbor tuple.
+   * \param mainAddr The neighbor tuple main address.
+   * \param willingness The neighbor willingness.
+   * \returns The neighbor tuple, if found. Else it returns a null pointer.
+   */
+  NeighborTuple* FindNeighborTuple (const Ipv4Address &mainAddr,
+                                    uint8_t willingness);
+
+  /**
+   * Erases a neighbor tuple.
+   * \param neighborTuple The neighbor tuple.
+   */
+  void EraseNeighborTuple (const NeighborTuple &neighborTuple);
+  /**
+   * Erases a neighbor tuple.
+   * \param mainAddr The neighbor tuple main address.
+   */
+  void EraseNeighborTuple (const Ipv4Address &mainAddr);
+
+  /**
+   * Inserts a neighbor tuple.
+   * \param tuple The neighbor tuple.
+   */
+  void InsertNeighborTuple (const NeighborTuple &tuple);
+
+  // Two-hop neighbor
+
+  /**
+   * Gets the 2-hop neighbor set.
+   * \returns The 2-hop neighbor set.
+   */
+  const TwoHopNeighborSet & GetTwoHopNeighbors () const
+  {
+    return m_twoHopNeighborSet;
+  }
+  /**
+   * Gets a mutable reference to the 2-hop neighbor set.
+   *
+   * The 2-hop neighbor set index is rebuilt on the next lookup.
+   *
+   * \returns The 2-hop neighbor set.
+   */
+  TwoHopNeighborSet & GetTwoHopNeighborsMutable ()
+  {
+    m_twoHopNeighborIndex.Invalidate ();
+    return m_twoHopNeighborSet;
+  }
+
+  /**
+   * Finds a 2-hop neighbor tuple.
+   * \param neighbor The neighbor main address.
+   * \param twoHopNeighbor The 2-hop neighbor main address.
+   * \returns The 2-hop neighbor tuple, if found. Else it returns a null pointer.
+   */
+  TwoHopNeighborTuple* FindTwoHopNeighborTuple (const Ipv4Address &neighbor,
+                                                const Ipv4Address &twoHopNeighbor);
+
+  /**
+   * Erases a 2-hop neighbor tuple.
+   * \param tuple The 2-hop neighbor tuple.
+   */
+  void EraseTwoHopNeighborTuple (const TwoHopNeighborTuple &tuple);
+  /**
+   * Erases the 2-hop neighbor tuples with the same 1-hop neighbor.
+   * \param neighbor The neighbor address.
+   */
+  void EraseTwoHopNeighborTuples (const Ipv4Address &neighbor);
+  /**
+   * Erases the 2-hop neighbor tuples with matching predicates.
+   * \param neighbor The neighbor address.
+   * \param twoHopNeighbor The 2-hop neighbor main address.
+   */
+  void EraseTwoHopNeighborTuples (const Ipv4Address &neighbor,
+                                  const Ipv4Address &twoHopNeighbor);
+  /**
+   * Inserts a 2-hop neighbor tuple.
+   * \param tuple The 2-hop neighbor tuple.
+   */
+  void InsertTwoHopNeighborTuple (const TwoHopNeighborTuple &tuple);
+
+  // MPR
+
+  /**
+   * Checks if there's an MPR with a specific address.
+   * \param address The address to test.
+   * \return True if a MPR with the specified address exists.
+   */
+  bool FindMprAddress (const Ipv4Address &address);
+
+  /**
+   * Sets the MPR set to the one specified.
+   * \param mprSet The new MPR set.
+   */
+  void SetMprSet (MprSet mprSet);
+
+  /**
+   * Gets the MPR set.
+   * \return The MPR set.
+   */
+  MprSet GetMprSet () const;
+
+  // Duplicate
+
+  /**
+   * Finds a duplicate tuple.
+   * \param address The duplicate tuple address.
+   * \param sequenceNumber The duplicate tuple sequence number.
+   * \returns The duplicate tuple, or a null pointer if no match or if the
+   * tuple has expired.
+   */
+  DuplicateTuple* FindDuplicateTuple (const Ipv4Address &address,
+                                      uint16_t sequenceNumber);
+
+  /**
+   * Erases a duplicate tuple.
+   * \param tuple The tuple to erase.
+   */
+  void EraseDuplicateTuple (const DuplicateTuple &tuple);
+  /**
+   * Inserts a duplicate tuple, or replaces the tuple with the same address
+   * and sequence number.  The tuple is dropped after its expiration time.
+   * \param tuple The tuple to insert.
+   */
+  void InsertDuplicateTuple (const DuplicateTuple &tuple);
+
+  // Link
+
+  /**
+   * Gets the Link set.
+   * \return The Link set.
+   */
+  const LinkSet & GetLinks () const
+  {
+    return m_linkSet;
+  }
+  /**
+   * Finds a link tuple.
+   * \param ifaceAddr The interface address of the link.
+   * \returns The link tuple, or a null pointer if no match.
+   */
+  LinkTuple* FindLinkTuple (const Ipv4Address &ifaceAddr);
+  /**
+   * Finds a symmetrical link tuple.
+   * \param ifaceAddr The interface address of the link.
+   * \param time The time at which the link should be considered symmetrical.
+   * \returns The link tuple, or a null pointer if no match.
+   */
+  LinkTuple* FindSymLinkTuple (const Ipv4Address &ifaceAddr, Time time);
+  /**
+   * Erases a link tuple.
+   * \param tuple The tuple to erase.
+   */
+  void EraseLinkTuple (const LinkTuple &tuple);
+  /**
+   * Inserts a link tuple.
+   * \param tuple The tuple to insert.
+   * \returns A reference to the inserted tuple.
+   */
+  LinkTuple& InsertLinkTuple (const LinkTuple &tuple);
+
+  // Topology
+
+  /**
+   * Gets the topology set.
+   * \returns The topology set.
+   */
+  const TopologySet & GetTopologySet () const
+  {
+    return m_topologySet;
+  }
+  /**
+   * Finds a topology tuple.
+   * \param destAddr The destination address.
+   * \param lastAddr The address of the node previous to the destination.
+   * \returns The topology tuple, or a null pointer if no match.
+   */
+  TopologyTuple* FindTopologyTuple (const Ipv4Address &destAddr,
+                                    const Ipv4Address &lastAddr);
+  /**
+   * Finds a topology tuple.
+   * \param lastAddr The address of the node previous to the destination.
+   * \param ansn The Advertised Neighbor Sequence Number.
+   * \returns The topology tuple, or a null pointer if no match.
+   */
+  TopologyTuple* FindNewerTopologyTuple (const Ipv4Address &lastAddr,
+                                         uint16_t ansn);
+  /**
+   * Erases a topology tuple.
+   * \param tuple The tuple to erase.
+   */
+  void EraseTopologyTuple (const TopologyTuple &tuple);
+  /**
+   * Erases a topology tuple.
+   * \param lastAddr The address of the node previous to the destination.
+   * \param ansn The Advertised Neighbor Sequence Number.
+   */
+  void EraseOlderTopologyTuples (const Ipv4Address &lastAddr,
+                                 uint16_t ansn);
+  /**
+   * Inserts a topology tuple.
+   * \param tuple The tuple to insert.
+   */
+  void InsertTopologyTuple (const TopologyTuple &tuple);
+  /**
+   * Finds the topology tuples with a given last address.
+   * \param lastAddr The address of the node previous to the destination.
+   * \returns The positions of the tuples in the topology set, in set order.
+   */
+  const std::vector<uint32_t> & FindTopologyTuplesByLastAddr (const Ipv4Address &lastAddr) const;
+  /**
+   * Finds the topology tuples with a given destination address.
+   * \param destAddr The destination address.
+   * \returns The positions of the tuples in the topology set, in set order.
+   */
+  const std::vector<uint32_t> & FindTopologyTuplesByDestAddr (const Ipv4Address &destAddr) const;
+  /**
+   * Gets the destinations of the topology tuples inserted or erased
+   * since the last call to ClearTopologyChanges ().
+   * \returns The destination addresses.
+   */
+  const std::set<Ipv4Address> & GetTopologyChanges () const
+  {
+    return m_topologyChanges;
+  }
+  /**
+   * Forgets the recorded topology set changes.
+   */
+  void ClearTopologyChanges ()
+  {
+    m_topologyChanges.clear ();
+  }
+
+  // Interface association
+
+  /**
+   * Gets the interface association set.
+   * \returns The interface association set.
+   */
+  const IfaceAssocSet & GetIfaceAssocSet () const
+  {
+    return m_ifaceAssocSet;
+  }
+  /**
+   * Gets a mutable reference to the interface association set.
+   *
+   * The interface association set index is rebuilt on the next lookup.
+   *
+   * \returns The interface association set.
+   */
+  IfaceAssocSet & GetIfaceAssocSetMutable ()
+  {
+    m_ifaceAssocIndex.Invalidate ();
+    return m_ifaceAssocSet;
+  }
+
+  /**
+   * Finds a interface association tuple.
+   * \param ifaceAddr The interface address.
+   * \returns The interface association  tuple, or a null pointer if no match.
+   */
+  IfaceAssocTuple* FindIfaceAssocTuple (const Ipv4Address &ifaceAddr);
+  /**
+   * Finds a interface association tuple.
+   * \param ifaceAddr The interface address.
+   * \returns The interface association  tuple, or a null pointer if no match.
+   */
+  const IfaceAssocTuple* FindIfaceAssocTuple (const Ipv4Address &ifaceAddr) const;
+  /**
+   * Erases a interface association tuple.
+   * \param tuple The tuple to erase.
+   */
+  void EraseIfaceAssocTuple (const IfaceAssocTuple &tuple);
+  /**
+   * Inserts a interface association tuple.
+   * \param tuple The tuple to insert.
+   */
+  void InsertIfaceAssocTuple (const IfaceAssocTuple &tuple);
+
+  // Host-Network Association
+  /**
+   * Gets the association set known to the node.
+   * \returns The association set known to the node.
+   */
+  const AssociationSet & GetAssociationSet () const  // Associations known to the node
+  {
+    return m_associationSet;
+  }
+
+  /**
+   * Gets the association set the node has.
+   * \returns The association set the node has.
+   */
+  const Associations & GetAssociations () const  // Set of associations that the node has
+  {
+    return m_associations;
+  }
+
+  /**
+   * Finds an association tuple.
+   * \param gatewayAddr The gateway address.
+   * \param networkAddr The network address.
+   * \param netmask The network mask.
+   * \returns The association  tuple, or a null pointer if no match.
+   */
+  AssociationTuple* FindAssociationTuple (const Ipv4Address &gatewayAddr, \
+                                          const Ipv4Address &networkAddr, \
+                                          const Ipv4Mask &netmask);
+  /**
+   * Erases a known association tuple.
+   * \param tuple The tuple to erase.
+   */
+  void EraseAssociationTuple (const AssociationTuple &tuple);
+  /**
+   * Inserts a known association tuple.
+   * \param tuple The tuple to insert.
+   */
+  void InsertAssociationTuple (const AssociationTuple &tuple);
+  /**
+   * Erases an association.
+   * \param tuple The tuple to erase.
+   */
+  void EraseAssociation (const Association &tuple);
+  /**
+   * Inserts an association tuple.
+   * \param tuple The tuple to insert.
+   */
+  void InsertAssociation (const Association &tuple);
+
+  /**
+   * Returns a vector of all interfaces of a given neighbor, with the
+   * exception of the "main" one.
+   * \param neighborMainAddr The neighbor main address
+   * \returns A container of the neighbor addresses (excluding the main one).
+   */
+  std::vector<Ipv4Address>
+  FindNeighborInterfaces (const Ipv4Address &neighborMainAddr) const;
+
+};
+
+}
+}  // namespace olsr,ns3
+
+#endif /* OLSR_STATE_H */
@@ -0,0 +1,12 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_PSC
+    
+
+// Module headers:
+#include "udp-group-echo-helper.h"
+#include "udp-group-echo-server.h"
+#endif
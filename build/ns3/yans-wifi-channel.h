@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef YANS_WIFI_CHANNEL_H
+#define YANS_WIFI_CHANNEL_H
+
+#include "ns3/channel.h"
+#include "ns3/vector.h"
+#include <map>
+#include <unordered_map>
+
+namespace ns3 {
+
+class NetDevice;
+class PropagationLossModel;
+class PropagationDelayModel;
+class YansWifiPhy;
+class Packet;
+class Time;
+class MobilityModel;
+
+/**
+ * \brief a channel to interconnect ns3::YansWifiPhy objects.
+ * \ingroup wifi
+ *
+ * This class is expected to be used in tandem with the ns3::YansWifiPhy
+ * class and supports an ns3::PropagationLossModel and an
+ * ns3::PropagationDelayModel.  By default, no propagation models are set;
+ * it is the caller's responsibility to set them before using the channel.
+ *
+ * Two optional mechanisms limit the number of receptions scheduled for
+ * each transmission in large scenarios.  If the Culling attribute is set,
+ * a signal is not delivered to a PHY when its received power is lower than
+ * the energy detection threshold of that PHY by more than CullingMargin,
+ * and thus neither decoded nor accounted for as interference.  If the
+ * CullingRange attribute is positive, the PHYs are indexed in a grid of
+ * square cells of that size, and only the PHYs located in the cells around
+ * the sender are considered; the PHYs farther than that range are never
+ * delivered the signal.  The PHYs are moved in the grid when their
+ * mobility model notifies a course change, and those moving at the time of
+ * the last course change are always considered.
+ */
+class YansWifiChannel : public Channel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  YansWifiChannel ();
+  virtual ~YansWifiChannel ();
+
+  //inherited from Channel.
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+  /**
+   * Adds the given YansWifiPhy to the PHY list
+   *
+   * \param phy the YansWifiPhy to be added to the PHY list
+   */
+  void Add (Ptr<YansWifiPhy> phy);
+
+  /**
+   * \param loss the new propagation loss model.
+   */
+  void SetPropagationLossModel (const Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the new propagation delay model.
+   */
+  void SetPropagationDelayModel (const Ptr<PropagationDelayModel> delay);
+
+  /**
+   * \param sender the phy object from which the packet is originating.
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet, in dBm
+   * \param duration the transmission duration associated with the packet
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy::StartTx.  The channel
+   * attempts to deliver the packet to all other YansWifiPhy objects
+   * on the channel (except for the sender).
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   *
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \return the number of signals delivered to a PHY since the creation
+   *         of the channel
+   */
+  uint64_t GetNDelivered (void) const;
+  /**
+   * \return the number of signals not delivered to a PHY because of the
+   *         culling threshold or of the culling range since the creation
+   *         of the channel
+   *
+   * The PHYs not considered because they are outside the cells around the
+   * sender are counted regardless of their channel number.
+   */
+  uint64_t GetNCulled (void) const;
+
+
+private:
+  /**
+   * A vector of pointers to YansWifiPhy.
+   */
+  typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+
+  /**
+   * This method is scheduled by Send for each associated YansWifiPhy.
+   * The method then calls the corresponding YansWifiPhy that the first
+   * bit of the packet has arrived.
+   *
+   * \param receiver the device to which the packet is destined
+   * \param packet the packet being sent
+   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const Packet> packet, double txPowerDbm, Time duration);
+
+  /**
+   * Compute the propagation of the signal to the given PHY and schedule its
+   * reception, unless it is culled.
+   *
+   * \param sender the PHY sending the signal
+   * \param receiver the PHY receiving the signal
+   * \param senderMobility the mobility model of the sender
+   * \param packet the packet being sent
+   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  void Deliver (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> senderMobility,
+                Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
+
+  /**
+   * \param position a position
+   * \param dx the offset along the x axis, in cells
+   * \param dy the offset along the y axis, in cells
+   * \return the key of the grid cell at the given offset from the cell
+   *         containing the position
+   */
+  uint64_t GetCell (Vector position, int32_t dx, int32_t dy) const;
+  /**
+   * Add the PHYs attached since the last transmission to the grid, and
+   * listen to the course changes of their mobility model.
+   */
+  void IndexPhys (void) const;
+  /**
+   * Place the given PHY in the grid cell of its position, or in the list
+   * of moving PHYs if it is moving.
+   *
+   * \param index the index of the PHY in the PHY list
+   * \param mobility the mobility model of the PHY
+   */
+  void PlacePhy (uint32_t index, Ptr<const MobilityModel> mobility) const;
+  /**
+   * Remove the given PHY from its grid cell or from the list of moving PHYs.
+   *
+   * \param index the index of the PHY in the PHY list
+   */
+  void RemovePhy (uint32_t index) const;
+  /**
+   * Move the PHYs using the given mobility model in the grid.
+   *
+   * \param mobility the mobility model whose course changed
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility) const;
+
+  /// Location of a PHY in the grid
+  struct GridEntry
+  {
+    bool moving; ///< whether the PHY is in the list of moving PHYs
+    uint64_t cell; ///< the key of the cell, if the PHY is not moving
+  };
+
+  PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
+  Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
+  Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  bool m_culling;                      //!< Whether signals below the culling threshold are culled
+  double m_cullingMargin;              //!< Margin below the energy detection threshold (dB)
+  double m_cullingRange;               //!< Culling range and size of the grid cells (m), disabled if not positive
+  mutable uint64_t m_nDelivered;       //!< Number of signals delivered
+  mutable uint64_t m_nCulled;          //!< Number of signals culled
+  mutable std::unordered_map<uint64_t, std::vector<uint32_t> > m_grid; //!< Indexes of the PHYs in each grid cell
+  mutable std::vector<uint32_t> m_moving; //!< Indexes of the moving PHYs
+  mutable std::vector<GridEntry> m_gridEntries; //!< Location of each indexed PHY
+  mutable std::map<Ptr<const MobilityModel>, std::vector<uint32_t> > m_mobilityPhys; //!< Indexes of the PHYs using each mobility model
+};
+
+} //namespace ns3
+
+#endif /* YANS_WIFI_CHANNEL_H */
@@ -26,41 +26,24 @@
  *          Pavel Boyko <boyko@iitp.ru>
  */
 #include "aodv-id-cache.h"
-#include <algorithm>
 
 namespace ns3 {
 namespace aodv {
 bool
 IdCache::IsDuplicate (Ipv4Address addr, uint32_t id)
 {
-  Purge ();
-  for (std::vector<UniqueId>::const_iterator i = m_idCache.begin ();
-       i != m_idCache.end (); ++i)
-    {
-      if (i->m_context == addr && i->m_id == id)
-        {
-          return true;
-        }
-    }
-  struct UniqueId uniqueId =
-  {
-    addr, id, m_lifetime + Simulator::Now ()
-  };
-  m_idCache.push_back (uniqueId);
-  return false;
+  return m_idCache.IsDuplicate (addr, id);
 }
 void
 IdCache::Purge ()
 {
-  m_idCache.erase (remove_if (m_idCache.begin (), m_idCache.end (),
-                              IsExpired ()), m_idCache.end ());
+  m_idCache.Purge ();
 }
 
 uint32_t
 IdCache::GetSize ()
 {
-  Purge ();
-  return m_idCache.size ();
+  return m_idCache.GetSize ();
 }
 
 }
@@ -31,7 +31,7 @@
 
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
-#include <vector>
+#include "ns3/duplicate-cache.h"
 
 namespace ns3 {
 namespace aodv {
@@ -47,7 +47,7 @@ public:
    * constructor
    * \param lifetime the lifetime for added entries
    */
-  IdCache (Time lifetime) : m_lifetime (lifetime)
+  IdCache (Time lifetime) : m_idCache (lifetime)
   {
   }
   /**
@@ -69,7 +69,7 @@ public:
    */
   void SetLifetime (Time lifetime)
   {
-    m_lifetime = lifetime;
+    m_idCache.SetLifetime (lifetime);
   }
   /**
    * Return lifetime for existing entries in cache
@@ -77,39 +77,11 @@ public:
    */
   Time GetLifeTime () const
   {
-    return m_lifetime;
+    return m_idCache.GetLifetime ();
   }
 private:
-  /// Unique packet ID
-  struct UniqueId
-  {
-    /// ID is supposed to be unique in single address context (e.g. sender address)
-    Ipv4Address m_context;
-    /// The id
-    uint32_t m_id;
-    /// When record will expire
-    Time m_expire;
-  };
-  /**
-   * \brief IsExpired structure
-   */
-  struct IsExpired
-  {
-    /**
-     * \brief Check if the entry is expired
-     *
-     * \param u UniqueId entry
-     * \return true if expired, false otherwise
-     */
-    bool operator() (const struct UniqueId & u) const
-    {
-      return (u.m_expire < Simulator::Now ());
-    }
-  };
-  /// Already seen IDs
-  std::vector<UniqueId> m_idCache;
-  /// Default lifetime for ID records
-  Time m_lifetime;
+  /// Already seen IDs, by (address, id)
+  DuplicateCache<> m_idCache;
 };
 
 }  // namespace aodv
@@ -27,8 +27,20 @@
 #include "pointer.h"
 #include "assert.h"
 #include "log.h"
+#include "boolean.h"
+#include "string.h"
+#include "enum.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <fstream>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
 
 
 /**
@@ -53,6 +65,24 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("Profiling",
+                   "If true, account wall clock time, invocation count and "
+                   "event queue size to each event type, and write the "
+                   "profile to ProfileFile at Simulator::Destroy.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_profiling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ProfileFile",
+                   "Name of the file the event profile is written to.",
+                   StringValue ("simulator-profile.csv"),
+                   MakeStringAccessor (&DefaultSimulatorImpl::m_profileFile),
+                   MakeStringChecker ())
+    .AddAttribute ("ProfileFormat",
+                   "Format of the event profile file.",
+                   EnumValue (DefaultSimulatorImpl::PROFILE_CSV),
+                   MakeEnumAccessor (&DefaultSimulatorImpl::m_profileFormat),
+                   MakeEnumChecker (DefaultSimulatorImpl::PROFILE_CSV, "Csv",
+                                    DefaultSimulatorImpl::PROFILE_JSON, "Json"))
   ;
   return tid;
 }
@@ -71,6 +101,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_eventCount = 0;
+  m_profiling = false;
+  m_profileFormat = PROFILE_CSV;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
 }
@@ -108,6 +141,11 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+  if (m_profiling)
+    {
+      WriteProfile ();
+      m_profile.clear ();
+    }
 }
 
 void
@@ -146,12 +184,211 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_profiling)
+    {
+      InvokeProfiled (next.impl);
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
   next.impl->Unref ();
+  m_eventCount++;
 
   ProcessEventsWithContext ();
 }
 
+void
+DefaultSimulatorImpl::InvokeProfiled (EventImpl *event)
+{
+  // Queue size at dispatch, including the event being dispatched
+  uint64_t queueSize = m_unscheduledEvents + 1;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+  uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count ();
+
+  // EventImpl has virtual functions, hence typeid yields the dynamic type
+  ProfileEntry &entry = m_profile[&typeid (*event)];
+  entry.count++;
+  entry.totalNs += elapsed;
+  entry.maxNs = std::max (entry.maxNs, elapsed);
+  entry.queueSum += queueSize;
+  entry.queueMax = std::max (entry.queueMax, queueSize);
+}
+
+namespace {
+
+/**
+ * \ingroup simulator
+ * Build a human readable label for an event type.
+ *
+ * The demangled name of an event created with MakeEvent () looks like
+ * <tt>ns3::MakeEvent<void (ns3::Foo::*)(int), ns3::Ptr<ns3::Foo>, int>
+ * (...)::EventMemberImpl1</tt>.  In this case the label is reduced to the
+ * target function type, i.e., <tt>void (ns3::Foo::*)(int)</tt>.
+ *
+ * \param [in] type The type of the event.
+ * \returns The event label.
+ */
+std::string
+ProfileLabel (const std::type_info *type)
+{
+  std::string name = type->name ();
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+  const std::string prefix = "ns3::MakeEvent<";
+  if (name.compare (0, prefix.size (), prefix) == 0)
+    {
+      // Keep the first template argument, honoring nested brackets
+      int depth = 0;
+      for (std::string::size_type i = prefix.size (); i < name.size (); ++i)
+        {
+          char c = name[i];
+          if (c == '<' || c == '(')
+            {
+              depth++;
+            }
+          else if (c == '>' || c == ')')
+            {
+              if (depth == 0)
+                {
+                  return name.substr (prefix.size (), i - prefix.size ());
+                }
+              depth--;
+            }
+          else if (c == ',' && depth == 0)
+            {
+              return name.substr (prefix.size (), i - prefix.size ());
+            }
+        }
+    }
+  return name;
+}
+
+/**
+ * \ingroup simulator
+ * Quote a string for the CSV or JSON profile output.
+ *
+ * \param [in] s The string to quote.
+ * \returns The quoted string.
+ */
+std::string
+ProfileQuote (const std::string &s)
+{
+  std::string quoted = "\"";
+  for (std::string::size_type i = 0; i < s.size (); ++i)
+    {
+      if (s[i] == '"')
+        {
+          quoted += '\\';
+        }
+      quoted += s[i];
+    }
+  return quoted + "\"";
+}
+
+/**
+ * \ingroup simulator
+ * Order profile rows by decreasing total time.
+ *
+ * \param [in] a The first row.
+ * \param [in] b The second row.
+ * \returns \c true if \p a has a larger total time than \p b.
+ */
+template <typename T>
+bool
+ProfileGreaterTotal (const T &a, const T &b)
+{
+  return a.second.totalNs > b.second.totalNs;
+}
+
+} // unnamed namespace
+
+void
+DefaultSimulatorImpl::WriteProfile (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_profile.empty ())
+    {
+      return;
+    }
+  std::ofstream out (m_profileFile.c_str ());
+  if (!out.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << m_profileFile);
+      return;
+    }
+
+  typedef std::pair<std::string, ProfileEntry> Row;
+  std::vector<Row> rows;
+  for (ProfileMap::const_iterator it = m_profile.begin (); it != m_profile.end (); ++it)
+    {
+      rows.push_back (Row (ProfileLabel (it->first), it->second));
+    }
+  std::sort (rows.begin (), rows.end (), ProfileGreaterTotal<Row>);
+
+  if (m_profileFormat == PROFILE_CSV)
+    {
+      out << "event,count,totalMs,meanUs,maxUs,meanQueueSize,maxQueueSize" << std::endl;
+    }
+  else
+    {
+      out << "[" << std::endl;
+    }
+  for (std::vector<Row>::const_iterator it = rows.begin (); it != rows.end (); ++it)
+    {
+      const ProfileEntry &e = it->second;
+      double totalMs = e.totalNs / 1e6;
+      double meanUs = e.totalNs / 1e3 / e.count;
+      double maxUs = e.maxNs / 1e3;
+      double meanQueue = static_cast<double> (e.queueSum) / e.count;
+      if (m_profileFormat == PROFILE_CSV)
+        {
+          // Labels contain commas, quote them as in RFC 4180
+          std::string label;
+          for (std::string::size_type i = 0; i < it->first.size (); ++i)
+            {
+              label += it->first[i];
+              if (it->first[i] == '"')
+                {
+                  label += '"';
+                }
+            }
+          out << "\"" << label << "\","
+              << e.count << ","
+              << totalMs << ","
+              << meanUs << ","
+              << maxUs << ","
+              << meanQueue << ","
+              << e.queueMax << std::endl;
+        }
+      else
+        {
+          out << "  {\"event\": " << ProfileQuote (it->first)
+              << ", \"count\": " << e.count
+              << ", \"totalMs\": " << totalMs
+              << ", \"meanUs\": " << meanUs
+              << ", \"maxUs\": " << maxUs
+              << ", \"meanQueueSize\": " << meanQueue
+              << ", \"maxQueueSize\": " << e.queueMax
+              << "}" << (it + 1 != rows.end () ? "," : "") << std::endl;
+        }
+    }
+  if (m_profileFormat == PROFILE_JSON)
+    {
+      out << "]" << std::endl;
+    }
+  out.close ();
+}
+
 bool 
 DefaultSimulatorImpl::IsFinished (void) const
 {
@@ -411,4 +648,10 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetEventCount (void) const
+{
+  return m_eventCount;
+}
+
 } // namespace ns3
@@ -30,6 +30,9 @@
 #include "ptr.h"
 
 #include <list>
+#include <map>
+#include <string>
+#include <typeinfo>
 
 /**
  * \file
@@ -43,6 +46,13 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the \c Profiling attribute is set, the wall clock time, the number
+ * of invocations and the event queue size at dispatch are accumulated per
+ * event type.  The event type is the dynamic type of the EventImpl; for
+ * events created with MakeEvent () it identifies the target class and the
+ * signature of the target function.  The profile is written to the
+ * \c ProfileFile at Simulator::Destroy ().
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -77,6 +87,7 @@ public:
   virtual void SetScheduler (ObjectFactory schedulerFactory);
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
 
 private:
   virtual void DoDispose (void);
@@ -85,6 +96,56 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+  /**
+   * Invoke an event and account its wall clock time, and the event
+   * queue size at dispatch, to the profile entry of its type.
+   *
+   * \param [in] event The event to invoke.
+   */
+  void InvokeProfiled (EventImpl *event);
+  /**
+   * Write the event profile to the configured file.
+   *
+   * Nothing is written if profiling is disabled or if no event
+   * has been profiled.
+   */
+  void WriteProfile (void) const;
+
+  /** Output format of the event profile. */
+  enum ProfileFormat
+  {
+    PROFILE_CSV,   //!< Comma separated values, one row per event type
+    PROFILE_JSON   //!< JSON array, one object per event type
+  };
+
+  /** Accumulated statistics of one event type. */
+  struct ProfileEntry
+  {
+    /** Number of invocations. */
+    uint64_t count;
+    /** Total wall clock time spent in the event, in nanoseconds. */
+    uint64_t totalNs;
+    /** Longest single invocation, in nanoseconds. */
+    uint64_t maxNs;
+    /** Sum of the event queue sizes at dispatch. */
+    uint64_t queueSum;
+    /** Largest event queue size at dispatch. */
+    uint64_t queueMax;
+  };
+  /**
+   * Container type for the event profile, indexed by the dynamic
+   * type of the EventImpl.  The key is the address of the std::type_info,
+   * which is unique per type, so no string is built on the event path.
+   */
+  typedef std::map<const std::type_info *, ProfileEntry> ProfileMap;
+  /** The event profile. */
+  ProfileMap m_profile;
+  /** Flag \c true if the event execution is profiled. */
+  bool m_profiling;
+  /** Name of the file the event profile is written to at Destroy. */
+  std::string m_profileFile;
+  /** Format of the event profile file. */
+  enum ProfileFormat m_profileFormat;
  
   /** Wrap an event with its execution context. */
   struct EventWithContext {
@@ -124,6 +185,8 @@ private:
   uint64_t m_currentTs;
   /** Execution context of the current event. */
   uint32_t m_currentContext;
+  /** The event count. */
+  uint64_t m_eventCount;
   /**
    * Number of events that have been inserted but not yet scheduled,
    *  not counting the Destroy events; this is used for validation
@@ -22,7 +22,11 @@
 #include "trace-source-accessor.h"
 #include "attribute-construction-list.h"
 #include "string.h"
+#include "simple-ref-count.h"
 #include "ns3/core-config.h"
+#include <string>
+#include <utility>
+#include <vector>
 #ifdef HAVE_STDLIB_H
 #include <cstdlib>
 #endif
@@ -76,93 +80,218 @@ ObjectBase::NotifyConstructionCompleted (void)
   NS_LOG_FUNCTION (this);
 }
 
-void
-ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
+/**
+ * \ingroup object
+ * The attributes of a TypeId and of its parents, in the order in which
+ * ObjectBase::ConstructSelf sets them.
+ *
+ * The plan is built the first time an object of the TypeId is constructed
+ * and rebuilt when TypeId::GetAttributeGeneration reports a change of the
+ * type ids, e.g. after Config::SetDefault.
+ */
+struct ConstructionPlan : public SimpleRefCount<ConstructionPlan>
+{
+  /** An attribute to set. */
+  struct Step
+  {
+    TypeId tid;                                 //!< The TypeId declaring the attribute.
+    std::string name;                           //!< The attribute name.
+    bool construct;                             //!< Whether the attribute is set at construction.
+    Ptr<const AttributeAccessor> accessor;      //!< The attribute accessor.
+    Ptr<const AttributeChecker> checker;        //!< The attribute checker.
+    Ptr<const AttributeValue> initialValue;     //!< The initial value.
+    bool initialValueChecked;                   //!< Whether the initial value can be set as is.
+    std::vector<std::string> envValues;         //!< The values from NS_ATTRIBUTE_DEFAULT.
+  };
+  uint32_t generation;                          //!< The TypeId::GetAttributeGeneration of the plan.
+  std::vector<Step> steps;                      //!< The attributes to set.
+};
+
+/**
+ * \ingroup object
+ * Get the values of the NS_ATTRIBUTE_DEFAULT environment variable,
+ * parsed the first time they are needed.
+ *
+ * \returns The values of the variable, as a list of (attribute full
+ *          name, value) pairs in the order of the variable.
+ */
+static const std::vector<std::pair<std::string, std::string> > &
+GetEnvDefaults (void)
+{
+  static std::vector<std::pair<std::string, std::string> > defaults;
+  static bool parsed = false;
+  if (parsed)
+    {
+      return defaults;
+    }
+  parsed = true;
+#ifdef HAVE_GETENV
+  char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+  if (envVar != 0)
+    {
+      std::string env = std::string (envVar);
+      std::string::size_type cur = 0;
+      std::string::size_type next = 0;
+      while (next != std::string::npos)
+        {
+          next = env.find (";", cur);
+          std::string tmp = std::string (env, cur, next-cur);
+          std::string::size_type equal = tmp.find ("=");
+          if (equal != std::string::npos)
+            {
+              std::string name = tmp.substr (0, equal);
+              std::string envval = tmp.substr (equal+1, tmp.size () - equal - 1);
+              defaults.push_back (std::make_pair (name, envval));
+            }
+          cur = next + 1;
+        }
+    }
+#endif /* HAVE_GETENV */
+  return defaults;
+}
+
+/**
+ * \ingroup object
+ * Get the construction plan of a TypeId, building it if needed.
+ *
+ * \param [in] tid The TypeId.
+ * \returns The construction plan.
+ */
+static Ptr<const ConstructionPlan>
+GetConstructionPlan (TypeId tid)
 {
+  // The plans are held by pointer: setting an attribute may construct
+  // other objects, and hence build other plans.
+  static std::vector<Ptr<ConstructionPlan> > plans;
+  uint32_t generation = TypeId::GetAttributeGeneration ();
+  uint16_t uid = tid.GetUid ();
+  if (uid >= plans.size ())
+    {
+      plans.resize (uid + 1);
+    }
+  if (plans[uid] != 0 && plans[uid]->generation == generation)
+    {
+      return plans[uid];
+    }
+
+  NS_LOG_DEBUG ("build the construction plan of tid="<<tid.GetName ());
+  const std::vector<std::pair<std::string, std::string> > &env = GetEnvDefaults ();
+  Ptr<ConstructionPlan> plan = Create<ConstructionPlan> ();
+  plan->generation = generation;
   // loop over the inheritance tree back to the Object base class.
-  NS_LOG_FUNCTION (this << &attributes);
-  TypeId tid = GetInstanceTypeId ();
   do {
-      // loop over all attributes in object type
-      NS_LOG_DEBUG ("construct tid="<<tid.GetName ()<<", params="<<tid.GetAttributeN ());
       for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
         {
-          struct TypeId::AttributeInformation info = tid.GetAttribute(i);
-          NS_LOG_DEBUG ("try to construct \""<< tid.GetName ()<<"::"<<
-                        info.name <<"\"");
-          // is this attribute stored in this AttributeConstructionList instance ?
-          Ptr<AttributeValue> value = attributes.Find(info.checker);
-          // See if this attribute should not be set here in the
-          // constructor.
-          if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          ConstructionPlan::Step step;
+          step.tid = tid;
+          step.name = info.name;
+          step.construct = info.flags & TypeId::ATTR_CONSTRUCT;
+          step.accessor = info.accessor;
+          step.checker = info.checker;
+          step.initialValue = info.initialValue;
+          // Initial values given as strings are parsed for each object,
+          // as parsing may create a new object (e.g., a random variable).
+          step.initialValueChecked = info.checker->Check (*info.initialValue);
+          if (!env.empty ())
             {
-              // Handle this attribute if it should not be 
-              // set here.
-              if (value == 0)
-                {
-                  // Skip this attribute if it's not in the
-                  // AttributeConstructionList.
-                  continue;
-                }              
-              else
+              std::string fullName = tid.GetAttributeFullName (i);
+              for (std::vector<std::pair<std::string, std::string> >::const_iterator it = env.begin ();
+                   it != env.end (); ++it)
                 {
-                  // This is an error because this attribute is not
-                  // settable in its constructor but is present in
-                  // the AttributeConstructionList.
-                  NS_FATAL_ERROR ("Attribute name="<<info.name<<" tid="<<tid.GetName () << ": initial value cannot be set using attributes");
+                  if (it->first == fullName)
+                    {
+                      step.envValues.push_back (it->second);
+                    }
                 }
             }
+          plan->steps.push_back (step);
+        }
+      tid = tid.GetParent ();
+    } while (tid != ObjectBase::GetTypeId ());
+  plans[uid] = plan;
+  return plan;
+}
 
-          if (value != 0)
+void
+ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
+{
+  NS_LOG_FUNCTION (this << &attributes);
+  Ptr<const ConstructionPlan> plan = GetConstructionPlan (GetInstanceTypeId ());
+  bool hasAttributes = attributes.Begin () != attributes.End ();
+  for (std::vector<ConstructionPlan::Step>::const_iterator step = plan->steps.begin ();
+       step != plan->steps.end (); ++step)
+    {
+      NS_LOG_DEBUG ("try to construct \""<< step->tid.GetName ()<<"::"<<
+                    step->name <<"\"");
+      // is this attribute stored in this AttributeConstructionList instance ?
+      Ptr<AttributeValue> value;
+      if (hasAttributes)
+        {
+          value = attributes.Find (step->checker);
+        }
+      // See if this attribute should not be set here in the
+      // constructor.
+      if (!step->construct)
+        {
+          // Handle this attribute if it should not be 
+          // set here.
+          if (value == 0)
             {
-              // We have a matching attribute value.
-              if (DoSet (info.accessor, info.checker, *value))
-                {
-                  NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                                info.name<<"\"");
-                  continue;
-                }
+              // Skip this attribute if it's not in the
+              // AttributeConstructionList.
+              continue;
+            }              
+          else
+            {
+              // This is an error because this attribute is not
+              // settable in its constructor but is present in
+              // the AttributeConstructionList.
+              NS_FATAL_ERROR ("Attribute name="<<step->name<<" tid="<<step->tid.GetName () << ": initial value cannot be set using attributes");
             }
+        }
 
-#ifdef HAVE_GETENV
-          // No matching attribute value so we try to look at the env var.
-          char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
-          if (envVar != 0)
+      if (value != 0)
+        {
+          // We have a matching attribute value.
+          if (DoSet (step->accessor, step->checker, *value))
             {
-              std::string env = std::string (envVar);
-              std::string::size_type cur = 0;
-              std::string::size_type next = 0;
-              while (next != std::string::npos)
-                {
-                  next = env.find (";", cur);
-                  std::string tmp = std::string (env, cur, next-cur);
-                  std::string::size_type equal = tmp.find ("=");
-                  if (equal != std::string::npos)
-                    {
-                      std::string name = tmp.substr (0, equal);
-                      std::string envval = tmp.substr (equal+1, tmp.size () - equal - 1);
-                      if (name == tid.GetAttributeFullName (i))
-                        {
-                          if (DoSet (info.accessor, info.checker, StringValue (envval)))
-                            {
-                              NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                                            info.name <<"\" from env var");
-                              break;
-                            }
-                        }
-                    }
-                  cur = next + 1;
-                }
+              NS_LOG_DEBUG ("construct \""<< step->tid.GetName ()<<"::"<<
+                            step->name<<"\"");
+              continue;
             }
-#endif /* HAVE_GETENV */
+        }
 
-          // No matching attribute value so we try to set the default value.
-          DoSet (info.accessor, info.checker, *info.initialValue);
-          NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                        info.name <<"\" from initial value.");
+      // No matching attribute value so we try to look at the env var.
+      bool fromEnv = false;
+      for (std::vector<std::string>::const_iterator envval = step->envValues.begin ();
+           envval != step->envValues.end (); ++envval)
+        {
+          if (DoSet (step->accessor, step->checker, StringValue (*envval)))
+            {
+              NS_LOG_DEBUG ("construct \""<< step->tid.GetName ()<<"::"<<
+                            step->name <<"\" from env var");
+              fromEnv = true;
+              break;
+            }
         }
-      tid = tid.GetParent ();
-    } while (tid != ObjectBase::GetTypeId ());
+      if (fromEnv)
+        {
+          continue;
+        }
+
+      // No matching attribute value so we try to set the default value.
+      if (step->initialValueChecked)
+        {
+          step->accessor->Set (this, *step->initialValue);
+        }
+      else
+        {
+          DoSet (step->accessor, step->checker, *step->initialValue);
+        }
+      NS_LOG_DEBUG ("construct \""<< step->tid.GetName ()<<"::"<<
+                    step->name <<"\" from initial value.");
+    }
   NotifyConstructionCompleted ();
 }
 
@@ -201,6 +330,35 @@ ObjectBase::SetAttribute (std::string name, const AttributeValue &value)
       NS_FATAL_ERROR ("Attribute name="<<name<<" could not be set for this object: tid="<<tid.GetName ());
     }
 }
+
+bool
+ObjectBase::HasAttribute (const TypeId::AttributeHandle &attribute) const
+{
+  TypeId tid = GetInstanceTypeId ();
+  TypeId owner;
+  owner.SetUid (attribute.tid);
+  return tid == owner || tid.IsChildOf (owner);
+}
+
+void
+ObjectBase::SetAttribute (const TypeId::AttributeHandle &attribute, const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (this << attribute.name << &value);
+  if (!HasAttribute (attribute))
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" does not exist for this object: tid="<<GetInstanceTypeId ().GetName ());
+    }
+  if (!(attribute.flags & TypeId::ATTR_SET) ||
+      !attribute.accessor->HasSetter ())
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" is not settable for this object: tid="<<GetInstanceTypeId ().GetName ());
+    }
+  if (!DoSet (attribute.accessor, attribute.checker, value))
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" could not be set for this object: tid="<<GetInstanceTypeId ().GetName ());
+    }
+}
+
 bool 
 ObjectBase::SetAttributeFailSafe (std::string name, const AttributeValue &value)
 {
@@ -253,6 +411,38 @@ ObjectBase::GetAttribute (std::string name, AttributeValue &value) const
   str->Set (v->SerializeToString (info.checker));
 }
 
+void
+ObjectBase::GetAttribute (const TypeId::AttributeHandle &attribute, AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << attribute.name << &value);
+  if (!HasAttribute (attribute))
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" does not exist for this object: tid="<<GetInstanceTypeId ().GetName ());
+    }
+  if (!(attribute.flags & TypeId::ATTR_GET) ||
+      !attribute.accessor->HasGetter ())
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" is not gettable for this object: tid="<<GetInstanceTypeId ().GetName ());
+    }
+  bool ok = attribute.accessor->Get (this, value);
+  if (ok)
+    {
+      return;
+    }
+  StringValue *str = dynamic_cast<StringValue *> (&value);
+  if (str == 0)
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" tid="<<GetInstanceTypeId ().GetName () << ": input value is not a string");
+    }
+  Ptr<AttributeValue> v = attribute.checker->Create ();
+  ok = attribute.accessor->Get (this, *PeekPointer (v));
+  if (!ok)
+    {
+      NS_FATAL_ERROR ("Attribute name="<<attribute.name<<" tid="<<GetInstanceTypeId ().GetName () << ": could not get value");
+    }
+  str->Set (v->SerializeToString (attribute.checker));
+}
+
 
 bool
 ObjectBase::GetAttributeFailSafe (std::string name, AttributeValue &value) const
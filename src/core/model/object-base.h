@@ -157,6 +157,17 @@ public:
    * \param [in] value The name of the attribute to set.
    */
   void SetAttribute (std::string name, const AttributeValue &value);
+  /**
+   * Set a single attribute resolved by TypeId::LookupAttributeHandle,
+   * raising fatal errors if unsuccessful.
+   *
+   * The handle must have been looked up on the TypeId of this object
+   * or of one of its parents.
+   *
+   * \param [in] attribute The attribute to set.
+   * \param [in] value The value to set it to.
+   */
+  void SetAttribute (const TypeId::AttributeHandle &attribute, const AttributeValue &value);
   /**
    * Set a single attribute without raising errors.
    *
@@ -184,6 +195,14 @@ public:
    * \param [out] value Where the result should be stored.
    */
   void GetAttribute (std::string name, AttributeValue &value) const;
+  /**
+   * Get the value of an attribute resolved by
+   * TypeId::LookupAttributeHandle, raising fatal errors if unsuccessful.
+   *
+   * \param [in]  attribute The attribute to read.
+   * \param [out] value Where the result should be stored.
+   */
+  void GetAttribute (const TypeId::AttributeHandle &attribute, AttributeValue &value) const;
   /**
    * Get the value of an attribute without raising erros.
    *
@@ -280,6 +299,14 @@ private:
   bool DoSet (Ptr<const AttributeAccessor> spec,
               Ptr<const AttributeChecker> checker, 
               const AttributeValue &value);
+  /**
+   * Check that an attribute handle applies to this object.
+   *
+   * \param [in] attribute The attribute.
+   * \returns \c true if the attribute is declared by the TypeId of
+   *          this object or by one of its parents.
+   */
+  bool HasAttribute (const TypeId::AttributeHandle &attribute) const;
 
 };
 
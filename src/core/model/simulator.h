@@ -184,6 +184,12 @@ public:
    */
   static uint32_t GetContext (void);
 
+  /**
+   * Get the number of events executed.
+   * \returns The total number of events executed.
+   */
+  static uint64_t GetEventCount (void);
+
   /**
    * Context enum values.
    *
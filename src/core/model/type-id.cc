@@ -24,6 +24,7 @@
 #include "trace-source-accessor.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -78,6 +79,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -216,6 +219,28 @@ public:
   void SetAttributeInitialValue (uint16_t uid,
                                  std::size_t i,
                                  Ptr<const AttributeValue> initialValue);
+  /**
+   * Find an attribute of a type id or of its parents by name.
+   * \param [in] uid The id.
+   * \param [in] name The attribute name.
+   * \param [out] owner The id of the type id declaring the attribute.
+   * \param [out] index The index of the attribute in \p owner.
+   * \returns \c true if the attribute was found.
+   */
+  bool FindAttribute (uint16_t uid, const std::string &name,
+                      uint16_t *owner, std::size_t *index);
+  /**
+   * Get a reference to the information of an attribute.
+   * \param [in] uid The id.
+   * \param [in] i Index into attribute array
+   * \returns The information associated to attribute whose index is \p i.
+   */
+  const struct TypeId::AttributeInformation &PeekAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Get the number of changes to the attributes of all the type ids.
+   * \returns The number of changes.
+   */
+  uint32_t GetAttributeGeneration (void) const;
   /**
    * Get the number of attributes.
    * \param [in] uid The id.
@@ -264,6 +289,23 @@ public:
    * \returns Detailed information about the requested trace source.
    */
   struct TypeId::TraceSourceInformation GetTraceSource (uint16_t uid, std::size_t i) const;
+  /**
+   * Find a trace source of a type id or of its parents by name.
+   * \param [in] uid The id.
+   * \param [in] name The trace source name.
+   * \param [out] owner The id of the type id declaring the trace source.
+   * \param [out] index The index of the trace source in \p owner.
+   * \returns \c true if the trace source was found.
+   */
+  bool FindTraceSource (uint16_t uid, const std::string &name,
+                        uint16_t *owner, std::size_t *index);
+  /**
+   * Get a reference to the information of a trace source.
+   * \param [in] uid The id.
+   * \param [in] i Index into trace source array
+   * \returns The information associated to trace source whose index is \p i.
+   */
+  const struct TypeId::TraceSourceInformation &PeekTraceSource (uint16_t uid, std::size_t i) const;
   /**
    * Check if this TypeId should not be listed in documentation.
    * \param [in] uid The id.
@@ -319,10 +361,34 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /** \c true if attributeIndex and traceSourceIndex are up to date. */
+    bool indexed;
+    /**
+     * The attributes of this type id and of its parents by name,
+     * as (declaring type id, index) pairs.
+     */
+    std::unordered_map<std::string, std::pair<uint16_t, std::size_t> > attributeIndex;
+    /**
+     * The trace sources of this type id and of its parents by name,
+     * as (declaring type id, index) pairs.
+     */
+    std::unordered_map<std::string, std::pair<uint16_t, std::size_t> > traceSourceIndex;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
+  /**
+   * Build the indexes by name of a type id, if they are not up to date.
+   * \param [in] uid The id.
+   * \returns The information record, with up to date indexes.
+   */
+  struct IidInformation *UpdateIndexes (uint16_t uid);
+  /**
+   * Mark the indexes by name of all the type ids as out of date, after
+   * a change of parent, or a new attribute or trace source.
+   */
+  void InvalidateIndexes (void);
+
   /**
    * Retrieve the information record for a type.
    * \param [in] uid The id.
@@ -343,6 +409,15 @@ private:
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /**
+   * The number of changes to the parents, attributes and initial values
+   * of the type ids.
+   */
+  uint32_t m_attributeGeneration;
+
+  /** \c true if the indexes by name of some type ids are up to date. */
+  bool m_indexed;
+
 
   /** IidManager constants. */
   enum {
@@ -378,6 +453,13 @@ IidManager::Hasher (const std::string name)
  */
 #define IIDL IID << ": "
 
+IidManager::IidManager ()
+  : m_attributeGeneration (0),
+    m_indexed (false)
+{
+  NS_LOG_FUNCTION (IID);
+}
+
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
@@ -439,6 +521,7 @@ IidManager::AllocateUid (std::string name)
   information.size = (std::size_t)(-1);
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.indexed = false;
   m_information.push_back (information);
   std::size_t tuid = m_information.size();
   NS_ASSERT (tuid <= 0xffff);
@@ -467,6 +550,8 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_attributeGeneration++;
+  InvalidateIndexes ();
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -676,6 +761,8 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  m_attributeGeneration++;
+  InvalidateIndexes ();
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void 
@@ -687,6 +774,94 @@ IidManager::SetAttributeInitialValue (uint16_t uid,
   struct IidInformation *information = LookupInformation (uid);
   NS_ASSERT (i < information->attributes.size ());
   information->attributes[i].initialValue = initialValue;
+  m_attributeGeneration++;
+}
+
+uint32_t
+IidManager::GetAttributeGeneration (void) const
+{
+  NS_LOG_FUNCTION (IID);
+  return m_attributeGeneration;
+}
+
+void
+IidManager::InvalidateIndexes (void)
+{
+  NS_LOG_FUNCTION (IID);
+  if (!m_indexed)
+    {
+      return;
+    }
+  for (std::vector<struct IidInformation>::iterator i = m_information.begin ();
+       i != m_information.end (); ++i)
+    {
+      i->indexed = false;
+      i->attributeIndex.clear ();
+      i->traceSourceIndex.clear ();
+    }
+  m_indexed = false;
+}
+
+struct IidManager::IidInformation *
+IidManager::UpdateIndexes (uint16_t uid)
+{
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->indexed)
+    {
+      return information;
+    }
+  NS_LOG_FUNCTION (IID << uid);
+  // Walk up the inheritance tree: the first type id declaring a name,
+  // i.e., the most derived one, is kept.
+  while (true)
+    {
+      struct IidInformation *current = LookupInformation (uid);
+      for (std::size_t i = 0; i < current->attributes.size (); i++)
+        {
+          information->attributeIndex.insert (std::make_pair (current->attributes[i].name,
+                                                              std::make_pair (uid, i)));
+        }
+      for (std::size_t i = 0; i < current->traceSources.size (); i++)
+        {
+          information->traceSourceIndex.insert (std::make_pair (current->traceSources[i].name,
+                                                                std::make_pair (uid, i)));
+        }
+      if (current->parent == uid || current->parent == 0)
+        {
+          // top of inheritance tree
+          break;
+        }
+      uid = current->parent;
+    }
+  information->indexed = true;
+  m_indexed = true;
+  return information;
+}
+
+bool
+IidManager::FindAttribute (uint16_t uid, const std::string &name,
+                           uint16_t *owner, std::size_t *index)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = UpdateIndexes (uid);
+  std::unordered_map<std::string, std::pair<uint16_t, std::size_t> >::const_iterator it =
+    information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      return false;
+    }
+  *owner = it->second.first;
+  *index = it->second.second;
+  return true;
+}
+
+const struct TypeId::AttributeInformation &
+IidManager::PeekAttribute (uint16_t uid, std::size_t i) const
+{
+  NS_LOG_FUNCTION (IID << uid << i);
+  struct IidInformation *information = LookupInformation (uid);
+  NS_ASSERT (i < information->attributes.size ());
+  return information->attributes[i];
 }
 
 
@@ -767,6 +942,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  InvalidateIndexes ();
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -787,6 +963,32 @@ IidManager::GetTraceSource (uint16_t uid, std::size_t i) const
   NS_LOG_LOGIC (IIDL << information->name);
   return information->traceSources[i];
 }
+
+bool
+IidManager::FindTraceSource (uint16_t uid, const std::string &name,
+                             uint16_t *owner, std::size_t *index)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = UpdateIndexes (uid);
+  std::unordered_map<std::string, std::pair<uint16_t, std::size_t> >::const_iterator it =
+    information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      return false;
+    }
+  *owner = it->second.first;
+  *index = it->second.second;
+  return true;
+}
+
+const struct TypeId::TraceSourceInformation &
+IidManager::PeekTraceSource (uint16_t uid, std::size_t i) const
+{
+  NS_LOG_FUNCTION (IID << uid << i);
+  struct IidInformation *information = LookupInformation (uid);
+  NS_ASSERT (i < information->traceSources.size ());
+  return information->traceSources[i];
+}
 bool 
 IidManager::MustHideFromDocumentation (uint16_t uid) const
 {
@@ -873,42 +1075,66 @@ TypeId::GetRegistered (uint16_t i)
   return TypeId (IidManager::Get ()->GetRegistered (i));
 }
 
+/**
+ * \ingroup object
+ * Check the support level of an attribute or trace source found by name.
+ *
+ * \param [in] kind "Attribute" or "TraceSource", for the messages.
+ * \param [in] name The name of the attribute or trace source.
+ * \param [in] supportLevel Its support level.
+ * \param [in] supportMsg Its support message.
+ */
+static void
+CheckSupportLevel (const char *kind, const std::string &name,
+                   TypeId::SupportLevel supportLevel, const std::string &supportMsg)
+{
+  if (supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << kind << " '" << name << "' is deprecated: "
+                << supportMsg << std::endl;
+    }
+  else if (supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR (kind << " '" << name
+                      << "' is obsolete, with no fallback: "
+                      << supportMsg);
+    }
+}
+
 bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  uint16_t owner;
+  std::size_t index;
+  if (!IidManager::Get ()->FindAttribute (m_tid, name, &owner, &index))
+    {
+      return false;
+    }
+  const struct TypeId::AttributeInformation &tmp = IidManager::Get ()->PeekAttribute (owner, index);
+  CheckSupportLevel ("Attribute", name, tmp.supportLevel, tmp.supportMsg);
+  *info = tmp;
+  return true;
+}
+
+bool
+TypeId::LookupAttributeHandle (std::string name, struct TypeId::AttributeHandle *handle) const
+{
+  NS_LOG_FUNCTION (this << name << handle);
+  uint16_t owner;
+  std::size_t index;
+  if (!IidManager::Get ()->FindAttribute (m_tid, name, &owner, &index))
+    {
+      return false;
+    }
+  const struct TypeId::AttributeInformation &tmp = IidManager::Get ()->PeekAttribute (owner, index);
+  CheckSupportLevel ("Attribute", name, tmp.supportLevel, tmp.supportMsg);
+  handle->name = tmp.name;
+  handle->tid = owner;
+  handle->flags = tmp.flags;
+  handle->accessor = tmp.accessor;
+  handle->checker = tmp.checker;
+  return true;
 }
 
 TypeId 
@@ -1048,6 +1274,13 @@ TypeId::SetAttributeInitialValue (std::size_t i,
   return true;
 }
 
+uint32_t
+TypeId::GetAttributeGeneration (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return IidManager::Get ()->GetAttributeGeneration ();
+}
+
 
 Callback<ObjectBase *> 
 TypeId::GetConstructor (void) const
@@ -1137,46 +1370,31 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                   return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else  if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  uint16_t owner;
+  std::size_t index;
+  if (!IidManager::Get ()->FindTraceSource (m_tid, name, &owner, &index))
+    {
+      return 0;
+    }
+  const struct TypeId::TraceSourceInformation &tmp = IidManager::Get ()->PeekTraceSource (owner, index);
+  CheckSupportLevel ("TraceSource", name, tmp.supportLevel, tmp.supportMsg);
+  *info = tmp;
+  return tmp.accessor;
 }
 
 Ptr<const TraceSourceAccessor> 
 TypeId::LookupTraceSourceByName (std::string name) const
 {
-  struct TraceSourceInformation info;
-  return LookupTraceSourceByName (name, &info);
+  NS_LOG_FUNCTION (this << name);
+  uint16_t owner;
+  std::size_t index;
+  if (!IidManager::Get ()->FindTraceSource (m_tid, name, &owner, &index))
+    {
+      return 0;
+    }
+  const struct TypeId::TraceSourceInformation &tmp = IidManager::Get ()->PeekTraceSource (owner, index);
+  CheckSupportLevel ("TraceSource", name, tmp.supportLevel, tmp.supportMsg);
+  return tmp.accessor;
 }
 
 uint16_t 
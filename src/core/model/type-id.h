@@ -108,6 +108,25 @@ public:
     /** Support message. */
     std::string supportMsg;
   };
+  /**
+   * An attribute resolved by name with LookupAttributeHandle.
+   *
+   * The handle can be used to set or get the attribute on any object of
+   * the TypeId used for the lookup, or of a subclass, without looking
+   * the name up again.
+   */
+  struct AttributeHandle {
+    /** Attribute name. */
+    std::string name;
+    /** The uid of the TypeId declaring the attribute. */
+    uint16_t tid;
+    /** AttributeFlags value. */
+    uint32_t flags;
+    /** Accessor object. */
+    Ptr<const AttributeAccessor> accessor;
+    /** Checker object. */
+    Ptr<const AttributeChecker> checker;
+  };
 
   /** Type of hash values. */
   typedef uint32_t hash_t;
@@ -393,6 +412,18 @@ public:
   bool SetAttributeInitialValue (std::size_t i,
                                  Ptr<const AttributeValue> initialValue);
 
+  /**
+   * Get the number of changes made to the type ids which affect the
+   * construction of objects: new parents, new attributes and new
+   * initial values (e.g. from Config::SetDefault).
+   *
+   * Caches built from the attributes of the type ids are stale when
+   * this number has changed.
+   *
+   * \returns The number of changes to the attributes.
+   */
+  static uint32_t GetAttributeGeneration (void);
+
   /**
    * Record in this TypeId the fact that a new attribute exists.
    *
@@ -485,6 +516,19 @@ public:
    * \returns \c true if the requested attribute could be found.
    */
   bool LookupAttributeByName (std::string name, struct AttributeInformation *info) const;
+  /**
+   * Find an Attribute by name, retrieving a handle on it.
+   *
+   * Helpers setting the same attribute on many objects can resolve
+   * the name once, then use ObjectBase::SetAttribute (const
+   * TypeId::AttributeHandle &, const AttributeValue &).
+   *
+   * \param [in]  name The name of the requested attribute
+   * \param [out] handle A pointer to the TypeId::AttributeHandle
+   *              where the result value of this method will be stored.
+   * \returns \c true if the requested attribute could be found.
+   */
+  bool LookupAttributeHandle (std::string name, struct AttributeHandle *handle) const;
   /**
    * Find a TraceSource by name.
    *
@@ -821,6 +821,19 @@ RandomVariableStreamAttributeTestCase::DoRun (void)
   p = CreateObject<AttributeObjectTest> ();
   NS_TEST_ASSERT_MSG_NE (p, 0, "Unable to CreateObject");
 
+  //
+  // The initial value is given as a string, so each object must get its
+  // own random variable.
+  //
+  Ptr<AttributeObjectTest> q = CreateObject<AttributeObjectTest> ();
+  PointerValue pRandom;
+  PointerValue qRandom;
+  p->GetAttribute ("TestRandom", pRandom);
+  q->GetAttribute ("TestRandom", qRandom);
+  NS_TEST_ASSERT_MSG_NE (pRandom.Get<RandomVariableStream> (), 0, "No initial random variable");
+  NS_TEST_ASSERT_MSG_NE (pRandom.Get<RandomVariableStream> (), qRandom.Get<RandomVariableStream> (),
+                         "Objects share the random variable of their initial value");
+
   //
   // Try to set a UniformRandomVariable
   //
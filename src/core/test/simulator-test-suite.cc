@@ -23,6 +23,12 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/enum.h"
+
+#include <fstream>
 
 using namespace ns3;
 
@@ -138,6 +144,8 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_b, true, "Event B did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_c, true, "Event C did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_d, true, "Event D did not run ?");
+  // the canceled event A is still processed, the removed event C is not
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount (), 3, "Unexpected number of executed events");
 
   EventId anId = Simulator::ScheduleNow (&SimulatorEventsTestCase::Eventfoo0, this);
   EventId anotherId = anId;
@@ -461,6 +469,64 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorProfilingTestCase : public TestCase
+{
+public:
+  SimulatorProfilingTestCase ();
+  virtual void DoRun (void);
+  void Foo (int a);
+  void Bar (int a);
+};
+
+SimulatorProfilingTestCase::SimulatorProfilingTestCase ()
+  : TestCase ("Check that the event profile of DefaultSimulatorImpl is written at Destroy")
+{
+}
+void
+SimulatorProfilingTestCase::Foo (int a)
+{
+}
+void
+SimulatorProfilingTestCase::Bar (int a)
+{
+  Simulator::Schedule (MicroSeconds (1), &SimulatorProfilingTestCase::Foo, this, a);
+}
+void
+SimulatorProfilingTestCase::DoRun (void)
+{
+  std::string file = CreateTempDirFilename ("simulator-profile.csv");
+  ObjectFactory factory;
+  factory.SetTypeId (DefaultSimulatorImpl::GetTypeId ());
+  factory.Set ("Profiling", BooleanValue (true));
+  factory.Set ("ProfileFile", StringValue (file));
+  factory.Set ("ProfileFormat", EnumValue (0));
+  Simulator::SetImplementation (factory.Create<SimulatorImpl> ());
+
+  for (int i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &SimulatorProfilingTestCase::Bar, this, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::ifstream in (file.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (in.is_open (), true, "Profile file " << file << " was not written");
+  std::string header;
+  std::getline (in, header);
+  NS_TEST_EXPECT_MSG_EQ (header, "event,count,totalMs,meanUs,maxUs,meanQueueSize,maxQueueSize",
+                         "Unexpected profile header");
+  // Foo and Bar have the same signature, hence the same event type
+  std::string line;
+  uint32_t rows = 0;
+  while (std::getline (in, line))
+    {
+      NS_TEST_EXPECT_MSG_NE (line.find ("SimulatorProfilingTestCase::*)(int)\",20,"), std::string::npos,
+                             "Unexpected profile row " << line);
+      rows++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (rows, 1, "Unexpected number of profile rows");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -477,5 +543,6 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorProfilingTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -325,6 +325,116 @@ DeprecatedAttributeTestCase::DoRun (void)
        << endl;
 }
 
+
+
+//----------------------------
+//
+// Attribute handle test
+
+class DerivedAttribute : public DeprecatedAttribute
+{
+private:
+  int m_derivedAttr;
+
+public:
+  DerivedAttribute () : m_derivedAttr (0) { };
+  virtual ~DerivedAttribute () { };
+
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("DerivedAttribute")
+      .SetParent<DeprecatedAttribute> ()
+      .AddConstructor<DerivedAttribute> ()
+      .AddAttribute ("derivedAttribute",
+                     "the derived Attribute",
+                     IntegerValue (2),
+                     MakeIntegerAccessor (&DerivedAttribute::m_derivedAttr),
+                     MakeIntegerChecker<int> ());
+    return tid;
+  }
+};
+
+
+class AttributeHandleTestCase : public TestCase
+{
+public:
+  AttributeHandleTestCase ();
+  virtual ~AttributeHandleTestCase ();
+private:
+  virtual void DoRun (void);
+
+};
+
+AttributeHandleTestCase::AttributeHandleTestCase ()
+  : TestCase ("Check attribute handles and the lookup indexes")
+{
+}
+
+AttributeHandleTestCase::~AttributeHandleTestCase ()
+{
+}
+
+void
+AttributeHandleTestCase::DoRun (void)
+{
+  TypeId tid = DerivedAttribute::GetTypeId ();
+
+  // Attributes of the TypeId and of its parents are found
+  struct TypeId::AttributeInformation ainfo;
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("derivedAttribute", &ainfo), true,
+                         "lookup derived attribute");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("attribute", &ainfo), true,
+                         "lookup parent attribute");
+  NS_TEST_ASSERT_MSG_EQ (ainfo.name, "attribute", "wrong attribute found");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("missing", &ainfo), false,
+                         "lookup missing attribute");
+  NS_TEST_ASSERT_MSG_NE (tid.LookupTraceSourceByName ("trace"), 0,
+                         "lookup parent trace source");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName ("missing"), 0,
+                         "lookup missing trace source");
+
+  // A handle of the parent TypeId is usable on the derived objects
+  Ptr<DerivedAttribute> object = CreateObject<DerivedAttribute> ();
+  TypeId::AttributeHandle handle;
+  NS_TEST_ASSERT_MSG_EQ (DeprecatedAttribute::GetTypeId ().LookupAttributeHandle ("attribute", &handle), true,
+                         "lookup attribute handle");
+  object->SetAttribute (handle, IntegerValue (5));
+  IntegerValue value;
+  object->GetAttribute ("attribute", value);
+  NS_TEST_ASSERT_MSG_EQ (value.Get (), 5, "attribute not set through its handle");
+  object->SetAttribute ("attribute", IntegerValue (6));
+  object->GetAttribute (handle, value);
+  NS_TEST_ASSERT_MSG_EQ (value.Get (), 6, "attribute not read through its handle");
+
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeHandle ("derivedAttribute", &handle), true,
+                         "lookup derived attribute handle");
+  object->SetAttribute (handle, IntegerValue (7));
+  object->GetAttribute ("derivedAttribute", value);
+  NS_TEST_ASSERT_MSG_EQ (value.Get (), 7, "derived attribute not set through its handle");
+
+  // The indexes follow the attributes added after a lookup
+  TypeId late;
+  if (!TypeId::LookupByNameFailSafe ("LateAttribute", &late))
+    {
+      late = TypeId ("LateAttribute")
+        .SetParent<Object> ()
+        .AddAttribute ("first", "the first Attribute",
+                       EmptyAttributeValue (),
+                       MakeEmptyAttributeAccessor (),
+                       MakeEmptyAttributeChecker ());
+      NS_TEST_ASSERT_MSG_EQ (late.LookupAttributeByName ("second", &ainfo), false,
+                             "lookup attribute not added yet");
+      late.AddAttribute ("second", "the second Attribute",
+                         EmptyAttributeValue (),
+                         MakeEmptyAttributeAccessor (),
+                         MakeEmptyAttributeChecker ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (late.LookupAttributeByName ("second", &ainfo), true,
+                         "lookup attribute added after a lookup");
+  NS_TEST_ASSERT_MSG_EQ (late.LookupAttributeByName ("first", &ainfo), true,
+                         "lookup first attribute");
+}
+
   
 //----------------------------
 //
@@ -437,6 +547,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new AttributeHandleTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
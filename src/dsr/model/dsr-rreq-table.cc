@@ -259,35 +259,32 @@ DsrRreqTable::FindSourceEntry (Ipv4Address src, Ipv4Address dst, uint16_t id)
   DsrReceivedRreqEntry rreqEntry;
   rreqEntry.SetDestination (dst);
   rreqEntry.SetIdentification (id);
-  std::list<DsrReceivedRreqEntry> receivedRreqEntryList;
   /*
    * this function will return false if the entry is not found, true if duplicate entry find
    */
-  std::map<Ipv4Address, std::list<DsrReceivedRreqEntry> >::const_iterator i = m_sourceRreqMap.find (src);
+  std::map<Ipv4Address, std::list<DsrReceivedRreqEntry> >::iterator i = m_sourceRreqMap.find (src);
   if (i == m_sourceRreqMap.end ())
     {
       NS_LOG_LOGIC ("The source request table entry for " << src << " not found");
 
-      receivedRreqEntryList.clear ();  /// Clear the received source request entry
-      receivedRreqEntryList.push_back (rreqEntry);
-
-      m_sourceRreqMap [src] = receivedRreqEntryList;
+      m_sourceRreqMap [src].push_back (rreqEntry);
       return false;
     }
   else
     {
       NS_LOG_LOGIC ("Find the request table entry for  " << src << ", check if it is exact duplicate");
+      std::list<DsrReceivedRreqEntry> &receivedRreqEntryList = i->second;
       /*
-       * Drop the most aged packet when buffer reaches to max
+       * The most aged entry is dropped when buffer reaches to max, so it is not checked
        */
-      receivedRreqEntryList = i->second;
-      if (receivedRreqEntryList.size () >= m_requestIdSize)
+      bool full = receivedRreqEntryList.size () >= m_requestIdSize;
+      std::list<DsrReceivedRreqEntry>::const_iterator j = receivedRreqEntryList.begin ();
+      if (full && j != receivedRreqEntryList.end ())
         {
-          receivedRreqEntryList.pop_front ();
+          ++j;
         }
-      Ipv4Address src = i->first;
       // We loop the receive rreq entry to find duplicate
-      for (std::list<DsrReceivedRreqEntry>::const_iterator j = receivedRreqEntryList.begin (); j != receivedRreqEntryList.end (); ++j)
+      for (; j != receivedRreqEntryList.end (); ++j)
         {
           if (*j == rreqEntry)          /// Check if we have found one duplication entry or not
             {
@@ -295,8 +292,11 @@ DsrRreqTable::FindSourceEntry (Ipv4Address src, Ipv4Address dst, uint16_t id)
             }
         }
       /// if this entry is not found, we need to save the entry in the cache, and then return false for the check
+      if (full && !receivedRreqEntryList.empty ())
+        {
+          receivedRreqEntryList.pop_front ();
+        }
       receivedRreqEntryList.push_back (rreqEntry);
-      m_sourceRreqMap [src] = receivedRreqEntryList;
       return false;
     }
 }
@@ -22,8 +22,10 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/simulator.h"
+#include <cmath>
 
 namespace ns3 {
 
@@ -66,6 +68,14 @@ BasicEnergySource::GetTypeId (void)
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("EventDrivenEnergyUpdate",
+                   "If true, the remaining energy is only updated when a device "
+                   "changes state or when it is read, and a single event is scheduled "
+                   "at the time the low (or high) battery threshold is reached, "
+                   "instead of every PeriodicEnergyUpdateInterval.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BasicEnergySource::m_eventDriven),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at BasicEnergySource.",
                      MakeTraceSourceAccessor (&BasicEnergySource::m_remainingEnergyJ),
@@ -79,6 +89,7 @@ BasicEnergySource::BasicEnergySource ()
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
   m_depleted = false;
+  m_eventDriven = false;
 }
 
 BasicEnergySource::~BasicEnergySource ()
@@ -182,6 +193,18 @@ BasicEnergySource::UpdateEnergySource (void)
       NotifyEnergyChanged ();
     }
 
+  // a handler of the notifications above may have updated the source already
+  m_energyUpdateEvent.Cancel ();
+
+  if (m_eventDriven)
+    {
+      // the device models change their current after notifying the energy
+      // source, so the next threshold is computed once they are done
+      m_energyUpdateEvent = Simulator::ScheduleNow (&BasicEnergySource::ScheduleThresholdEvent,
+                                                    this);
+      return;
+    }
+
   m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
                                              &BasicEnergySource::UpdateEnergySource,
                                              this);
@@ -191,6 +214,36 @@ BasicEnergySource::UpdateEnergySource (void)
  * Private functions start here.
  */
 
+void
+BasicEnergySource::ScheduleThresholdEvent (void)
+{
+  NS_LOG_FUNCTION (this);
+  double powerW = CalculateTotalCurrent () * m_supplyVoltageV;
+  double energyToThresholdJ;
+  if (!m_depleted && powerW > 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+  else if (m_depleted && powerW < 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_highBatteryTh * m_initialEnergyJ;
+    }
+  else
+    {
+      return; // the remaining energy does not move towards a threshold
+    }
+  // round up, so that the threshold is reached when the event expires
+  double delayNs = std::ceil (energyToThresholdJ / powerW * 1e9);
+  if (delayNs >= Time::Max ().GetNanoSeconds ())
+    {
+      return;
+    }
+  NS_LOG_DEBUG ("BasicEnergySource:Threshold reached in " << delayNs << " ns");
+  m_energyUpdateEvent = Simulator::Schedule (NanoSeconds (std::max (delayNs, 1.0)),
+                                             &BasicEnergySource::UpdateEnergySource,
+                                             this);
+}
+
 void
 BasicEnergySource::DoInitialize (void)
 {
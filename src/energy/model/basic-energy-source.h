@@ -33,6 +33,11 @@ namespace ns3 {
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * The remaining energy is updated every PeriodicEnergyUpdateInterval, or,
+ * with the EventDrivenEnergyUpdate attribute, only when a device changes
+ * state, when it is read, and when the low or high battery threshold is
+ * reached, which is computed exactly from the current drawn by the devices.
+ *
  */
 class BasicEnergySource : public EnergySource
 {
@@ -135,6 +140,14 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * In event-driven mode, schedules the update of the energy source at the
+   * time the remaining energy reaches the low battery threshold (or the high
+   * battery threshold if the source is depleted and being recharged), given
+   * the current drawn by the devices.
+   */
+  void ScheduleThresholdEvent (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -146,6 +159,7 @@ private:
   EventId m_energyUpdateEvent;            // energy update event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  bool m_eventDriven;                     // update on device state changes and thresholds only
 
 };
 
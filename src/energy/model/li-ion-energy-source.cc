@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/simulator.h"
 
@@ -103,6 +104,13 @@ LiIonEnergySource::GetTypeId (void)
                    MakeTimeAccessor (&LiIonEnergySource::SetEnergyUpdateInterval,
                                      &LiIonEnergySource::GetEnergyUpdateInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("EventDrivenEnergyUpdate",
+                   "If true, the remaining energy is only updated when a device "
+                   "changes state or when it is read, and when the low battery "
+                   "threshold is reached, instead of every PeriodicEnergyUpdateInterval.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LiIonEnergySource::m_eventDriven),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at BasicEnergySource.",
                      MakeTraceSourceAccessor (&LiIonEnergySource::m_remainingEnergyJ),
@@ -113,7 +121,8 @@ LiIonEnergySource::GetTypeId (void)
 
 LiIonEnergySource::LiIonEnergySource ()
   : m_drainedCapacity (0.0),
-    m_lastUpdateTime (Seconds (0.0))
+    m_lastUpdateTime (Seconds (0.0)),
+    m_eventDriven (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -234,6 +243,15 @@ LiIonEnergySource::UpdateEnergySource (void)
       return; // stop periodic update
     }
 
+  if (m_eventDriven)
+    {
+      // the device models change their current after notifying the energy
+      // source, so the threshold is computed once they are done
+      m_energyUpdateEvent = Simulator::ScheduleNow (&LiIonEnergySource::ScheduleThresholdEvent,
+                                                    this);
+      return;
+    }
+
   m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
                                              &LiIonEnergySource::UpdateEnergySource,
                                              this);
@@ -242,6 +260,31 @@ LiIonEnergySource::UpdateEnergySource (void)
 /*
  * Private functions start here.
  */
+
+void
+LiIonEnergySource::ScheduleThresholdEvent (void)
+{
+  NS_LOG_FUNCTION (this);
+  double totalCurrentA = CalculateTotalCurrent ();
+  double powerW = totalCurrentA * GetVoltage (totalCurrentA);
+  if (totalCurrentA <= 0 || powerW <= 0)
+    {
+      return; // the cell is not discharging
+    }
+  // the voltage only decreases while discharging, so the threshold is
+  // reached at the earliest after this delay, rounded up
+  double energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+  double delayNs = std::ceil (energyToThresholdJ / powerW * 1e9);
+  if (delayNs >= Time::Max ().GetNanoSeconds ())
+    {
+      return;
+    }
+  NS_LOG_DEBUG ("LiIonEnergySource:Threshold reached in at least " << delayNs << " ns");
+  m_energyUpdateEvent = Simulator::Schedule (NanoSeconds (std::max (delayNs, 1.0)),
+                                             &LiIonEnergySource::UpdateEnergySource,
+                                             this);
+}
+
 void
 LiIonEnergySource::DoInitialize (void)
 {
@@ -274,8 +317,17 @@ LiIonEnergySource::CalculateRemainingEnergy (void)
   double totalCurrentA = CalculateTotalCurrent ();
   Time duration = Simulator::Now () - m_lastUpdateTime;
   NS_ASSERT (duration.GetSeconds () >= 0);
-  // energy = current * voltage * time
-  double energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds ();
+  double energyToDecreaseJ;
+  if (m_eventDriven)
+    {
+      // the durations are not bounded, follow the voltage along the discharge curve
+      energyToDecreaseJ = GetDrainedEnergy (totalCurrentA, duration.GetSeconds ());
+    }
+  else
+    {
+      // energy = current * voltage * time
+      energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds ();
+    }
 
   if (m_remainingEnergyJ < energyToDecreaseJ) 
     {
@@ -320,4 +372,33 @@ LiIonEnergySource::GetVoltage (double i) const
   return V;
 }
 
+double
+LiIonEnergySource::GetDrainedEnergy (double current, double duration) const
+{
+  NS_LOG_FUNCTION (this << current << duration);
+
+  double q0 = m_drainedCapacity;
+  double dq = current * duration / 3600;
+  if (dq == 0 || q0 + dq >= m_qRated)
+    {
+      // out of the discharge curve
+      return current * m_supplyVoltageV * duration;
+    }
+
+  // empirical factors, see GetVoltage
+  double A = m_eFull - m_eExp;
+  double B = 3 / m_qExp;
+  double K = std::abs ( (m_eFull - m_eNom + A * (std::exp (-B * m_qNom) - 1)) * (m_qRated - m_qNom) / m_qNom);
+  double E0 = m_eFull + K + m_internalResistance * m_typCurrent - A;
+
+  // energy = current * integral of V over time = 3600 * integral of V over
+  // the drained capacity, with
+  // V (q) = E0 - K * Q / (Q - q) + A * exp (-B * q) - R * current
+  double integral = (E0 - m_internalResistance * current) * dq
+    + K * m_qRated * std::log1p (-dq / (m_qRated - q0))
+    - A / B * std::exp (-B * q0) * std::expm1 (-B * dq);
+
+  return 3600 * integral;
+}
+
 } // namespace ns3
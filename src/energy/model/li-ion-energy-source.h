@@ -44,6 +44,15 @@ namespace ns3 {
  * If the actual voltage of the cell goes below the minimum threshold voltage, the
  * cell is considered depleted and the energy drained event fired up.
  *
+ * The remaining energy is updated every PeriodicEnergyUpdateInterval, or,
+ * with the EventDrivenEnergyUpdate attribute, only when a device changes
+ * state, when it is read, and when the low battery threshold is reached.
+ * In that mode, the energy drained at a constant current is the integral of
+ * the discharge curve rather than the voltage at the last update times the
+ * duration, and the time the threshold is reached is predicted from the
+ * current voltage, which can only bring it earlier: the prediction is then
+ * refined until the threshold is actually reached.
+ *
  *
  * The model requires several parameters to approximates the discharge curves:
  * - IntialCellVoltage, maximum voltage of the fully charged cell
@@ -180,6 +189,23 @@ private:
    */
   double GetVoltage (double current) const;
 
+  /**
+   * \param current the actual discharge current value.
+   * \param duration the discharge duration, in seconds.
+   * \returns the energy drained from the cell, in Joules.
+   *
+   * Integrates the cell voltage along the discharge curve, starting from the
+   * capacity drained so far, for a constant discharge current.
+   */
+  double GetDrainedEnergy (double current, double duration) const;
+
+  /**
+   * In event-driven mode, schedules the update of the energy source at the
+   * time the remaining energy reaches the low battery threshold, given the
+   * current drawn by the devices.
+   */
+  void ScheduleThresholdEvent (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   TracedValue<double> m_remainingEnergyJ; // remaining energy, in Joules
@@ -189,6 +215,7 @@ private:
   EventId m_energyUpdateEvent;            // energy update event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  bool m_eventDriven;                     // update on device state changes and threshold only
   double m_eFull;                         // initial voltage of the cell, in Volts
   double m_eNom;                          // nominal voltage of the cell, in Volts
   double m_eExp;                          // cell voltage at the end of the exponential zone, in Volts
@@ -0,0 +1,314 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/li-ion-energy-source.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("EventDrivenEnergyUpdateTestSuite");
+
+/**
+ * \ingroup energy
+ * \ingroup tests
+ *
+ * \brief A device energy model recording the depletion and recharge of
+ * its energy source; when the source is depleted, the device is plugged
+ * in and draws a negative current.
+ */
+class RecordingDeviceEnergyModel : public SimpleDeviceEnergyModel
+{
+public:
+  RecordingDeviceEnergyModel ()
+    : m_depletionTime (Time::Max ()),
+      m_rechargeTime (Time::Max ()),
+      m_rechargeCurrentA (0)
+  {
+  }
+
+  virtual void HandleEnergyDepletion (void)
+  {
+    if (m_depletionTime == Time::Max ())
+      {
+        m_depletionTime = Simulator::Now ();
+        if (m_rechargeCurrentA != 0)
+          {
+            SetCurrentA (m_rechargeCurrentA);
+          }
+      }
+  }
+
+  virtual void HandleEnergyRecharged (void)
+  {
+    if (m_rechargeTime == Time::Max ())
+      {
+        m_rechargeTime = Simulator::Now ();
+      }
+  }
+
+  Time m_depletionTime;       //!< time of the first depletion
+  Time m_rechargeTime;        //!< time of the first recharge
+  double m_rechargeCurrentA;  //!< current drawn once depleted
+};
+
+/**
+ * \ingroup energy
+ * \ingroup tests
+ *
+ * \brief Results of a scenario run with one of the update modes
+ */
+struct EnergyUpdateResults
+{
+  std::vector<double> remainingEnergyJ; //!< remaining energy at the check times
+  Time depletionTime;                   //!< time of the first depletion
+  Time rechargeTime;                    //!< time of the first recharge
+  uint64_t events;                      //!< number of events executed
+};
+
+/**
+ * \ingroup energy
+ * \ingroup tests
+ *
+ * \brief BasicEnergySource event-driven update test
+ *
+ * A device draws 0.5 A from a 100 J, 3 V source, then 0.1 A from 10.3 s
+ * and 1 A from 25.7 s: the low battery threshold of 10 J is reached at
+ * 49.01 s.  The device then recharges the source at 1 A, so that the high
+ * battery threshold of 15 J is reached 5/3 s later.  With the event-driven
+ * update, the remaining energy and the threshold times are exact; with the
+ * periodic update, the thresholds are reached at the next periodic update.
+ */
+class BasicEventDrivenEnergyTestCase : public TestCase
+{
+public:
+  BasicEventDrivenEnergyTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario
+   * \param eventDriven whether the source uses the event-driven update
+   * \returns the results
+   */
+  EnergyUpdateResults RunScenario (bool eventDriven);
+  /**
+   * Record the remaining energy of the source
+   * \param source the energy source
+   * \param results the results
+   */
+  static void Record (Ptr<EnergySource> source, EnergyUpdateResults *results);
+};
+
+BasicEventDrivenEnergyTestCase::BasicEventDrivenEnergyTestCase ()
+  : TestCase ("BasicEnergySource event-driven update")
+{
+}
+
+void
+BasicEventDrivenEnergyTestCase::Record (Ptr<EnergySource> source, EnergyUpdateResults *results)
+{
+  results->remainingEnergyJ.push_back (source->GetRemainingEnergy ());
+}
+
+EnergyUpdateResults
+BasicEventDrivenEnergyTestCase::RunScenario (bool eventDriven)
+{
+  EnergyUpdateResults results;
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<BasicEnergySource> es = CreateObject<BasicEnergySource> ();
+  es->SetAttribute ("BasicEnergySourceInitialEnergyJ", DoubleValue (100));
+  es->SetAttribute ("BasicEnergySupplyVoltageV", DoubleValue (3));
+  es->SetAttribute ("BasicEnergyLowBatteryThreshold", DoubleValue (0.10));
+  es->SetAttribute ("BasicEnergyHighBatteryThreshold", DoubleValue (0.15));
+  es->SetAttribute ("EventDrivenEnergyUpdate", BooleanValue (eventDriven));
+  Ptr<RecordingDeviceEnergyModel> dem = CreateObject<RecordingDeviceEnergyModel> ();
+  dem->m_rechargeCurrentA = -1;
+
+  es->SetNode (node);
+  dem->SetEnergySource (es);
+  es->AppendDeviceEnergyModel (dem);
+  node->AggregateObject (es);
+
+  Simulator::Schedule (Seconds (0), &SimpleDeviceEnergyModel::SetCurrentA, dem, 0.5);
+  Simulator::Schedule (Seconds (10.3), &SimpleDeviceEnergyModel::SetCurrentA, dem, 0.1);
+  Simulator::Schedule (Seconds (25.7), &SimpleDeviceEnergyModel::SetCurrentA, dem, 1.0);
+  Simulator::Schedule (Seconds (5), &BasicEventDrivenEnergyTestCase::Record, es, &results);
+  Simulator::Schedule (Seconds (20), &BasicEventDrivenEnergyTestCase::Record, es, &results);
+  Simulator::Schedule (Seconds (30), &BasicEventDrivenEnergyTestCase::Record, es, &results);
+  Simulator::Stop (Seconds (60));
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Run ();
+
+  results.depletionTime = dem->m_depletionTime;
+  results.rechargeTime = dem->m_rechargeTime;
+  results.events = Simulator::GetEventCount () - events;
+  Simulator::Destroy ();
+  return results;
+}
+
+void
+BasicEventDrivenEnergyTestCase::DoRun (void)
+{
+  EnergyUpdateResults periodic = RunScenario (false);
+  EnergyUpdateResults eventDriven = RunScenario (true);
+
+  double expected[] = {92.5, 81.64, 67.03};
+  NS_TEST_ASSERT_MSG_EQ (periodic.remainingEnergyJ.size (), 3, "missing remaining energy");
+  NS_TEST_ASSERT_MSG_EQ (eventDriven.remainingEnergyJ.size (), 3, "missing remaining energy");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (periodic.remainingEnergyJ[i], expected[i], 1e-6,
+                                 "wrong remaining energy with the periodic update");
+      NS_TEST_EXPECT_MSG_EQ_TOL (eventDriven.remainingEnergyJ[i], expected[i], 1e-6,
+                                 "wrong remaining energy with the event-driven update");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ_TOL (eventDriven.depletionTime.GetSeconds (), 49.01, 1e-8,
+                             "wrong depletion time with the event-driven update");
+  NS_TEST_EXPECT_MSG_EQ_TOL (eventDriven.rechargeTime.GetSeconds (), 49.01 + 5.0 / 3, 1e-8,
+                             "wrong recharge time with the event-driven update");
+  // the periodic update detects the thresholds up to an update interval later,
+  // when the remaining energy is already past them
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (periodic.depletionTime, Seconds (49.01), "depleted too early");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (periodic.depletionTime, Seconds (50.01), "depleted too late");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (periodic.rechargeTime - periodic.depletionTime, Seconds (5.0 / 3),
+                               "recharged too early");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (periodic.rechargeTime - periodic.depletionTime, Seconds (5),
+                               "recharged too late");
+  NS_TEST_EXPECT_MSG_LT (eventDriven.events, periodic.events / 2, "too many events");
+}
+
+/**
+ * \ingroup energy
+ * \ingroup tests
+ *
+ * \brief LiIonEnergySource event-driven update test
+ *
+ * A device draws 2.33 A from the cell, then 4 A from 1000 s, until the
+ * cell is depleted.  The remaining energy follows the discharge curve with
+ * both update modes, which agree within their approximations.
+ */
+class LiIonEventDrivenEnergyTestCase : public TestCase
+{
+public:
+  LiIonEventDrivenEnergyTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario
+   * \param eventDriven whether the source uses the event-driven update
+   * \returns the results
+   */
+  EnergyUpdateResults RunScenario (bool eventDriven);
+  /**
+   * Record the remaining energy of the source
+   * \param source the energy source
+   * \param results the results
+   */
+  static void Record (Ptr<EnergySource> source, EnergyUpdateResults *results);
+};
+
+LiIonEventDrivenEnergyTestCase::LiIonEventDrivenEnergyTestCase ()
+  : TestCase ("LiIonEnergySource event-driven update")
+{
+}
+
+void
+LiIonEventDrivenEnergyTestCase::Record (Ptr<EnergySource> source, EnergyUpdateResults *results)
+{
+  results->remainingEnergyJ.push_back (source->GetRemainingEnergy ());
+}
+
+EnergyUpdateResults
+LiIonEventDrivenEnergyTestCase::RunScenario (bool eventDriven)
+{
+  EnergyUpdateResults results;
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<LiIonEnergySource> es = CreateObject<LiIonEnergySource> ();
+  es->SetAttribute ("EventDrivenEnergyUpdate", BooleanValue (eventDriven));
+  Ptr<RecordingDeviceEnergyModel> dem = CreateObject<RecordingDeviceEnergyModel> ();
+
+  es->SetNode (node);
+  dem->SetEnergySource (es);
+  es->AppendDeviceEnergyModel (dem);
+  node->AggregateObject (es);
+
+  Simulator::Schedule (Seconds (0), &SimpleDeviceEnergyModel::SetCurrentA, dem, 2.33);
+  Simulator::Schedule (Seconds (1000), &SimpleDeviceEnergyModel::SetCurrentA, dem, 4.0);
+  Simulator::Schedule (Seconds (500), &LiIonEventDrivenEnergyTestCase::Record, es, &results);
+  Simulator::Schedule (Seconds (1500), &LiIonEventDrivenEnergyTestCase::Record, es, &results);
+  Simulator::Stop (Seconds (4000));
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Run ();
+
+  results.depletionTime = dem->m_depletionTime;
+  results.events = Simulator::GetEventCount () - events;
+  Simulator::Destroy ();
+  return results;
+}
+
+void
+LiIonEventDrivenEnergyTestCase::DoRun (void)
+{
+  EnergyUpdateResults periodic = RunScenario (false);
+  EnergyUpdateResults eventDriven = RunScenario (true);
+
+  NS_TEST_ASSERT_MSG_EQ (periodic.remainingEnergyJ.size (), 2, "missing remaining energy");
+  NS_TEST_ASSERT_MSG_EQ (eventDriven.remainingEnergyJ.size (), 2, "missing remaining energy");
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (eventDriven.remainingEnergyJ[i], periodic.remainingEnergyJ[i],
+                                 periodic.remainingEnergyJ[i] * 1e-3,
+                                 "the update modes disagree on the remaining energy");
+    }
+  NS_TEST_ASSERT_MSG_NE (periodic.depletionTime, Time::Max (), "the cell is not depleted");
+  NS_TEST_EXPECT_MSG_EQ_TOL (eventDriven.depletionTime, periodic.depletionTime, Seconds (2),
+                             "the update modes disagree on the depletion time");
+  NS_TEST_EXPECT_MSG_LT (eventDriven.events, periodic.events / 10, "too many events");
+}
+
+/**
+ * \ingroup energy
+ * \ingroup tests
+ *
+ * \brief Event-driven energy update TestSuite
+ */
+class EventDrivenEnergyUpdateTestSuite : public TestSuite
+{
+public:
+  EventDrivenEnergyUpdateTestSuite ();
+};
+
+EventDrivenEnergyUpdateTestSuite::EventDrivenEnergyUpdateTestSuite ()
+  : TestSuite ("event-driven-energy-update", UNIT)
+{
+  AddTestCase (new BasicEventDrivenEnergyTestCase, TestCase::QUICK);
+  AddTestCase (new LiIonEventDrivenEnergyTestCase, TestCase::QUICK);
+}
+
+/// create an instance of the test suite
+static EventDrivenEnergyUpdateTestSuite g_eventDrivenEnergyUpdateTestSuite;
@@ -22,6 +22,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include <fstream>
 #include <sstream>
 
@@ -45,6 +46,12 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (10.0)),
                    MakeTimeAccessor (&FlowMonitor::m_maxPerHopDelay),
                    MakeTimeChecker ())
+    .AddAttribute ("SamplingInterval", ("Only one out of this number of packets of each flow is tracked "
+                                        "from its transmission to its reception.  The delay, jitter, "
+                                        "forwarding and loss statistics are estimated from these packets."),
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FlowMonitor::m_samplingInterval),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddAttribute ("StartTime", ("The time when the monitoring starts."),
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&FlowMonitor::Start),
@@ -80,7 +87,8 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_samplingInterval (1),
+    m_enabled (false)
 {
   // m_histogramBinWidth=DEFAULT_BIN_WIDTH;
 }
@@ -99,9 +107,38 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_trackedPackets.clear ();
+  m_expiryList.clear ();
   Object::DoDispose ();
 }
 
+inline uint64_t
+FlowMonitor::GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId)
+{
+  return (static_cast<uint64_t> (flowId) << 32) | packetId;
+}
+
+inline bool
+FlowMonitor::IsSampled (FlowPacketId packetId) const
+{
+  return packetId % m_samplingInterval == 0;
+}
+
+inline void
+FlowMonitor::RefreshTrackedPacket (TrackedPacket &tracked)
+{
+  // the packets are seen in time order, so that the list stays sorted
+  // by the time when the packets were last seen
+  m_expiryList.splice (m_expiryList.end (), m_expiryList, tracked.expiry);
+}
+
+inline void
+FlowMonitor::UntrackPacket (TrackedPacketMap::iterator tracked)
+{
+  m_expiryList.erase (tracked->second.expiry);
+  m_trackedPackets.erase (tracked);
+}
+
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
@@ -140,12 +177,26 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
-  tracked.firstSeenTime = now;
-  tracked.lastSeenTime = tracked.firstSeenTime;
-  tracked.timesForwarded = 0;
-  NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
-                                                                << ").");
+  if (IsSampled (packetId))
+    {
+      uint64_t key = GetTrackedPacketKey (flowId, packetId);
+      std::pair<TrackedPacketMap::iterator, bool> inserted =
+        m_trackedPackets.insert (std::make_pair (key, TrackedPacket ()));
+      TrackedPacket &tracked = inserted.first->second;
+      if (inserted.second)
+        {
+          tracked.expiry = m_expiryList.insert (m_expiryList.end (), key);
+        }
+      else
+        {
+          RefreshTrackedPacket (tracked);
+        }
+      tracked.firstSeenTime = now;
+      tracked.lastSeenTime = tracked.firstSeenTime;
+      tracked.timesForwarded = 0;
+      NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
+                                                                    << ").");
+    }
 
   probe->AddPacketStats (flowId, packetSize, Seconds (0));
 
@@ -167,8 +218,12 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
     {
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
+  if (!IsSampled (packetId))
+    {
+      probe->AddPacketStats (flowId, packetSize, Seconds (0));
+      return;
+    }
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
   if (tracked == m_trackedPackets.end ())
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
@@ -178,9 +233,10 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
 
   tracked->second.timesForwarded++;
   tracked->second.lastSeenTime = Simulator::Now ();
+  RefreshTrackedPacket (tracked->second);
 
   Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
-  probe->AddPacketStats (flowId, packetSize, delay);
+  probe->AddPacketStats (flowId, packetSize, delay * m_samplingInterval);
 }
 
 
@@ -191,36 +247,56 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked == m_trackedPackets.end ())
+  TrackedPacketMap::iterator tracked = m_trackedPackets.end ();
+  if (IsSampled (packetId))
     {
-      NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
-                                                             << ") but not known to be transmitted.");
-      return;
+      tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
+      if (tracked == m_trackedPackets.end ())
+        {
+          NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
+                                                                 << ") but not known to be transmitted.");
+          return;
+        }
     }
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
-  probe->AddPacketStats (flowId, packetSize, delay);
-
   FlowStats &stats = GetStatsForFlow (flowId);
-  stats.delaySum += delay;
-  stats.delayHistogram.AddValue (delay.GetSeconds ());
-  if (stats.rxPackets > 0 )
+  if (tracked != m_trackedPackets.end ())
     {
-      Time jitter = stats.lastDelay - delay;
-      if (jitter > Seconds (0))
+      // the sums are weighted by the sampling interval, to estimate
+      // the sums over all the packets of the flow
+      Time delay = (now - tracked->second.firstSeenTime);
+      probe->AddPacketStats (flowId, packetSize, delay * m_samplingInterval);
+
+      stats.delaySum += delay * m_samplingInterval;
+      // the jitter is measured against the last tracked packet
+      if (stats.delayHistogram.GetNBins () > 0)
         {
-          stats.jitterSum += jitter;
-          stats.jitterHistogram.AddValue (jitter.GetSeconds ());
-        }
-      else 
-        {
-          stats.jitterSum -= jitter;
-          stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+          Time jitter = stats.lastDelay - delay;
+          if (jitter > Seconds (0))
+            {
+              stats.jitterSum += jitter * m_samplingInterval;
+              stats.jitterHistogram.AddValue (jitter.GetSeconds ());
+            }
+          else 
+            {
+              stats.jitterSum -= jitter * m_samplingInterval;
+              stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+            }
         }
+      stats.delayHistogram.AddValue (delay.GetSeconds ());
+      stats.lastDelay = delay;
+      stats.timesForwarded += tracked->second.timesForwarded * m_samplingInterval;
+
+      NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
+                    << flowId << ", packetId=" << packetId << ").");
+
+      UntrackPacket (tracked); // we don't need to track this packet anymore
+    }
+  else
+    {
+      probe->AddPacketStats (flowId, packetSize, Seconds (0));
     }
-  stats.lastDelay = delay;
 
   stats.rxBytes += packetSize;
   stats.packetSizeHistogram.AddValue ((double) packetSize);
@@ -239,12 +315,6 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
-
-  NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
-                << flowId << ", packetId=" << packetId << ").");
-
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -269,14 +339,14 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (GetTrackedPacketKey (flowId, packetId));
   if (tracked != m_trackedPackets.end ())
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      UntrackPacket (tracked);
     }
 }
 
@@ -292,23 +362,24 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // only the packets at the head of the expiry list, which were
+  // last seen the longest time ago, need to be checked
+  while (!m_expiryList.empty ())
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      TrackedPacketMap::iterator iter = m_trackedPackets.find (m_expiryList.front ());
+      NS_ASSERT (iter != m_trackedPackets.end ());
+      if (now - iter->second.lastSeenTime < maxDelay)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
-        }
-      else
-        {
-          iter++;
+          break;
         }
+
+      // packet is considered lost, add it to the loss statistics
+      FlowStatsContainerI flow = m_flowStats.find (static_cast<FlowId> (iter->first >> 32));
+      NS_ASSERT (flow != m_flowStats.end ());
+      flow->second.lostPackets += m_samplingInterval;
+
+      // we won't track it anymore
+      UntrackPacket (iter);
     }
 }
 
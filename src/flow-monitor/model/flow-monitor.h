@@ -23,6 +23,8 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -270,14 +272,18 @@ private:
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+    std::list<uint64_t>::iterator expiry; //!< position of the packet in m_expiryList
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
 
-  /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  /// (FlowId,PacketId) --> TrackedPacket, see GetTrackedPacketKey
+  typedef std::unordered_map<uint64_t, TrackedPacket> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /// Keys of the tracked packets, ordered by the time when they were last seen
+  std::list<uint64_t> m_expiryList;
+  uint32_t m_samplingInterval; //!< One out of m_samplingInterval packets of each flow is tracked
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -300,6 +306,25 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Get the key of a packet in m_trackedPackets
+  /// \param flowId the Flow identification
+  /// \param packetId the Packet ID
+  /// \returns the key
+  static uint64_t GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId);
+
+  /// Check if a packet is tracked, depending on the SamplingInterval
+  /// \param packetId the Packet ID
+  /// \returns true if the packet is tracked
+  bool IsSampled (FlowPacketId packetId) const;
+
+  /// Move a tracked packet at the end of m_expiryList, after it has been seen
+  /// \param tracked the tracked packet
+  void RefreshTrackedPacket (TrackedPacket &tracked);
+
+  /// Stop tracking a packet
+  /// \param tracked the tracked packet
+  void UntrackPacket (TrackedPacketMap::iterator tracked);
 };
 
 
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief A probe reporting the packets given by the test
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor packet tracking Test
+ *
+ * Ten packets of a flow are transmitted at 0.5 s; the first five are
+ * received at 1.5 s, the sixth is forwarded at 5.5 s, and the others
+ * are never seen again.  With a MaxPerHopDelay of 10 s, the last four
+ * packets are lost at the periodic check at 11 s, the sixth at 16 s.
+ * With a sampling interval of 2, only the packets with an even id are
+ * tracked, and each of them accounts for two packets.
+ */
+class FlowMonitorTrackingTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param samplingInterval the SamplingInterval of the FlowMonitor
+   */
+  FlowMonitorTrackingTestCase (uint32_t samplingInterval);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Transmit packets
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Transmit (uint32_t first, uint32_t last);
+  /**
+   * Receive packets
+   * \param first the first packet id
+   * \param last the last packet id
+   */
+  void Receive (uint32_t first, uint32_t last);
+  /**
+   * Forward a packet
+   * \param packetId the packet id
+   */
+  void Forward (uint32_t packetId);
+  /**
+   * Check the number of lost packets
+   * \param lostPackets the expected number of lost packets
+   */
+  void CheckLost (uint32_t lostPackets);
+
+  uint32_t m_samplingInterval;    //!< the SamplingInterval of the FlowMonitor
+  Ptr<FlowMonitor> m_monitor;     //!< the FlowMonitor
+  Ptr<FlowProbe> m_probe;         //!< the probe
+};
+
+FlowMonitorTrackingTestCase::FlowMonitorTrackingTestCase (uint32_t samplingInterval)
+  : TestCase ("Packet tracking with a sampling interval of " + std::to_string (samplingInterval)),
+    m_samplingInterval (samplingInterval)
+{
+}
+
+void
+FlowMonitorTrackingTestCase::Transmit (uint32_t first, uint32_t last)
+{
+  for (uint32_t id = first; id <= last; id++)
+    {
+      m_monitor->ReportFirstTx (m_probe, 1, id, 100);
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::Receive (uint32_t first, uint32_t last)
+{
+  for (uint32_t id = first; id <= last; id++)
+    {
+      m_monitor->ReportLastRx (m_probe, 1, id, 100);
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::Forward (uint32_t packetId)
+{
+  m_monitor->ReportForwarding (m_probe, 1, packetId, 100);
+}
+
+void
+FlowMonitorTrackingTestCase::CheckLost (uint32_t lostPackets)
+{
+  const FlowMonitor::FlowStats &stats = m_monitor->GetFlowStats ().at (1);
+  NS_TEST_EXPECT_MSG_EQ (stats.lostPackets, lostPackets, "wrong number of lost packets at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+FlowMonitorTrackingTestCase::DoRun (void)
+{
+  m_monitor = CreateObject<FlowMonitor> ();
+  m_monitor->SetAttribute ("SamplingInterval", UintegerValue (m_samplingInterval));
+  m_monitor->StartRightNow ();
+  m_probe = CreateObject<FlowMonitorTestProbe> (m_monitor);
+
+  Simulator::Schedule (Seconds (0.5), &FlowMonitorTrackingTestCase::Transmit, this, 0, 9);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitorTrackingTestCase::Receive, this, 0, 4);
+  Simulator::Schedule (Seconds (5.5), &FlowMonitorTrackingTestCase::Forward, this, 5);
+  Simulator::Schedule (Seconds (10.5), &FlowMonitorTrackingTestCase::CheckLost, this, 0);
+  Simulator::Schedule (Seconds (11.5), &FlowMonitorTrackingTestCase::CheckLost, this, 4);
+  Simulator::Schedule (Seconds (15.5), &FlowMonitorTrackingTestCase::CheckLost, this, 4);
+  Simulator::Schedule (Seconds (16.5), &FlowMonitorTrackingTestCase::CheckLost, this, m_samplingInterval == 1 ? 5 : 4);
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+
+  // the losses, delays and forwards are estimated from the tracked packets:
+  // with a sampling interval of 2, packets 0, 2 and 4 are received, 6 and
+  // 8 are lost, and none is forwarded
+  const FlowMonitor::FlowStats &stats = m_monitor->GetFlowStats ().at (1);
+  NS_TEST_ASSERT_MSG_EQ (stats.txPackets, 10, "wrong number of transmitted packets");
+  NS_TEST_ASSERT_MSG_EQ (stats.rxPackets, 5, "wrong number of received packets");
+  NS_TEST_ASSERT_MSG_EQ (stats.rxBytes, 500, "wrong number of received bytes");
+  if (m_samplingInterval == 1)
+    {
+      NS_TEST_ASSERT_MSG_EQ (stats.lostPackets, 5, "wrong number of lost packets");
+      NS_TEST_ASSERT_MSG_EQ (stats.delaySum, Seconds (5), "wrong sum of the delays");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (stats.lostPackets, 4, "wrong estimate of the lost packets");
+      NS_TEST_ASSERT_MSG_EQ (stats.delaySum, Seconds (6), "wrong estimate of the sum of the delays");
+    }
+  NS_TEST_ASSERT_MSG_EQ (stats.jitterSum, Seconds (0), "wrong sum of the jitters");
+
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  m_probe = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowMonitorTrackingTestCase (1), TestCase::QUICK);
+  AddTestCase (new FlowMonitorTrackingTestCase (2), TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
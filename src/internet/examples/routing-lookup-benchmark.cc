@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the cost of a route lookup in Ipv4StaticRouting,
+// Ipv4GlobalRouting and Ipv6StaticRouting as the number of routes grows.
+//
+// For each number of routes, a routing protocol of a node with one
+// interface is filled with host routes (like the routes toward the UEs on
+// a PGW, or the routes computed by the global route manager), plus a few
+// network routes and a default route, and RouteOutput is then called for
+// destinations covered by these routes in a round robin fashion. The mean
+// wall clock time per lookup is printed for each routing protocol and
+// number of routes; with the prefix tries indexing the routes, it should
+// not depend on the number of routes.
+//
+// Command line arguments:
+// --lookups (number of lookups for each routing protocol and number of routes)
+// --maxRoutes (largest number of routes)
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("RoutingLookupBenchmark");
+
+/**
+ * \param i an index
+ * \returns the i-th host address, in 10.0.0.0/8
+ */
+static Ipv4Address
+GetHostAddress (uint32_t i)
+{
+  return Ipv4Address ((10 << 24) + i + 1);
+}
+
+/**
+ * \param i an index
+ * \returns the i-th host address, in 2001:db8::/32
+ */
+static Ipv6Address
+GetHostAddress6 (uint32_t i)
+{
+  uint8_t address[16] = {0x20, 0x01, 0x0d, 0xb8};
+  address[12] = (i + 1) >> 24;
+  address[13] = (i + 1) >> 16;
+  address[14] = (i + 1) >> 8;
+  address[15] = (i + 1);
+  return Ipv6Address (address);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t lookups = 1000000;
+  uint32_t maxRoutes = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue ("lookups", "Number of lookups for each routing protocol and number of routes", lookups);
+  cmd.AddValue ("maxRoutes", "Largest number of routes", maxRoutes);
+  cmd.Parse (argc, argv);
+
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  device->SetAddress (Mac48Address::Allocate ());
+  node->AddDevice (device);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  uint32_t interface = ipv4->AddInterface (device);
+  ipv4->AddAddress (interface, Ipv4InterfaceAddress (Ipv4Address ("192.168.0.1"), Ipv4Mask ("/24")));
+  ipv4->SetUp (interface);
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+  uint32_t interface6 = ipv6->AddInterface (device);
+  ipv6->AddAddress (interface6, Ipv6InterfaceAddress (Ipv6Address ("2001:db9::1"), Ipv6Prefix (64)));
+  ipv6->SetUp (interface6);
+  Ipv4Address gateway ("192.168.0.2");
+  Ipv6Address gateway6 ("2001:db9::2");
+
+  std::cout << "routing,routes,nsPerLookup" << std::endl;
+  for (uint32_t routes = 100; routes <= maxRoutes; routes *= 10)
+    {
+      Ptr<Ipv4StaticRouting> staticRouting = CreateObject<Ipv4StaticRouting> ();
+      staticRouting->SetIpv4 (ipv4);
+      Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting> ();
+      globalRouting->SetIpv4 (ipv4);
+      Ptr<Ipv6StaticRouting> staticRouting6 = CreateObject<Ipv6StaticRouting> ();
+      staticRouting6->SetIpv6 (ipv6);
+      for (uint32_t i = 0; i < routes; i++)
+        {
+          staticRouting->AddHostRouteTo (GetHostAddress (i), gateway, interface);
+          globalRouting->AddHostRouteTo (GetHostAddress (i), gateway, interface);
+          staticRouting6->AddHostRouteTo (GetHostAddress6 (i), gateway6, interface6);
+        }
+      staticRouting->AddNetworkRouteTo (Ipv4Address ("172.16.0.0"), Ipv4Mask ("/12"), gateway, interface);
+      staticRouting->SetDefaultRoute (gateway, interface);
+      globalRouting->AddNetworkRouteTo (Ipv4Address ("172.16.0.0"), Ipv4Mask ("/12"), gateway, interface);
+      staticRouting6->AddNetworkRouteTo (Ipv6Address ("2001:db8::"), Ipv6Prefix (32), gateway6, interface6);
+      staticRouting6->SetDefaultRoute (gateway6, interface6);
+
+      Ptr<Packet> packet = Create<Packet> ();
+      Socket::SocketErrno error;
+      Ipv4Header header;
+      Ipv6Header header6;
+      SystemWallClockMs clock;
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          header.SetDestination (GetHostAddress (i % routes));
+          staticRouting->RouteOutput (packet, header, 0, error);
+        }
+      std::cout << "Ipv4StaticRouting," << routes << "," << clock.End () * 1e6 / lookups << std::endl;
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          header.SetDestination (GetHostAddress (i % routes));
+          globalRouting->RouteOutput (packet, header, 0, error);
+        }
+      std::cout << "Ipv4GlobalRouting," << routes << "," << clock.End () * 1e6 / lookups << std::endl;
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          header6.SetDestinationAddress (GetHostAddress6 (i % routes));
+          staticRouting6->RouteOutput (packet, header6, 0, error);
+        }
+      std::cout << "Ipv6StaticRouting," << routes << "," << clock.End () * 1e6 / lookups << std::endl;
+
+      staticRouting->Dispose ();
+      globalRouting->Dispose ();
+      staticRouting6->Dispose ();
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
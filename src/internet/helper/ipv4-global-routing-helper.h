@@ -84,6 +84,21 @@ public:
    *
    */
   static void RecomputeRoutingTables (void);
+  /**
+   * \brief Update the routes after a topology change, such as a link going
+   * down or up, or a change of interface metric.
+   *
+   * The first call computes all of the routes, as RecomputeRoutingTables()
+   * does, and keeps the shortest path tree of every router.  The following
+   * calls only recompute the parts of these trees affected by the changes
+   * since the previous call, and only replace the corresponding routes.
+   * The resulting routes are the same as with RecomputeRoutingTables(),
+   * although their order in the routing tables may differ.
+   *
+   * Calling PopulateRoutingTables() or RecomputeRoutingTables() discards the
+   * kept trees.
+   */
+  static void UpdateRoutingTables (void);
 private:
   /**
    * \brief Assignment operator declared private and not implemented to disallow
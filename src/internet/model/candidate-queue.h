@@ -22,7 +22,8 @@
 #define CANDIDATE_QUEUE_H
 
 #include <stdint.h>
-#include <list>
+#include <map>
+#include <vector>
 #include "ns3/ipv4-address.h"
 
 namespace ns3 {
@@ -45,8 +46,14 @@ class SPFVertex;
  *
  * Although a STL priority_queue almost does what we want, the requirement
  * for a Find () operation, the dynamic nature of the data and the derived
- * requirement for a Reorder () operation led us to implement this simple 
- * enhanced priority queue.
+ * requirement for a DecreaseKey () operation led us to implement this
+ * enhanced priority queue.  It is a binary heap indexed by vertex ID, so
+ * that Push (), Pop () and DecreaseKey () take a logarithmic time and Find ()
+ * does not walk the queue.
+ *
+ * Vertices having the same distance and type are popped in the order
+ * in which they were pushed; a vertex whose distance has been decreased
+ * is popped as if it had been pushed at the time of the decrease.
  */
 class CandidateQueue
 {
@@ -154,6 +161,19 @@ public:
  */
   void Reorder (void);
 
+/**
+ * @brief Restore the order of the Candidate Queue after the distance of one
+ * of its vertices has been decreased.
+ *
+ * This is the method to call when the value of m_distanceFromRoot of a
+ * single vertex of the queue has been lowered.  It takes a logarithmic time,
+ * while Reorder () rebuilds the whole queue.
+ *
+ * @see SPFVertex
+ * @param v The Shortest Path First Vertex whose distance has been decreased.
+ */
+  void DecreaseKey (SPFVertex *v);
+
 private:
 /**
  * Candidate Queue copy construction is disallowed (not implemented) to 
@@ -184,8 +204,45 @@ private:
  */
   static bool CompareSPFVertex (const SPFVertex* v1, const SPFVertex* v2);
 
-  typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
+  /// SPFVertex pointer stored in the heap, with its insertion sequence number
+  struct Candidate
+  {
+    SPFVertex *vertex; //!< the vertex
+    uint64_t sequence; //!< sequence number, to pop equal vertices in FIFO order
+  };
+
+/**
+ * \brief return true if c1 should be popped before c2
+ * \param c1 first operand
+ * \param c2 second operand
+ * \return True if c1 should be popped before c2; false otherwise
+ */
+  static bool IsBefore (const Candidate &c1, const Candidate &c2);
+
+/**
+ * \brief Move the candidate at the given position of the heap towards the top
+ * \param i the position
+ */
+  void SiftUp (uint32_t i);
+
+/**
+ * \brief Move the candidate at the given position of the heap towards the
+ * bottom
+ * \param i the position
+ */
+  void SiftDown (uint32_t i);
+
+/**
+ * \brief Store a candidate at a given position of the heap
+ * \param i the position
+ * \param c the candidate
+ */
+  void Place (uint32_t i, const Candidate &c);
+
+  typedef std::vector<Candidate> CandidateList_t; //!< binary heap of SPFVertex candidates
   CandidateList_t m_candidates;  //!< SPFVertex candidates
+  std::map<Ipv4Address, uint32_t> m_positions; //!< position in m_candidates, indexed by vertex ID
+  uint64_t m_sequence; //!< sequence number of the next candidate
 
   /**
    * \brief Stream insertion operator.
@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DUPLICATE_CACHE_H
+#define DUPLICATE_CACHE_H
+
+#include <stdint.h>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "ns3/empty.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup internet
+ *
+ * \brief Cache of message identifiers, used to detect duplicate messages.
+ *
+ * Routing protocols that flood messages (AODV RREQs, OLSR messages, ...)
+ * remember, for a given time, the (address, identifier) pairs of the
+ * messages they already processed.  This class keeps those pairs in a
+ * hash table, so that the look up and the insertion of a pair take
+ * constant time regardless of the number of cached messages.
+ *
+ * Each entry has an expiration time.  Expired entries are never returned,
+ * and they are removed in batches: the entries are grouped in buckets of
+ * close expiration times, and a whole bucket is dropped when the last of
+ * its entries expires.  An entry whose expiration time is changed is not
+ * moved between buckets; it is skipped when its old bucket is dropped.
+ *
+ * \tparam T The type of the value stored with each entry.
+ */
+template <typename T = empty>
+class DuplicateCache
+{
+public:
+  /**
+   * Constructor.
+   * \param lifetime The lifetime of the entries inserted by IsDuplicate.
+   */
+  DuplicateCache (Time lifetime = Seconds (0))
+    : m_lifetime (lifetime),
+      m_bucketWidth (Seconds (1))
+  {
+  }
+
+  /**
+   * \brief Check whether a message was already seen, and remember it.
+   *
+   * If there is no entry for the message, an entry with the default value
+   * is inserted, which expires after the lifetime of the cache.
+   *
+   * \param addr The address of the message originator.
+   * \param id The identifier of the message.
+   * \returns true if the message is a duplicate.
+   */
+  bool IsDuplicate (const Ipv4Address &addr, uint32_t id)
+  {
+    if (Find (addr, id) != 0)
+      {
+        return true;
+      }
+    Insert (addr, id, T (), Simulator::Now () + m_lifetime);
+    return false;
+  }
+
+  /**
+   * \brief Look up an entry.
+   * \param addr The address of the message originator.
+   * \param id The identifier of the message.
+   * \returns A pointer to the value of the entry, or 0 if there is no
+   * entry or it has expired.  The pointer is valid until the entry is
+   * erased.
+   */
+  T * Find (const Ipv4Address &addr, uint32_t id)
+  {
+    typename EntryMap::iterator it = m_entries.find (GetKey (addr, id));
+    if (it == m_entries.end () || it->second.expire < Simulator::Now ())
+      {
+        return 0;
+      }
+    return &it->second.value;
+  }
+
+  /**
+   * \brief Insert an entry, or replace the existing one.
+   * \param addr The address of the message originator.
+   * \param id The identifier of the message.
+   * \param value The value of the entry.
+   * \param expire The (absolute) expiration time of the entry.
+   */
+  void Insert (const Ipv4Address &addr, uint32_t id, const T &value, Time expire)
+  {
+    Purge ();
+    uint64_t key = GetKey (addr, id);
+    Entry &entry = m_entries[key];
+    entry.value = value;
+    entry.expire = expire;
+    if (m_buckets.empty () || expire >= m_buckets.back ().start + m_bucketWidth)
+      {
+        Bucket bucket;
+        bucket.start = expire;
+        bucket.end = expire;
+        m_buckets.push_back (bucket);
+      }
+    Bucket &bucket = m_buckets.back ();
+    if (expire > bucket.end)
+      {
+        bucket.end = expire;
+      }
+    bucket.keys.push_back (key);
+  }
+
+  /**
+   * \brief Erase an entry.
+   * \param addr The address of the message originator.
+   * \param id The identifier of the message.
+   */
+  void Erase (const Ipv4Address &addr, uint32_t id)
+  {
+    m_entries.erase (GetKey (addr, id));
+  }
+
+  /// Remove the expired entries whose bucket has expired.
+  void Purge ()
+  {
+    Time now = Simulator::Now ();
+    while (!m_buckets.empty () && m_buckets.front ().end < now)
+      {
+        const std::vector<uint64_t> &keys = m_buckets.front ().keys;
+        for (std::vector<uint64_t>::const_iterator i = keys.begin (); i != keys.end (); ++i)
+          {
+            typename EntryMap::iterator it = m_entries.find (*i);
+            if (it != m_entries.end () && it->second.expire < now)
+              {
+                m_entries.erase (it);
+              }
+          }
+        m_buckets.pop_front ();
+      }
+  }
+
+  /// Remove all the entries.
+  void Clear ()
+  {
+    m_entries.clear ();
+    m_buckets.clear ();
+  }
+
+  /**
+   * \returns The number of entries that have not expired.
+   */
+  uint32_t GetSize ()
+  {
+    Purge ();
+    Time now = Simulator::Now ();
+    uint32_t size = 0;
+    for (typename EntryMap::const_iterator it = m_entries.begin (); it != m_entries.end (); ++it)
+      {
+        if (it->second.expire >= now)
+          {
+            size++;
+          }
+      }
+    return size;
+  }
+
+  /**
+   * Set the lifetime of the entries inserted by IsDuplicate.
+   * \param lifetime The lifetime.
+   */
+  void SetLifetime (Time lifetime)
+  {
+    m_lifetime = lifetime;
+  }
+  /**
+   * \returns The lifetime of the entries inserted by IsDuplicate.
+   */
+  Time GetLifetime () const
+  {
+    return m_lifetime;
+  }
+
+  /**
+   * \brief Set the width of the buckets of expiration times.
+   *
+   * An expired entry is removed at most a bucket width after its
+   * expiration time.
+   *
+   * \param width The width.
+   */
+  void SetBucketWidth (Time width)
+  {
+    m_bucketWidth = width;
+  }
+
+private:
+  /// An entry of the cache.
+  struct Entry
+  {
+    T value;     //!< The value.
+    Time expire; //!< The expiration time.
+  };
+  /// A group of entries with close expiration times.
+  struct Bucket
+  {
+    Time start;                  //!< The expiration time of the first entry.
+    Time end;                    //!< The latest expiration time of the entries.
+    std::vector<uint64_t> keys;  //!< The keys of the entries.
+  };
+  /// Container of the entries, by key.
+  typedef std::unordered_map<uint64_t, Entry> EntryMap;
+
+  /**
+   * \param addr The address of the message originator.
+   * \param id The identifier of the message.
+   * \returns The key of the entry.
+   */
+  static uint64_t GetKey (const Ipv4Address &addr, uint32_t id)
+  {
+    return (static_cast<uint64_t> (addr.Get ()) << 32) | id;
+  }
+
+  EntryMap m_entries;           //!< The entries.
+  std::deque<Bucket> m_buckets; //!< The buckets, by expiration time.
+  Time m_lifetime;              //!< The lifetime of the entries inserted by IsDuplicate.
+  Time m_bucketWidth;           //!< The width of the buckets.
+};
+
+} // namespace ns3
+
+#endif /* DUPLICATE_CACHE_H */
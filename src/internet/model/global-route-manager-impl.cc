@@ -26,6 +26,9 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
 #include <iostream>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
@@ -423,7 +426,9 @@ SPFVertex::ClearVertexProcessed (void)
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB ()
   :
     m_database (),
-    m_extdatabase ()
+    m_extdatabase (),
+    m_linkDataIndex (),
+    m_linkDataIndexValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -471,6 +476,7 @@ GlobalRouteManagerLSDB::Insert (Ipv4Address addr, GlobalRoutingLSA* lsa)
   else
     {
       m_database.insert (LSDBPair_t (addr, lsa));
+      m_linkDataIndexValid = false;
     }
 }
 
@@ -488,6 +494,19 @@ GlobalRouteManagerLSDB::GetNumExtLSAs () const
   return m_extdatabase.size ();
 }
 
+std::vector<GlobalRoutingLSA*>
+GlobalRouteManagerLSDB::GetLSAs () const
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<GlobalRoutingLSA*> lsas;
+  lsas.reserve (m_database.size ());
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      lsas.push_back (i->second);
+    }
+  return lsas;
+}
+
 GlobalRoutingLSA*
 GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 {
@@ -495,13 +514,10 @@ GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 //
 // Look up an LSA by its address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LSDBMap_t::const_iterator i = m_database.find (addr);
+  if (i != m_database.end ())
     {
-      if (i->first == addr)
-        {
-          return i->second;
-        }
+      return i->second;
     }
   return 0;
 }
@@ -511,22 +527,32 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this << addr);
 //
-// Look up an LSA by its address.
+// Index the LSAs by the link data of their TransitNetwork link records,
+// keeping the first LSA in the order of the database for each address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  if (!m_linkDataIndexValid)
     {
-      GlobalRoutingLSA* temp = i->second;
-// Iterate among temp's Link Records
-      for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
+      m_linkDataIndex.clear ();
+      LSDBMap_t::const_iterator i;
+      for (i= m_database.begin (); i!= m_database.end (); i++)
         {
-          GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
-          if ( lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork &&
-               lr->GetLinkData () == addr)
+          GlobalRoutingLSA* temp = i->second;
+// Iterate among temp's Link Records
+          for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
             {
-              return temp;
+              GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
+              if (lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                  m_linkDataIndex.insert (LSDBPair_t (lr->GetLinkData (), temp));
+                }
             }
         }
+      m_linkDataIndexValid = true;
+    }
+  LSDBMap_t::const_iterator i = m_linkDataIndex.find (addr);
+  if (i != m_linkDataIndex.end ())
+    {
+      return i->second;
     }
   return 0;
 }
@@ -539,7 +565,9 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl () 
   :
-    m_spfroot (0)
+    m_spfroot (0),
+    m_spfrootNode (0),
+    m_spfIncremental (false)
 {
   NS_LOG_FUNCTION (this);
   m_lsdb = new GlobalRouteManagerLSDB ();
@@ -572,25 +600,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
-      Ptr<Node> node = *i;
-      Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-      if (router == 0)
-        {
-          continue;
-        }
-      Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-      uint32_t j = 0;
-      uint32_t nRoutes = gr->GetNRoutes ();
-      NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
-      // Each time we delete route 0, the route index shifts downward
-      // We can delete all routes if we delete the route numbered 0
-      // nRoutes times
-      for (j = 0; j < nRoutes; j++)
-        {
-          NS_LOG_LOGIC ("Deleting global route " << j << " from node " << node->GetId ());
-          gr->RemoveRoute (0);
-        }
-      NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
+      DeleteRoutes (*i);
     }
   if (m_lsdb)
     {
@@ -598,6 +608,38 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
       delete m_lsdb;
       m_lsdb = new GlobalRouteManagerLSDB ();
     }
+//
+// The shortest path trees kept by UpdateRoutes () describe the deleted
+// routes; the next call to UpdateRoutes () computes everything again.
+//
+  m_spfIncremental = false;
+  m_spfTrees.clear ();
+  m_spfGraph.clear ();
+  m_spfIndex.clear ();
+}
+
+void
+GlobalRouteManagerImpl::DeleteRoutes (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    {
+      return;
+    }
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  uint32_t j = 0;
+  uint32_t nRoutes = gr->GetNRoutes ();
+  NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
+  // Each time we delete route 0, the route index shifts downward
+  // We can delete all routes if we delete the route numbered 0
+  // nRoutes times
+  for (j = 0; j < nRoutes; j++)
+    {
+      NS_LOG_LOGIC ("Deleting global route " << j << " from node " << node->GetId ());
+      gr->RemoveRoute (0);
+    }
+  NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
 }
 
 //
@@ -697,6 +739,21 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 {
   NS_LOG_FUNCTION (this);
 //
+// Routes computed here are not tracked by UpdateRoutes (), which starts
+// again from scratch on its next call.
+//
+  m_spfIncremental = false;
+  m_spfTrees.clear ();
+  m_spfGraph.clear ();
+  m_spfIndex.clear ();
+  CalculateRoutes ();
+}
+
+void
+GlobalRouteManagerImpl::CalculateRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+//
 // Walk the list of nodes in the system.
 //
   NS_LOG_INFO ("About to start SPF calculation");
@@ -730,6 +787,144 @@ GlobalRouteManagerImpl::InitializeRoutes ()
   NS_LOG_INFO ("Finished SPF calculation");
 }
 
+//
+// UpdateRoutes () is meant to be called again and again while the topology
+// changes, e.g., when links go up and down in a large backhaul network.  The
+// first call computes the routes from scratch and keeps, for each router, the
+// distance and the root exit directions of every vertex of its shortest path
+// tree, as well as a compact copy of the link state graph.  The following
+// calls rebuild the LSDB, compare the new graph with the kept one, and only
+// revisit the parts of each tree affected by the removed and added edges
+// (a dynamic version of the Dijkstra algorithm).  The routes of the vertices
+// whose exit directions have changed are then replaced in the routing table.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_spfIncremental)
+    {
+      NS_LOG_INFO ("Computing all of the routes");
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      BuildSPFGraph ();
+      m_spfIncremental = true;
+      CalculateRoutes ();
+      return;
+    }
+//
+// Gather the LSAs again.  The previous LSDB is kept until the routes that
+// were computed from it have been removed.
+//
+  GlobalRouteManagerLSDB *oldLsdb = m_lsdb;
+  std::vector<SPFGraphVertex> oldGraph;
+  oldGraph.swap (m_spfGraph);
+  m_lsdb = new GlobalRouteManagerLSDB ();
+  BuildGlobalRoutingDatabase ();
+  BuildSPFGraph ();
+  uint32_t nVertices = m_spfGraph.size ();
+  oldGraph.resize (nVertices);
+//
+// Compare the two graphs: vertex indexes are stable, so that the edges can
+// be compared vertex by vertex.
+//
+  std::vector<SPFEdgeChange> removed;
+  std::vector<SPFEdgeChange> added;
+  std::vector<bool> changed (nVertices, false);
+  bool modified = false;
+  for (uint32_t v = 0; v < nVertices; v++)
+    {
+      const SPFGraphVertex &oldVertex = oldGraph[v];
+      const SPFGraphVertex &newVertex = m_spfGraph[v];
+      if (!IsSameLSA (oldVertex.lsa, newVertex.lsa)
+          || oldVertex.extLsas.size () != newVertex.extLsas.size ())
+        {
+          changed[v] = true;
+        }
+      else
+        {
+          for (uint32_t j = 0; j < newVertex.extLsas.size (); j++)
+            {
+              if (!IsSameLSA (oldVertex.extLsas[j], newVertex.extLsas[j]))
+                {
+                  changed[v] = true;
+                  break;
+                }
+            }
+        }
+      std::vector<SPFEdge> oldOut = oldVertex.out;
+      std::vector<SPFEdge> newOut = newVertex.out;
+      std::sort (oldOut.begin (), oldOut.end (), &IsEdgeBefore);
+      std::sort (newOut.begin (), newOut.end (), &IsEdgeBefore);
+      std::vector<SPFEdge> diff;
+      std::set_difference (oldOut.begin (), oldOut.end (), newOut.begin (), newOut.end (),
+                           std::back_inserter (diff), &IsEdgeBefore);
+      for (uint32_t j = 0; j < diff.size (); j++)
+        {
+          SPFEdgeChange change = { v, diff[j] };
+          removed.push_back (change);
+        }
+      diff.clear ();
+      std::set_difference (newOut.begin (), newOut.end (), oldOut.begin (), oldOut.end (),
+                           std::back_inserter (diff), &IsEdgeBefore);
+      for (uint32_t j = 0; j < diff.size (); j++)
+        {
+          SPFEdgeChange change = { v, diff[j] };
+          added.push_back (change);
+        }
+      modified = modified || changed[v];
+    }
+  modified = modified || !removed.empty () || !added.empty ();
+  NS_LOG_INFO ("Link state changes: " << removed.size () << " edges removed, " <<
+               added.size () << " edges added");
+
+  if (modified)
+    {
+      uint32_t systemId = MpiInterface::GetSystemId ();
+      NodeList::Iterator listEnd = NodeList::End ();
+      for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+        {
+          Ptr<Node> node = *i;
+          Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+          if (!rtr || node->GetSystemId () != systemId)
+            {
+              continue;
+            }
+          Ipv4Address root = rtr->GetRouterId ();
+          std::map<Ipv4Address, SPFTree>::iterator tree = m_spfTrees.find (root);
+          if (rtr->GetNumLSAs () == 0)
+            {
+              if (tree != m_spfTrees.end ())
+                {
+                  DeleteRoutes (node);
+                  m_spfTrees.erase (tree);
+                }
+              continue;
+            }
+//
+// A change of the root LSA may change any of the outgoing interfaces, and
+// stub routers only have a default route; compute these trees again.
+//
+          uint32_t rootIndex = m_spfIndex[root];
+          if (tree == m_spfTrees.end () || tree->second.stub || changed[rootIndex])
+            {
+              NS_LOG_LOGIC ("Computing the shortest path tree of " << root);
+              DeleteRoutes (node);
+              SPFCalculate (root);
+            }
+          else
+            {
+              NS_LOG_LOGIC ("Updating the shortest path tree of " << root);
+              m_spfrootNode = node;
+              SPFUpdate (root, tree->second, oldGraph, removed, added, changed);
+              m_spfrootNode = 0;
+            }
+        }
+    }
+  delete oldLsdb;
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section 
 // 16.1 (2) for further details.
@@ -960,7 +1155,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 // If we've changed the cost to get to the vertex represented by <w>, we 
 // must reorder the priority queue keyed to that cost.
 //
-                  candidate.Reorder ();
+                  candidate.DecreaseKey (cw);
                 }
             } // new lower cost path found
         } // end W is already on the candidate list
@@ -1124,7 +1319,9 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
         }
       else 
         {
-          w->SetRootExitDirection (v->GetRootExitDirection ());
+// The network may have been reached over several equal-cost paths, so
+// all of its exits are inherited.
+          w->InheritAllRootExitDirections (v);
         }
     }
   else 
@@ -1369,6 +1566,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
   v->SetDistanceFromRoot (0);
   v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
   NS_LOG_LOGIC ("Starting SPFCalculate for node " << root);
+  SetSPFRootNode (root);
 
 //
 // Optimize SPF calculation, for ns-3.
@@ -1380,7 +1578,16 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
   if (NodeList::GetNNodes () > 0 && CheckForStubNode (root))
     {
       NS_LOG_LOGIC ("SPFCalculate truncated for stub node " << root);
+      if (m_spfIncremental)
+        {
+          SPFTree &tree = m_spfTrees[root];
+          tree.stub = true;
+          tree.distance.clear ();
+          tree.exits.clear ();
+        }
       delete m_spfroot;
+      m_spfroot = 0;
+      m_spfrootNode = 0;
       return;
     }
 
@@ -1498,10 +1705,16 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
 // We're all done setting the routing information for the node at the root of
 // the SPF tree.  Delete all of the vertices and corresponding resources.  Go
-// possibly do it again for the next router.
+// possibly do it again for the next router.  UpdateRoutes () keeps the
+// distances and exit directions of the tree.
 //
+  if (m_spfIncremental)
+    {
+      SPFSaveTree ();
+    }
   delete m_spfroot;
   m_spfroot = 0;
+  m_spfrootNode = 0;
 }
 
 void
@@ -1556,62 +1769,39 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
   NS_LOG_LOGIC ("External is on remote host: " 
                 << extlsa->GetAdvertisingRouter () << "; installing");
 
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The root of the Shortest Path First tree is the router to which we are
+// going to write the actual routing table entries.  SPFCalculate () has
+// already found its node.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  Ptr<Node> node = m_spfrootNode;
+  if (node == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
+      NS_LOG_LOGIC ("No node found for router " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
 //
 // Routing information is updated using the Ipv4 interface.  We need to QI
 // for that interface.  If the node is acting as an IP version 4 router, it
 // should absolutely have an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "QI for <Ipv4> interface failed");
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = extlsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = extlsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
 
 //
 // Here's why we did all of that work.  We're going to add a host route to the
@@ -1626,39 +1816,36 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add external network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    {
+      return;
+    }
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  NS_ASSERT (gr);
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " add external network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 
@@ -1719,70 +1906,38 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
     }
   NS_LOG_LOGIC ("Stub is on remote host: " << v->GetVertexId () << "; installing");
 //
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
+// The root of the Shortest Path First tree is the router to which we are
+// going to write the actual routing table entries.  SPFCalculate () has
+// already found its node.
 //
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  Ptr<Node> node = m_spfrootNode;
+  if (node == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
+      NS_LOG_LOGIC ("No node found for router " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
 //
 // Routing information is updated using the Ipv4 interface.  We need to QI
 // for that interface.  If the node is acting as an IP version 4 router, it
 // should absolutely have an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "QI for <Ipv4> interface failed");
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask (l->GetLinkData ().Get ());
-          Ipv4Address tempip = l->GetLinkId ();
-          tempip = tempip.CombineMask (tempmask);
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask (l->GetLinkData ().Get ());
+  Ipv4Address tempip = l->GetLinkId ();
+  tempip = tempip.CombineMask (tempmask);
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -1797,39 +1952,36 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
 // which the packets should be send for forwarding.
 //
 
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    {
+      return;
+    }
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  NS_ASSERT (gr);
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1846,68 +1998,44 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 //
 // We have an IP address <a> and a vertex ID of the root of the SPF tree.
 // The question is what interface index does this address correspond to.
-// The answer is a little complicated since we have to find a pointer to
-// the node corresponding to the vertex ID, find the Ipv4 interface on that
-// node in order to iterate the interfaces and find the one corresponding to
-// the address in question.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-//
-// Walk the list of nodes in the system looking for the one corresponding to
-// the node at the root of the SPF tree.  This is the node for which we are
-// building the routing table.
+// SPFCalculate () has already found the node corresponding to the vertex ID;
+// we need the Ipv4 interface on that node in order to iterate the interfaces
+// and find the one corresponding to the address in question.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  Ptr<Node> node = m_spfrootNode;
+  if (node == 0)
     {
-      Ptr<Node> node = *i;
-
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
 //
-// If the node doesn't have a GlobalRouter interface it can't be the one
-// we're interested in.
+// Couldn't find it.
 //
-      if (rtr == 0)
-        {
-          continue;
-        }
-
-      if (rtr->GetRouterId () == routerId)
-        {
+      NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << m_spfroot->GetVertexId ());
+      return -1;
+    }
 //
 // This is the node we're building the routing table for.  We're going to need
 // the Ipv4 interface to look for the ipv4 interface index.  Since this node
 // is participating in routing IP version 4 packets, it certainly must have 
 // an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                         "GetObject for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
+                 "GetObject for <Ipv4> interface failed");
 //
 // Look through the interfaces on this node for one that has the IP address
 // we're looking for.  If we find one, return the corresponding interface
 // index, or -1 if not found.
 //
-          int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
+  int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
 
 #if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif 
-          return interface;
-        }
+  if (interface < 0)
+    {
+      NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                      "Expected an interface associated with address a:" << a);
     }
-//
-// Couldn't find it.
-//
-  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << routerId);
-  return -1;
+#endif 
+  return interface;
 }
 
 //
@@ -1934,70 +2062,38 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
   NS_ASSERT_MSG (m_spfroot, 
                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
 //
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The root of the Shortest Path First tree is the router to which we are
+// going to write the actual routing table entries.  SPFCalculate () has
+// already found its node.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  Ptr<Node> node = m_spfrootNode;
+  if (node == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
+      NS_LOG_LOGIC ("No node found for router " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
 //
 // Routing information is updated using the Ipv4 interface.  We need to 
 // GetObject for that interface.  If the node is acting as an IP version 4 
 // router, it should absolutely have an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "GetObject for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "GetObject for <Ipv4> interface failed");
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
 
-          uint32_t nLinkRecords = lsa->GetNLinkRecords ();
+  uint32_t nLinkRecords = lsa->GetNLinkRecords ();
 //
 // Iterate through the link records on the vertex to which we're going to add
 // routes.  To make sure we're being clear, we're going to add routing table
@@ -2006,18 +2102,18 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // the local side of the point-to-point links found on the node described by
 // the vertex <v>.
 //
-          NS_LOG_LOGIC (" Node " << node->GetId () <<
-                        " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
-          for (uint32_t j = 0; j < nLinkRecords; ++j)
-            {
+  NS_LOG_LOGIC (" Node " << node->GetId () <<
+                " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
+  for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
 //
 // We are only concerned about point-to-point links
 //
-              GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
-              if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                  continue;
-                }
+      GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+      if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
+        {
+          continue;
+        }
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -2031,153 +2127,116 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-              Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-              if (router == 0)
-                {
-                  continue;
-                }
-              Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-              NS_ASSERT (gr);
-              // walk through all available exit directions due to ECMP,
-              // and add host route for each of the exit direction toward
-              // the vertex 'v'
-              for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-                {
-                  SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-                  Ipv4Address nextHop = exit.first;
-                  int32_t outIf = exit.second;
-                  if (outIf >= 0)
-                    {
-                      gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
-                                          outIf);
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " adding host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " and outgoing interface " << outIf);
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " NOT able to add host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " since outgoing interface id is negative " << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
-            }
-//
-// Done adding the routes for the selected node.
-//
+      Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+      if (router == 0)
+        {
           return;
         }
-    }
-}
-void
-GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
+      Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+      NS_ASSERT (gr);
+      // walk through all available exit directions due to ECMP,
+      // and add host route for each of the exit direction toward
+      // the vertex 'v'
+      for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+        {
+          SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+          Ipv4Address nextHop = exit.first;
+          int32_t outIf = exit.second;
+          if (outIf >= 0)
+            {
+              gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
+                                  outIf);
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                            " adding host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " and outgoing interface " << outIf);
+            }
+          else
+            {
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                            " NOT able to add host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
+    }
+//
+// Done adding the routes for the selected node.
+//
+}
+void
+GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
 {
   NS_LOG_FUNCTION (this << v);
 
   NS_ASSERT_MSG (m_spfroot, 
                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
 //
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The root of the Shortest Path First tree is the router to which we are
+// going to write the actual routing table entries.  SPFCalculate () has
+// already found its node.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  Ptr<Node> node = m_spfrootNode;
+  if (node == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
+      NS_LOG_LOGIC ("No node found for router " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
 //
 // Routing information is updated using the Ipv4 interface.  We need to 
 // GetObject for that interface.  If the node is acting as an IP version 4 
 // router, it should absolutely have an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "GetObject for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                 "GetObject for <Ipv4> interface failed");
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = lsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all available exit directions due to ECMP,
-          // and add host route for each of the exit direction toward
-          // the vertex 'v'
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = lsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router == 0)
+    {
+      return;
+    }
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  NS_ASSERT (gr);
+  // walk through all available exit directions due to ECMP,
+  // and add host route for each of the exit direction toward
+  // the vertex 'v'
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
 
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative " << outIf);
-                }
-            }
+      if (outIf >= 0)
+        {
+          gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-    } 
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative " << outIf);
+        }
+    }
 }
 
 // Derived from quagga ospf_vertex_add_parents ()
@@ -2203,6 +2262,609 @@ GlobalRouteManagerImpl::SPFVertexAddParent (SPFVertex* v)
     }
 }
 
+void
+GlobalRouteManagerImpl::SetSPFRootNode (Ipv4Address root)
+{
+  NS_LOG_FUNCTION (this << root);
+//
+// Walk the list of nodes looking for the one that has the router ID of the
+// root vertex, which is the one we're going to write the routing
+// information to.
+//
+  m_spfrootNode = 0;
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      if (rtr == 0)
+        {
+          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
+          continue;
+        }
+      if (rtr->GetRouterId () == root)
+        {
+          m_spfrootNode = node;
+          return;
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::BuildSPFGraph ()
+{
+  NS_LOG_FUNCTION (this);
+//
+// Vertex indexes are kept from one graph to the next, so that the graphs
+// built before and after a topology change can be compared index by index.
+//
+  std::vector<GlobalRoutingLSA*> lsas = m_lsdb->GetLSAs ();
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      Ipv4Address id = lsas[i]->GetLinkStateId ();
+      if (m_spfIndex.find (id) == m_spfIndex.end ())
+        {
+          uint32_t index = m_spfIndex.size ();
+          m_spfIndex[id] = index;
+        }
+    }
+  m_spfGraph.assign (m_spfIndex.size (), SPFGraphVertex ());
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      m_spfGraph[m_spfIndex[lsas[i]->GetLinkStateId ()]].lsa = lsas[i];
+    }
+//
+// The edges are the ones followed by SPFNext ().
+//
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      GlobalRoutingLSA *lsa = lsas[i];
+      uint32_t v = m_spfIndex[lsa->GetLinkStateId ()];
+      if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+        {
+          for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+            {
+              GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (j);
+              if (l->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint
+                  && l->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                  continue;
+                }
+              GlobalRoutingLSA *w_lsa = m_lsdb->GetLSA (l->GetLinkId ());
+              if (w_lsa == 0)
+                {
+                  NS_LOG_WARN ("No LSA for link " << l->GetLinkId () << " of " << lsa->GetLinkStateId ());
+                  continue;
+                }
+              SPFEdge edge = { m_spfIndex[w_lsa->GetLinkStateId ()], l->GetMetric (), l->GetLinkData () };
+              m_spfGraph[v].out.push_back (edge);
+            }
+        }
+      else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+          for (uint32_t j = 0; j < lsa->GetNAttachedRouters (); j++)
+            {
+              GlobalRoutingLSA *w_lsa = m_lsdb->GetLSAByLinkData (lsa->GetAttachedRouter (j));
+              if (w_lsa == 0)
+                {
+                  continue;
+                }
+              SPFEdge edge = { m_spfIndex[w_lsa->GetLinkStateId ()], 0, lsa->GetAttachedRouter (j) };
+              m_spfGraph[v].out.push_back (edge);
+            }
+        }
+    }
+  for (uint32_t v = 0; v < m_spfGraph.size (); v++)
+    {
+      const std::vector<SPFEdge> &out = m_spfGraph[v].out;
+      for (uint32_t j = 0; j < out.size (); j++)
+        {
+          SPFEdge edge = { v, out[j].cost, out[j].linkData };
+          m_spfGraph[out[j].vertex].in.push_back (edge);
+        }
+    }
+  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+    {
+      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
+      std::map<Ipv4Address, uint32_t>::const_iterator v = m_spfIndex.find (extlsa->GetAdvertisingRouter ());
+      if (v != m_spfIndex.end ())
+        {
+          m_spfGraph[v->second].extLsas.push_back (extlsa);
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::SPFSaveTree ()
+{
+  NS_LOG_FUNCTION (this);
+  SPFTree &tree = m_spfTrees[m_spfroot->GetVertexId ()];
+  tree.stub = false;
+  tree.distance.assign (m_spfGraph.size (), SPF_INFINITY);
+  tree.exits.assign (m_spfGraph.size (), SPFExits ());
+//
+// Walk the tree; vertices with several parents are found several times.
+//
+  std::vector<SPFVertex *> stack (1, m_spfroot);
+  while (!stack.empty ())
+    {
+      SPFVertex *v = stack.back ();
+      stack.pop_back ();
+      uint32_t index = m_spfIndex[v->GetVertexId ()];
+      if (tree.distance[index] != SPF_INFINITY)
+        {
+          continue;
+        }
+      tree.distance[index] = v->GetDistanceFromRoot ();
+      if (v != m_spfroot)
+        {
+          SPFExits &exits = tree.exits[index];
+          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+            {
+              exits.push_back (v->GetRootExitDirection (i));
+            }
+          std::sort (exits.begin (), exits.end ());
+          exits.erase (std::unique (exits.begin (), exits.end ()), exits.end ());
+        }
+      for (uint32_t i = 0; i < v->GetNChildren (); i++)
+        {
+          stack.push_back (v->GetChild (i));
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::SPFUpdate (Ipv4Address root, SPFTree &tree,
+                                   const std::vector<SPFGraphVertex> &oldGraph,
+                                   const std::vector<SPFEdgeChange> &removed,
+                                   const std::vector<SPFEdgeChange> &added,
+                                   const std::vector<bool> &changed)
+{
+  NS_LOG_FUNCTION (this << root);
+
+  uint32_t nVertices = m_spfGraph.size ();
+  uint32_t rootIndex = m_spfIndex[root];
+  tree.distance.resize (nVertices, SPF_INFINITY);
+  tree.exits.resize (nVertices);
+  std::vector<uint32_t> oldDistance = tree.distance;
+//
+// The vertices reached through a removed edge of the previous tree, and all
+// of their descendants in that tree, may have lost their shortest paths.
+//
+  std::vector<bool> affected (nVertices, false);
+  std::vector<uint32_t> pending;
+  for (uint32_t i = 0; i < removed.size (); i++)
+    {
+      uint32_t u = removed[i].from;
+      uint32_t w = removed[i].edge.vertex;
+      if (w != rootIndex && !affected[w] && oldDistance[u] != SPF_INFINITY
+          && oldDistance[u] + removed[i].edge.cost == oldDistance[w])
+        {
+          affected[w] = true;
+          pending.push_back (w);
+        }
+    }
+  std::vector<uint32_t> touched;
+  while (!pending.empty ())
+    {
+      uint32_t v = pending.back ();
+      pending.pop_back ();
+      touched.push_back (v);
+      const std::vector<SPFEdge> &out = oldGraph[v].out;
+      for (uint32_t j = 0; j < out.size (); j++)
+        {
+          uint32_t w = out[j].vertex;
+          if (w != rootIndex && !affected[w] && oldDistance[w] != SPF_INFINITY
+              && oldDistance[v] + out[j].cost == oldDistance[w])
+            {
+              affected[w] = true;
+              pending.push_back (w);
+            }
+        }
+    }
+//
+// Run the Dijkstra algorithm from the boundary of the affected region and
+// from the heads of the added edges.
+//
+  typedef std::pair<uint32_t, uint32_t> Candidate_t; // distance, vertex
+  std::priority_queue<Candidate_t, std::vector<Candidate_t>, std::greater<Candidate_t> > candidates;
+  for (uint32_t i = 0; i < touched.size (); i++)
+    {
+      tree.distance[touched[i]] = SPF_INFINITY;
+    }
+  for (uint32_t i = 0; i < touched.size (); i++)
+    {
+      uint32_t v = touched[i];
+      const std::vector<SPFEdge> &in = m_spfGraph[v].in;
+      for (uint32_t j = 0; j < in.size (); j++)
+        {
+          uint32_t u = in[j].vertex;
+          if (!affected[u] && tree.distance[u] != SPF_INFINITY
+              && tree.distance[u] + in[j].cost < tree.distance[v])
+            {
+              tree.distance[v] = tree.distance[u] + in[j].cost;
+              candidates.push (Candidate_t (tree.distance[v], v));
+            }
+        }
+    }
+  for (uint32_t i = 0; i < added.size (); i++)
+    {
+      uint32_t u = added[i].from;
+      uint32_t w = added[i].edge.vertex;
+      if (tree.distance[u] != SPF_INFINITY
+          && tree.distance[u] + added[i].edge.cost < tree.distance[w])
+        {
+          if (!affected[w])
+            {
+              affected[w] = true;
+              touched.push_back (w);
+            }
+          tree.distance[w] = tree.distance[u] + added[i].edge.cost;
+          candidates.push (Candidate_t (tree.distance[w], w));
+        }
+    }
+  while (!candidates.empty ())
+    {
+      Candidate_t c = candidates.top ();
+      candidates.pop ();
+      if (c.first != tree.distance[c.second])
+        {
+          continue;
+        }
+      const std::vector<SPFEdge> &out = m_spfGraph[c.second].out;
+      for (uint32_t j = 0; j < out.size (); j++)
+        {
+          uint32_t w = out[j].vertex;
+          if (c.first + out[j].cost < tree.distance[w])
+            {
+              if (!affected[w])
+                {
+                  affected[w] = true;
+                  touched.push_back (w);
+                }
+              tree.distance[w] = c.first + out[j].cost;
+              candidates.push (Candidate_t (tree.distance[w], w));
+            }
+        }
+    }
+//
+// The exit directions of a vertex depend on those of its parents, so they
+// are computed again in the order of the distances, networks first as in
+// CandidateQueue.  The vertices whose distance, parents or LSAs may have
+// changed are visited, as well as the children of the vertices whose exit
+// directions have changed.
+//
+  std::set<std::pair<uint64_t, uint32_t> > dirty;
+  std::vector<bool> inDirty (nVertices, false);
+  for (uint32_t v = 0; v < nVertices; v++)
+    {
+      bool visit = changed[v];
+      if (affected[v] && tree.distance[v] != oldDistance[v])
+        {
+          visit = true;
+          for (uint32_t j = 0; j < m_spfGraph[v].out.size (); j++)
+            {
+              inDirty[m_spfGraph[v].out[j].vertex] = true;
+            }
+          for (uint32_t j = 0; j < oldGraph[v].out.size (); j++)
+            {
+              inDirty[oldGraph[v].out[j].vertex] = true;
+            }
+        }
+      inDirty[v] = inDirty[v] || visit || affected[v];
+    }
+  for (uint32_t i = 0; i < removed.size (); i++)
+    {
+      inDirty[removed[i].edge.vertex] = true;
+    }
+  for (uint32_t i = 0; i < added.size (); i++)
+    {
+      inDirty[added[i].edge.vertex] = true;
+    }
+  for (uint32_t v = 0; v < nVertices; v++)
+    {
+      if (inDirty[v] && v != rootIndex)
+        {
+          dirty.insert (std::make_pair (SPFOrderKey (v, tree.distance[v]), v));
+        }
+    }
+  std::vector<uint32_t> replaced;
+  std::map<uint32_t, SPFExits> oldExits;
+  while (!dirty.empty ())
+    {
+      uint32_t v = dirty.begin ()->second;
+      dirty.erase (dirty.begin ());
+      SPFExits exits;
+      if (tree.distance[v] != SPF_INFINITY)
+        {
+          SPFComputeExits (rootIndex, v, tree, exits);
+        }
+      if (exits != tree.exits[v])
+        {
+          if (oldExits.find (v) == oldExits.end ())
+            {
+              oldExits[v] = tree.exits[v];
+              if (!changed[v])
+                {
+                  replaced.push_back (v);
+                }
+            }
+          tree.exits[v].swap (exits);
+          const std::vector<SPFEdge> &out = m_spfGraph[v].out;
+          for (uint32_t j = 0; j < out.size (); j++)
+            {
+              uint32_t w = out[j].vertex;
+              if (w != rootIndex && tree.distance[v] != SPF_INFINITY
+                  && tree.distance[v] + out[j].cost == tree.distance[w])
+                {
+                  dirty.insert (std::make_pair (SPFOrderKey (w, tree.distance[w]), w));
+                }
+            }
+        }
+    }
+  for (uint32_t v = 0; v < nVertices; v++)
+    {
+      if (changed[v] && v != rootIndex)
+        {
+          replaced.push_back (v);
+        }
+    }
+//
+// Replace the routes: all of the previous routes are removed first, so that
+// a route moving from one vertex to another one is not removed after having
+// been added.
+//
+  for (uint32_t i = 0; i < replaced.size (); i++)
+    {
+      uint32_t v = replaced[i];
+      std::map<uint32_t, SPFExits>::const_iterator old = oldExits.find (v);
+      SPFUpdateRoutes (oldGraph[v], old != oldExits.end () ? old->second : tree.exits[v], false);
+    }
+  for (uint32_t i = 0; i < replaced.size (); i++)
+    {
+      uint32_t v = replaced[i];
+      SPFUpdateRoutes (m_spfGraph[v], tree.exits[v], true);
+    }
+  NS_LOG_LOGIC ("Updated " << touched.size () << " distances and the routes of " <<
+                replaced.size () << " vertices of the tree of " << root);
+}
+
+uint64_t
+GlobalRouteManagerImpl::SPFOrderKey (uint32_t v, uint32_t distance) const
+{
+  GlobalRoutingLSA *lsa = m_spfGraph[v].lsa;
+  bool network = lsa != 0 && lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA;
+  return (static_cast<uint64_t> (distance) << 1) | (network ? 0 : 1);
+}
+
+void
+GlobalRouteManagerImpl::SPFComputeExits (uint32_t root, uint32_t v, const SPFTree &tree, SPFExits &exits)
+{
+  NS_LOG_FUNCTION (this << root << v);
+
+  exits.clear ();
+  GlobalRoutingLSA *w_lsa = m_spfGraph[v].lsa;
+  const std::vector<SPFEdge> &in = m_spfGraph[v].in;
+  for (uint32_t j = 0; j < in.size (); j++)
+    {
+//
+// Equal cost parents all contribute their exit directions, as merged by
+// SPFNext ().
+//
+      uint32_t u = in[j].vertex;
+      if (u == v || tree.distance[u] == SPF_INFINITY
+          || tree.distance[u] + in[j].cost != tree.distance[v])
+        {
+          continue;
+        }
+      GlobalRoutingLSA *u_lsa = m_spfGraph[u].lsa;
+      if (u == root)
+        {
+          if (w_lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+            {
+//
+// The next hop is the address of the remote end of the link, found in the
+// first link record of <v> towards the root (see SPFGetNextLink ()).
+//
+              for (uint32_t k = 0; k < w_lsa->GetNLinkRecords (); k++)
+                {
+                  GlobalRoutingLinkRecord *l = w_lsa->GetLinkRecord (k);
+                  if (l->GetLinkId () == u_lsa->GetLinkStateId ())
+                    {
+                      exits.push_back (SPFVertex::NodeExit_t (l->GetLinkData (),
+                                                              FindOutgoingInterfaceId (in[j].linkData)));
+                      break;
+                    }
+                }
+            }
+          else
+            {
+              exits.push_back (SPFVertex::NodeExit_t (Ipv4Address::GetZero (),
+                                                      FindOutgoingInterfaceId (w_lsa->GetLinkStateId (),
+                                                                               w_lsa->GetNetworkLSANetworkMask ())));
+            }
+        }
+      else if (u_lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA
+               && !tree.exits[u].empty ()
+               && tree.exits[u].front ().first == Ipv4Address::GetZero ())
+        {
+//
+// <u> is a network attached to the root: the next hop is the address of
+// <v> on that network.
+//
+          for (uint32_t k = 0; k < w_lsa->GetNLinkRecords (); k++)
+            {
+              GlobalRoutingLinkRecord *l = w_lsa->GetLinkRecord (k);
+              if (l->GetLinkId () == u_lsa->GetLinkStateId ())
+                {
+                  for (uint32_t e = 0; e < tree.exits[u].size (); e++)
+                    {
+                      exits.push_back (SPFVertex::NodeExit_t (l->GetLinkData (), tree.exits[u][e].second));
+                    }
+                  break;
+                }
+            }
+        }
+      else
+        {
+          exits.insert (exits.end (), tree.exits[u].begin (), tree.exits[u].end ());
+        }
+    }
+  std::sort (exits.begin (), exits.end ());
+  exits.erase (std::unique (exits.begin (), exits.end ()), exits.end ());
+}
+
+void
+GlobalRouteManagerImpl::SPFUpdateRoutes (const SPFGraphVertex &vertex, const SPFExits &exits, bool add)
+{
+  NS_LOG_FUNCTION (this << add);
+
+  GlobalRoutingLSA *lsa = vertex.lsa;
+  if (lsa == 0 || exits.empty ())
+    {
+      return;
+    }
+  Ptr<GlobalRouter> router = m_spfrootNode->GetObject<GlobalRouter> ();
+  NS_ASSERT (router);
+  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+  NS_ASSERT (gr);
+
+  for (SPFExits::const_iterator i = exits.begin (); i != exits.end (); i++)
+    {
+      Ipv4Address nextHop = i->first;
+      int32_t outIf = i->second;
+      if (outIf < 0)
+        {
+          continue;
+        }
+      bool found = true;
+      if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+//
+// The route added by SPFIntraAddTransit ().
+//
+          Ipv4Mask mask = lsa->GetNetworkLSANetworkMask ();
+          Ipv4Address network = lsa->GetLinkStateId ().CombineMask (mask);
+          if (add)
+            {
+              gr->AddNetworkRouteTo (network, mask, nextHop, outIf);
+            }
+          else
+            {
+              found = gr->RemoveNetworkRouteTo (network, mask, nextHop, outIf);
+            }
+        }
+      else
+        {
+//
+// The routes added by SPFIntraAddRouter () and SPFIntraAddStub ().
+//
+          for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+            {
+              GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (j);
+              if (l->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+                {
+                  if (add)
+                    {
+                      gr->AddHostRouteTo (l->GetLinkData (), nextHop, outIf);
+                    }
+                  else
+                    {
+                      found = gr->RemoveHostRouteTo (l->GetLinkData (), nextHop, outIf) && found;
+                    }
+                }
+              else if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
+                {
+                  Ipv4Mask mask (l->GetLinkData ().Get ());
+                  Ipv4Address network = l->GetLinkId ().CombineMask (mask);
+                  if (add)
+                    {
+                      gr->AddNetworkRouteTo (network, mask, nextHop, outIf);
+                    }
+                  else
+                    {
+                      found = gr->RemoveNetworkRouteTo (network, mask, nextHop, outIf) && found;
+                    }
+                }
+            }
+//
+// The routes added by SPFAddASExternal ().
+//
+          for (uint32_t j = 0; j < vertex.extLsas.size (); j++)
+            {
+              GlobalRoutingLSA *extlsa = vertex.extLsas[j];
+              Ipv4Mask mask = extlsa->GetNetworkLSANetworkMask ();
+              Ipv4Address network = extlsa->GetLinkStateId ().CombineMask (mask);
+              if (add)
+                {
+                  gr->AddASExternalRouteTo (network, mask, nextHop, outIf);
+                }
+              else
+                {
+                  found = gr->RemoveASExternalRouteTo (network, mask, nextHop, outIf) && found;
+                }
+            }
+        }
+      if (!found)
+        {
+          NS_LOG_WARN ("Route towards " << lsa->GetLinkStateId () << " via " << nextHop <<
+                       " not found in the table of node " << m_spfrootNode->GetId ());
+        }
+    }
+}
+
+bool
+GlobalRouteManagerImpl::IsSameLSA (const GlobalRoutingLSA *a, const GlobalRoutingLSA *b)
+{
+  if (a == 0 || b == 0)
+    {
+      return a == b;
+    }
+  if (a->GetLSType () != b->GetLSType ()
+      || a->GetLinkStateId () != b->GetLinkStateId ()
+      || a->GetAdvertisingRouter () != b->GetAdvertisingRouter ()
+      || a->GetNetworkLSANetworkMask () != b->GetNetworkLSANetworkMask ()
+      || a->GetNLinkRecords () != b->GetNLinkRecords ()
+      || a->GetNAttachedRouters () != b->GetNAttachedRouters ())
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < a->GetNLinkRecords (); i++)
+    {
+      GlobalRoutingLinkRecord *la = a->GetLinkRecord (i);
+      GlobalRoutingLinkRecord *lb = b->GetLinkRecord (i);
+      if (la->GetLinkType () != lb->GetLinkType ()
+          || la->GetLinkId () != lb->GetLinkId ()
+          || la->GetLinkData () != lb->GetLinkData ()
+          || la->GetMetric () != lb->GetMetric ())
+        {
+          return false;
+        }
+    }
+  for (uint32_t i = 0; i < a->GetNAttachedRouters (); i++)
+    {
+      if (a->GetAttachedRouter (i) != b->GetAttachedRouter (i))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+GlobalRouteManagerImpl::IsEdgeBefore (const SPFEdge &a, const SPFEdge &b)
+{
+  if (a.vertex != b.vertex)
+    {
+      return a.vertex < b.vertex;
+    }
+  if (a.cost != b.cost)
+    {
+      return a.cost < b.cost;
+    }
+  return a.linkData < b.linkData;
+}
+
 } // namespace ns3
 
 
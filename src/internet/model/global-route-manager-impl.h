@@ -38,6 +38,7 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -674,6 +675,14 @@ public:
    */
   uint32_t GetNumExtLSAs () const;
 
+  /**
+   * @brief Get the router and network Link State Advertisements, in the
+   * order of their link state ID.
+   *
+   * @see GlobalRoutingLSA
+   * @returns The Link State Advertisements of the database.
+   */
+  std::vector<GlobalRoutingLSA*> GetLSAs () const;
 
 private:
   typedef std::map<Ipv4Address, GlobalRoutingLSA*> LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -681,6 +690,8 @@ private:
 
   LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
   std::vector<GlobalRoutingLSA*> m_extdatabase; //!< database of External Link State Advertisements
+  mutable LSDBMap_t m_linkDataIndex; //!< LSAs indexed by the link data of their TransitNetwork records, built on demand
+  mutable bool m_linkDataIndexValid; //!< whether m_linkDataIndex is up to date
 
 /**
  * @brief GlobalRouteManagerLSDB copy construction is disallowed.  There's no 
@@ -735,6 +746,19 @@ public:
  */
   virtual void InitializeRoutes ();
 
+/**
+ * @brief Update the routing database and the per-node forwarding tables
+ * after a change of the topology, recomputing only the parts of the
+ * shortest path trees affected by the change.
+ *
+ * The first call computes all of the routes, as DeleteGlobalRoutes (),
+ * BuildGlobalRoutingDatabase () and InitializeRoutes () do, and keeps the
+ * shortest path tree of each router.  The following calls gather the Link
+ * State Advertisements again, compare them with the previous ones and
+ * update the trees and the forwarding tables of the routers incrementally.
+ */
+  virtual void UpdateRoutes ();
+
 /**
  * @brief Debugging routine; allow client code to supply a pre-built LSDB
  */
@@ -767,8 +791,146 @@ private:
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
   SPFVertex* m_spfroot; //!< the root node
+  Ptr<Node> m_spfrootNode; //!< the node of the root router, whose routing tables are computed
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
 
+  /// Edge of the link state graph kept for the incremental SPF computation
+  struct SPFEdge
+  {
+    uint32_t vertex;      //!< index of the vertex at the other end of the edge
+    uint32_t cost;        //!< cost of the edge
+    Ipv4Address linkData; //!< link data of the router link record, or attached router of the network LSA
+  };
+
+  /// Vertex of the link state graph kept for the incremental SPF computation
+  struct SPFGraphVertex
+  {
+    GlobalRoutingLSA *lsa;                   //!< router or network LSA, 0 if absent
+    std::vector<SPFEdge> out;                //!< edges from this vertex
+    std::vector<SPFEdge> in;                 //!< edges to this vertex, indexed by their origin
+    std::vector<GlobalRoutingLSA *> extLsas; //!< AS external LSAs advertised by this router
+  };
+
+  /// Edge added or removed between two link state graphs
+  struct SPFEdgeChange
+  {
+    uint32_t from; //!< index of the vertex at the origin of the edge
+    SPFEdge edge;  //!< the edge
+  };
+
+  typedef std::vector<SPFVertex::NodeExit_t> SPFExits; //!< root exit directions of a vertex
+
+  /// Shortest path tree of a router kept for the incremental SPF computation
+  struct SPFTree
+  {
+    bool stub;                      //!< routes installed by CheckForStubNode ()
+    std::vector<uint32_t> distance; //!< distance from the root, by vertex index
+    std::vector<SPFExits> exits;    //!< sorted root exit directions, by vertex index
+  };
+
+  bool m_spfIncremental; //!< whether the shortest path trees are kept for UpdateRoutes ()
+  std::map<Ipv4Address, uint32_t> m_spfIndex; //!< vertex index, by vertex ID
+  std::vector<SPFGraphVertex> m_spfGraph;     //!< link state graph, by vertex index
+  std::map<Ipv4Address, SPFTree> m_spfTrees;  //!< shortest path trees, by router ID
+
+  /**
+   * \brief Run the SPF calculation for each router of this system
+   */
+  void CalculateRoutes ();
+
+  /**
+   * \brief Find the node of the root router and store it in m_spfrootNode
+   * \param root the router ID of the root
+   */
+  void SetSPFRootNode (Ipv4Address root);
+
+  /**
+   * \brief Delete all of the routes of a router
+   * \param node the node of the router
+   */
+  void DeleteRoutes (Ptr<Node> node);
+
+  /**
+   * \brief Build m_spfGraph from the link state database
+   */
+  void BuildSPFGraph ();
+
+  /**
+   * \brief Store the shortest path tree rooted at m_spfroot in m_spfTrees
+   */
+  void SPFSaveTree ();
+
+  /**
+   * \brief Update the shortest path tree and the routing table of a router
+   * after a change of the link state graph.
+   *
+   * Only the vertices whose shortest paths went through a removed edge, and
+   * the vertices to which an added edge gives a shorter path, are considered
+   * again; only the routes of the vertices whose exit directions or LSA have
+   * changed are replaced.
+   *
+   * \param root the router ID of the root
+   * \param tree the previous shortest path tree of the root
+   * \param oldGraph the previous link state graph
+   * \param removed the edges of oldGraph not in m_spfGraph
+   * \param added the edges of m_spfGraph not in oldGraph
+   * \param changed whether the LSAs of each vertex have changed
+   */
+  void SPFUpdate (Ipv4Address root, SPFTree &tree,
+                  const std::vector<SPFGraphVertex> &oldGraph,
+                  const std::vector<SPFEdgeChange> &removed,
+                  const std::vector<SPFEdgeChange> &added,
+                  const std::vector<bool> &changed);
+
+  /**
+   * \brief Key ordering the vertices as CandidateQueue does: by distance,
+   * networks before routers
+   * \param v the index of the vertex
+   * \param distance the distance of the vertex from the root
+   * \returns the key
+   */
+  uint64_t SPFOrderKey (uint32_t v, uint32_t distance) const;
+
+  /**
+   * \brief Compute the root exit directions of a vertex from those of its
+   * parents in the shortest path tree, as SPFNexthopCalculation () does.
+   *
+   * \param root the index of the root vertex
+   * \param v the index of the vertex
+   * \param tree the shortest path tree, up to date for the parents of v
+   * \param exits the computed root exit directions
+   */
+  void SPFComputeExits (uint32_t root, uint32_t v, const SPFTree &tree, SPFExits &exits);
+
+  /**
+   * \brief Add or remove the routes towards a vertex in the routing table
+   * of the root router.
+   *
+   * These are the routes that SPFIntraAddRouter (), SPFIntraAddTransit (),
+   * SPFIntraAddStub () and SPFAddASExternal () add for this vertex.
+   *
+   * \param vertex the vertex
+   * \param exits the root exit directions of the vertex
+   * \param add true to add the routes, false to remove them
+   */
+  void SPFUpdateRoutes (const SPFGraphVertex &vertex, const SPFExits &exits, bool add);
+
+  /**
+   * \brief Compare two LSAs, except for their SPF status
+   * \param a first LSA, or 0
+   * \param b second LSA, or 0
+   * \returns true if the LSAs are identical
+   */
+  static bool IsSameLSA (const GlobalRoutingLSA *a, const GlobalRoutingLSA *b);
+
+  /**
+   * \brief Order SPF edges by vertex, cost and link data
+   * \param a first edge
+   * \param b second edge
+   * \returns true if a is before b
+   */
+  static bool IsEdgeBefore (const SPFEdge &a, const SPFEdge &b);
+
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
    *
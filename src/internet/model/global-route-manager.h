@@ -65,6 +65,13 @@ public:
  */
   static void InitializeRoutes ();
 
+/**
+ * @brief Update the routing database and the per-node forwarding tables
+ * after a topology change, recomputing only the affected parts of the
+ * shortest path trees
+ */
+  static void UpdateRoutes ();
+
 private:
 /**
  * @brief Global Route Manager copy construction is disallowed.  There's no 
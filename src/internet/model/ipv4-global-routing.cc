@@ -28,6 +28,7 @@
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/boolean.h"
 #include "ns3/node.h"
+#include "ns3/unused.h"
 #include "ipv4-global-routing.h"
 #include "global-route-manager.h"
 
@@ -80,6 +81,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, nextHop, interface);
   m_hostRoutes.push_back (route);
+  IndexRoute (m_hostRoutesIndex, --m_hostRoutes.end ());
 }
 
 void 
@@ -90,6 +92,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, interface);
   m_hostRoutes.push_back (route);
+  IndexRoute (m_hostRoutesIndex, --m_hostRoutes.end ());
 }
 
 void 
@@ -105,6 +108,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (route);
+  IndexRoute (m_networkRoutesIndex, --m_networkRoutes.end ());
 }
 
 void 
@@ -118,6 +122,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (route);
+  IndexRoute (m_networkRoutesIndex, --m_networkRoutes.end ());
 }
 
 void 
@@ -133,6 +138,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_ASexternalRoutes.push_back (route);
+  IndexRoute (m_ASexternalRoutesIndex, --m_ASexternalRoutes.end ());
 }
 
 
@@ -146,72 +152,72 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
   typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
   RouteVec_t allRoutes;
 
+  // The indexes return the routes whose destination matches, in the
+  // order of the route lists
+  uint8_t address[4];
+  dest.Serialize (address);
+  std::vector<HostRoutesI> matches;
   NS_LOG_LOGIC ("Number of m_hostRoutes = " << m_hostRoutes.size ());
-  for (HostRoutesCI i = m_hostRoutes.begin (); 
-       i != m_hostRoutes.end (); 
-       i++) 
+  m_hostRoutesIndex.Lookup (address, matches);
+  for (std::vector<HostRoutesI>::const_iterator i = matches.begin ();
+       i != matches.end ();
+       i++)
     {
-      NS_ASSERT ((*i)->IsHost ());
-      if ((*i)->GetDest ().IsEqual (dest)) 
+      Ipv4RoutingTableEntry *route = **i;
+      NS_ASSERT (route->IsHost ());
+      if (oif != 0)
         {
-          if (oif != 0)
+          if (oif != m_ipv4->GetNetDevice (route->GetInterface ()))
             {
-              if (oif != m_ipv4->GetNetDevice ((*i)->GetInterface ()))
-                {
-                  NS_LOG_LOGIC ("Not on requested interface, skipping");
-                  continue;
-                }
+              NS_LOG_LOGIC ("Not on requested interface, skipping");
+              continue;
             }
-          allRoutes.push_back (*i);
-          NS_LOG_LOGIC (allRoutes.size () << "Found global host route" << *i); 
         }
+      allRoutes.push_back (route);
+      NS_LOG_LOGIC (allRoutes.size () << "Found global host route" << route);
     }
   if (allRoutes.size () == 0) // if no host route is found
     {
       NS_LOG_LOGIC ("Number of m_networkRoutes" << m_networkRoutes.size ());
-      for (NetworkRoutesI j = m_networkRoutes.begin (); 
-           j != m_networkRoutes.end (); 
-           j++) 
+      matches.clear ();
+      m_networkRoutesIndex.Lookup (address, matches);
+      for (std::vector<NetworkRoutesI>::const_iterator j = matches.begin ();
+           j != matches.end ();
+           j++)
         {
-          Ipv4Mask mask = (*j)->GetDestNetworkMask ();
-          Ipv4Address entry = (*j)->GetDestNetwork ();
-          if (mask.IsMatch (dest, entry)) 
+          Ipv4RoutingTableEntry *route = **j;
+          if (oif != 0)
             {
-              if (oif != 0)
+              if (oif != m_ipv4->GetNetDevice (route->GetInterface ()))
                 {
-                  if (oif != m_ipv4->GetNetDevice ((*j)->GetInterface ()))
-                    {
-                      NS_LOG_LOGIC ("Not on requested interface, skipping");
-                      continue;
-                    }
+                  NS_LOG_LOGIC ("Not on requested interface, skipping");
+                  continue;
                 }
-              allRoutes.push_back (*j);
-              NS_LOG_LOGIC (allRoutes.size () << "Found global network route" << *j);
             }
+          allRoutes.push_back (route);
+          NS_LOG_LOGIC (allRoutes.size () << "Found global network route" << route);
         }
     }
   if (allRoutes.size () == 0)  // consider external if no host/network found
     {
-      for (ASExternalRoutesI k = m_ASexternalRoutes.begin ();
-           k != m_ASexternalRoutes.end ();
+      matches.clear ();
+      m_ASexternalRoutesIndex.Lookup (address, matches);
+      for (std::vector<ASExternalRoutesI>::const_iterator k = matches.begin ();
+           k != matches.end ();
            k++)
         {
-          Ipv4Mask mask = (*k)->GetDestNetworkMask ();
-          Ipv4Address entry = (*k)->GetDestNetwork ();
-          if (mask.IsMatch (dest, entry))
+          Ipv4RoutingTableEntry *route = **k;
+          NS_LOG_LOGIC ("Found external route" << route);
+          if (oif != 0)
             {
-              NS_LOG_LOGIC ("Found external route" << *k);
-              if (oif != 0)
+              if (oif != m_ipv4->GetNetDevice (route->GetInterface ()))
                 {
-                  if (oif != m_ipv4->GetNetDevice ((*k)->GetInterface ()))
-                    {
-                      NS_LOG_LOGIC ("Not on requested interface, skipping");
-                      continue;
-                    }
+                  NS_LOG_LOGIC ("Not on requested interface, skipping");
+                  continue;
                 }
-              allRoutes.push_back (*k);
-              break;
             }
+          allRoutes.push_back (route);
+          break;
         }
     }
   if (allRoutes.size () > 0 ) // if route(s) is found
@@ -319,6 +325,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
           if (tmp  == index)
             {
               NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
+              UnindexRoute (m_hostRoutesIndex, i);
               delete *i;
               m_hostRoutes.erase (i);
               NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
@@ -336,6 +343,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
       if (tmp == index)
         {
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
+          UnindexRoute (m_networkRoutesIndex, j);
           delete *j;
           m_networkRoutes.erase (j);
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
@@ -352,6 +360,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
       if (tmp == index)
         {
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_ASexternalRoutes.size ());
+          UnindexRoute (m_ASexternalRoutesIndex, k);
           delete *k;
           m_ASexternalRoutes.erase (k);
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
@@ -362,6 +371,91 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
   NS_ASSERT (false);
 }
 
+bool
+Ipv4GlobalRouting::RemoveHostRouteTo (Ipv4Address dest,
+                                      Ipv4Address nextHop,
+                                      uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << dest << nextHop << interface);
+  return RemoveIndexedRoute (m_hostRoutes, m_hostRoutesIndex, dest,
+                             Ipv4Mask::GetOnes (), nextHop, interface);
+}
+
+bool
+Ipv4GlobalRouting::RemoveNetworkRouteTo (Ipv4Address network,
+                                         Ipv4Mask networkMask,
+                                         Ipv4Address nextHop,
+                                         uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << network << networkMask << nextHop << interface);
+  return RemoveIndexedRoute (m_networkRoutes, m_networkRoutesIndex, network,
+                             networkMask, nextHop, interface);
+}
+
+bool
+Ipv4GlobalRouting::RemoveASExternalRouteTo (Ipv4Address network,
+                                            Ipv4Mask networkMask,
+                                            Ipv4Address nextHop,
+                                            uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << network << networkMask << nextHop << interface);
+  return RemoveIndexedRoute (m_ASexternalRoutes, m_ASexternalRoutesIndex, network,
+                             networkMask, nextHop, interface);
+}
+
+bool
+Ipv4GlobalRouting::RemoveIndexedRoute (std::list<Ipv4RoutingTableEntry *> &routes,
+                                       RoutesIndex &index,
+                                       Ipv4Address network,
+                                       Ipv4Mask networkMask,
+                                       Ipv4Address nextHop,
+                                       uint32_t interface)
+{
+  uint8_t address[4];
+  network.Serialize (address);
+  std::vector<HostRoutesI> matches;
+  index.Lookup (address, matches);
+  for (std::vector<HostRoutesI>::const_iterator i = matches.begin ();
+       i != matches.end ();
+       i++)
+    {
+      Ipv4RoutingTableEntry *route = **i;
+      if (route->GetDestNetwork () == network
+          && route->GetDestNetworkMask () == networkMask
+          && route->GetGateway () == nextHop
+          && route->GetInterface () == interface)
+        {
+          UnindexRoute (index, *i);
+          delete route;
+          routes.erase (*i);
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+Ipv4GlobalRouting::IndexRoute (RoutesIndex &index, HostRoutesI route)
+{
+  uint8_t address[4];
+  uint8_t mask[4];
+  (*route)->GetDestNetwork ().Serialize (address);
+  Ipv4Address ((*route)->GetDestNetworkMask ().Get ()).Serialize (mask);
+  index.Insert (address, mask, route);
+}
+
+void
+Ipv4GlobalRouting::UnindexRoute (RoutesIndex &index, HostRoutesI route)
+{
+  uint8_t address[4];
+  uint8_t mask[4];
+  (*route)->GetDestNetwork ().Serialize (address);
+  Ipv4Address ((*route)->GetDestNetworkMask ().Get ()).Serialize (mask);
+  bool removed = index.Remove (address, mask, route);
+  NS_ASSERT (removed);
+  NS_UNUSED (removed);
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams (int64_t stream)
 {
@@ -392,6 +486,9 @@ Ipv4GlobalRouting::DoDispose (void)
     {
       delete (*l);
     }
+  m_hostRoutesIndex.Clear ();
+  m_networkRoutesIndex.Clear ();
+  m_ASexternalRoutesIndex.Clear ();
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -28,6 +28,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "prefix-trie.h"
 
 namespace ns3 {
 
@@ -218,6 +219,52 @@ public:
    */
   void RemoveRoute (uint32_t i);
 
+  /**
+   * \brief Remove a host route from the global unicast routing table.
+   *
+   * Only one route is removed if several identical routes are present.
+   *
+   * \param dest The Ipv4Address destination of the route.
+   * \param nextHop The next hop Ipv4Address of the route.
+   * \param interface The network interface index of the route.
+   * \return true if a route was found and removed
+   */
+  bool RemoveHostRouteTo (Ipv4Address dest,
+                          Ipv4Address nextHop,
+                          uint32_t interface);
+
+  /**
+   * \brief Remove a network route from the global unicast routing table.
+   *
+   * Only one route is removed if several identical routes are present.
+   *
+   * \param network The Ipv4Address network of the route.
+   * \param networkMask The Ipv4Mask of the route.
+   * \param nextHop The next hop Ipv4Address of the route.
+   * \param interface The network interface index of the route.
+   * \return true if a route was found and removed
+   */
+  bool RemoveNetworkRouteTo (Ipv4Address network,
+                             Ipv4Mask networkMask,
+                             Ipv4Address nextHop,
+                             uint32_t interface);
+
+  /**
+   * \brief Remove an external route from the global unicast routing table.
+   *
+   * Only one route is removed if several identical routes are present.
+   *
+   * \param network The Ipv4Address network of the route.
+   * \param networkMask The Ipv4Mask of the route.
+   * \param nextHop The next hop Ipv4Address of the route.
+   * \param interface The network interface index of the route.
+   * \return true if a route was found and removed
+   */
+  bool RemoveASExternalRouteTo (Ipv4Address network,
+                                Ipv4Mask networkMask,
+                                Ipv4Address nextHop,
+                                uint32_t interface);
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -268,9 +315,44 @@ private:
    */
   Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif = 0);
 
+  /// index of the route lists by destination prefix
+  typedef PrefixTrie<HostRoutesI, 4> RoutesIndex;
+
+  /**
+   * \brief Add a route to an index.
+   * \param index the index
+   * \param route the route
+   */
+  static void IndexRoute (RoutesIndex &index, HostRoutesI route);
+  /**
+   * \brief Remove a route from an index.
+   * \param index the index
+   * \param route the route
+   */
+  static void UnindexRoute (RoutesIndex &index, HostRoutesI route);
+  /**
+   * \brief Remove a route from a route list and its index.
+   * \param routes the route list
+   * \param index the index of the list
+   * \param network the destination of the route
+   * \param networkMask the destination mask of the route
+   * \param nextHop the next hop of the route
+   * \param interface the interface of the route
+   * \return true if a route was found and removed
+   */
+  static bool RemoveIndexedRoute (std::list<Ipv4RoutingTableEntry *> &routes,
+                                  RoutesIndex &index,
+                                  Ipv4Address network,
+                                  Ipv4Mask networkMask,
+                                  Ipv4Address nextHop,
+                                  uint32_t interface);
+
   HostRoutes m_hostRoutes;             //!< Routes to hosts
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
   ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
+  RoutesIndex m_hostRoutesIndex;       //!< Routes to hosts, indexed by destination
+  RoutesIndex m_networkRoutesIndex;    //!< Routes to networks, indexed by destination prefix
+  RoutesIndex m_ASexternalRoutesIndex; //!< External routes, indexed by destination prefix
 
   Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
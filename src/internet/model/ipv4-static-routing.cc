@@ -31,6 +31,7 @@
 #include "ns3/simulator.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/unused.h"
 #include "ipv4-static-routing.h"
 #include "ipv4-routing-table-entry.h"
 
@@ -72,7 +73,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         nextHop,
                                                         interface);
-  m_networkRoutes.push_back (make_pair (route,metric));
+  AddNetworkRoute (route, metric);
 }
 
 void 
@@ -86,7 +87,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         interface);
-  m_networkRoutes.push_back (make_pair (route,metric));
+  AddNetworkRoute (route, metric);
 }
 
 void 
@@ -143,7 +144,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         outputInterface);
-  m_networkRoutes.push_back (make_pair (route,0));
+  AddNetworkRoute (route, 0);
 }
 
 uint32_t 
@@ -240,9 +241,15 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
-       i++) 
+  // Only the routes whose prefix matches are considered, in the order of
+  // the forwarding table
+  uint8_t address[4];
+  dest.Serialize (address);
+  std::vector<std::pair <Ipv4RoutingTableEntry *, uint32_t> > routes;
+  m_networkRoutesIndex.Lookup (address, routes);
+  for (std::vector<std::pair <Ipv4RoutingTableEntry *, uint32_t> >::const_iterator i = routes.begin ();
+       i != routes.end ();
+       i++)
     {
       Ipv4RoutingTableEntry *j=i->first;
       uint32_t metric =i->second;
@@ -447,8 +454,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete j->first;
-          m_networkRoutes.erase (j);
+          RemoveNetworkRoute (j);
           return;
         }
       tmp++;
@@ -575,6 +581,7 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  m_networkRoutesIndex.Clear ();
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -613,8 +620,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
@@ -660,8 +666,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkMask () == networkMask)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
@@ -670,6 +675,33 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
     }
 }
 
+void
+Ipv4StaticRouting::AddNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (make_pair (route, metric));
+  uint8_t address[4];
+  uint8_t mask[4];
+  route->GetDestNetwork ().Serialize (address);
+  Ipv4Address (route->GetDestNetworkMask ().Get ()).Serialize (mask);
+  m_networkRoutesIndex.Insert (address, mask, make_pair (route, metric));
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::RemoveNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  uint8_t address[4];
+  uint8_t mask[4];
+  it->first->GetDestNetwork ().Serialize (address);
+  Ipv4Address (it->first->GetDestNetworkMask ().Get ()).Serialize (mask);
+  bool removed = m_networkRoutesIndex.Remove (address, mask, *it);
+  NS_ASSERT (removed);
+  NS_UNUSED (removed);
+  delete it->first;
+  return m_networkRoutes.erase (it);
+}
+
 void 
 Ipv4StaticRouting::SetIpv4 (Ptr<Ipv4> ipv4)
 {
@@ -31,6 +31,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "prefix-trie.h"
 
 namespace ns3 {
 
@@ -413,11 +414,31 @@ private:
   Ptr<Ipv4MulticastRoute> LookupStatic (Ipv4Address origin, Ipv4Address group,
                                         uint32_t interface);
 
+  /**
+   * \brief Add a network route to the forwarding table and to its index.
+   * \param route the route, owned by the forwarding table
+   * \param metric the metric of the route
+   */
+  void AddNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table and from its
+   * index, and delete it.
+   * \param it the route
+   * \return the route following the removed one
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI it);
+
   /**
    * \brief the forwarding table for network.
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes indexed by destination prefix.
+   */
+  PrefixTrie<std::pair <Ipv4RoutingTableEntry *, uint32_t>, 4> m_networkRoutesIndex;
+
   /**
    * \brief the forwarding table for multicast.
    */
@@ -26,6 +26,7 @@
 #include "ns3/ipv6-route.h"
 #include "ns3/net-device.h"
 #include "ns3/names.h"
+#include "ns3/unused.h"
 
 #include "ipv6-static-routing.h"
 #include "ipv6-routing-table-entry.h"
@@ -151,7 +152,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   NS_LOG_FUNCTION (this << network << networkPrefix << nextHop << interface << metric);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -164,7 +165,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
 
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface, prefixToUse);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface, uint32_t metric)
@@ -172,7 +173,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   NS_LOG_FUNCTION (this << network << networkPrefix << interface);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::SetDefaultRoute (Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -196,7 +197,7 @@ void Ipv6StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   Ipv6Address network = Ipv6Address ("ff00::"); /* RFC 3513 */
   Ipv6Prefix networkMask = Ipv6Prefix (8);
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, outputInterface);
-  m_networkRoutes.push_back (std::make_pair (route, 0));
+  AddNetworkRoute (route, 0);
 }
 
 uint32_t Ipv6StaticRouting::GetNMulticastRoutes () const
@@ -300,7 +301,13 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
       return rtentry;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  // Only the routes whose prefix matches are considered, in the order of
+  // the forwarding table
+  uint8_t address[16];
+  dst.GetBytes (address);
+  std::vector<std::pair <Ipv6RoutingTableEntry *, uint32_t> > routes;
+  m_networkRoutesIndex.Lookup (address, routes);
+  for (std::vector<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::const_iterator it = routes.begin (); it != routes.end (); it++)
     {
       Ipv6RoutingTableEntry* j = it->first;
       uint32_t metric = it->second;
@@ -371,6 +378,31 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
   return rtentry;
 }
 
+void Ipv6StaticRouting::AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (std::make_pair (route, metric));
+  uint8_t address[16];
+  uint8_t prefix[16];
+  route->GetDestNetwork ().GetBytes (address);
+  route->GetDestNetworkPrefix ().GetBytes (prefix);
+  m_networkRoutesIndex.Insert (address, prefix, std::make_pair (route, metric));
+}
+
+Ipv6StaticRouting::NetworkRoutesI Ipv6StaticRouting::RemoveNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  uint8_t address[16];
+  uint8_t prefix[16];
+  it->first->GetDestNetwork ().GetBytes (address);
+  it->first->GetDestNetworkPrefix ().GetBytes (prefix);
+  bool removed = m_networkRoutesIndex.Remove (address, prefix, *it);
+  NS_ASSERT (removed);
+  NS_UNUSED (removed);
+  delete it->first;
+  return m_networkRoutes.erase (it);
+}
+
 void Ipv6StaticRouting::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -380,6 +412,7 @@ void Ipv6StaticRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_networkRoutesIndex.Clear ();
 
   for (MulticastRoutesI i = m_multicastRoutes.begin (); i != m_multicastRoutes.end (); i = m_multicastRoutes.erase (i))
     {
@@ -452,7 +485,13 @@ Ipv6RoutingTableEntry Ipv6StaticRouting::GetDefaultRoute ()
   uint32_t shortestMetric = 0xffffffff;
   Ipv6RoutingTableEntry* result = 0;
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  // Only the routes whose prefix matches are considered, in the order of
+  // the forwarding table
+  uint8_t address[16];
+  dst.GetBytes (address);
+  std::vector<std::pair <Ipv6RoutingTableEntry *, uint32_t> > routes;
+  m_networkRoutesIndex.Lookup (address, routes);
+  for (std::vector<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::const_iterator it = routes.begin (); it != routes.end (); it++)
     {
       Ipv6RoutingTableEntry* j = it->first;
       uint32_t metric = it->second;
@@ -528,8 +567,7 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (it);
           return;
         }
       tmp++;
@@ -547,8 +585,7 @@ void Ipv6StaticRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uin
       if (network == rtentry->GetDest () && rtentry->GetInterface () == ifIndex
           && rtentry->GetPrefixToUse () == prefixToUse)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (it);
           return;
         }
     }
@@ -672,8 +709,7 @@ void Ipv6StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
@@ -717,8 +753,7 @@ void Ipv6StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAd
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkPrefix () == networkMask)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
@@ -761,8 +796,7 @@ void Ipv6StaticRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv
 
           if (dst == entry && prefix == mask && rtentry->GetInterface () == interface)
             {
-              delete j->first;
-              j = m_networkRoutes.erase (j);
+              j = RemoveNetworkRoute (j);
             }
           else
             {
@@ -30,6 +30,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "prefix-trie.h"
 
 namespace ns3 {
 
@@ -281,11 +282,31 @@ private:
    */
   Ptr<Ipv6MulticastRoute> LookupStatic (Ipv6Address origin, Ipv6Address group, uint32_t ifIndex);
 
+  /**
+   * \brief Add a network route to the forwarding table and to its index.
+   * \param route the route, owned by the forwarding table
+   * \param metric the metric of the route
+   */
+  void AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table and from its
+   * index, and delete it.
+   * \param it the route
+   * \return the route following the removed one
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI it);
+
   /**
    * \brief the forwarding table for network.
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes indexed by destination prefix.
+   */
+  PrefixTrie<std::pair <Ipv6RoutingTableEntry *, uint32_t>, 16> m_networkRoutesIndex;
+
   /**
    * \brief the forwarding table for multicast.
    */
@@ -0,0 +1,446 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Path-compressed binary trie indexing routes by destination prefix.
+ *
+ * The trie stores values (typically routing table entries) under an
+ * address and a mask of \p N bytes, in network byte order (4 for IPv4,
+ * 16 for IPv6).  A lookup returns all the values whose prefix matches a
+ * given address, i.e., the values found on the path from the root to the
+ * longest matching prefix, in the order in which they were inserted.  This
+ * lets the routing protocols replace a linear walk of their route lists
+ * with a lookup whose cost only depends on the address length and on the
+ * number of matching routes, while applying the same selection rules
+ * (longest match, metric, ECMP) to the same routes in the same order.
+ *
+ * Masks that are not contiguous are valid in the routing APIs; the values
+ * inserted with such masks are kept in a separate list which is checked
+ * linearly by each lookup.
+ *
+ * \tparam T the type of the values, which must be copyable and comparable
+ *           for equality
+ * \tparam N the length of the addresses in bytes
+ */
+template <typename T, uint8_t N>
+class PrefixTrie
+{
+public:
+  PrefixTrie ();
+  ~PrefixTrie ();
+
+  /**
+   * \brief Insert a value.
+   *
+   * The bits of the address outside of the mask are ignored.
+   *
+   * \param address the destination address, in network byte order
+   * \param mask the destination mask, in network byte order
+   * \param value the value
+   */
+  void Insert (const uint8_t *address, const uint8_t *mask, T value);
+
+  /**
+   * \brief Remove a value.
+   *
+   * \param address the destination address the value was inserted with
+   * \param mask the destination mask the value was inserted with
+   * \param value the value
+   * \returns true if the value was found and removed
+   */
+  bool Remove (const uint8_t *address, const uint8_t *mask, T value);
+
+  /**
+   * \brief Find the values whose prefix matches an address.
+   *
+   * \param address the address, in network byte order
+   * \param matches the vector to which the matching values are appended,
+   *        in insertion order
+   */
+  void Lookup (const uint8_t *address, std::vector<T> &matches) const;
+
+  /**
+   * \brief Remove all the values.
+   */
+  void Clear (void);
+
+  /**
+   * \returns the number of values in the trie
+   */
+  uint32_t GetSize (void) const;
+
+private:
+  /// Values of a prefix, with their insertion sequence number
+  typedef std::vector<std::pair<uint64_t, T> > Values;
+
+  /// A node of the trie, i.e., a prefix
+  struct Node
+  {
+    uint8_t prefix[N];  //!< the prefix, with the bits after the length set to zero
+    uint8_t length;     //!< the length of the prefix in bits
+    Node *children[2];  //!< the subtries whose next bit is 0 and 1
+    Values values;      //!< the values stored under this prefix
+  };
+
+  /// A value inserted with a mask that is not contiguous
+  struct Irregular
+  {
+    uint8_t address[N]; //!< the destination address
+    uint8_t mask[N];    //!< the destination mask
+    uint64_t sequence;  //!< the insertion sequence number
+    T value;            //!< the value
+  };
+
+  /// Disable copy, since the trie owns its nodes
+  PrefixTrie (const PrefixTrie &);
+  /// Disable assignment, since the trie owns its nodes
+  PrefixTrie &operator = (const PrefixTrie &);
+
+  /**
+   * \param address an address
+   * \param bit the index of a bit, from the most significant one
+   * \returns the value of the bit
+   */
+  static uint8_t GetBit (const uint8_t *address, uint32_t bit);
+  /**
+   * \param a an address
+   * \param b an address
+   * \param max the maximum length to compare
+   * \returns the length of the longest common prefix, up to max bits
+   */
+  static uint32_t GetCommonLength (const uint8_t *a, const uint8_t *b, uint32_t max);
+  /**
+   * \param mask a mask
+   * \returns the length of the mask, or -1 if it is not contiguous
+   */
+  static int32_t GetPrefixLength (const uint8_t *mask);
+  /**
+   * \param address an address
+   * \param length the length of the prefix
+   * \returns a new node for the prefix of the address
+   */
+  static Node *CreateNode (const uint8_t *address, uint32_t length);
+  /**
+   * Delete a node and its subtries.
+   * \param node the node
+   */
+  static void DeleteNode (Node *node);
+  /**
+   * \param a a value and its sequence number
+   * \param b a value and its sequence number
+   * \returns true if a was inserted before b
+   */
+  static bool IsInsertedBefore (const std::pair<uint64_t, T> &a, const std::pair<uint64_t, T> &b);
+
+  Node *m_root;                       //!< the node of the empty prefix
+  std::vector<Irregular> m_irregular; //!< the values with masks that are not contiguous
+  uint64_t m_sequence;                //!< the sequence number of the next value
+  uint32_t m_size;                    //!< the number of values
+};
+
+} // namespace ns3
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+namespace ns3 {
+
+template <typename T, uint8_t N>
+PrefixTrie<T, N>::PrefixTrie ()
+  : m_root (CreateNode (0, 0)),
+    m_sequence (0),
+    m_size (0)
+{
+}
+
+template <typename T, uint8_t N>
+PrefixTrie<T, N>::~PrefixTrie ()
+{
+  DeleteNode (m_root);
+}
+
+template <typename T, uint8_t N>
+void
+PrefixTrie<T, N>::Insert (const uint8_t *address, const uint8_t *mask, T value)
+{
+  m_size++;
+  int32_t length = GetPrefixLength (mask);
+  if (length < 0)
+    {
+      Irregular irregular;
+      std::memcpy (irregular.address, address, N);
+      std::memcpy (irregular.mask, mask, N);
+      irregular.sequence = m_sequence++;
+      irregular.value = value;
+      m_irregular.push_back (irregular);
+      return;
+    }
+
+  Node *node = m_root;
+  while (node->length != length)
+    {
+      Node **link = &node->children[GetBit (address, node->length)];
+      Node *child = *link;
+      if (child == 0)
+        {
+          node = *link = CreateNode (address, length);
+          break;
+        }
+      uint32_t common = GetCommonLength (address, child->prefix, std::min<uint32_t> (length, child->length));
+      if (common == child->length)
+        {
+          node = child;
+          continue;
+        }
+      // The new prefix diverges from the child or is shorter: insert a node
+      // for the common prefix above the child
+      Node *parent = CreateNode (address, common);
+      parent->children[GetBit (child->prefix, common)] = child;
+      *link = parent;
+      node = parent;
+      if (common != static_cast<uint32_t> (length))
+        {
+          node = parent->children[GetBit (address, common)] = CreateNode (address, length);
+        }
+      break;
+    }
+  node->values.push_back (std::make_pair (m_sequence++, value));
+}
+
+template <typename T, uint8_t N>
+bool
+PrefixTrie<T, N>::Remove (const uint8_t *address, const uint8_t *mask, T value)
+{
+  int32_t length = GetPrefixLength (mask);
+  if (length < 0)
+    {
+      for (typename std::vector<Irregular>::iterator i = m_irregular.begin (); i != m_irregular.end (); i++)
+        {
+          if (i->value == value
+              && std::memcmp (i->mask, mask, N) == 0
+              && GetCommonLength (i->address, address, N * 8) == N * 8)
+            {
+              m_irregular.erase (i);
+              m_size--;
+              return true;
+            }
+        }
+      return false;
+    }
+
+  Node **link = &m_root;
+  Node *node = m_root;
+  while (node->length < length)
+    {
+      link = &node->children[GetBit (address, node->length)];
+      node = *link;
+      if (node == 0 || node->length > length
+          || GetCommonLength (address, node->prefix, node->length) != node->length)
+        {
+          return false;
+        }
+    }
+  for (typename Values::iterator i = node->values.begin (); i != node->values.end (); i++)
+    {
+      if (i->second == value)
+        {
+          node->values.erase (i);
+          m_size--;
+          // Remove the node if it is no longer needed to hold a value or to
+          // branch between two subtries
+          if (node->values.empty () && node != m_root
+              && (node->children[0] == 0 || node->children[1] == 0))
+            {
+              *link = node->children[0] != 0 ? node->children[0] : node->children[1];
+              node->children[0] = node->children[1] = 0;
+              DeleteNode (node);
+            }
+          return true;
+        }
+    }
+  return false;
+}
+
+template <typename T, uint8_t N>
+void
+PrefixTrie<T, N>::Lookup (const uint8_t *address, std::vector<T> &matches) const
+{
+  Values found;
+  const Node *node = m_root;
+  while (node != 0 && GetCommonLength (address, node->prefix, node->length) == node->length)
+    {
+      found.insert (found.end (), node->values.begin (), node->values.end ());
+      if (node->length == N * 8)
+        {
+          break;
+        }
+      node = node->children[GetBit (address, node->length)];
+    }
+  for (typename std::vector<Irregular>::const_iterator i = m_irregular.begin (); i != m_irregular.end (); i++)
+    {
+      bool match = true;
+      for (uint8_t j = 0; j < N && match; j++)
+        {
+          match = ((address[j] & i->mask[j]) == (i->address[j] & i->mask[j]));
+        }
+      if (match)
+        {
+          found.push_back (std::make_pair (i->sequence, i->value));
+        }
+    }
+  if (found.size () > 1)
+    {
+      std::sort (found.begin (), found.end (), &PrefixTrie<T, N>::IsInsertedBefore);
+    }
+  for (typename Values::const_iterator i = found.begin (); i != found.end (); i++)
+    {
+      matches.push_back (i->second);
+    }
+}
+
+template <typename T, uint8_t N>
+void
+PrefixTrie<T, N>::Clear (void)
+{
+  DeleteNode (m_root);
+  m_root = CreateNode (0, 0);
+  m_irregular.clear ();
+  m_size = 0;
+}
+
+template <typename T, uint8_t N>
+uint32_t
+PrefixTrie<T, N>::GetSize (void) const
+{
+  return m_size;
+}
+
+template <typename T, uint8_t N>
+uint8_t
+PrefixTrie<T, N>::GetBit (const uint8_t *address, uint32_t bit)
+{
+  NS_ASSERT (bit < N * 8);
+  return (address[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+template <typename T, uint8_t N>
+uint32_t
+PrefixTrie<T, N>::GetCommonLength (const uint8_t *a, const uint8_t *b, uint32_t max)
+{
+  uint32_t length = 0;
+  for (uint8_t i = 0; i < N && length < max; i++)
+    {
+      uint8_t diff = a[i] ^ b[i];
+      if (diff == 0)
+        {
+          length += 8;
+          continue;
+        }
+      while ((diff & 0x80) == 0)
+        {
+          diff <<= 1;
+          length++;
+        }
+      break;
+    }
+  return std::min (length, max);
+}
+
+template <typename T, uint8_t N>
+int32_t
+PrefixTrie<T, N>::GetPrefixLength (const uint8_t *mask)
+{
+  int32_t length = 0;
+  uint8_t i = 0;
+  for (; i < N && mask[i] == 0xff; i++)
+    {
+      length += 8;
+    }
+  if (i < N)
+    {
+      uint8_t byte = mask[i++];
+      while (byte & 0x80)
+        {
+          byte <<= 1;
+          length++;
+        }
+      if (byte != 0)
+        {
+          return -1;
+        }
+    }
+  for (; i < N; i++)
+    {
+      if (mask[i] != 0)
+        {
+          return -1;
+        }
+    }
+  return length;
+}
+
+template <typename T, uint8_t N>
+typename PrefixTrie<T, N>::Node *
+PrefixTrie<T, N>::CreateNode (const uint8_t *address, uint32_t length)
+{
+  Node *node = new Node ();
+  std::memset (node->prefix, 0, N);
+  for (uint32_t i = 0; i < length; i++)
+    {
+      node->prefix[i / 8] |= GetBit (address, i) << (7 - i % 8);
+    }
+  node->length = length;
+  node->children[0] = node->children[1] = 0;
+  return node;
+}
+
+template <typename T, uint8_t N>
+void
+PrefixTrie<T, N>::DeleteNode (Node *node)
+{
+  if (node != 0)
+    {
+      DeleteNode (node->children[0]);
+      DeleteNode (node->children[1]);
+      delete node;
+    }
+}
+
+template <typename T, uint8_t N>
+bool
+PrefixTrie<T, N>::IsInsertedBefore (const std::pair<uint64_t, T> &a, const std::pair<uint64_t, T> &b)
+{
+  return a.first < b.first;
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
@@ -96,7 +96,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n),
+    m_lostBoundary (n), m_nextSegHint (n)
 {
 }
 
@@ -163,8 +164,11 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
 
   if (m_sentList.size () > 0)
     {
+      UnindexSentItem (m_sentList.front ());
       m_sentList.front ()->m_startSeq = seq;
+      IndexSentItem (m_sentList.begin ());
     }
+  ResetHints ();
 
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
@@ -294,7 +298,7 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
   NS_ASSERT (it != m_appList.end ());
 
   m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  IndexSentItem (m_sentList.insert (m_sentList.end (), item));
   m_sentSize += item->m_packet->GetSize ();
 
   return item;
@@ -308,36 +312,33 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  PacketIndex::const_iterator index = m_sentIndex.find (seq);
+  if (index != m_sentIndex.end ())
     {
-      if ((*it)->m_startSeq == seq)
+      PacketList::iterator it = index->second;
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked... there is the possibility to merge
+          if (! (*next)->m_sacked)
             {
-              // Next is not sacked... there is the possibility to merge
-              if (! (*next)->m_sacked)
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -398,7 +399,7 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
-                                bool *listEdited) const
+                                bool *listEdited)
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -434,12 +435,25 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   TcpTxItem *outItem = nullptr;
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+  bool sentList = (&list == &m_sentList);
+
+  if (sentList)
+    {
+      // Start the walk from the packet that contains seq
+      PacketIndex::const_iterator index = m_sentIndex.upper_bound (seq);
+      if (index != m_sentIndex.begin ())
+        {
+          --index;
+          it = index->second;
+          beginOfCurrentPacket = index->first;
+        }
+    }
 
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (!sentList || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -469,7 +483,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstIt = list.insert (it, firstPart);
+              if (sentList)
+                {
+                  IndexSentItem (firstIt);
+                  IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -517,6 +536,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
 
                   list.erase (it);
 
+                  if (sentList)
+                    {
+                      UnindexSentItem (currentItem);
+                    }
                   MergeItems (previous, currentItem);
                   delete currentItem;
                   if (listEdited)
@@ -535,7 +558,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstIt = list.insert (it, firstPart);
+              if (sentList)
+                {
+                  IndexSentItem (firstIt);
+                  IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -566,6 +594,15 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
           MergeItems (currentItem, next);
           list.erase (it);
 
+          if (sentList)
+            {
+              UnindexSentItem (next);
+              // The merged packet may have lost its retransmitted flag
+              if (currentItem->m_startSeq < m_nextSegHint)
+                {
+                  m_nextSegHint = currentItem->m_startSeq;
+                }
+            }
           delete next;
 
           if (listEdited)
@@ -693,6 +730,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
 
           RemoveFromCounts (item, pktSize);
 
+          UnindexSentItem (item);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -705,7 +743,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          UnindexSentItem (item);
           item->m_startSeq += offset;
+          IndexSentItem (i);
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -733,8 +773,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
           // It is not possible to have the UNA sacked; otherwise, it would
           // have been ACKed. This is, most likely, our wrong guessing
           // when adding Reno dupacks in the count.
-          head->m_sacked = false;
+          SetSacked (m_sentList.begin (), false);
           m_sackedOut -= head->m_packet->GetSize ();
+          ResetHints ();
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
           AddRenoSack ();
           MarkHeadAsLost ();
@@ -749,6 +790,14 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
     {
       m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
     }
+  if (m_lostBoundary < m_firstByteSeq)
+    {
+      m_lostBoundary = m_firstByteSeq;
+    }
+  if (m_nextSegHint < m_firstByteSeq)
+    {
+      m_nextSegHint = m_firstByteSeq;
+    }
 
   NS_LOG_DEBUG ("Discarded up to " << seq << " lost: " << m_lostOut <<
                 " retrans: " << m_retrans << " sacked: " << m_sackedOut);
@@ -768,69 +817,61 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list)
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first && !modified)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return false;
         }
 
-      while (item_it != m_sentList.end ())
+      // Only mark as sacked the packets that are precisely mapped over the
+      // option. It means that if the receiver is reporting as sacked single
+      // range bytes that are not mapped 1:1 in what we have, the option is
+      // discarded. There's room for improvement here.
+      // The packets are contiguous: if the first one that starts inside the
+      // block does not end inside it, no packet does.
+      PacketIndex::const_iterator first = m_sentIndex.lower_bound ((*option_it).first);
+      if (first == m_sentIndex.end ()
+          || first->first + (*first->second)->m_packet->GetSize () > (*option_it).second)
         {
+          NS_LOG_INFO ("Received block " << *option_it << ", not found in the sent list");
+          continue;
+        }
+      modified = true;
+
+      // Walk only the packets inside the block that are not sacked yet
+      PacketIndex::iterator index = m_unsackedIndex.lower_bound ((*option_it).first);
+      while (index != m_unsackedIndex.end ())
+        {
+          PacketList::iterator item_it = index->second;
+          SequenceNumber32 beginOfCurrentPacket = index->first;
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
 
-          // Check the boundary of this packet ... only mark as sacked if
-          // it is precisely mapped over the option. It means that if the receiver
-          // is reporting as sacked single range bytes that are not mapped 1:1
-          // in what we have, the option is discarded. There's room for improvement
-          // here.
-          if (beginOfCurrentPacket >= (*option_it).first
-              && beginOfCurrentPacket + pktSize <= (*option_it).second)
+          if (beginOfCurrentPacket + pktSize > (*option_it).second)
             {
-              if ((*item_it)->m_sacked)
-                {
-                  NS_ASSERT (!(*item_it)->m_lost);
-                  NS_LOG_INFO ("Received block " << *option_it <<
-                               ", checking sentList for block " << *(*item_it) <<
-                               ", found in the sackboard already sacked");
-                }
-              else
-                {
-                  if ((*item_it)->m_lost)
-                    {
-                      (*item_it)->m_lost = false;
-                      m_lostOut -= (*item_it)->m_packet->GetSize ();
-                    }
+              // We already passed the received block end. Exit from the loop
+              break;
+            }
+          ++index; // SetSacked removes the current entry from the index
 
-                  (*item_it)->m_sacked = true;
-                  m_sackedOut += (*item_it)->m_packet->GetSize ();
+          if ((*item_it)->m_lost)
+            {
+              (*item_it)->m_lost = false;
+              m_lostOut -= pktSize;
+            }
 
-                  if (m_highestSack.first == m_sentList.end()
-                      || m_highestSack.second <= beginOfCurrentPacket + pktSize)
-                    {
-                      m_highestSack = std::make_pair (item_it, beginOfCurrentPacket);
-                    }
+          SetSacked (item_it, true);
+          m_sackedOut += pktSize;
 
-                  NS_LOG_INFO ("Received block " << *option_it <<
-                               ", checking sentList for block " << *(*item_it) <<
-                               ", found in the sackboard, sacking, current highSack: " <<
-                               m_highestSack.second);
-                }
-              modified = true;
-            }
-          else if (beginOfCurrentPacket + pktSize > (*option_it).second)
+          if (m_highestSack.first == m_sentList.end()
+              || m_highestSack.second <= beginOfCurrentPacket + pktSize)
             {
-              // We already passed the received block end. Exit from the loop
-              NS_LOG_INFO ("Received block [" << *option_it <<
-                           ", checking sentList for block " << *(*item_it) <<
-                           "], not found, breaking loop");
-              break;
+              m_highestSack = std::make_pair (item_it, beginOfCurrentPacket);
             }
 
-          beginOfCurrentPacket += pktSize;
-          ++item_it;
+          NS_LOG_INFO ("Received block " << *option_it <<
+                       ", checking sentList for block " << *(*item_it) <<
+                       ", found in the sackboard, sacking, current highSack: " <<
+                       m_highestSack.second);
         }
     }
 
@@ -853,7 +894,8 @@ TcpTxBuffer::UpdateLostCount ()
 {
   NS_LOG_FUNCTION (this);
   uint32_t sacked = 0;
-  SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
+  bool thresholdReached = false;
+  SequenceNumber32 boundary;
   if (m_highestSack.first == m_sentList.end ())
     {
       NS_LOG_INFO ("Status before the update: " << *this <<
@@ -868,6 +910,12 @@ TcpTxBuffer::UpdateLostCount ()
   for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
+      if (thresholdReached && item->m_startSeq < m_lostBoundary)
+        {
+          // Everything below the boundary is already sacked or lost
+          break;
+        }
+
       if (item->m_sacked)
         {
           sacked++;
@@ -875,13 +923,21 @@ TcpTxBuffer::UpdateLostCount ()
 
       if (sacked >= m_dupAckThresh)
         {
+          if (!thresholdReached)
+            {
+              thresholdReached = true;
+              boundary = item->m_startSeq;
+            }
           if (!item->m_sacked && !item->m_lost)
             {
               item->m_lost = true;
               m_lostOut += item->m_packet->GetSize ();
+              if (item->m_startSeq < m_nextSegHint)
+                {
+                  m_nextSegHint = item->m_startSeq;
+                }
             }
         }
-      beginOfCurrentPacket -= item->m_packet->GetSize ();
     }
 
   if (sacked >= m_dupAckThresh)
@@ -891,8 +947,13 @@ TcpTxBuffer::UpdateLostCount ()
         {
           item->m_lost = true;
           m_lostOut += item->m_packet->GetSize ();
+          m_nextSegHint = item->m_startSeq;
         }
     }
+  if (thresholdReached && m_lostBoundary < boundary)
+    {
+      m_lostBoundary = boundary;
+    }
   NS_LOG_INFO ("Status after the update: " << *this);
   ConsistencyCheck ();
 }
@@ -902,35 +963,31 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first packet that begins at or after seq
+  PacketIndex::const_iterator index = m_sentIndex.lower_bound (seq);
+  if (index == m_sentIndex.end ())
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
-        {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
+      return false;
+    }
 
-          if ((*it)->m_sacked == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
-            }
+  for (PacketList::const_iterator it = index->second; it != m_sentList.end (); ++it)
+    {
+      if ((*it)->m_lost == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
         }
 
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
+        }
     }
 
   return false;
@@ -954,36 +1011,24 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
-  TcpTxItem *item;
-  SequenceNumber32 seqPerRule3;
-  bool isSeqPerRule3Valid = false;
-  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
+  // No packet before the hint is a candidate: skip them
+  SequenceNumber32 from = std::max (m_nextSegHint, m_firstByteSeq.Get ());
+  PacketIndex::const_iterator index;
 
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  for (index = m_unsackedIndex.lower_bound (from); index != m_unsackedIndex.end (); ++index)
     {
-      item = *it;
+      const TcpTxItem *item = *index->second;
 
       // Condition 1.a , 1.b , and 1.c
-      if (item->m_retrans == false && item->m_sacked == false)
+      if (item->m_retrans == false && item->m_lost)
         {
-          if (item->m_lost)
-            {
-              NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-              *seq = beginOfCurrentPkt;
-              return true;
-            }
-          else if (seqPerRule3.GetValue () == 0 && isRecovery)
-            {
-              NS_LOG_INFO ("Saving for rule 3 the seq " << beginOfCurrentPkt);
-              isSeqPerRule3Valid = true;
-              seqPerRule3 = beginOfCurrentPkt;
-            }
+          NS_LOG_INFO("IsLost, returning" << index->first);
+          m_nextSegHint = index->first;
+          *seq = index->first;
+          return true;
         }
-
-      // Nothing found, iterate
-      beginOfCurrentPkt += item->m_packet->GetSize ();
     }
+  m_nextSegHint = m_firstByteSeq + m_sentSize;
 
   /* (2) If no sequence number 'S2' per rule (1) exists but there
    *     exists available unsent data and the receiver's advertised
@@ -1008,11 +1053,17 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *     (specifically excluding step (1.c)), then one segment of up to
    *     SMSS octets starting with S3 SHOULD be returned.
    */
-  if (isSeqPerRule3Valid)
+  if (isRecovery)
     {
-      NS_LOG_INFO ("Rule3 valid. " << seqPerRule3);
-      *seq = seqPerRule3;
-      return true;
+      for (index = m_unsackedIndex.begin (); index != m_unsackedIndex.end (); ++index)
+        {
+          if ((*index->second)->m_retrans == false)
+            {
+              NS_LOG_INFO ("Rule3 valid. " << index->first);
+              *seq = index->first;
+              return true;
+            }
+        }
     }
 
   /* (4) If the conditions for (1), (2), and (3) fail, but there exists
@@ -1184,6 +1235,8 @@ TcpTxBuffer::ResetRenoSack ()
     {
       (*it)->m_sacked = false;
     }
+  m_unsackedIndex = m_sentIndex;
+  ResetHints ();
 
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
 }
@@ -1203,6 +1256,10 @@ TcpTxBuffer::ResetSentList ()
       m_sentList.pop_back ();
     }
 
+  m_sentIndex.clear ();
+  m_unsackedIndex.clear ();
+  ResetHints ();
+
   m_sentSize = 0;
   m_lostOut = 0;
   m_retrans = 0;
@@ -1218,6 +1275,7 @@ TcpTxBuffer::ResetLastSegmentSent ()
     {
       TcpTxItem *item = m_sentList.back ();
 
+      UnindexSentItem (item);
       m_sentList.pop_back ();
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
@@ -1270,6 +1328,11 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
 
       (*it)->m_retrans = false;
     }
+  if (resetSack)
+    {
+      m_unsackedIndex = m_sentIndex;
+    }
+  ResetHints ();
 
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
@@ -1303,6 +1366,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead ()
     {
       m_sentList.front ()->m_retrans = false;
       m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+      m_nextSegHint = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1317,7 +1381,7 @@ TcpTxBuffer::MarkHeadAsLost ()
       // A sacked head means that we should advance SND.UNA.. so it's an error.
       if (m_sentList.front ()->m_sacked)
         {
-          m_sentList.front ()->m_sacked = false;
+          SetSacked (m_sentList.begin (), false);
           m_sackedOut -= m_sentList.front ()->m_packet->GetSize ();
         }
 
@@ -1332,6 +1396,7 @@ TcpTxBuffer::MarkHeadAsLost ()
           m_sentList.front()->m_lost = true;
           m_lostOut += m_sentList.front ()->m_packet->GetSize ();
         }
+      m_nextSegHint = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1345,18 +1410,14 @@ TcpTxBuffer::AddRenoSack (void)
   m_renoSack = true;
 
   // We can _never_ SACK the head, so start from the second segment sent
-  auto it = ++m_sentList.begin ();
-
-  // Find the "highest sacked" point, that is SND.UNA + m_sackedOut
-  while (it != m_sentList.end () && (*it)->m_sacked)
-    {
-      ++it;
-    }
+  // and find the "highest sacked" point, that is SND.UNA + m_sackedOut
+  PacketIndex::const_iterator index = m_unsackedIndex.upper_bound (m_firstByteSeq);
 
   // Add to the sacked size the size of the first "not sacked" segment
-  if (it != m_sentList.end ())
+  if (index != m_unsackedIndex.end ())
     {
-      (*it)->m_sacked = true;
+      PacketList::iterator it = index->second;
+      SetSacked (it, true);
       m_sackedOut += (*it)->m_packet->GetSize ();
       m_highestSack = std::make_pair (it, (*it)->m_startSeq);
       NS_LOG_INFO ("Added a Reno SACK, status: " << *this);
@@ -1370,6 +1431,44 @@ TcpTxBuffer::AddRenoSack (void)
   ConsistencyCheck ();
 }
 
+void
+TcpTxBuffer::IndexSentItem (PacketList::iterator it)
+{
+  m_sentIndex[(*it)->m_startSeq] = it;
+  if (!(*it)->m_sacked)
+    {
+      m_unsackedIndex[(*it)->m_startSeq] = it;
+    }
+}
+
+void
+TcpTxBuffer::UnindexSentItem (const TcpTxItem *item)
+{
+  m_sentIndex.erase (item->m_startSeq);
+  m_unsackedIndex.erase (item->m_startSeq);
+}
+
+void
+TcpTxBuffer::SetSacked (PacketList::iterator it, bool sacked)
+{
+  (*it)->m_sacked = sacked;
+  if (sacked)
+    {
+      m_unsackedIndex.erase ((*it)->m_startSeq);
+    }
+  else
+    {
+      m_unsackedIndex[(*it)->m_startSeq] = it;
+    }
+}
+
+void
+TcpTxBuffer::ResetHints ()
+{
+  m_lostBoundary = m_firstByteSeq;
+  m_nextSegHint = m_firstByteSeq;
+}
+
 void
 TcpTxBuffer::ConsistencyCheck () const
 {
@@ -1406,6 +1505,9 @@ TcpTxBuffer::ConsistencyCheck () const
                  " stored lost: " << m_lostOut);
   NS_ASSERT_MSG (retrans == m_retrans, " Counted retrans: " << retrans <<
                  " stored retrans: " << m_retrans);
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (),
+                 " Indexed items: " << m_sentIndex.size () <<
+                 " sent items: " << m_sentList.size ());
 }
 
 std::ostream &
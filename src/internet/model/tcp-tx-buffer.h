@@ -28,6 +28,8 @@
 #include "ns3/nstime.h"
 #include "ns3/tcp-option-sack.h"
 #include "ns3/packet.h"
+#include <list>
+#include <map>
 
 namespace ns3 {
 class Packet;
@@ -105,6 +107,12 @@ public:
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * To avoid walking the whole list with large windows, the items of the
+ * SentList are also indexed by their starting sequence number, and the items
+ * not sacked are indexed separately. The SACK blocks, the segments to
+ * retransmit and the segments to be marked as lost are then found in
+ * logarithmic time, and only the items that change are visited.
+ *
  * Item properties
  * ---------------
  *
@@ -426,8 +434,8 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
+   * and updates the lost count. The walk stops at m_lostBoundary, below which
+   * all the items are already sacked or lost.
    *
    */
   void UpdateLostCount ();
@@ -560,7 +568,7 @@ private:
    */
   TcpTxItem* GetPacketFromList (PacketList &list, const SequenceNumber32 &startingSeq,
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
-                                bool *listEdited = nullptr) const;
+                                bool *listEdited = nullptr);
 
   /**
    * \brief Merge two TcpTxItem
@@ -586,6 +594,31 @@ private:
    */
   void SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const;
 
+  /**
+   * \brief Add an item of the SentList to the indexes
+   * \param it the item
+   */
+  void IndexSentItem (PacketList::iterator it);
+
+  /**
+   * \brief Remove an item of the SentList from the indexes
+   * \param item the item
+   */
+  void UnindexSentItem (const TcpTxItem *item);
+
+  /**
+   * \brief Set the sacked flag of an item of the SentList
+   * \param it the item
+   * \param sacked the new value of the flag
+   */
+  void SetSacked (PacketList::iterator it, bool sacked);
+
+  /**
+   * \brief Forget the loss detection and retransmission progress, after
+   * flags have been changed in the whole SentList
+   */
+  void ResetHints ();
+
   /**
    * \brief Check if the values of sacked, lost, retrans, are in sync
    * with the sent list.
@@ -608,6 +641,14 @@ private:
   TracedValue<SequenceNumber32> m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
   std::pair <PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+  /// Index of the items of a list, by starting sequence number
+  typedef std::map<SequenceNumber32, PacketList::iterator> PacketIndex;
+
+  PacketIndex m_sentIndex;     //!< Items of the SentList
+  PacketIndex m_unsackedIndex; //!< Items of the SentList that are not sacked
+  SequenceNumber32 m_lostBoundary; //!< The items starting before are all sacked or lost
+  mutable SequenceNumber32 m_nextSegHint; //!< No item starting before is lost and not retransmitted
+
   uint32_t m_lostOut   {0}; //!< Number of lost bytes
   uint32_t m_sackedOut {0}; //!< Number of sacked bytes
   uint32_t m_retrans   {0}; //!< Number of retransmitted bytes
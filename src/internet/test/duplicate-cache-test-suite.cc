@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+#include <utility>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/duplicate-cache.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief DuplicateCache IsDuplicate Test
+ */
+class DuplicateCacheIsDuplicateTestCase : public TestCase
+{
+public:
+  DuplicateCacheIsDuplicateTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Check the entries inserted at time 0, after their lifetime.
+  void CheckExpired ();
+  DuplicateCache<> m_cache; //!< The cache.
+};
+
+DuplicateCacheIsDuplicateTestCase::DuplicateCacheIsDuplicateTestCase ()
+  : TestCase ("DuplicateCache IsDuplicate"),
+    m_cache (Seconds (10))
+{
+}
+
+void
+DuplicateCacheIsDuplicateTestCase::CheckExpired ()
+{
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetSize (), 0, "All the entries should have expired");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("1.2.3.4"), 3), false, "Expired entry");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetSize (), 1, "The entry should be inserted again");
+}
+
+void
+DuplicateCacheIsDuplicateTestCase::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("1.2.3.4"), 3), false, "Unknown ID");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("1.2.3.4"), 3), true, "Known ID");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("1.2.3.4"), 4), false, "Unknown ID");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("4.3.2.1"), 3), false, "Unknown address");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetSize (), 3, "Unexpected number of entries");
+
+  m_cache.Erase (Ipv4Address ("1.2.3.4"), 4);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetSize (), 2, "The entry should be erased");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.IsDuplicate (Ipv4Address ("1.2.3.4"), 4), false, "Erased ID");
+
+  Simulator::Schedule (Seconds (11), &DuplicateCacheIsDuplicateTestCase::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief DuplicateCache random operations Test
+ *
+ * Random insertions, refreshes and erasures are checked against a
+ * std::map of the entries and their expiration times.
+ */
+class DuplicateCacheRandomTestCase : public TestCase
+{
+public:
+  DuplicateCacheRandomTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Do a random operation, and check the cache against the reference.
+  void Step ();
+
+  /// Reference entries: the value and the expiration time, by (address, id).
+  typedef std::map<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, Time> > Reference;
+
+  DuplicateCache<uint32_t> m_cache;       //!< The cache.
+  Reference m_reference;                  //!< The reference.
+  Ptr<UniformRandomVariable> m_random;    //!< Random variable.
+  uint32_t m_steps;                       //!< Number of steps left.
+};
+
+DuplicateCacheRandomTestCase::DuplicateCacheRandomTestCase ()
+  : TestCase ("DuplicateCache random operations"),
+    m_steps (2000)
+{
+}
+
+void
+DuplicateCacheRandomTestCase::Step ()
+{
+  Time now = Simulator::Now ();
+  Ipv4Address addr (m_random->GetInteger (1, 4));
+  uint32_t id = m_random->GetInteger (0, 20);
+  std::pair<uint32_t, uint32_t> key (addr.Get (), id);
+  uint32_t op = m_random->GetInteger (0, 3);
+  if (op < 3)
+    {
+      uint32_t value = m_random->GetInteger ();
+      Time expire = now + MilliSeconds (m_random->GetInteger (0, 5000));
+      m_cache.Insert (addr, id, value, expire);
+      m_reference[key] = std::make_pair (value, expire);
+    }
+  else
+    {
+      m_cache.Erase (addr, id);
+      m_reference.erase (key);
+    }
+
+  uint32_t size = 0;
+  for (Reference::const_iterator it = m_reference.begin (); it != m_reference.end (); ++it)
+    {
+      uint32_t *value = m_cache.Find (Ipv4Address (it->first.first), it->first.second);
+      bool expired = it->second.second < now;
+      NS_TEST_ASSERT_MSG_EQ ((value == 0), expired, "Unexpected lookup of " << Ipv4Address (it->first.first)
+                             << " " << it->first.second << " at " << now.GetSeconds ());
+      if (!expired)
+        {
+          NS_TEST_ASSERT_MSG_EQ (*value, it->second.first, "Unexpected value");
+          size++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_cache.GetSize (), size, "Unexpected number of entries");
+
+  if (--m_steps > 0)
+    {
+      Simulator::Schedule (MilliSeconds (m_random->GetInteger (0, 100)),
+                           &DuplicateCacheRandomTestCase::Step, this);
+    }
+}
+
+void
+DuplicateCacheRandomTestCase::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  m_cache.SetBucketWidth (MilliSeconds (300));
+  Simulator::ScheduleNow (&DuplicateCacheRandomTestCase::Step, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_steps, 0, "The test should run all the steps");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief DuplicateCache TestSuite
+ */
+class DuplicateCacheTestSuite : public TestSuite
+{
+public:
+  DuplicateCacheTestSuite ();
+};
+
+DuplicateCacheTestSuite::DuplicateCacheTestSuite ()
+  : TestSuite ("duplicate-cache", UNIT)
+{
+  AddTestCase (new DuplicateCacheIsDuplicateTestCase, TestCase::QUICK);
+  AddTestCase (new DuplicateCacheRandomTestCase, TestCase::QUICK);
+}
+
+static DuplicateCacheTestSuite g_duplicateCacheTestSuite; //!< Static variable for test initialization
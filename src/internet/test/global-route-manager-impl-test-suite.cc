@@ -27,6 +27,7 @@
 #include "ns3/candidate-queue.h"
 #include "ns3/simulator.h"
 #include <cstdlib> // for rand()
+#include <vector>
 
 using namespace ns3;
 
@@ -226,6 +227,76 @@ GlobalRouteManagerImplTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Candidate Queue ordering and decrease-key Test
+ */
+class CandidateQueueTestCase : public TestCase
+{
+public:
+  CandidateQueueTestCase ();
+  virtual void DoRun (void);
+};
+
+CandidateQueueTestCase::CandidateQueueTestCase ()
+  : TestCase ("CandidateQueue ordering and decrease-key")
+{
+}
+
+void
+CandidateQueueTestCase::DoRun (void)
+{
+  CandidateQueue candidate;
+  std::vector<SPFVertex *> vertices;
+  for (uint32_t i = 0; i < 50; ++i)
+    {
+      SPFVertex *v = new SPFVertex;
+      v->SetVertexId (Ipv4Address (i + 1));
+      v->SetVertexType (i % 3 ? SPFVertex::VertexRouter : SPFVertex::VertexNetwork);
+      v->SetDistanceFromRoot (100 + (i * 7) % 20);
+      candidate.Push (v);
+      vertices.push_back (v);
+    }
+  NS_TEST_ASSERT_MSG_EQ (candidate.Size (), 50, "Wrong queue size");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Find (Ipv4Address (10)), vertices[9], "Vertex not found");
+
+  // lower some distances, as SPFNext () does
+  for (uint32_t i = 0; i < 50; i += 5)
+    {
+      SPFVertex *v = candidate.Find (Ipv4Address (i + 1));
+      v->SetDistanceFromRoot (v->GetDistanceFromRoot () - 10 - i % 4);
+      candidate.DecreaseKey (v);
+    }
+  NS_TEST_ASSERT_MSG_EQ (candidate.Top (), vertices[0], "Wrong top of queue");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Top ()->GetDistanceFromRoot (), 90, "Wrong distance at top of queue");
+
+  SPFVertex *previous = 0;
+  while (!candidate.Empty ())
+    {
+      SPFVertex *v = candidate.Pop ();
+      if (previous)
+        {
+          bool ordered = previous->GetDistanceFromRoot () <= v->GetDistanceFromRoot ();
+          NS_TEST_EXPECT_MSG_EQ (ordered, true, "Vertices popped out of order");
+          if (previous->GetDistanceFromRoot () == v->GetDistanceFromRoot ())
+            {
+              ordered = previous->GetVertexType () == SPFVertex::VertexNetwork
+                || v->GetVertexType () == SPFVertex::VertexRouter;
+              NS_TEST_EXPECT_MSG_EQ (ordered, true,
+                                     "Network vertex popped after router vertex at equal distance");
+            }
+        }
+      NS_TEST_EXPECT_MSG_EQ (candidate.Find (v->GetVertexId ()), 0, "Popped vertex still found");
+      previous = v;
+    }
+  for (uint32_t i = 0; i < vertices.size (); ++i)
+    {
+      delete vertices[i];
+    }
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -243,6 +314,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite ()
   : TestSuite ("global-route-manager-impl", UNIT)
 {
   AddTestCase (new GlobalRouteManagerImplTestCase (), TestCase::QUICK);
+  AddTestCase (new CandidateQueueTestCase (), TestCase::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite g_globalRoutingManagerImplTestSuite; //!< Static variable for test initialization
@@ -15,6 +15,8 @@
  */
 
 #include <vector>
+#include <sstream>
+#include <algorithm>
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/inet-socket-address.h"
@@ -1244,6 +1246,192 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting incremental update test
+ *
+ * A mesh of routers, a LAN, a stub network and a stub router go through a
+ * series of interface and metric changes.  The routes computed by
+ * UpdateRoutingTables () after each change must be the same as the ones
+ * computed from scratch by RecomputeRoutingTables ().
+ *
+ *   n6 -- n5 ==LAN== n2, n4 (10.1.9.0/24)
+ *   n0 -- n1 -- n2 -- n3 -- n0, n1 -- n3, n0 -- n4, n4 stub 172.16.4.0/24
+ */
+class Ipv4GlobalRoutingIncrementalTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingIncrementalTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Build the topology, apply the changes and gather the routes.
+   * \param incremental Whether to use UpdateRoutingTables ().
+   * \returns The sorted routes of all the nodes, after each change.
+   */
+  std::vector<std::string> RunChanges (bool incremental);
+
+  /**
+   * \brief Print the sorted routes of all the nodes.
+   * \param nodes The nodes.
+   * \returns The routes.
+   */
+  std::string GetRoutes (NodeContainer nodes);
+};
+
+Ipv4GlobalRoutingIncrementalTestCase::Ipv4GlobalRoutingIncrementalTestCase ()
+  : TestCase ("Incremental update of the global routes")
+{
+}
+
+std::string
+Ipv4GlobalRoutingIncrementalTestCase::GetRoutes (NodeContainer nodes)
+{
+  std::ostringstream oss;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<Ipv4GlobalRouting> routing = nodes.Get (i)->GetObject<Ipv4L3Protocol> ()
+        ->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      std::vector<std::string> routes;
+      for (uint32_t j = 0; j < routing->GetNRoutes (); j++)
+        {
+          Ipv4RoutingTableEntry *route = routing->GetRoute (j);
+          std::ostringstream entry;
+          entry << route->GetDest () << "/" << route->GetDestNetworkMask ()
+                << " gw " << route->GetGateway () << " if " << route->GetInterface ();
+          routes.push_back (entry.str ());
+        }
+      std::sort (routes.begin (), routes.end ());
+      oss << "n" << i << ":";
+      for (uint32_t j = 0; j < routes.size (); j++)
+        {
+          oss << " [" << routes[j] << "]";
+        }
+      oss << std::endl;
+    }
+  return oss.str ();
+}
+
+std::vector<std::string>
+Ipv4GlobalRoutingIncrementalTestCase::RunChanges (bool incremental)
+{
+  NodeContainer nodes;
+  nodes.Create (7);
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (nodes);
+
+  SimpleNetDeviceHelper p2pHelper;
+  p2pHelper.SetNetDevicePointToPointMode (true);
+  Ipv4AddressHelper ipv4;
+  uint32_t links[][2] = { {0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 3}, {0, 4}, {5, 6} };
+  std::vector<NetDeviceContainer> devices;
+  for (uint32_t i = 0; i < sizeof (links) / sizeof (links[0]); i++)
+    {
+      NetDeviceContainer net = p2pHelper.Install (NodeContainer (nodes.Get (links[i][0]), nodes.Get (links[i][1])));
+      std::ostringstream base;
+      base << "10.1." << i + 1 << ".0";
+      ipv4.SetBase (base.str ().c_str (), "255.255.255.252");
+      ipv4.Assign (net);
+      devices.push_back (net);
+    }
+
+  SimpleNetDeviceHelper lanHelper;
+  NetDeviceContainer lan = lanHelper.Install (NodeContainer (nodes.Get (2), nodes.Get (4), nodes.Get (5)));
+  ipv4.SetBase ("10.1.9.0", "255.255.255.0");
+  ipv4.Assign (lan);
+  NetDeviceContainer stub = lanHelper.Install (nodes.Get (4));
+  ipv4.SetBase ("172.16.4.0", "255.255.255.0");
+  ipv4.Assign (stub);
+
+  if (incremental)
+    {
+      Ipv4GlobalRoutingHelper::UpdateRoutingTables ();
+    }
+  else
+    {
+      Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+    }
+
+  std::vector<std::string> routes;
+  routes.push_back (GetRoutes (nodes));
+
+  Ptr<Ipv4> ipv4n0 = nodes.Get (0)->GetObject<Ipv4> ();
+  Ptr<Ipv4> ipv4n1 = nodes.Get (1)->GetObject<Ipv4> ();
+  Ptr<Ipv4> ipv4n2 = nodes.Get (2)->GetObject<Ipv4> ();
+  int32_t n1n2 = ipv4n1->GetInterfaceForDevice (devices[1].Get (0));
+  int32_t n2n1 = ipv4n2->GetInterfaceForDevice (devices[1].Get (1));
+  int32_t n0n3 = ipv4n0->GetInterfaceForDevice (devices[3].Get (1));
+  int32_t n2lan = ipv4n2->GetInterfaceForDevice (lan.Get (0));
+
+  for (uint32_t step = 0; step < 8; step++)
+    {
+      switch (step)
+        {
+        case 0:
+          ipv4n1->SetDown (n1n2);
+          break;
+        case 1:
+          ipv4n0->SetMetric (n0n3, 5);
+          break;
+        case 2:
+          ipv4n1->SetUp (n1n2);
+          break;
+        case 3:
+          ipv4n2->SetDown (n2lan);
+          break;
+        case 4:
+          // no change
+          break;
+        case 5:
+          ipv4n2->SetUp (n2lan);
+          ipv4n2->SetDown (n2n1);
+          break;
+        case 6:
+          ipv4n0->SetMetric (n0n3, 1);
+          break;
+        case 7:
+          ipv4n2->SetUp (n2n1);
+          break;
+        }
+      if (incremental)
+        {
+          Ipv4GlobalRoutingHelper::UpdateRoutingTables ();
+        }
+      else
+        {
+          Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+        }
+      routes.push_back (GetRoutes (nodes));
+    }
+
+  Simulator::Destroy ();
+  return routes;
+}
+
+void
+Ipv4GlobalRoutingIncrementalTestCase::DoRun (void)
+{
+  std::vector<std::string> expected = RunChanges (false);
+  std::vector<std::string> routes = RunChanges (true);
+
+  NS_TEST_ASSERT_MSG_EQ (routes.size (), expected.size (), "Wrong number of steps");
+  for (uint32_t i = 0; i < routes.size (); i++)
+    {
+      NS_LOG_DEBUG ("Step " << i << std::endl << routes[i]);
+      NS_TEST_EXPECT_MSG_EQ (routes[i], expected[i], "Incremental routes differ from full computation at step " << i);
+    }
+  // the changes have an effect on the routes
+  NS_TEST_EXPECT_MSG_NE (expected[0], expected[1], "Link down did not change the routes");
+  NS_TEST_EXPECT_MSG_NE (expected[1], expected[2], "Metric change did not change the routes");
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1267,6 +1455,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingIncrementalTestCase, TestCase::QUICK);
   }
 
 static Ipv4GlobalRoutingTestSuite g_globalRoutingTestSuite; //!< Static variable for test initialization
@@ -35,6 +35,8 @@
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/socket-factory.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
 
 using namespace ns3;
 
@@ -201,6 +203,88 @@ Ipv4StaticRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting route selection Test
+ *
+ * Check that the longest prefix is selected, then the lowest metric, and
+ * that removed routes are no longer selected.
+ */
+class Ipv4StaticRoutingSelectionTestCase : public TestCase
+{
+public:
+  Ipv4StaticRoutingSelectionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Get the gateway of the route selected for a destination.
+   * \param routing The static routing.
+   * \param destination The destination address.
+   * \return The gateway, or 255.255.255.255 if there is no route.
+   */
+  Ipv4Address GetGateway (Ptr<Ipv4StaticRouting> routing, std::string destination);
+};
+
+Ipv4StaticRoutingSelectionTestCase::Ipv4StaticRoutingSelectionTestCase ()
+  : TestCase ("Static routing route selection")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingSelectionTestCase::GetGateway (Ptr<Ipv4StaticRouting> routing, std::string destination)
+{
+  Ipv4Header header;
+  header.SetDestination (Ipv4Address (destination.c_str ()));
+  Socket::SocketErrno error;
+  Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, error);
+  return route != 0 ? route->GetGateway () : Ipv4Address::GetBroadcast ();
+}
+
+void
+Ipv4StaticRoutingSelectionTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (3);
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  SimpleNetDeviceHelper devHelper;
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("192.168.1.0", "255.255.255.0");
+  ipv4.Assign (devHelper.Install (NodeContainer (nodes.Get (0), nodes.Get (1))));
+  ipv4.SetBase ("192.168.2.0", "255.255.255.0");
+  ipv4.Assign (devHelper.Install (NodeContainer (nodes.Get (0), nodes.Get (2))));
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> routing = ipv4RoutingHelper.GetStaticRouting (nodes.Get (0)->GetObject<Ipv4> ());
+  routing->AddNetworkRouteTo (Ipv4Address ("10.0.0.0"), Ipv4Mask ("/8"), Ipv4Address ("192.168.1.2"), 1);
+  routing->AddNetworkRouteTo (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), Ipv4Address ("192.168.1.2"), 1, 5);
+  routing->AddNetworkRouteTo (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), Ipv4Address ("192.168.2.2"), 2, 1);
+  routing->AddHostRouteTo (Ipv4Address ("10.1.2.3"), Ipv4Address ("192.168.1.2"), 1, 10);
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.2.3"), Ipv4Address ("192.168.1.2"), "The host route should be selected");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.9.9"), Ipv4Address ("192.168.2.2"), "The route with the lowest metric should be selected");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.2.0.1"), Ipv4Address ("192.168.1.2"), "The /8 route should be selected");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "11.0.0.1"), Ipv4Address::GetBroadcast (), "There should be no route");
+
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      if (routing->GetRoute (i).GetGateway () == Ipv4Address ("192.168.2.2"))
+        {
+          routing->RemoveRoute (i);
+          break;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.9.9"), Ipv4Address ("192.168.1.2"), "The removed route should not be selected");
+
+  routing->SetDefaultRoute (Ipv4Address ("192.168.2.2"), 2);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "11.0.0.1"), Ipv4Address ("192.168.2.2"), "The default route should be selected");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -217,6 +301,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite ()
   : TestSuite ("ipv4-static-routing", UNIT)
 {
   AddTestCase (new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4StaticRoutingSelectionTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite ipv4StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/prefix-trie.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie IPv4 Test
+ */
+class PrefixTrieIpv4TestCase : public TestCase
+{
+public:
+  PrefixTrieIpv4TestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Insert a value.
+   * \param address The destination address.
+   * \param mask The destination mask.
+   * \param value The value.
+   */
+  void Insert (std::string address, std::string mask, uint32_t value);
+  /**
+   * \brief Remove a value.
+   * \param address The destination address.
+   * \param mask The destination mask.
+   * \param value The value.
+   * \return True if the value was removed.
+   */
+  bool Remove (std::string address, std::string mask, uint32_t value);
+  /**
+   * \brief Look up an address.
+   * \param address The address.
+   * \return The matching values, separated by spaces.
+   */
+  std::string Lookup (std::string address);
+
+  PrefixTrie<uint32_t, 4> m_trie; //!< The trie
+};
+
+PrefixTrieIpv4TestCase::PrefixTrieIpv4TestCase ()
+  : TestCase ("PrefixTrie with IPv4 prefixes")
+{
+}
+
+void
+PrefixTrieIpv4TestCase::Insert (std::string address, std::string mask, uint32_t value)
+{
+  uint8_t a[4];
+  uint8_t m[4];
+  Ipv4Address (address.c_str ()).Serialize (a);
+  Ipv4Address (Ipv4Mask (mask.c_str ()).Get ()).Serialize (m);
+  m_trie.Insert (a, m, value);
+}
+
+bool
+PrefixTrieIpv4TestCase::Remove (std::string address, std::string mask, uint32_t value)
+{
+  uint8_t a[4];
+  uint8_t m[4];
+  Ipv4Address (address.c_str ()).Serialize (a);
+  Ipv4Address (Ipv4Mask (mask.c_str ()).Get ()).Serialize (m);
+  return m_trie.Remove (a, m, value);
+}
+
+std::string
+PrefixTrieIpv4TestCase::Lookup (std::string address)
+{
+  uint8_t a[4];
+  Ipv4Address (address.c_str ()).Serialize (a);
+  std::vector<uint32_t> matches;
+  m_trie.Lookup (a, matches);
+  std::ostringstream oss;
+  for (std::vector<uint32_t>::const_iterator i = matches.begin (); i != matches.end (); i++)
+    {
+      oss << (i == matches.begin () ? "" : " ") << *i;
+    }
+  return oss.str ();
+}
+
+void
+PrefixTrieIpv4TestCase::DoRun (void)
+{
+  Insert ("10.0.0.0", "/8", 1);
+  Insert ("10.1.0.0", "/16", 2);
+  Insert ("0.0.0.0", "/0", 3);
+  Insert ("10.1.2.3", "/32", 4);
+  Insert ("10.1.0.0", "/16", 5);
+  // A mask which is not contiguous, matching 10.x.2.x
+  Insert ("10.0.2.0", "255.0.255.0", 6);
+  Insert ("11.0.0.0", "/8", 7);
+  // The host bits are ignored
+  Insert ("10.200.1.1", "/9", 8);
+  NS_TEST_EXPECT_MSG_EQ (m_trie.GetSize (), 8, "Unexpected size");
+
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.3"), "1 2 3 4 5 6", "Matches should be in insertion order");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.4"), "1 2 3 5 6", "Unexpected matches");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.200.0.1"), "1 3 8", "Unexpected matches");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("11.1.2.3"), "3 7", "Unexpected matches");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("12.0.0.1"), "3", "Only the default prefix should match");
+
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.1.0.0", "/16", 2), true, "The value should be removed");
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.1.0.0", "/16", 2), false, "The value was already removed");
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.1.0.0", "/24", 5), false, "The value was inserted with another mask");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.3"), "1 3 4 5 6", "Unexpected matches after removal");
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.0.0.0", "/8", 1), true, "The value should be removed");
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.1.2.3", "/32", 4), true, "The value should be removed");
+  NS_TEST_EXPECT_MSG_EQ (Remove ("10.0.2.0", "255.0.255.0", 6), true, "The value should be removed");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.3"), "3 5", "Unexpected matches after removal");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.255.0.1"), "3 8", "Unexpected matches after removal");
+
+  Insert ("10.1.2.0", "/24", 9);
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.3"), "3 5 9", "Unexpected matches after insertion");
+  NS_TEST_EXPECT_MSG_EQ (m_trie.GetSize (), 5, "Unexpected size");
+
+  m_trie.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (m_trie.GetSize (), 0, "The trie should be empty");
+  NS_TEST_EXPECT_MSG_EQ (Lookup ("10.1.2.3"), "", "There should be no match");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie IPv6 Test
+ */
+class PrefixTrieIpv6TestCase : public TestCase
+{
+public:
+  PrefixTrieIpv6TestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PrefixTrieIpv6TestCase::PrefixTrieIpv6TestCase ()
+  : TestCase ("PrefixTrie with IPv6 prefixes")
+{
+}
+
+void
+PrefixTrieIpv6TestCase::DoRun (void)
+{
+  PrefixTrie<uint32_t, 16> trie;
+  const char *prefixes[] = {"2001:db8::", "2001:db8::1", "2001:db8:0:1::", "::"};
+  uint8_t lengths[] = {32, 128, 64, 0};
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      uint8_t address[16];
+      uint8_t prefix[16];
+      Ipv6Address (prefixes[i]).GetBytes (address);
+      Ipv6Prefix (lengths[i]).GetBytes (prefix);
+      trie.Insert (address, prefix, i);
+    }
+
+  uint8_t address[16];
+  std::vector<uint32_t> matches;
+  Ipv6Address ("2001:db8::1").GetBytes (address);
+  trie.Lookup (address, matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 3, "Unexpected number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches.back (), 3, "Matches should be in insertion order");
+
+  matches.clear ();
+  Ipv6Address ("2001:db8:0:1::5").GetBytes (address);
+  trie.Lookup (address, matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 3, "Unexpected number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches[1], 2, "The /64 prefix should match");
+
+  matches.clear ();
+  Ipv6Address ("2001:db9::1").GetBytes (address);
+  trie.Lookup (address, matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 1, "Only the default prefix should match");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+public:
+  PrefixTrieTestSuite ();
+};
+
+PrefixTrieTestSuite::PrefixTrieTestSuite ()
+  : TestSuite ("prefix-trie", UNIT)
+{
+  AddTestCase (new PrefixTrieIpv4TestCase, TestCase::QUICK);
+  AddTestCase (new PrefixTrieIpv6TestCase, TestCase::QUICK);
+}
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,402 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/lte-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-module.h"
+#include <fstream>
+#include <cmath>
+#include <sys/resource.h>
+
+/*
+This example is a performance benchmark of the out-of-coverage Sidelink
+procedures. UEs are uniformly dropped in a disc whose radius is derived from
+the requested UE density, and one of the following scenarios is simulated:
+- comm: all the UEs transmit on the PSCCH/PSSCH of a UE selected pool
+- disc: all the UEs announce and monitor discovery messages on the PSDCH
+- sync: same as comm, with the SLSS transmission and the SyncRef selection
+        procedures enabled on unsynchronized UEs
+At the end of the simulation, a JSON record with the setup and run wall clock
+times, the number of executed events, the event rate, the peak resident set
+size and some reception statistics is printed and appended to the output file,
+so regressions can be tracked across versions. See lte-sl-benchmark.sh to
+sweep the number of UEs, the density and the pool configuration.
+Parameters include:
+- scenario: comm, disc or sync
+- ueCount: number of UEs
+- density: number of UEs per square kilometer
+- period: duration of the Sidelink period (comm and sync)
+- pscchLength: length of the PSCCH in subframes (comm and sync)
+- ktrp: repetition pattern of the PSSCH (comm and sync)
+- rbSize: PSSCH allocation size in RBs (comm and sync)
+- mcs: PSSCH modulation and coding scheme (comm and sync)
+- discPeriod: discovery period in frames (disc)
+- discTxProb: discovery transmission probability in percent (disc)
+- discMonitored: number of application codes monitored per UE (disc)
+- simTime: simulation time in seconds
+- output: name of the file where the JSON record is appended
+The time spent per type of event is reported by enabling the simulator
+profiling, e.g., with --ns3::DefaultSimulatorImpl::Profiling=true.
+*/
+
+NS_LOG_COMPONENT_DEFINE ("LteSlBenchmark");
+
+using namespace ns3;
+
+/**
+ * Reception statistics collected during the benchmark
+ */
+struct BenchmarkStats
+{
+  uint64_t psschTbs; ///< number of PSSCH TBs received
+  uint64_t psschTbsOk; ///< number of PSSCH TBs correctly decoded
+  uint64_t pscchTbs; ///< number of PSCCH TBs received
+  uint64_t pscchTbsOk; ///< number of PSCCH TBs correctly decoded
+  uint64_t discoveryRx; ///< number of discovery messages monitored
+  uint64_t syncRefChanges; ///< number of changes of SyncRef
+};
+
+static BenchmarkStats g_stats = {0, 0, 0, 0, 0, 0};
+
+void
+SlPhyReception (PhyReceptionStatParameters params)
+{
+  g_stats.psschTbs++;
+  g_stats.psschTbsOk += params.m_correctness;
+}
+
+void
+SlPscchReception (SlPhyReceptionStatParameters params)
+{
+  g_stats.pscchTbs++;
+  g_stats.pscchTbsOk += params.m_correctness;
+}
+
+void
+DiscoveryMonitoring (uint64_t imsi, uint16_t cellId, uint16_t rnti, uint32_t proSeAppCode)
+{
+  g_stats.discoveryRx++;
+}
+
+void
+SlStartDiscovery (Ptr<LteHelper> helper, Ptr<NetDevice> ue, std::list<uint32_t> apps, bool rxtx)
+{
+  helper->StartDiscovery (ue, apps, rxtx);
+}
+
+void
+ChangeOfSyncRef (LteUeRrc::SlChangeOfSyncRefStatParameters param)
+{
+  g_stats.syncRefChanges++;
+}
+
+/**
+ * \return the peak resident set size of the process in kilobytes
+ */
+static uint64_t
+GetPeakRssKb (void)
+{
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string scenario = "comm"; // Benchmarked procedure
+  uint32_t ueCount = 100; // Number of UEs
+  double density = 100; // Number of UEs per square kilometer
+  std::string period = "sf40"; // Length of Sidelink period in milliseconds
+  uint32_t pscchLength = 8; // Number of PSCCH subframes
+  uint32_t ktrp = 2; // Transmissions opportunities in a Time Repetition Pattern
+  uint32_t rbSize = 2; // PSSCH subchannel allocation size in RBs
+  uint32_t mcs = 10; // Modulation and Coding Scheme
+  uint32_t discPeriod = 32; // Discovery period in frames
+  uint32_t discTxProb = 100; // Discovery transmission probability in percent
+  uint32_t discMonitored = 10; // Number of application codes monitored per UE
+  double simTime = 5.0; // Simulation time in seconds
+  std::string output = "lte-sl-benchmark.json";
+
+  CommandLine cmd;
+  cmd.AddValue ("scenario", "Benchmarked procedure: comm, disc or sync", scenario);
+  cmd.AddValue ("ueCount", "Number of UEs", ueCount);
+  cmd.AddValue ("density", "Number of UEs per square kilometer", density);
+  cmd.AddValue ("period", "Sidelink period", period);
+  cmd.AddValue ("pscchLength", "Length of PSCCH", pscchLength);
+  cmd.AddValue ("ktrp", "Repetition", ktrp);
+  cmd.AddValue ("rbSize", "PSSCH allocation size", rbSize);
+  cmd.AddValue ("mcs", "PSSCH MCS", mcs);
+  cmd.AddValue ("discPeriod", "Discovery period in frames (32, 64, 128, 256, 512 or 1024)", discPeriod);
+  cmd.AddValue ("discTxProb", "Discovery transmission probability (25, 50, 75 or 100)", discTxProb);
+  cmd.AddValue ("discMonitored", "Number of application codes monitored per UE", discMonitored);
+  cmd.AddValue ("simTime", "Simulation time", simTime);
+  cmd.AddValue ("output", "Name of the file where the JSON record is appended", output);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (scenario != "comm" && scenario != "disc" && scenario != "sync",
+                   "Unknown scenario " << scenario);
+  bool comm = (scenario != "disc");
+  bool sync = (scenario == "sync");
+  double radius = std::sqrt (ueCount / (M_PI * density)) * 1000;
+
+  SystemWallClockMs setupClock;
+  setupClock.Start ();
+
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlCtrlErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlDataErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlDiscoveryErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DropRbOnCollisionEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantMcs", UintegerValue (mcs));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantSize", UintegerValue (rbSize));
+  Config::SetDefault ("ns3::LteUeMac::Ktrp", UintegerValue (ktrp));
+  Config::SetDefault ("ns3::LteUePhy::TxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::Pcmax", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PscchTxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PsschTxPower", DoubleValue (23.0));
+  if (sync)
+    {
+      Config::SetDefault ("ns3::LteUeRrc::UeSlssTransmissionEnabled", BooleanValue (true));
+      Config::SetDefault ("ns3::LteUePhy::UeRandomInitialSubframeIndication", BooleanValue (true));
+      Config::SetDefault ("ns3::LteUePhy::UeSlssInterScanningPeriodMax", TimeValue (MilliSeconds (2000)));
+      Config::SetDefault ("ns3::LteUePhy::UeSlssInterScanningPeriodMin", TimeValue (MilliSeconds (2000)));
+      Config::SetDefault ("ns3::LteUeRrc::MinSrsrp", DoubleValue (-125));
+      Config::SetDefault ("ns3::LteUePhy::MinSrsrp", DoubleValue (-125));
+    }
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetAttribute ("UseSidelink", BooleanValue (true));
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisPropagationLossModel"));
+  lteHelper->DisableEnbPhy (true);
+  lteHelper->Initialize ();
+
+  // Frequency for Public Safety use case (band 14 : 788 - 798 MHz for Uplink)
+  double ulFreq = LteSpectrumValueHelper::GetCarrierFrequency (23330);
+  lteHelper->GetUplinkPathlossModel ()->SetAttribute ("Frequency", DoubleValue (ulFreq));
+
+  Ptr<LteSidelinkHelper> proseHelper = CreateObject<LteSidelinkHelper> ();
+  proseHelper->SetLteHelper (lteHelper);
+
+  NodeContainer ueNodes;
+  ueNodes.Create (ueCount);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "rho", DoubleValue (radius),
+                                 "Z", DoubleValue (1.5));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  Ptr<LteSlUeRrc> ueSidelinkConfiguration = CreateObject<LteSlUeRrc> ();
+  LteRrcSap::SlPreconfiguration preconfiguration;
+  preconfiguration.preconfigGeneral.carrierFreq = 23330;
+  preconfiguration.preconfigGeneral.slBandwidth = 50;
+
+  if (comm)
+    {
+      InternetStackHelper internet;
+      internet.Install (ueNodes);
+      epcHelper->AssignUeIpv4Address (ueDevs);
+      Ipv4StaticRoutingHelper ipv4RoutingHelper;
+      for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+        {
+          Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (u)->GetObject<Ipv4> ());
+          ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+        }
+      lteHelper->Attach (ueDevs);
+
+      Ipv4Address groupAddress ("225.0.0.0");
+      UdpClientHelper udpClient (groupAddress, 8000);
+      udpClient.SetAttribute ("MaxPackets", UintegerValue (5000000));
+      udpClient.SetAttribute ("Interval", TimeValue (MilliSeconds (40)));
+      udpClient.SetAttribute ("PacketSize", UintegerValue (200));
+      ApplicationContainer clientApps = udpClient.Install (ueNodes);
+      clientApps.Start (Seconds (1.5));
+
+      uint32_t groupL2Address = 0xFF;
+      Ptr<LteSlTft> tft = Create<LteSlTft> (LteSlTft::BIDIRECTIONAL, groupAddress, groupL2Address);
+      proseHelper->ActivateSidelinkBearer (Seconds (1.0), ueDevs, tft);
+
+      ueSidelinkConfiguration->SetSlEnabled (true);
+      preconfiguration.preconfigComm.nbPools = 1;
+      LteSlPreconfigPoolFactory pfactory;
+      uint64_t pscchBitmapValue = 0x0;
+      for (uint32_t i = 0; i < pscchLength; i++)
+        {
+          pscchBitmapValue = pscchBitmapValue << 1 | 0x1;
+        }
+      pfactory.SetControlBitmap (pscchBitmapValue);
+      pfactory.SetControlPeriod (period);
+      pfactory.SetDataOffset (pscchLength);
+      preconfiguration.preconfigComm.pools[0] = pfactory.CreatePool ();
+      if (sync)
+        {
+          preconfiguration.preconfigSync.syncOffsetIndicator1 = 18;
+          preconfiguration.preconfigSync.syncOffsetIndicator2 = 29;
+          preconfiguration.preconfigSync.syncTxThreshOoC = -60;
+          preconfiguration.preconfigSync.syncRefDiffHyst = 0;
+          preconfiguration.preconfigSync.syncRefMinHyst = 0;
+          preconfiguration.preconfigSync.filterCoefficient = 0;
+        }
+    }
+  else
+    {
+      ueSidelinkConfiguration->SetDiscEnabled (true);
+      preconfiguration.preconfigDisc.nbPools = 1;
+      preconfiguration.preconfigDisc.pools[0].cpLen.cplen = LteRrcSap::SlCpLen::NORMAL;
+      preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf32;
+      switch (discPeriod)
+        {
+        case 32: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf32; break;
+        case 64: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf64; break;
+        case 128: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf128; break;
+        case 256: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf256; break;
+        case 512: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf512; break;
+        case 1024: preconfiguration.preconfigDisc.pools[0].discPeriod.period = LteRrcSap::SlPeriodDisc::rf1024; break;
+        default: NS_FATAL_ERROR ("Invalid discovery period " << discPeriod);
+        }
+      preconfiguration.preconfigDisc.pools[0].numRetx = 0;
+      preconfiguration.preconfigDisc.pools[0].numRepetition = 1;
+      preconfiguration.preconfigDisc.pools[0].tfResourceConfig.prbNum = 10;
+      preconfiguration.preconfigDisc.pools[0].tfResourceConfig.prbStart = 10;
+      preconfiguration.preconfigDisc.pools[0].tfResourceConfig.prbEnd = 49;
+      preconfiguration.preconfigDisc.pools[0].tfResourceConfig.offsetIndicator.offset = 0;
+      preconfiguration.preconfigDisc.pools[0].tfResourceConfig.subframeBitmap.bitmap = std::bitset<40> (0x11111);
+      preconfiguration.preconfigDisc.pools[0].txParameters.txParametersGeneral.alpha = LteRrcSap::SlTxParameters::al09;
+      preconfiguration.preconfigDisc.pools[0].txParameters.txParametersGeneral.p0 = -40;
+      preconfiguration.preconfigDisc.pools[0].txParameters.txProbability = SidelinkDiscResourcePool::TxProbabilityFromInt (discTxProb);
+    }
+  ueSidelinkConfiguration->SetSlPreconfiguration (preconfiguration);
+  lteHelper->InstallSidelinkConfiguration (ueDevs, ueSidelinkConfiguration);
+
+  Ptr<UniformRandomVariable> rndSlssid = CreateObject<UniformRandomVariable> ();
+  rndSlssid->SetAttribute ("Min", DoubleValue (100000.0));
+  rndSlssid->SetAttribute ("Max", DoubleValue (200000.0));
+  Ptr<UniformRandomVariable> rndStartScanning = CreateObject<UniformRandomVariable> ();
+  rndStartScanning->SetAttribute ("Min", DoubleValue (2000));
+  rndStartScanning->SetAttribute ("Max", DoubleValue (4000));
+
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<LteUeNetDevice> ueDev = ueDevs.Get (i)->GetObject<LteUeNetDevice> ();
+      Ptr<LteUePhy> uePhy = ueDev->GetPhy ();
+      if (comm)
+        {
+          uePhy->GetSlSpectrumPhy ()->TraceConnectWithoutContext ("SlPhyReception", MakeCallback (&SlPhyReception));
+          uePhy->GetSlSpectrumPhy ()->TraceConnectWithoutContext ("SlPscchReception", MakeCallback (&SlPscchReception));
+        }
+      else
+        {
+          ueDev->GetRrc ()->TraceConnectWithoutContext ("DiscoveryMonitoring", MakeCallback (&DiscoveryMonitoring));
+          // Announce the application code i + 1 and monitor the ones of the next UEs
+          std::list<uint32_t> announceApps;
+          announceApps.push_back (i + 1);
+          std::list<uint32_t> monitorApps;
+          for (uint32_t j = 1; j <= std::min (discMonitored, ueCount - 1); ++j)
+            {
+              monitorApps.push_back ((i + j) % ueCount + 1);
+            }
+          Simulator::Schedule (Seconds (2.0), &SlStartDiscovery, lteHelper, ueDevs.Get (i), announceApps, true);
+          Simulator::Schedule (Seconds (2.0), &SlStartDiscovery, lteHelper, ueDevs.Get (i), monitorApps, false);
+        }
+      if (sync)
+        {
+          ueDev->GetRrc ()->SetSlssid (rndSlssid->GetInteger ());
+          uePhy->SetFirstScanningTime (MilliSeconds (rndStartScanning->GetInteger ()));
+          ueDev->GetRrc ()->TraceConnectWithoutContext ("ChangeOfSyncRef", MakeCallback (&ChangeOfSyncRef));
+        }
+    }
+
+  int64_t setupTime = setupClock.End ();
+
+  SystemWallClockMs runClock;
+  runClock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t runTime = runClock.End ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  std::ostringstream json;
+  json << "{\"scenario\": \"" << scenario << "\""
+       << ", \"ueCount\": " << ueCount
+       << ", \"density\": " << density
+       << ", \"radius\": " << radius
+       << ", \"simTime\": " << simTime;
+  if (comm)
+    {
+      json << ", \"pool\": {\"period\": \"" << period << "\""
+           << ", \"pscchLength\": " << pscchLength
+           << ", \"ktrp\": " << ktrp
+           << ", \"rbSize\": " << rbSize
+           << ", \"mcs\": " << mcs << "}";
+    }
+  else
+    {
+      json << ", \"pool\": {\"discPeriod\": " << discPeriod
+           << ", \"discTxProb\": " << discTxProb
+           << ", \"discMonitored\": " << discMonitored << "}";
+    }
+  json << ", \"setupTimeMs\": " << setupTime
+       << ", \"runTimeMs\": " << runTime
+       << ", \"events\": " << events
+       << ", \"eventsPerSecond\": " << (runTime > 0 ? events * 1000.0 / runTime : 0.0)
+       << ", \"peakRssKb\": " << GetPeakRssKb ()
+       << ", \"stats\": {\"psschTbs\": " << g_stats.psschTbs
+       << ", \"psschTbsOk\": " << g_stats.psschTbsOk
+       << ", \"pscchTbs\": " << g_stats.pscchTbs
+       << ", \"pscchTbsOk\": " << g_stats.pscchTbsOk
+       << ", \"discoveryRx\": " << g_stats.discoveryRx
+       << ", \"syncRefChanges\": " << g_stats.syncRefChanges << "}"
+       << "}";
+
+  std::cout << json.str () << std::endl;
+  std::ofstream outFile (output.c_str (), std::ofstream::out | std::ofstream::app);
+  outFile << json.str () << std::endl;
+  outFile.close ();
+
+  return 0;
+}
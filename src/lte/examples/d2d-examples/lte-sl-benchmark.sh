@@ -0,0 +1,99 @@
+#! /bin/bash
+
+ #/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+ #
+ # NIST-developed software is provided by NIST as a public
+ # service. You may use, copy and distribute copies of the software in
+ # any medium, provided that you keep intact this entire notice. You
+ # may improve, modify and create derivative works of the software or
+ # any portion of the software, and you may copy and distribute such
+ # modifications or works. Modified works should carry a notice
+ # stating that you changed the software and should note the date and
+ # nature of any such change. Please explicitly acknowledge the
+ # National Institute of Standards and Technology as the source of the
+ # software.
+ #
+ # NIST-developed software is expressly provided "AS IS." NIST MAKES
+ # NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ # OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ # WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ # NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ # WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ # OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ # WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ # SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ # CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ #
+ # You are solely responsible for determining the appropriateness of
+ # using and distributing the software and you assume all risks
+ # associated with its use, including but not limited to the risks and
+ # costs of program errors, compliance with applicable laws, damage to
+ # or loss of data, programs or equipment, and the unavailability or
+ # interruption of operation. This software is not intended to be used
+ # in any situation where a failure could cause risk of injury or
+ # damage to property. The software developed by NIST employees is not
+ # subject to copyright protection within the United States.
+
+# Sidelink performance benchmark: runs the lte-sl-benchmark example for the
+# communication, discovery and synchronization scenarios while sweeping the
+# number of UEs, the UE density and the pool configuration. Each run appends
+# one JSON record to $Records; the records are gathered in the JSON array
+# $Output at the end. Must be run from the top directory of ns-3.
+
+scenario="lte-sl-benchmark"
+UE_COUNTS="100 1000 10000"
+DENSITIES="100 1000" #UEs per square kilometer
+Time=5 #simulation length
+Records="lte-sl-benchmark-records.json"
+Output="lte-sl-benchmark.json"
+
+if [ -e $Records ] || [ -e $Output ];then
+  echo "ERROR: $Records or $Output already exists. Appending to old results is not allowed!"
+  exit
+fi
+
+function run_comm ()
+{
+    type=$1
+    period=$2
+    pscch=$3
+    mcs=$4
+    ktrp=$5
+    rb=$6
+
+    for ue in $UE_COUNTS
+    do
+      for density in $DENSITIES
+      do
+        echo "Running $type: ueCount=$ue density=$density period=$period pscchLength=$pscch mcs=$mcs ktrp=$ktrp rbSize=$rb"
+        ./waf --run "$scenario --scenario=${type} --ueCount=${ue} --density=${density} --period=${period} --pscchLength=${pscch} --mcs=${mcs} --ktrp=${ktrp} --rbSize=${rb} --simTime=${Time} --output=${Records}" >> /dev/null 2>&1
+      done
+    done
+}
+
+function run_disc ()
+{
+    period=$1
+    txprob=$2
+
+    for ue in $UE_COUNTS
+    do
+      for density in $DENSITIES
+      do
+        echo "Running disc: ueCount=$ue density=$density discPeriod=$period discTxProb=$txprob"
+        ./waf --run "$scenario --scenario=disc --ueCount=${ue} --density=${density} --discPeriod=${period} --discTxProb=${txprob} --simTime=${Time} --output=${Records}" >> /dev/null 2>&1
+      done
+    done
+}
+
+echo "PSCCH/PSSCH"
+run_comm "comm" "sf40" 8 10 2 2
+run_comm "comm" "sf80" 8 12 4 4
+echo "Discovery"
+run_disc 32 100
+run_disc 64 50
+echo "Synchronization"
+run_comm "sync" "sf40" 8 10 2 2
+
+awk 'BEGIN{print "["}{if (NR>1) printf ",\n"; printf "  %s", $0}END{print "\n]"}' $Records > $Output
+echo "Results written in $Output"
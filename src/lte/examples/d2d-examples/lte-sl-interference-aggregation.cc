@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/lte-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-module.h"
+#include <iomanip>
+
+/*
+This example measures the execution time of a dense out-of-coverage Sidelink
+communication scenario with the exact Sidelink interference model and with the
+aggregate interference approximation (LteSlInterference::AggregateWeakSignals),
+in which the signals received below a power floor are only accounted as
+interference and not tracked individually.
+UEs are uniformly dropped in a disc and all of them transmit on the same
+UE-selected pool. The PSSCH packet reception ratio (PRR) over all the links is
+reported along with the wall clock time so both modes can be compared.
+Parameters include:
+- ueCount: number of UEs
+- radius: radius of the disc in which the UEs are dropped (m)
+- aggregate: enable the aggregate interference approximation
+- rxPowerFloor: the RX power floor of the aggregate mode (dBm)
+- simTime: Simulation time in seconds
+*/
+
+NS_LOG_COMPONENT_DEFINE ("LteSlInterferenceAggregation");
+
+using namespace ns3;
+
+static uint64_t g_nTb = 0; ///< number of PSSCH TBs received
+static uint64_t g_nTbOk = 0; ///< number of PSSCH TBs correctly decoded
+
+void
+SlPhyReception (PhyReceptionStatParameters params)
+{
+  g_nTb++;
+  g_nTbOk += params.m_correctness;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueCount = 50; // Number of UEs
+  double radius = 2000; // Radius of the deployment in meters
+  bool aggregate = false; // Enable the aggregate interference approximation
+  double rxPowerFloor = -100; // RX power floor in dBm
+  double simTime = 5.0; // Simulation time in seconds
+
+  CommandLine cmd;
+  cmd.AddValue ("ueCount", "Number of UEs", ueCount);
+  cmd.AddValue ("radius", "Radius of the deployment (m)", radius);
+  cmd.AddValue ("aggregate", "Enable the aggregate interference approximation", aggregate);
+  cmd.AddValue ("rxPowerFloor", "RX power floor of the aggregate mode (dBm)", rxPowerFloor);
+  cmd.AddValue ("simTime", "Simulation time", simTime);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::LteSlInterference::AggregateWeakSignals", BooleanValue (aggregate));
+  Config::SetDefault ("ns3::LteSlInterference::RxPowerFloor", DoubleValue (rxPowerFloor));
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlCtrlErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlDataErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DropRbOnCollisionEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantMcs", UintegerValue (10));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantSize", UintegerValue (2));
+  Config::SetDefault ("ns3::LteUeMac::Ktrp", UintegerValue (2));
+  Config::SetDefault ("ns3::LteUePhy::TxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::Pcmax", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PscchTxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PsschTxPower", DoubleValue (23.0));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetAttribute ("UseSidelink", BooleanValue (true));
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisPropagationLossModel"));
+  lteHelper->DisableEnbPhy (true);
+  lteHelper->Initialize ();
+
+  double ulFreq = LteSpectrumValueHelper::GetCarrierFrequency (23330);
+  lteHelper->GetUplinkPathlossModel ()->SetAttribute ("Frequency", DoubleValue (ulFreq));
+
+  Ptr<LteSidelinkHelper> proseHelper = CreateObject<LteSidelinkHelper> ();
+  proseHelper->SetLteHelper (lteHelper);
+
+  NodeContainer ueNodes;
+  ueNodes.Create (ueCount);
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "rho", DoubleValue (radius),
+                                 "Z", DoubleValue (1.5));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevs);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+  lteHelper->Attach (ueDevs);
+
+  Ipv4Address groupAddress ("225.0.0.0");
+  UdpClientHelper udpClient (groupAddress, 8000);
+  udpClient.SetAttribute ("MaxPackets", UintegerValue (5000000));
+  udpClient.SetAttribute ("Interval", TimeValue (MilliSeconds (40)));
+  udpClient.SetAttribute ("PacketSize", UintegerValue (200));
+  ApplicationContainer clientApps = udpClient.Install (ueNodes);
+  clientApps.Start (Seconds (1.5));
+
+  uint32_t groupL2Address = 0xFF;
+  Ptr<LteSlTft> tft = Create<LteSlTft> (LteSlTft::BIDIRECTIONAL, groupAddress, groupL2Address);
+  proseHelper->ActivateSidelinkBearer (Seconds (1.0), ueDevs, tft);
+
+  Ptr<LteSlUeRrc> ueSidelinkConfiguration = CreateObject<LteSlUeRrc> ();
+  ueSidelinkConfiguration->SetSlEnabled (true);
+  LteRrcSap::SlPreconfiguration preconfiguration;
+  preconfiguration.preconfigGeneral.carrierFreq = 23330;
+  preconfiguration.preconfigGeneral.slBandwidth = 50;
+  preconfiguration.preconfigComm.nbPools = 1;
+  LteSlPreconfigPoolFactory pfactory;
+  pfactory.SetControlBitmap (0xFF);
+  pfactory.SetControlPeriod ("sf40");
+  pfactory.SetDataOffset (8);
+  preconfiguration.preconfigComm.pools[0] = pfactory.CreatePool ();
+  ueSidelinkConfiguration->SetSlPreconfiguration (preconfiguration);
+  lteHelper->InstallSidelinkConfiguration (ueDevs, ueSidelinkConfiguration);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/SlSpectrumPhy/SlPhyReception",
+                                 MakeCallback (&SlPhyReception));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  int64_t elapsed = clock.End ();
+
+  std::cout << "Aggregate interference: " << (aggregate ? "enabled" : "disabled") << std::endl;
+  std::cout << "Wall clock time (ms): " << elapsed << std::endl;
+  std::cout << "PSSCH TBs received: " << g_nTb << std::endl;
+  std::cout << "PSSCH PRR: " << std::setprecision (4) << (g_nTb > 0 ? (double) g_nTbOk / g_nTb : 0.0) << std::endl;
+
+  return 0;
+}
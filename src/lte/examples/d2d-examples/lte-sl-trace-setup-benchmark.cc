@@ -0,0 +1,147 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/lte-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include <iostream>
+
+/*
+This example compares the setup time of the Sidelink trace connections made
+with Config::Connect and wildcard paths, as LteHelper used to do, with the
+one of the LteTraceConnector, which walks the devices of a container.
+ueCount out-of-coverage UEs are installed and the PHY and MAC Sidelink trace
+sources of all the UEs are connected with both methods. The wall clock time
+of each method and the number of connected trace sources are printed as a
+JSON record.
+Parameters include:
+- ueCount: number of UEs
+*/
+
+NS_LOG_COMPONENT_DEFINE ("LteSlTraceSetupBenchmark");
+
+using namespace ns3;
+
+/**
+ * Trace sink of the Sidelink PHY reception traces
+ *
+ * \param context The trace context
+ * \param params The reception parameters
+ */
+void
+PhyReceptionTrace (std::string context, PhyReceptionStatParameters params)
+{
+}
+
+/**
+ * Trace sink of the Sidelink PSCCH reception traces
+ *
+ * \param context The trace context
+ * \param params The reception parameters
+ */
+void
+PscchReceptionTrace (std::string context, SlPhyReceptionStatParameters params)
+{
+}
+
+/**
+ * Trace sink of the Sidelink MAC scheduling traces
+ *
+ * \param context The trace context
+ * \param params The scheduling parameters
+ */
+void
+SchedulingTrace (std::string context, SlUeMacStatParameters params)
+{
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueCount = 1000; // Number of UEs
+
+  CommandLine cmd;
+  cmd.AddValue ("ueCount", "Number of UEs", ueCount);
+  cmd.Parse (argc, argv);
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseSidelink", BooleanValue (true));
+  lteHelper->DisableEnbPhy (true);
+  lteHelper->Initialize ();
+
+  NodeContainer ueNodes;
+  ueNodes.Create (ueCount);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (ueNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  uint32_t configCount = 0;
+  std::string prefix = "/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/";
+  configCount += Config::LookupMatches (prefix + "LteUePhy/SlSpectrumPhy").GetN ();
+  Config::Connect (prefix + "LteUePhy/SlSpectrumPhy/SlPhyReception", MakeCallback (&PhyReceptionTrace));
+  Config::Connect (prefix + "LteUePhy/SlSpectrumPhy/SlPscchReception", MakeCallback (&PscchReceptionTrace));
+  Config::Connect (prefix + "LteUeMac/SlPscchScheduling", MakeCallback (&SchedulingTrace));
+  Config::Connect (prefix + "LteUeMac/SlPsschScheduling", MakeCallback (&SchedulingTrace));
+  int64_t configTime = clock.End ();
+
+  clock.Start ();
+  uint32_t connectorCount = 0;
+  NetDeviceContainer devices = LteTraceConnector::GetUeDevices ();
+  connectorCount += LteTraceConnector::ConnectUe (devices, LteTraceConnector::UE_SL_SPECTRUM_PHY,
+                                                  "SlPhyReception", MakeCallback (&PhyReceptionTrace));
+  LteTraceConnector::ConnectUe (devices, LteTraceConnector::UE_SL_SPECTRUM_PHY,
+                                "SlPscchReception", MakeCallback (&PscchReceptionTrace));
+  LteTraceConnector::ConnectUe (devices, LteTraceConnector::UE_MAC,
+                                "SlPscchScheduling", MakeCallback (&SchedulingTrace));
+  LteTraceConnector::ConnectUe (devices, LteTraceConnector::UE_MAC,
+                                "SlPsschScheduling", MakeCallback (&SchedulingTrace));
+  int64_t connectorTime = clock.End ();
+
+  NS_ABORT_MSG_UNLESS (configCount == connectorCount, "Config::Connect connected " << configCount
+                       << " trace sources, LteTraceConnector " << connectorCount);
+
+  std::cout << "{\"ueCount\": " << ueCount
+            << ", \"connectedPerTrace\": " << connectorCount
+            << ", \"configConnectMs\": " << configTime
+            << ", \"traceConnectorMs\": " << connectorTime
+            << "}" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
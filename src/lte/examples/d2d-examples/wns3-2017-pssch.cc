@@ -139,7 +139,7 @@ main (int argc, char *argv[])
   NS_LOG_LOGIC ("UL freq: " << ulFreq);
   Ptr<Object> uplinkPathlossModel = lteHelper->GetUplinkPathlossModel ();
   Ptr<PropagationLossModel> lossModel = uplinkPathlossModel->GetObject<PropagationLossModel> ();
-  NS_ASSERT_MSG (lossModel > 0, "No PathLossModel");
+  NS_ASSERT_MSG (lossModel != 0, "No PathLossModel");
   bool ulFreqOk = uplinkPathlossModel->SetAttributeFailSafe ("Frequency", DoubleValue (ulFreq));
   if (!ulFreqOk)
     {
@@ -540,7 +540,7 @@ int main (int argc, char *argv[])
   Ptr<Object> downlinkPathlossModel = lteHelper->GetDownlinkPathlossModel ();
   Ptr<PropagationLossModel> lossModel = downlinkPathlossModel->GetObject<PropagationLossModel> ();
 
-  NS_ASSERT_MSG (lossModel > 0, "No PathLossModel");
+  NS_ASSERT_MSG (lossModel != 0, "No PathLossModel");
   topoHelper->AttachWithWrapAround (lossModel, ueDevs, enbDevs);
   NS_LOG_DEBUG ("Attached UE's to the eNB with wrap-around");
 
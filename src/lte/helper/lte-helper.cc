@@ -58,6 +58,7 @@
 #include <ns3/phy-stats-calculator.h>
 #include <ns3/phy-tx-stats-calculator.h>
 #include <ns3/phy-rx-stats-calculator.h>
+#include <ns3/lte-trace-connector.h>
 #include <ns3/epc-helper.h>
 #include <iostream>
 #include <ns3/lte-spectrum-value-helper.h>
@@ -74,6 +75,22 @@ NS_LOG_COMPONENT_DEFINE ("LteHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (LteHelper);
 
+/**
+ * Resolve an attribute by name, once for all the devices installed.
+ *
+ * \param tid the TypeId declaring the attribute
+ * \param name the name of the attribute
+ * \return the attribute handle
+ */
+static TypeId::AttributeHandle
+LookupAttributeHandle (TypeId tid, std::string name)
+{
+  TypeId::AttributeHandle handle;
+  bool found = tid.LookupAttributeHandle (name, &handle);
+  NS_ABORT_MSG_UNLESS (found, "Attribute " << name << " not found in " << tid.GetName ());
+  return handle;
+}
+
 LteHelper::LteHelper (void)
   : m_fadingStreamsAssigned (false),
     m_imsiCounter (0),
@@ -837,8 +854,9 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       Ptr<LteSpectrumPhy> slPhy;
       if (m_useSidelink)
         {
+          static TypeId::AttributeHandle halfDuplexPhy = LookupAttributeHandle (LteSpectrumPhy::GetTypeId (), "HalfDuplexPhy");
           slPhy = CreateObject<LteSpectrumPhy> ();
-          slPhy->SetAttribute ("HalfDuplexPhy", PointerValue (ulPhy));
+          slPhy->SetAttribute (halfDuplexPhy, PointerValue (ulPhy));
         }
 
       Ptr<LteUePhy> phy = CreateObject<LteUePhy> (dlPhy, ulPhy);
@@ -997,15 +1015,20 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       //Initialize sidelink configuration
       Ptr<LteSlUeRrc> ueSidelinkConfiguration = CreateObject<LteSlUeRrc> ();
       ueSidelinkConfiguration->SetSourceL2Id ((uint32_t) (imsi & 0xFFFFFF)); //use lower 24 bits of IMSI as source
-      rrc->SetAttribute ("SidelinkConfiguration", PointerValue (ueSidelinkConfiguration));
+      static TypeId::AttributeHandle sidelinkConfiguration = LookupAttributeHandle (LteUeRrc::GetTypeId (), "SidelinkConfiguration");
+      rrc->SetAttribute (sidelinkConfiguration, PointerValue (ueSidelinkConfiguration));
     }
 
+  static TypeId::AttributeHandle imsiAttribute = LookupAttributeHandle (LteUeNetDevice::GetTypeId (), "Imsi");
+  static TypeId::AttributeHandle rrcAttribute = LookupAttributeHandle (LteUeNetDevice::GetTypeId (), "LteUeRrc");
+  static TypeId::AttributeHandle nasAttribute = LookupAttributeHandle (LteUeNetDevice::GetTypeId (), "EpcUeNas");
+  static TypeId::AttributeHandle ccmAttribute = LookupAttributeHandle (LteUeNetDevice::GetTypeId (), "LteUeComponentCarrierManager");
   dev->SetNode (n);
-  dev->SetAttribute ("Imsi", UintegerValue (imsi));
+  dev->SetAttribute (imsiAttribute, UintegerValue (imsi));
   dev->SetCcMap (ueCcMap);
-  dev->SetAttribute ("LteUeRrc", PointerValue (rrc));
-  dev->SetAttribute ("EpcUeNas", PointerValue (nas));
-  dev->SetAttribute ("LteUeComponentCarrierManager", PointerValue (ccmUe));
+  dev->SetAttribute (rrcAttribute, PointerValue (rrc));
+  dev->SetAttribute (nasAttribute, PointerValue (nas));
+  dev->SetAttribute (ccmAttribute, PointerValue (ccmUe));
   // \todo The UE identifier should be dynamically set by the EPC
   // when the default PDP context is created. This is a simplification.
   dev->SetAddress (Mac64Address::Allocate ());
@@ -1675,43 +1698,49 @@ LteHelper::EnablePhyTraces (void)
 void
 LteHelper::EnableDlTxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/DlPhyTransmission",
-                   MakeBoundCallback (&PhyTxStatsCalculator::DlPhyTransmissionCallback, m_phyTxStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_PHY, "DlPhyTransmission",
+                                 MakeBoundCallback (&PhyTxStatsCalculator::DlPhyTransmissionCallback, m_phyTxStats));
 }
 
 void
 LteHelper::EnableUlTxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/UlPhyTransmission",
-                   MakeBoundCallback (&PhyTxStatsCalculator::UlPhyTransmissionCallback, m_phyTxStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_PHY, "UlPhyTransmission",
+                                MakeBoundCallback (&PhyTxStatsCalculator::UlPhyTransmissionCallback, m_phyTxStats));
 }
 
 void
 LteHelper::EnableDlRxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/DlSpectrumPhy/DlPhyReception",
-                   MakeBoundCallback (&PhyRxStatsCalculator::DlPhyReceptionCallback, m_phyRxStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_DL_SPECTRUM_PHY, "DlPhyReception",
+                                MakeBoundCallback (&PhyRxStatsCalculator::DlPhyReceptionCallback, m_phyRxStats));
 }
 
 void
 LteHelper::EnableUlRxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/UlSpectrumPhy/UlPhyReception",
-                   MakeBoundCallback (&PhyRxStatsCalculator::UlPhyReceptionCallback, m_phyRxStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_UL_SPECTRUM_PHY, "UlPhyReception",
+                                 MakeBoundCallback (&PhyRxStatsCalculator::UlPhyReceptionCallback, m_phyRxStats));
 }
 
 void
 LteHelper::EnableSlRxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/SlSpectrumPhy/SlPhyReception",
-                   MakeBoundCallback (&PhyRxStatsCalculator::SlPhyReceptionCallback, m_phyRxStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_SL_SPECTRUM_PHY, "SlPhyReception",
+                                MakeBoundCallback (&PhyRxStatsCalculator::SlPhyReceptionCallback, m_phyRxStats));
 }
 
 void
 LteHelper::EnableSlPscchRxPhyTraces (void)
 {
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/SlSpectrumPhy/SlPscchReception",
-                   MakeBoundCallback (&PhyRxStatsCalculator::SlPscchReceptionCallback, m_phyRxStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_SL_SPECTRUM_PHY, "SlPscchReception",
+                                MakeBoundCallback (&PhyRxStatsCalculator::SlPscchReceptionCallback, m_phyRxStats));
 }
 
 
@@ -1733,50 +1762,57 @@ void
 LteHelper::EnableDlMacTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/DlScheduling",
-                   MakeBoundCallback (&MacStatsCalculator::DlSchedulingCallback, m_macStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_MAC, "DlScheduling",
+                                 MakeBoundCallback (&MacStatsCalculator::DlSchedulingCallback, m_macStats));
 }
 
 void
 LteHelper::EnableUlMacTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/UlScheduling",
-                   MakeBoundCallback (&MacStatsCalculator::UlSchedulingCallback, m_macStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_MAC, "UlScheduling",
+                                 MakeBoundCallback (&MacStatsCalculator::UlSchedulingCallback, m_macStats));
 }
 
 void
 LteHelper::EnableSlPscchMacTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUeMac/SlPscchScheduling",
-                   MakeBoundCallback (&MacStatsCalculator::SlUeCchSchedulingCallback, m_macStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_MAC, "SlPscchScheduling",
+                                MakeBoundCallback (&MacStatsCalculator::SlUeCchSchedulingCallback, m_macStats));
 }
 
 void
 LteHelper::EnableSlPsschMacTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUeMac/SlPsschScheduling",
-                   MakeBoundCallback (&MacStatsCalculator::SlUeSchSchedulingCallback, m_macStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_MAC, "SlPsschScheduling",
+                                MakeBoundCallback (&MacStatsCalculator::SlUeSchSchedulingCallback, m_macStats));
 }
 
 void
 LteHelper::EnableDlPhyTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/ReportCurrentCellRsrpSinr",
-                   MakeBoundCallback (&PhyStatsCalculator::ReportCurrentCellRsrpSinrCallback, m_phyStats));
+  LteTraceConnector::ConnectUe (LteTraceConnector::GetUeDevices (),
+                                LteTraceConnector::UE_PHY, "ReportCurrentCellRsrpSinr",
+                                MakeBoundCallback (&PhyStatsCalculator::ReportCurrentCellRsrpSinrCallback, m_phyStats));
 }
 
 void
 LteHelper::EnableUlPhyTraces (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportUeSinr",
-                   MakeBoundCallback (&PhyStatsCalculator::ReportUeSinr, m_phyStats));
-  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportInterference",
-                   MakeBoundCallback (&PhyStatsCalculator::ReportInterference, m_phyStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_PHY, "ReportUeSinr",
+                                 MakeBoundCallback (&PhyStatsCalculator::ReportUeSinr, m_phyStats));
+  LteTraceConnector::ConnectEnb (LteTraceConnector::GetEnbDevices (),
+                                 LteTraceConnector::ENB_PHY, "ReportInterference",
+                                 MakeBoundCallback (&PhyStatsCalculator::ReportInterference, m_phyStats));
 
 }
 
@@ -0,0 +1,259 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "lte-trace-connector.h"
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/node.h>
+#include <ns3/node-list.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-phy.h>
+#include <ns3/lte-ue-mac.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-enb-mac.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/lte-enb-rrc.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteTraceConnector");
+
+uint32_t
+LteTraceConnector::ConnectUe (NetDeviceContainer devices, UeObject object,
+                              std::string traceSource, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (traceSource);
+  uint32_t connected = 0;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice> (*i);
+      if (ueDev == 0)
+        {
+          continue;
+        }
+      std::map< uint8_t, Ptr<ComponentCarrierUe> > ccMap = ueDev->GetCcMap ();
+      for (std::map< uint8_t, Ptr<ComponentCarrierUe> >::iterator it = ccMap.begin (); it != ccMap.end (); ++it)
+        {
+          // Build the context that Config::Connect would provide
+          std::ostringstream context;
+          context << "/NodeList/" << ueDev->GetNode ()->GetId ()
+                  << "/DeviceList/" << ueDev->GetIfIndex ()
+                  << "/ComponentCarrierMapUe/" << (uint16_t) it->first;
+          Ptr<Object> target;
+          switch (object)
+            {
+            case UE_PHY:
+              target = it->second->GetPhy ();
+              context << "/LteUePhy";
+              break;
+            case UE_MAC:
+              target = it->second->GetMac ();
+              context << "/LteUeMac";
+              break;
+            case UE_DL_SPECTRUM_PHY:
+              target = it->second->GetPhy ()->GetDlSpectrumPhy ();
+              context << "/LteUePhy/DlSpectrumPhy";
+              break;
+            case UE_UL_SPECTRUM_PHY:
+              target = it->second->GetPhy ()->GetUlSpectrumPhy ();
+              context << "/LteUePhy/UlSpectrumPhy";
+              break;
+            case UE_SL_SPECTRUM_PHY:
+              target = it->second->GetPhy ()->GetSlSpectrumPhy ();
+              context << "/LteUePhy/SlSpectrumPhy";
+              break;
+            default:
+              NS_FATAL_ERROR ("Unknown UE object " << object);
+            }
+          if (target == 0)
+            {
+              // e.g., no sidelink spectrum PHY when sidelink is not used
+              continue;
+            }
+          context << "/" << traceSource;
+          bool ok = target->TraceConnect (traceSource, context.str (), cb);
+          NS_ABORT_MSG_UNLESS (ok, "Could not connect trace source " << context.str ());
+          connected++;
+        }
+    }
+  return connected;
+}
+
+uint32_t
+LteTraceConnector::ConnectEnb (NetDeviceContainer devices, EnbObject object,
+                               std::string traceSource, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (traceSource);
+  uint32_t connected = 0;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> (*i);
+      if (enbDev == 0)
+        {
+          continue;
+        }
+      std::map< uint8_t, Ptr<ComponentCarrierEnb> > ccMap = enbDev->GetCcMap ();
+      for (std::map< uint8_t, Ptr<ComponentCarrierEnb> >::iterator it = ccMap.begin (); it != ccMap.end (); ++it)
+        {
+          // Build the context that Config::Connect would provide
+          std::ostringstream context;
+          context << "/NodeList/" << enbDev->GetNode ()->GetId ()
+                  << "/DeviceList/" << enbDev->GetIfIndex ()
+                  << "/ComponentCarrierMap/" << (uint16_t) it->first;
+          Ptr<Object> target;
+          switch (object)
+            {
+            case ENB_PHY:
+              target = it->second->GetPhy ();
+              context << "/LteEnbPhy";
+              break;
+            case ENB_MAC:
+              target = it->second->GetMac ();
+              context << "/LteEnbMac";
+              break;
+            case ENB_DL_SPECTRUM_PHY:
+              target = it->second->GetPhy ()->GetDlSpectrumPhy ();
+              context << "/LteEnbPhy/DlSpectrumPhy";
+              break;
+            case ENB_UL_SPECTRUM_PHY:
+              target = it->second->GetPhy ()->GetUlSpectrumPhy ();
+              context << "/LteEnbPhy/UlSpectrumPhy";
+              break;
+            default:
+              NS_FATAL_ERROR ("Unknown eNodeB object " << object);
+            }
+          if (target == 0)
+            {
+              continue;
+            }
+          context << "/" << traceSource;
+          bool ok = target->TraceConnect (traceSource, context.str (), cb);
+          NS_ABORT_MSG_UNLESS (ok, "Could not connect trace source " << context.str ());
+          connected++;
+        }
+    }
+  return connected;
+}
+
+uint32_t
+LteTraceConnector::ConnectUeRrc (NetDeviceContainer devices,
+                                 std::string traceSource, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (traceSource);
+  uint32_t connected = 0;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice> (*i);
+      if (ueDev == 0)
+        {
+          continue;
+        }
+      std::ostringstream context;
+      context << "/NodeList/" << ueDev->GetNode ()->GetId ()
+              << "/DeviceList/" << ueDev->GetIfIndex ()
+              << "/LteUeRrc/" << traceSource;
+      bool ok = ueDev->GetRrc ()->TraceConnect (traceSource, context.str (), cb);
+      NS_ABORT_MSG_UNLESS (ok, "Could not connect trace source " << context.str ());
+      connected++;
+    }
+  return connected;
+}
+
+uint32_t
+LteTraceConnector::ConnectEnbRrc (NetDeviceContainer devices,
+                                  std::string traceSource, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (traceSource);
+  uint32_t connected = 0;
+  for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
+    {
+      Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> (*i);
+      if (enbDev == 0)
+        {
+          continue;
+        }
+      std::ostringstream context;
+      context << "/NodeList/" << enbDev->GetNode ()->GetId ()
+              << "/DeviceList/" << enbDev->GetIfIndex ()
+              << "/LteEnbRrc/" << traceSource;
+      bool ok = enbDev->GetRrc ()->TraceConnect (traceSource, context.str (), cb);
+      NS_ABORT_MSG_UNLESS (ok, "Could not connect trace source " << context.str ());
+      connected++;
+    }
+  return connected;
+}
+
+NetDeviceContainer
+LteTraceConnector::GetUeDevices (void)
+{
+  NetDeviceContainer devices;
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      for (uint32_t i = 0; i < node->GetNDevices (); ++i)
+        {
+          Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice> (node->GetDevice (i));
+          if (ueDev != 0)
+            {
+              devices.Add (ueDev);
+            }
+        }
+    }
+  return devices;
+}
+
+NetDeviceContainer
+LteTraceConnector::GetEnbDevices (void)
+{
+  NetDeviceContainer devices;
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      for (uint32_t i = 0; i < node->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> (node->GetDevice (i));
+          if (enbDev != 0)
+            {
+              devices.Add (enbDev);
+            }
+        }
+    }
+  return devices;
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef LTE_TRACE_CONNECTOR_H
+#define LTE_TRACE_CONNECTOR_H
+
+#include <ns3/net-device-container.h>
+#include <ns3/callback.h>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Connects trace sources of the LTE devices of a NetDeviceContainer.
+ *
+ * Config::Connect with a wildcard path, e.g., on the SlPhyReception trace
+ * source of the sidelink LteSpectrumPhy of all the UEs, resolves the path
+ * by matching each path element against the attributes of every object of
+ * the simulation, which dominates the setup time of scenarios with tens of
+ * thousands of nodes. This class walks the
+ * component carriers of the given devices with their typed accessors
+ * instead, and connects the trace source directly on the target object.
+ *
+ * The callback receives the same context as with Config::Connect, so the
+ * two methods can be used interchangeably with the stats calculators.
+ */
+class LteTraceConnector
+{
+public:
+  /// Objects of a UE component carrier holding trace sources
+  enum UeObject
+  {
+    UE_PHY,             ///< LteUePhy
+    UE_MAC,             ///< LteUeMac
+    UE_DL_SPECTRUM_PHY, ///< Downlink LteSpectrumPhy of the LteUePhy
+    UE_UL_SPECTRUM_PHY, ///< Uplink LteSpectrumPhy of the LteUePhy
+    UE_SL_SPECTRUM_PHY  ///< Sidelink LteSpectrumPhy of the LteUePhy
+  };
+
+  /// Objects of an eNodeB component carrier holding trace sources
+  enum EnbObject
+  {
+    ENB_PHY,             ///< LteEnbPhy
+    ENB_MAC,             ///< LteEnbMac
+    ENB_DL_SPECTRUM_PHY, ///< Downlink LteSpectrumPhy of the LteEnbPhy
+    ENB_UL_SPECTRUM_PHY  ///< Uplink LteSpectrumPhy of the LteEnbPhy
+  };
+
+  /**
+   * Connect a trace source of each component carrier of the UE devices
+   *
+   * Devices that are not LteUeNetDevice are ignored.
+   *
+   * \param devices The devices
+   * \param object The object of the component carrier holding the trace source
+   * \param traceSource The name of the trace source
+   * \param cb The callback, invoked with the trace context as first argument
+   * \return The number of trace sources connected
+   */
+  static uint32_t ConnectUe (NetDeviceContainer devices, UeObject object,
+                             std::string traceSource, const CallbackBase &cb);
+
+  /**
+   * Connect a trace source of each component carrier of the eNodeB devices
+   *
+   * Devices that are not LteEnbNetDevice are ignored.
+   *
+   * \param devices The devices
+   * \param object The object of the component carrier holding the trace source
+   * \param traceSource The name of the trace source
+   * \param cb The callback, invoked with the trace context as first argument
+   * \return The number of trace sources connected
+   */
+  static uint32_t ConnectEnb (NetDeviceContainer devices, EnbObject object,
+                              std::string traceSource, const CallbackBase &cb);
+
+  /**
+   * Connect a trace source of the RRC of each UE device
+   *
+   * Devices that are not LteUeNetDevice are ignored.
+   *
+   * \param devices The devices
+   * \param traceSource The name of the trace source of the LteUeRrc
+   * \param cb The callback, invoked with the trace context as first argument
+   * \return The number of trace sources connected
+   */
+  static uint32_t ConnectUeRrc (NetDeviceContainer devices,
+                                std::string traceSource, const CallbackBase &cb);
+
+  /**
+   * Connect a trace source of the RRC of each eNodeB device
+   *
+   * Devices that are not LteEnbNetDevice are ignored.
+   *
+   * \param devices The devices
+   * \param traceSource The name of the trace source of the LteEnbRrc
+   * \param cb The callback, invoked with the trace context as first argument
+   * \return The number of trace sources connected
+   */
+  static uint32_t ConnectEnbRrc (NetDeviceContainer devices,
+                                 std::string traceSource, const CallbackBase &cb);
+
+  /**
+   * Get all the LteUeNetDevice of the simulation
+   *
+   * \return The container of the UE devices of all the nodes of the NodeList
+   */
+  static NetDeviceContainer GetUeDevices (void);
+
+  /**
+   * Get all the LteEnbNetDevice of the simulation
+   *
+   * \return The container of the eNodeB devices of all the nodes of the NodeList
+   */
+  static NetDeviceContainer GetEnbDevices (void);
+
+};
+
+} // namespace ns3
+
+#endif /* LTE_TRACE_CONNECTOR_H */
@@ -28,6 +28,7 @@
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-trace-connector.h>
 
 namespace ns3 {
 
@@ -151,22 +152,22 @@ RadioBearerStatsConnector::EnsureConnected ()
   NS_LOG_FUNCTION (this);
   if (!m_connected)
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, this));
+      LteTraceConnector::ConnectEnbRrc (LteTraceConnector::GetEnbDevices (), "NewUeContext",
+                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
+      LteTraceConnector::ConnectUeRrc (LteTraceConnector::GetUeDevices (), "RandomAccessSuccessful",
+                                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
+      LteTraceConnector::ConnectEnbRrc (LteTraceConnector::GetEnbDevices (), "ConnectionReconfiguration",
+                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
+      LteTraceConnector::ConnectUeRrc (LteTraceConnector::GetUeDevices (), "ConnectionReconfiguration",
+                                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
+      LteTraceConnector::ConnectEnbRrc (LteTraceConnector::GetEnbDevices (), "HandoverStart",
+                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, this));
+      LteTraceConnector::ConnectUeRrc (LteTraceConnector::GetUeDevices (), "HandoverStart",
+                                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, this));
+      LteTraceConnector::ConnectEnbRrc (LteTraceConnector::GetEnbDevices (), "HandoverEndOk",
+                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, this));
+      LteTraceConnector::ConnectUeRrc (LteTraceConnector::GetUeDevices (), "HandoverEndOk",
+                                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, this));
       m_connected = true;
     }
 }
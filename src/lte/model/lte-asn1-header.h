@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -55,23 +56,27 @@ public:
     
   /**
    * This function serializes class attributes to m_serializationResult
-   * local Buffer.  As ASN1 encoding produces a bitstream that does not have
+   * local buffer.  As ASN1 encoding produces a bitstream that does not have
    * a fixed length, this function is needed to store the result, so
    * its length can be retrieved with Header::GetSerializedSize() function.
    * This method is pure virtual in this class (needs to be implemented
    * in child classes) as the meaningful information elements are in
    * the subclasses.
+   *
+   * It is called twice for each message: a first time to count the
+   * encoded bits only, then to encode them in a buffer of that size.
+   * It must thus serialize the same elements at both calls.
    */
   virtual void PreSerialize (void) const = 0;
 
 protected:
-  mutable uint8_t m_serializationPendingBits; //!< pending bits
-  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
+  mutable uint8_t m_serializationPendingBits; //!< pending bits of the deserialization
+  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits of the deserialization
   mutable bool m_isDataSerialized; //!< true if data is serialized
-  mutable Buffer m_serializationResult; //!< serialization result
+  mutable std::vector<uint8_t> m_serializationResult; //!< serialization result
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write in m_serializationResult
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
@@ -541,6 +546,42 @@ protected:
    */
   Buffer::Iterator DeserializeSequenceOf (int *numElems, int nMax, int nMin,
                                           Buffer::Iterator bIterator);
+
+private:
+  /**
+   * Serialize the message in m_serializationResult, with a first call
+   * to PreSerialize counting the bits, to size the buffer, and a
+   * second one encoding them.
+   */
+  void DoPreSerialize (void) const;
+  /**
+   * Append bits to the serialization, most significant bit first.
+   * The bits are accumulated in m_serializationWord, and written to
+   * m_serializationResult 32 at a time.
+   * \param value the bits, in the least significant bits
+   * \param numBits the number of bits, between 1 and 32
+   */
+  void WriteBits (uint32_t value, uint8_t numBits) const;
+  /**
+   * Write octets at the end of the serialization
+   * \param word the octets, in the least significant bytes, most
+   *        significant byte first
+   * \param numOctets the number of octets, between 1 and 4
+   */
+  void WriteOctets (uint32_t word, uint8_t numOctets) const;
+  /**
+   * Read bits from the deserialization, most significant bit first
+   * \param numBits the number of bits, at most 32
+   * \param bIterator buffer iterator
+   * \returns the bits, in the least significant bits
+   */
+  uint32_t ReadBits (uint8_t numBits, Buffer::Iterator &bIterator);
+
+  mutable bool m_isSizingPass; //!< true while counting the bits of the serialization
+  mutable uint32_t m_numSizedBits; //!< number of bits counted by the sizing pass
+  mutable uint32_t m_serializationSize; //!< number of octets written to m_serializationResult
+  mutable uint64_t m_serializationWord; //!< bits not yet written to m_serializationResult
+  mutable uint8_t m_numSerializationWordBits; //!< number of bits in m_serializationWord
 };
 
 } // namespace ns3
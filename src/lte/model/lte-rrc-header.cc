@@ -4569,8 +4569,6 @@ RrcConnectionRequestHeader::Print (std::ostream &os) const
 void
 RrcConnectionRequestHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   SerializeUlCcchMessage (1);
 
   // Serialize RRCConnectionRequest sequence:
@@ -4698,8 +4696,6 @@ RrcConnectionSetupHeader::Print (std::ostream &os) const
 void
 RrcConnectionSetupHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   SerializeDlCcchMessage (3);
 
   SerializeInteger (15,0,15);
@@ -4869,8 +4865,6 @@ RrcConnectionSetupCompleteHeader::~RrcConnectionSetupCompleteHeader ()
 void
 RrcConnectionSetupCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize DCCH message
   SerializeUlDcchMessage (4);
 
@@ -4975,8 +4969,6 @@ RrcConnectionReconfigurationCompleteHeader::~RrcConnectionReconfigurationComplet
 void
 RrcConnectionReconfigurationCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize DCCH message
   SerializeUlDcchMessage (2);
 
@@ -5068,8 +5060,6 @@ RrcConnectionReconfigurationHeader::~RrcConnectionReconfigurationHeader ()
 void
 RrcConnectionReconfigurationHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   SerializeDlDcchMessage (4);
 
   // Serialize RRCConnectionSetupComplete sequence:
@@ -5718,8 +5708,6 @@ HandoverPreparationInfoHeader::HandoverPreparationInfoHeader ()
 void
 HandoverPreparationInfoHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize HandoverPreparationInformation sequence:
   // no default or optional fields. Extension marker not present.
   SerializeSequence (std::bitset<0> (),false);
@@ -5954,8 +5942,6 @@ RrcConnectionReestablishmentRequestHeader::~RrcConnectionReestablishmentRequestH
 void
 RrcConnectionReestablishmentRequestHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   SerializeUlCcchMessage (0);
 
   // Serialize RrcConnectionReestablishmentReques sequence:
@@ -6120,8 +6106,6 @@ RrcConnectionReestablishmentHeader::~RrcConnectionReestablishmentHeader ()
 void
 RrcConnectionReestablishmentHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   SerializeDlCcchMessage (0);
 
   // Serialize RrcConnectionReestablishment sequence:
@@ -6248,8 +6232,6 @@ RrcConnectionReestablishmentCompleteHeader::RrcConnectionReestablishmentComplete
 void
 RrcConnectionReestablishmentCompleteHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize DCCH message
   SerializeUlDcchMessage (3);
 
@@ -6350,8 +6332,6 @@ RrcConnectionReestablishmentRejectHeader::~RrcConnectionReestablishmentRejectHea
 void
 RrcConnectionReestablishmentRejectHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize CCCH message
   SerializeDlCcchMessage (1);
 
@@ -6435,8 +6415,6 @@ RrcConnectionReleaseHeader::~RrcConnectionReleaseHeader ()
 void
 RrcConnectionReleaseHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize DCCH message
   SerializeDlDcchMessage (5);
 
@@ -6560,8 +6538,6 @@ RrcConnectionRejectHeader::~RrcConnectionRejectHeader ()
 void
 RrcConnectionRejectHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize CCCH message
   SerializeDlCcchMessage (2);
 
@@ -6668,8 +6644,6 @@ MeasurementReportHeader::~MeasurementReportHeader ()
 void
 MeasurementReportHeader::PreSerialize () const
 {
-  m_serializationResult = Buffer ();
-
   // Serialize DCCH message
   SerializeUlDcchMessage (1);
 
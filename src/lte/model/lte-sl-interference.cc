@@ -26,16 +26,23 @@
 
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <cmath>
 
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("LteSlInterference");
 
+NS_OBJECT_ENSURE_REGISTERED (LteSlInterference);
+
 LteSlInterference::LteSlInterference ()
   : m_receiving (false),
     m_lastSignalId (0),
-    m_lastSignalIdBeforeReset (0)
+    m_lastSignalIdBeforeReset (0),
+    m_aggregateWeakSignals (false),
+    m_rxPowerFloor (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -65,10 +72,49 @@ LteSlInterference::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::LteSlInterference")
     .SetParent<Object> ()
     .SetGroupName("Lte")
+    .AddAttribute ("AggregateWeakSignals",
+                   "If true, the signals received with a power lower than RxPowerFloor "
+                   "are not tracked individually (no RX attempt is started for them) "
+                   "and only contribute to the aggregate interference",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteSlInterference::m_aggregateWeakSignals),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RxPowerFloor",
+                   "The received power (in dBm) under which a signal is folded into "
+                   "the aggregate interference when AggregateWeakSignals is enabled",
+                   DoubleValue (-120.0),
+                   MakeDoubleAccessor (&LteSlInterference::SetRxPowerFloor,
+                                       &LteSlInterference::GetRxPowerFloor),
+                   MakeDoubleChecker<double> ())
   ;
   return tid;
 }
 
+void
+LteSlInterference::SetRxPowerFloor (double floorDbm)
+{
+  NS_LOG_FUNCTION (this << floorDbm);
+  m_rxPowerFloor = std::pow (10.0, (floorDbm - 30) / 10);
+}
+
+double
+LteSlInterference::GetRxPowerFloor () const
+{
+  return 10 * std::log10 (m_rxPowerFloor) + 30;
+}
+
+bool
+LteSlInterference::IsTracked (Ptr<const SpectrumValue> rxPsd) const
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_aggregateWeakSignals || Integral (*rxPsd) >= m_rxPowerFloor)
+    {
+      return true;
+    }
+  NS_LOG_LOGIC ("signal below the RX power floor, folded into the aggregate interference");
+  return false;
+}
+
 
 void
 LteSlInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
@@ -115,6 +115,29 @@ public:
    */
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
+  /**
+   * Check if a signal must be tracked individually, i.e., if a RX attempt
+   * should be started for it. When the aggregate interference mode is
+   * disabled, all signals are tracked. Otherwise, only the signals whose
+   * received power is greater than or equal to the RX power floor are
+   * tracked; the others only contribute to the aggregate interference
+   * through AddSignal.
+   *
+   * \param rxPsd The power spectral density of the received signal
+   * \return true if StartRx should be called for this signal
+   */
+  bool IsTracked (Ptr<const SpectrumValue> rxPsd) const;
+
+  /**
+   * \param floorDbm The RX power floor in dBm
+   */
+  void SetRxPowerFloor (double floorDbm);
+
+  /**
+   * \return The RX power floor in dBm
+   */
+  double GetRxPowerFloor () const;
+
 private:
   /**
    * Conditionally evaluate chunk
@@ -168,9 +191,11 @@ private:
       a new interference chunk is calculated */
   std::list<Ptr<LteSlChunkProcessor> > m_interfChunkProcessorList;
 
+  bool m_aggregateWeakSignals; ///< fold signals below the RX power floor into the aggregate interference?
+  double m_rxPowerFloor; ///< RX power floor in W under which signals are not tracked individually
 
 };
 
 } // namespace ns3
 
-#endif /* LTE_INTERFERENCE_H */
+#endif /* LTE_SL_INTERFERENCE_H */
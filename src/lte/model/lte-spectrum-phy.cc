@@ -1096,6 +1096,9 @@ LteSpectrumPhy::StartRxSlData (Ptr<LteSpectrumSignalParametersSlFrame> params)
               NS_LOG_LOGIC ("the signal is neither from eNodeB nor from this UE");
               NS_LOG_DEBUG ("Signal is from Node id = "<<params->nodeId);
 
+              //In aggregate interference mode, weak signals are only accounted as interference
+              bool tracked = m_interferenceSl->IsTracked (params->psd);
+
               //SLSSs (PSBCH) should be received by all UEs
               //Checking if it is a SLSS, and if it is: measure S-RSRP and receive MIB-SL
               if (params->ctrlMsgList.size () >0)
@@ -1114,7 +1117,12 @@ LteSpectrumPhy::StartRxSlData (Ptr<LteSpectrumSignalParametersSlFrame> params)
                             {
                               m_ltePhyRxSlssCallback (mibSL.slssid, params->psd);
                             }
-                          //Receive MIB-SL
+                          //Receive MIB-SL (unless the signal is too weak to be tracked)
+                          if (!tracked)
+                            {
+                              params->ctrlMsgList.erase (ctrlIt);
+                              break;
+                            }
                           if (m_rxPacketInfo.empty ())
                             {
                               NS_ASSERT (m_state == IDLE);
@@ -1163,7 +1171,10 @@ LteSpectrumPhy::StartRxSlData (Ptr<LteSpectrumSignalParametersSlFrame> params)
               //Receive PSCCH, PSSCH and PSDCH only if synchronized to the transmitter (having the same SLSSID)
               //and belonging to the destination group
 
-              if (params->slssId == m_slssId && (params->groupId == 0 || m_l1GroupIds.find (params->groupId) != m_l1GroupIds.end()))
+              //Signals below the RX power floor of the aggregate interference mode
+              //are not received, they only contribute to the interference
+              if (params->slssId == m_slssId && (params->groupId == 0 || m_l1GroupIds.find (params->groupId) != m_l1GroupIds.end())
+                  && tracked)
                 {
                   if (m_rxPacketInfo.empty ())
                     {
@@ -0,0 +1,296 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/packet.h>
+#include <ns3/packet-burst.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
+#include <ns3/lte-control-messages.h>
+#include <ns3/lte-spectrum-signal-parameters-codec.h>
+#include <typeinfo>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteSpectrumSignalParametersCodec");
+
+/// Number of bytes of the ProSe application code of a discovery message
+static const uint32_t PROSE_APP_CODE_BYTES = 23;
+
+/// Register the LTE codecs when the module is loaded
+static struct LteSpectrumSignalParametersCodecRegistration
+{
+  LteSpectrumSignalParametersCodecRegistration ()
+  {
+    DistributedSpectrumChannel::AddSignalCodec (Create<LteSpectrumSignalParametersSlFrameCodec> ());
+    DistributedSpectrumChannel::AddSignalCodec (Create<LteSpectrumSignalParametersUlSrsFrameCodec> ());
+  }
+} g_lteSpectrumSignalParametersCodecRegistration; //!< registration of the LTE codecs
+
+/**
+ * \param msg a sidelink control message
+ * \return the size of the serialized message, after its type
+ */
+static uint32_t
+GetSerializedControlMessageSize (Ptr<LteControlMessage> msg)
+{
+  switch (msg->GetMessageType ())
+    {
+    case LteControlMessage::SCI:
+      return 14;
+    case LteControlMessage::MIB_SL:
+      return 33;
+    case LteControlMessage::SL_DISC_MSG:
+      return 9 + PROSE_APP_CODE_BYTES;
+    default:
+      NS_FATAL_ERROR ("control message " << msg->GetMessageType () << " not serialized in sidelink frames");
+    }
+  return 0;
+}
+
+std::string
+LteSpectrumSignalParametersSlFrameCodec::GetName (void) const
+{
+  return "LteSpectrumSignalParametersSlFrame";
+}
+
+bool
+LteSpectrumSignalParametersSlFrameCodec::CanSerialize (Ptr<const SpectrumSignalParameters> params) const
+{
+  return typeid (*params) == typeid (LteSpectrumSignalParametersSlFrame);
+}
+
+uint32_t
+LteSpectrumSignalParametersSlFrameCodec::GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const
+{
+  Ptr<const LteSpectrumSignalParametersSlFrame> p = DynamicCast<const LteSpectrumSignalParametersSlFrame> (params);
+  uint32_t size = 1 + 4;
+  if (p->packetBurst)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator it = p->packetBurst->Begin (); it != p->packetBurst->End (); ++it)
+        {
+          size += GetSerializedPacketSize (*it);
+        }
+    }
+  size += 4;
+  for (std::list<Ptr<LteControlMessage> >::const_iterator it = p->ctrlMsgList.begin (); it != p->ctrlMsgList.end (); ++it)
+    {
+      size += 1 + GetSerializedControlMessageSize (*it);
+    }
+  return size + 4 + 1 + 8;
+}
+
+void
+LteSpectrumSignalParametersSlFrameCodec::Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator i) const
+{
+  Ptr<const LteSpectrumSignalParametersSlFrame> p = DynamicCast<const LteSpectrumSignalParametersSlFrame> (params);
+  i.WriteU8 (p->packetBurst ? 1 : 0);
+  i.WriteU32 (p->packetBurst ? p->packetBurst->GetNPackets () : 0);
+  if (p->packetBurst)
+    {
+      for (std::list<Ptr<Packet> >::const_iterator it = p->packetBurst->Begin (); it != p->packetBurst->End (); ++it)
+        {
+          SerializePacket (*it, i);
+        }
+    }
+
+  i.WriteU32 (p->ctrlMsgList.size ());
+  for (std::list<Ptr<LteControlMessage> >::const_iterator it = p->ctrlMsgList.begin (); it != p->ctrlMsgList.end (); ++it)
+    {
+      i.WriteU8 ((*it)->GetMessageType ());
+      switch ((*it)->GetMessageType ())
+        {
+        case LteControlMessage::SCI:
+          {
+            SciListElement_s sci = DynamicCast<SciLteControlMessage> (*it)->GetSci ();
+            i.WriteU16 (sci.m_rnti);
+            i.WriteU8 (sci.m_resPscch);
+            i.WriteU8 (sci.m_hopping);
+            i.WriteU8 (sci.m_rbStart);
+            i.WriteU8 (sci.m_rbLen);
+            i.WriteU8 (sci.m_hoppingInfo);
+            i.WriteU16 (sci.m_tbSize);
+            i.WriteU8 (sci.m_trp);
+            i.WriteU8 (sci.m_mcs);
+            i.WriteU16 (sci.m_timing);
+            i.WriteU8 (sci.m_groupDstId);
+            break;
+          }
+        case LteControlMessage::MIB_SL:
+          {
+            LteRrcSap::MasterInformationBlockSL mib = DynamicCast<MibSlLteControlMessage> (*it)->GetMibSL ();
+            i.WriteU16 (mib.slBandwidth);
+            i.WriteU16 (mib.directFrameNo);
+            i.WriteU16 (mib.directSubframeNo);
+            i.WriteU8 (mib.inCoverage ? 1 : 0);
+            i.WriteU64 (mib.slssid);
+            i.WriteU64 (mib.rxTimestamp.GetTimeStep ());
+            i.WriteU64 (mib.creationTimestamp.GetTimeStep ());
+            i.WriteU16 (mib.rxOffset);
+            break;
+          }
+        case LteControlMessage::SL_DISC_MSG:
+          {
+            SlDiscMsg disc = DynamicCast<SlDiscMessage> (*it)->GetSlDiscMessage ();
+            i.WriteU16 (disc.m_rnti);
+            i.WriteU8 (disc.m_resPsdch);
+            i.WriteU8 (disc.m_msgType);
+            for (uint32_t byte = 0; byte < PROSE_APP_CODE_BYTES; ++byte)
+              {
+                uint8_t value = 0;
+                for (uint32_t bit = 0; bit < 8; ++bit)
+                  {
+                    value |= disc.m_proSeAppCode[byte * 8 + bit] << bit;
+                  }
+                i.WriteU8 (value);
+              }
+            i.WriteU32 (disc.m_mic);
+            i.WriteU8 (disc.m_utcBasedCounter);
+            break;
+          }
+        default:
+          NS_FATAL_ERROR ("control message " << (*it)->GetMessageType () << " not serialized in sidelink frames");
+        }
+    }
+
+  i.WriteU32 (p->nodeId);
+  i.WriteU8 (p->groupId);
+  i.WriteU64 (p->slssId);
+}
+
+Ptr<SpectrumSignalParameters>
+LteSpectrumSignalParametersSlFrameCodec::Deserialize (Buffer::Iterator i) const
+{
+  Ptr<LteSpectrumSignalParametersSlFrame> p = Create<LteSpectrumSignalParametersSlFrame> ();
+  bool hasBurst = i.ReadU8 ();
+  uint32_t nPackets = i.ReadU32 ();
+  if (hasBurst)
+    {
+      p->packetBurst = CreateObject<PacketBurst> ();
+      for (uint32_t j = 0; j < nPackets; ++j)
+        {
+          p->packetBurst->AddPacket (DeserializePacket (i));
+        }
+    }
+
+  uint32_t nMessages = i.ReadU32 ();
+  for (uint32_t j = 0; j < nMessages; ++j)
+    {
+      uint8_t type = i.ReadU8 ();
+      switch (type)
+        {
+        case LteControlMessage::SCI:
+          {
+            SciListElement_s sci;
+            sci.m_rnti = i.ReadU16 ();
+            sci.m_resPscch = i.ReadU8 ();
+            sci.m_hopping = i.ReadU8 ();
+            sci.m_rbStart = i.ReadU8 ();
+            sci.m_rbLen = i.ReadU8 ();
+            sci.m_hoppingInfo = i.ReadU8 ();
+            sci.m_tbSize = i.ReadU16 ();
+            sci.m_trp = i.ReadU8 ();
+            sci.m_mcs = i.ReadU8 ();
+            sci.m_timing = i.ReadU16 ();
+            sci.m_groupDstId = i.ReadU8 ();
+            Ptr<SciLteControlMessage> msg = Create<SciLteControlMessage> ();
+            msg->SetSci (sci);
+            p->ctrlMsgList.push_back (msg);
+            break;
+          }
+        case LteControlMessage::MIB_SL:
+          {
+            LteRrcSap::MasterInformationBlockSL mib;
+            mib.slBandwidth = i.ReadU16 ();
+            mib.directFrameNo = i.ReadU16 ();
+            mib.directSubframeNo = i.ReadU16 ();
+            mib.inCoverage = i.ReadU8 ();
+            mib.slssid = i.ReadU64 ();
+            mib.rxTimestamp = TimeStep (i.ReadU64 ());
+            mib.creationTimestamp = TimeStep (i.ReadU64 ());
+            mib.rxOffset = i.ReadU16 ();
+            Ptr<MibSlLteControlMessage> msg = Create<MibSlLteControlMessage> ();
+            msg->SetMibSL (mib);
+            p->ctrlMsgList.push_back (msg);
+            break;
+          }
+        case LteControlMessage::SL_DISC_MSG:
+          {
+            SlDiscMsg disc;
+            disc.m_rnti = i.ReadU16 ();
+            disc.m_resPsdch = i.ReadU8 ();
+            disc.m_msgType = i.ReadU8 ();
+            for (uint32_t byte = 0; byte < PROSE_APP_CODE_BYTES; ++byte)
+              {
+                uint8_t value = i.ReadU8 ();
+                for (uint32_t bit = 0; bit < 8; ++bit)
+                  {
+                    disc.m_proSeAppCode[byte * 8 + bit] = (value >> bit) & 1;
+                  }
+              }
+            disc.m_mic = i.ReadU32 ();
+            disc.m_utcBasedCounter = i.ReadU8 ();
+            Ptr<SlDiscMessage> msg = Create<SlDiscMessage> ();
+            msg->SetSlDiscMessage (disc);
+            p->ctrlMsgList.push_back (msg);
+            break;
+          }
+        default:
+          NS_FATAL_ERROR ("unknown control message " << (uint32_t) type << " in a sidelink frame");
+        }
+    }
+
+  p->nodeId = i.ReadU32 ();
+  p->groupId = i.ReadU8 ();
+  p->slssId = i.ReadU64 ();
+  return p;
+}
+
+
+std::string
+LteSpectrumSignalParametersUlSrsFrameCodec::GetName (void) const
+{
+  return "LteSpectrumSignalParametersUlSrsFrame";
+}
+
+bool
+LteSpectrumSignalParametersUlSrsFrameCodec::CanSerialize (Ptr<const SpectrumSignalParameters> params) const
+{
+  return typeid (*params) == typeid (LteSpectrumSignalParametersUlSrsFrame);
+}
+
+uint32_t
+LteSpectrumSignalParametersUlSrsFrameCodec::GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const
+{
+  return 2;
+}
+
+void
+LteSpectrumSignalParametersUlSrsFrameCodec::Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator i) const
+{
+  Ptr<const LteSpectrumSignalParametersUlSrsFrame> p = DynamicCast<const LteSpectrumSignalParametersUlSrsFrame> (params);
+  i.WriteU16 (p->cellId);
+}
+
+Ptr<SpectrumSignalParameters>
+LteSpectrumSignalParametersUlSrsFrameCodec::Deserialize (Buffer::Iterator i) const
+{
+  Ptr<LteSpectrumSignalParametersUlSrsFrame> p = Create<LteSpectrumSignalParametersUlSrsFrame> ();
+  p->cellId = i.ReadU16 ();
+  return p;
+}
+
+}  // namespace ns3
@@ -26,6 +26,7 @@
 #include <ns3/node.h>
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include <ns3/double.h>
 #include "lte-ue-phy.h"
@@ -65,6 +66,17 @@ static const Time UL_DATA_DURATION = NanoSeconds (1e6 - 71429 - 1);
  */
 static const Time UL_SRS_DELAY_FROM_SUBFRAME_START = NanoSeconds (1e6 - 71429); 
 
+/**
+ * First RB of the SLSS (PSSS, SSSS and PSBCH) transmission, i.e., the
+ * central 6 RBs of a 50 RB sidelink bandwidth.
+ */
+static const uint8_t SLSS_FIRST_RB = 22;
+
+/**
+ * Number of RBs of the SLSS (PSSS, SSSS and PSBCH) transmission.
+ */
+static const uint8_t SLSS_NUM_RB = 6;
+
 
 
 
@@ -179,6 +191,8 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_rsInterferencePowerUpdated (false),
     m_dataInterferencePowerUpdated (false),
     m_pssReceived (false),
+    m_ueMeasurementsMaxCells (0),
+    m_ueMeasurementsHysteresis (3.0),
     m_ueMeasurementsFilterPeriod (MilliSeconds (200)),
     m_ueMeasurementsFilterLast (MilliSeconds (0)),
     m_rsrpSinrSampleCounter (0),
@@ -356,6 +370,20 @@ LteUePhy::GetTypeId (void)
                    TimeValue (MilliSeconds (200)),
                    MakeTimeAccessor (&LteUePhy::m_ueMeasurementsFilterPeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("UeMeasurementsMaxCells",
+                   "Maximum number of neighbour cells measured and reported "
+                   "besides the serving cell, the strongest ones being kept; "
+                   "0 to measure all the cells heard.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LteUePhy::m_ueMeasurementsMaxCells),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("UeMeasurementsHysteresis",
+                   "Margin [dB] by which the RSRP of a cell which is not measured "
+                   "must exceed the RSRP of the weakest measured neighbour cell "
+                   "to replace it, when UeMeasurementsMaxCells is not 0.",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&LteUePhy::m_ueMeasurementsHysteresis),
+                   MakeDoubleChecker<double> (0.0))
     .AddTraceSource ("ReportUeMeasurements",
                      "Report UE measurements RSRP (dBm) and RSRQ (dB).",
                      MakeTraceSourceAccessor (&LteUePhy::m_reportUeMeasurements),
@@ -736,14 +764,15 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
               NS_LOG_INFO (this << " PSS RNTI " << m_rnti << " cellId " << m_cellId
                                 << " has RSRQ " << rsrq_dB << " and RBnum " << rbNum);
               // store measurements
-              std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap;
-              itMeasMap = m_ueMeasurementsMap.find ((*itPss).cellId);
-              if (itMeasMap != m_ueMeasurementsMap.end ())
+              uint32_t i = FindUeMeasurements ((*itPss).cellId);
+              if (i < m_ueMeasurements.size ()
+                  && m_ueMeasurements[i].cellId == (*itPss).cellId
+                  && m_ueMeasurements[i].rsrpNum > 0)
                 {
-                  (*itMeasMap).second.rsrqSum += rsrq_dB;
-                  (*itMeasMap).second.rsrqNum++;
+                  m_ueMeasurements[i].rsrqSum += rsrq_dB;
+                  m_ueMeasurements[i].rsrqNum++;
                 }
-              else
+              else if (m_ueMeasurementsMaxCells == 0)
                 {
                   NS_LOG_WARN ("race condition of bug 2091 occurred");
                 }
@@ -955,6 +984,73 @@ LteUePhy::CreateDlCqiFeedbackMessage (const SpectrumValue& sinr)
 }
 
 
+uint32_t
+LteUePhy::FindUeMeasurements (uint16_t cellId) const
+{
+  uint32_t i = 0;
+  while (i < m_ueMeasurements.size () && m_ueMeasurements[i].cellId < cellId)
+    {
+      i++;
+    }
+  return i;
+}
+
+void
+LteUePhy::StoreRsrpSample (uint16_t cellId, double rsrp)
+{
+  uint32_t i = FindUeMeasurements (cellId);
+  if (i < m_ueMeasurements.size () && m_ueMeasurements[i].cellId == cellId)
+    {
+      m_ueMeasurements[i].rsrpSum += rsrp;
+      m_ueMeasurements[i].rsrpNum++;
+      return;
+    }
+
+  if (m_ueMeasurementsMaxCells > 0 && m_ueMeasurements.size () > m_ueMeasurementsMaxCells)
+    {
+      // all the cells are measured: find the weakest neighbour cell,
+      // using the RSRP of the previous period for the cells not heard yet
+      uint32_t weakest = m_ueMeasurements.size ();
+      double weakestRsrp = DBL_MAX;
+      for (uint32_t j = 0; j < m_ueMeasurements.size (); j++)
+        {
+          const UeMeasurementsElement &el = m_ueMeasurements[j];
+          double elRsrp = (el.rsrpNum > 0) ? (el.rsrpSum / el.rsrpNum) : el.rsrpLast;
+          if (el.cellId != m_cellId && elRsrp < weakestRsrp)
+            {
+              weakest = j;
+              weakestRsrp = elRsrp;
+            }
+        }
+      NS_ASSERT (weakest < m_ueMeasurements.size ());
+      if (cellId != m_cellId && rsrp <= weakestRsrp + m_ueMeasurementsHysteresis)
+        {
+          NS_LOG_LOGIC (this << " cellId " << cellId << " RSRP " << rsrp
+                             << " not measured, weakest cellId " << m_ueMeasurements[weakest].cellId
+                             << " RSRP " << weakestRsrp);
+          return;
+        }
+      NS_LOG_LOGIC (this << " cellId " << cellId << " RSRP " << rsrp
+                         << " replaces cellId " << m_ueMeasurements[weakest].cellId
+                         << " RSRP " << weakestRsrp);
+      m_ueMeasurements.erase (m_ueMeasurements.begin () + weakest);
+      if (weakest < i)
+        {
+          i--;
+        }
+    }
+
+  // insert new entry
+  UeMeasurementsElement newEl;
+  newEl.cellId = cellId;
+  newEl.rsrpSum = rsrp;
+  newEl.rsrpNum = 1;
+  newEl.rsrqSum = 0;
+  newEl.rsrqNum = 0;
+  newEl.rsrpLast = rsrp;
+  m_ueMeasurements.insert (m_ueMeasurements.begin () + i, newEl);
+}
+
 void
 LteUePhy::ReportUeMeasurements ()
 {
@@ -963,40 +1059,54 @@ LteUePhy::ReportUeMeasurements ()
 
   LteUeCphySapUser::UeMeasurementsParameters ret;
 
-  std::map <uint16_t, UeMeasurementsElement>::iterator it;
-  for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end (); it++)
+  uint32_t numCells = 0;
+  for (uint32_t i = 0; i < m_ueMeasurements.size (); i++)
     {
-      double avg_rsrp = (*it).second.rsrpSum / static_cast<double> ((*it).second.rsrpNum);
-      double avg_rsrq = (*it).second.rsrqSum / static_cast<double> ((*it).second.rsrqNum);
+      UeMeasurementsElement el = m_ueMeasurements[i];
+      if (el.rsrpNum == 0)
+        {
+          // not heard during this period
+          continue;
+        }
+      double avg_rsrp = el.rsrpSum / static_cast<double> (el.rsrpNum);
+      double avg_rsrq = el.rsrqSum / static_cast<double> (el.rsrqNum);
       /*
        * In CELL_SEARCH state, this may result in avg_rsrq = 0/0 = -nan.
        * UE RRC must take this into account when receiving measurement reports.
        * TODO remove this shortcoming by calculating RSRQ during CELL_SEARCH
        */
-      NS_LOG_DEBUG (this << " CellId " << (*it).first
+      NS_LOG_DEBUG (this << " CellId " << el.cellId
                          << " RSRP " << avg_rsrp
-                         << " (nSamples " << (uint16_t)(*it).second.rsrpNum << ")"
+                         << " (nSamples " << (uint16_t)el.rsrpNum << ")"
                          << " RSRQ " << avg_rsrq
-                         << " (nSamples " << (uint16_t)(*it).second.rsrqNum << ")"
+                         << " (nSamples " << (uint16_t)el.rsrqNum << ")"
                          << " ComponentCarrierID " << (uint16_t)m_componentCarrierId);
 
       if (avg_rsrp >= m_rsrpReceptionThreshold)
         {
           LteUeCphySapUser::UeMeasurementsElement newEl;
-          newEl.m_cellId = (*it).first;
+          newEl.m_cellId = el.cellId;
           newEl.m_rsrp = avg_rsrp;
           newEl.m_rsrq = avg_rsrq;
           ret.m_ueMeasurementsList.push_back (newEl);
           ret.m_componentCarrierId = m_componentCarrierId;
         }
       // report to UE measurements trace
-      m_reportUeMeasurements (m_rnti, (*it).first, avg_rsrp, avg_rsrq, ((*it).first == m_cellId ? 1 : 0), m_componentCarrierId);
+      m_reportUeMeasurements (m_rnti, el.cellId, avg_rsrp, avg_rsrq, (el.cellId == m_cellId ? 1 : 0), m_componentCarrierId);
+
+      // keep the cell for the next period, with no samples
+      el.rsrpSum = 0;
+      el.rsrpNum = 0;
+      el.rsrqSum = 0;
+      el.rsrqNum = 0;
+      el.rsrpLast = avg_rsrp;
+      m_ueMeasurements[numCells++] = el;
     }
 
   // report to RRC
   m_ueCphySapUser->ReportUeMeasurements (ret);
 
-  m_ueMeasurementsMap.clear ();
+  m_ueMeasurements.resize (numCells);
   Simulator::Schedule (m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
@@ -1289,22 +1399,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
   // note that m_pssReceptionThreshold does not apply here
 
   // store measurements
-  std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap = m_ueMeasurementsMap.find (cellId);
-  if (itMeasMap == m_ueMeasurementsMap.end ())
-    {
-      // insert new entry
-      UeMeasurementsElement newEl;
-      newEl.rsrpSum = rsrp_dBm;
-      newEl.rsrpNum = 1;
-      newEl.rsrqSum = 0;
-      newEl.rsrqNum = 0;
-      m_ueMeasurementsMap.insert (std::pair <uint16_t, UeMeasurementsElement> (cellId, newEl));
-    }
-  else
-    {
-      (*itMeasMap).second.rsrpSum += rsrp_dBm;
-      (*itMeasMap).second.rsrpNum++;
-    }
+  StoreRsrpSample (cellId, rsrp_dBm);
 
   /*
    * Collect the PSS for later processing in GenerateCtrlCqiReport()
@@ -1901,7 +1996,7 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
               else
                 {
                   std::vector<int> dlRb;
-                  for (uint8_t i = 22; i < 28; i++)
+                  for (uint8_t i = SLSS_FIRST_RB; i < SLSS_FIRST_RB + SLSS_NUM_RB; i++)
                     {
                       dlRb.push_back (i);
                     }
@@ -2441,19 +2536,24 @@ LteUePhy::ReceiveSlss (uint16_t slssid, Ptr<SpectrumValue> p)
     {
       NS_LOG_LOGIC ("The UE is currently performing the SyncRef scanning or S-RSRP measurement");
 
-      //Measure instantaneous S-RSRP...
+      //Measure instantaneous S-RSRP on the RBs of the SLSS transmission
       double sum = 0.0;
       uint16_t nRB = 0;
-      Values::const_iterator itPi;
-      for (itPi = p->ConstValuesBegin(); itPi != p->ConstValuesEnd(); itPi++)
+      uint32_t lastRb = std::min<uint32_t> (SLSS_FIRST_RB + SLSS_NUM_RB, p->GetSpectrumModel ()->GetNumBands ());
+      for (uint32_t rb = SLSS_FIRST_RB; rb < lastRb; rb++)
         {
-          if ((*itPi))
+          if ((*p)[rb])
             {
-              double powerTxW = ((*itPi) * 180000.0) / 12.0; // convert PSD [W/Hz] to linear power [W]
+              double powerTxW = ((*p)[rb] * 180000.0) / 12.0; // convert PSD [W/Hz] to linear power [W]
               sum += powerTxW;
               nRB++;
             }
         }
+      if (nRB == 0)
+        {
+          NS_LOG_LOGIC ("No power received on the SLSS RBs... Ignoring");
+          return;
+        }
       double s_rsrp_W = (sum / static_cast<double> (nRB));
       double s_rsrp_dBm = 10 * log10(1000 * (s_rsrp_W));
       uint16_t offset = Simulator::Now ().GetMilliSeconds () % 40;
@@ -2472,45 +2572,57 @@ LteUePhy::ReceiveSlss (uint16_t slssid, Ptr<SpectrumValue> p)
       //Note that a SyncRef is identified by SLSSID and reception offset.
       //SLSSs coming from different UEs, but having the same SyncRef info (same SLSSID and reception offset)
       //are considered as different S-RSRP samples of the same SyncRef
-      std::map <std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator
-      itMeasMap = m_ueSlssMeasurementsMap.find (std::pair<uint16_t, uint16_t>(slssid,offset));
+      std::vector<SyncRefEntry>::iterator itSyncRef = FindSyncRef (slssid, offset);
 
-      if (itMeasMap == m_ueSlssMeasurementsMap.end ()) //First entry
+      if (m_ueSlssScanningInProgress)
         {
-          UeSlssMeasurementsElement newEl;
-          newEl.srsrpSum = s_rsrp_W;
-          newEl.srsrpNum = 1;
-
-          if (m_ueSlssScanningInProgress)
+          if (itSyncRef != m_syncRefTable.end ())
+            {
+              NS_LOG_LOGIC ("SyncRef scan in progress, SyncRef already detected");
+              return;
+            }
+          NS_LOG_LOGIC ("SyncRef scan in progress, first detected entry");
+          SyncRefEntry newEl;
+          newEl.slssid = slssid;
+          newEl.offset = offset;
+          newEl.detectedSrsrp = s_rsrp_W;
+          newEl.filteredSrsrp = 0.0;
+          newEl.srsrpNum = 0;
+          if (m_syncRefTable.size () < SYNC_REF_TABLE_CAPACITY)
             {
-              NS_LOG_LOGIC ("SyncRef scan in progress, first detected entry");
-              m_ueSlssDetectionMap.insert (std::pair< std::pair<uint16_t, uint16_t>,
-                                          UeSlssMeasurementsElement>(std::pair<uint16_t, uint16_t>(slssid,offset), newEl));
+              m_syncRefTable.push_back (newEl);
             }
-          else if (m_ueSlssMeasurementInProgress)
+          else
             {
-              NS_LOG_LOGIC ("S-RSRP measurement in progress, first measurement entry");
-              //Insert new measurement only if it was already detected
-              std::map <std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator
-              itDetectionMap = m_ueSlssDetectionMap.find (std::pair<uint16_t, uint16_t>(slssid,offset));
-              if (itDetectionMap != m_ueSlssDetectionMap.end ())
+              //Replace the weakest SyncRef if the new one is stronger
+              std::vector<SyncRefEntry>::iterator itWeakest = m_syncRefTable.begin ();
+              for (std::vector<SyncRefEntry>::iterator it = m_syncRefTable.begin (); it != m_syncRefTable.end (); it++)
                 {
-                  NS_LOG_LOGIC ("SyncRef already detected, storing measurement");
-                  m_ueSlssMeasurementsMap.insert (std::pair< std::pair<uint16_t, uint16_t>,
-                                                 UeSlssMeasurementsElement>(std::pair<uint16_t, uint16_t>(slssid,offset), newEl));
+                  if (it->detectedSrsrp < itWeakest->detectedSrsrp)
+                    {
+                      itWeakest = it;
+                    }
                 }
-              else
+              if (itWeakest->detectedSrsrp < s_rsrp_W)
                 {
-                  NS_LOG_LOGIC ("SyncRef was not detected during SyncRef search/scanning... Ignoring");
+                  NS_LOG_LOGIC ("SyncRef table full, replacing SyncRef SLSSID " << itWeakest->slssid
+                                << " offset " << itWeakest->offset);
+                  *itWeakest = newEl;
                 }
             }
         }
-      else
+      else if (m_ueSlssMeasurementInProgress)
         {
-          NS_LOG_LOGIC ("Measurement entry found... Adding values");
-
-          (*itMeasMap).second.srsrpSum += s_rsrp_W;
-          (*itMeasMap).second.srsrpNum++;
+          //Measure only the SyncRefs that were detected
+          if (itSyncRef == m_syncRefTable.end ())
+            {
+              NS_LOG_LOGIC ("SyncRef was not detected during SyncRef search/scanning... Ignoring");
+              return;
+            }
+          NS_LOG_LOGIC ("S-RSRP measurement in progress, adding sample");
+          //L1 filtering: linear average, updated incrementally
+          itSyncRef->srsrpNum++;
+          itSyncRef->filteredSrsrp += (s_rsrp_W - itSyncRef->filteredSrsrp) / itSyncRef->srsrpNum;
         }
     }
   else
@@ -2519,6 +2631,32 @@ LteUePhy::ReceiveSlss (uint16_t slssid, Ptr<SpectrumValue> p)
     }
 }
 
+std::vector<LteUePhy::SyncRefEntry>::iterator
+LteUePhy::FindSyncRef (uint16_t slssid, uint16_t offset)
+{
+  std::vector<SyncRefEntry>::iterator it;
+  for (it = m_syncRefTable.begin (); it != m_syncRefTable.end (); it++)
+    {
+      if (it->slssid == slssid && it->offset == offset)
+        {
+          break;
+        }
+    }
+  return it;
+}
+
+bool
+LteUePhy::SyncRefHigherSrsrp (const SyncRefEntry &a, const SyncRefEntry &b)
+{
+  return a.detectedSrsrp > b.detectedSrsrp;
+}
+
+bool
+LteUePhy::SyncRefLowerId (const SyncRefEntry &a, const SyncRefEntry &b)
+{
+  return (a.slssid < b.slssid) || (a.slssid == b.slssid && a.offset < b.offset);
+}
+
 void
 LteUePhy::SetUeSlssInterScanningPeriodMax (Time t)
 {
@@ -2549,70 +2687,64 @@ LteUePhy::EndSlssScanning ()
   m_ueSlssScanningInProgress = false;
 
   //Filter to keep only the SyncRefs with received MIB-SL
-  std::map <std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator itDetectionMap;
-  for (itDetectionMap = m_ueSlssDetectionMap.begin (); itDetectionMap != m_ueSlssDetectionMap.end ();itDetectionMap++)
+  std::vector<SyncRefEntry>::iterator itSyncRef = m_syncRefTable.begin ();
+  while (itSyncRef != m_syncRefTable.end ())
     {
-      NS_LOG_LOGIC ("UE RNTI "<<m_rnti<<" detected SyncRef with SLSSID "<<itDetectionMap->first.first <<" offset " << itDetectionMap->first.second <<" S-RSRP "<< itDetectionMap->second.srsrpSum / itDetectionMap->second.srsrpNum);
-      std::map <std::pair<uint16_t, uint16_t>, LteRrcSap::MasterInformationBlockSL>::iterator itMap =
-          m_detectedMibSl.find (std::pair<uint16_t, uint16_t>(itDetectionMap->first.first, itDetectionMap->first.second));
-      //If the MIB-SL wasn't received, erase it from the detection map
-      if (itMap == m_detectedMibSl.end ())
+      NS_LOG_LOGIC ("UE RNTI " << m_rnti << " detected SyncRef with SLSSID " << itSyncRef->slssid << " offset " << itSyncRef->offset << " S-RSRP " << itSyncRef->detectedSrsrp);
+      //If the MIB-SL wasn't received, erase it from the SyncRef table
+      if (m_detectedMibSl.find (std::pair<uint16_t, uint16_t> (itSyncRef->slssid, itSyncRef->offset)) == m_detectedMibSl.end ())
         {
           NS_LOG_LOGIC ("MIB-SL was not found... Removing from detection list");
-          m_ueSlssDetectionMap.erase(itDetectionMap);
+          itSyncRef = m_syncRefTable.erase (itSyncRef);
+        }
+      else
+        {
+          itSyncRef++;
         }
     }
 
-  //Select the 6 SyncRefs with higher S-RSRP. Remove the others form the detected list
-  std::map <double, std::pair<uint16_t, uint16_t> > tmp;
-  for (itDetectionMap = m_ueSlssDetectionMap.begin (); itDetectionMap != m_ueSlssDetectionMap.end ();itDetectionMap++)
-    {
-      tmp.insert (std::pair<double, std::pair<uint16_t, uint16_t> >(itDetectionMap->second.srsrpSum / itDetectionMap->second.srsrpNum, itDetectionMap->first));
-    }
-  while (tmp.size () > 6)
+  //Select the 6 SyncRefs with higher S-RSRP. Remove the others from the table
+  if (m_syncRefTable.size () > SYNC_REF_MEASURED)
     {
-      NS_LOG_LOGIC ("The UE detected more than 6 SyncRefs... Removing lowest S-RSRP SyncRef: SLSSID"<< tmp.begin ()->second.first <<"ofset "<<tmp.begin ()->second.second<< "S-RSRP " <<tmp.begin ()->first);
-      tmp.erase(tmp.begin ()->first);
+      std::nth_element (m_syncRefTable.begin (), m_syncRefTable.begin () + SYNC_REF_MEASURED - 1,
+                        m_syncRefTable.end (), &LteUePhy::SyncRefHigherSrsrp);
+      NS_LOG_LOGIC ("The UE detected more than " << (uint16_t) SYNC_REF_MEASURED << " SyncRefs... Removing "
+                    << m_syncRefTable.size () - SYNC_REF_MEASURED << " SyncRefs with lowest S-RSRP");
+      m_syncRefTable.resize (SYNC_REF_MEASURED);
     }
-  std::map <std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement> ret;
-  std::map <double, std::pair<uint16_t, uint16_t> >::iterator itTmp;
-  for (itTmp = tmp.begin (); itTmp != tmp.end (); itTmp++)
+  //Keep the SyncRefs ordered by SLSSID and offset, which is the order of the report
+  std::sort (m_syncRefTable.begin (), m_syncRefTable.end (), &LteUePhy::SyncRefLowerId);
+
+  //The S-RSRP measured during scanning is used as first measurement
+  for (itSyncRef = m_syncRefTable.begin (); itSyncRef != m_syncRefTable.end (); itSyncRef++)
     {
-      std::map<std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator
-      itDetectionMapTwo = m_ueSlssDetectionMap.find (itTmp->second);
-      if (itDetectionMapTwo != m_ueSlssDetectionMap.end ())
-        {
-          ret.insert (std::pair<std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement> (itDetectionMapTwo->first, itDetectionMapTwo->second));
-        }
+      itSyncRef->filteredSrsrp = itSyncRef->detectedSrsrp;
+      itSyncRef->srsrpNum = 1;
     }
 
-  m_ueSlssDetectionMap = ret; // It contains now only the 6 SyncRefs with higher S-RSRP
-  m_ueSlssMeasurementsMap= ret;// It contains now only the 6 SyncRefs with higher S-RSRP (we use the S-RSRP measurements during scanning as first measurements)
-
-  uint32_t nDetectedSyncRef = m_ueSlssDetectionMap.size ();
+  uint32_t nDetectedSyncRef = m_syncRefTable.size ();
 
   if (nDetectedSyncRef > 0)
     {
       NS_LOG_LOGIC ("At least one SyncRef detected, creating measurement schedule and starting measurement sub-process");
       //Create measurement schedule
-      std::map <std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator itMeasMap;
-      for (itMeasMap = m_ueSlssMeasurementsMap.begin (); itMeasMap != m_ueSlssMeasurementsMap.end (); itMeasMap++)
+      for (itSyncRef = m_syncRefTable.begin (); itSyncRef != m_syncRefTable.end (); itSyncRef++)
         {
           uint16_t currOffset = Simulator::Now ().GetMilliSeconds () % 40;
           int64_t t;
-          if ( currOffset < itMeasMap->first.second)
+          if ( currOffset < itSyncRef->offset)
             {
-              t = Simulator::Now ().GetMilliSeconds () + (itMeasMap->first.second - currOffset);
+              t = Simulator::Now ().GetMilliSeconds () + (itSyncRef->offset - currOffset);
             }
           else
             {
-              t = Simulator::Now ().GetMilliSeconds () + (40 - currOffset + itMeasMap->first.second);
+              t = Simulator::Now ().GetMilliSeconds () + (40 - currOffset + itSyncRef->offset);
             }
           uint16_t count = 1;
           while (t < (Simulator::Now ().GetMilliSeconds ()+ m_ueSlssMeasurementPeriod.GetMilliSeconds () - 40))
             {
-              NS_LOG_INFO ("UE RNTI "<<m_rnti<<" will measure S-RSRP of SyncRef SLSSID "<< itMeasMap->first.first<<" offset "<< itMeasMap->first.second<<" at t:"<< t<<" ms");
-              m_ueSlssMeasurementsSched.insert (std::pair<int64_t, std::pair<uint16_t, uint16_t> >(t,itMeasMap->first));
+              NS_LOG_INFO ("UE RNTI "<<m_rnti<<" will measure S-RSRP of SyncRef SLSSID "<< itSyncRef->slssid<<" offset "<< itSyncRef->offset<<" at t:"<< t<<" ms");
+              m_ueSlssMeasurementsSched.insert (std::pair<int64_t, std::pair<uint16_t, uint16_t> >(t, std::pair<uint16_t, uint16_t> (itSyncRef->slssid, itSyncRef->offset)));
               count ++;
               if (count > m_nSamplesSrsrpMeas)
                 {
@@ -2656,27 +2788,29 @@ LteUePhy::ReportSlssMeasurements (uint64_t slssid, uint16_t offset)
   NS_LOG_FUNCTION (this);
 
   LteUeCphySapUser::UeSlssMeasurementsParameters ret;
-  std::map<std::pair<uint16_t, uint16_t>, UeSlssMeasurementsElement>::iterator it;
+  std::vector<SyncRefEntry>::iterator it;
 
   if (slssid == 0) //Report all
     {
       NS_LOG_LOGIC ("End of S-RSRP measurement corresponding to the measurement sub-process... Reporting L1 filtered S-RSRP values of detected SyncRefs");
 
-      for (it = m_ueSlssMeasurementsMap.begin (); it != m_ueSlssMeasurementsMap.end (); it++)
+      for (it = m_syncRefTable.begin (); it != m_syncRefTable.end (); it++)
         {
-          //L1 filtering: linear average
-          double avg_s_rsrp_W = (*it).second.srsrpSum / static_cast<double> ((*it).second.srsrpNum);
+          if (it->srsrpNum == 0)
+            {
+              continue;
+            }
           //The stored values are in W, the report to the RRC should be in dBm
-          double avg_s_rsrp_dBm = 10 * log10 (1000 * (avg_s_rsrp_W));
+          double avg_s_rsrp_dBm = 10 * log10 (1000 * (it->filteredSrsrp));
 
           NS_LOG_INFO ("UE RNTI "<<m_rnti<< " report SyncRef with SLSSID "
-                      << (*it).first.first << " offset "<< (*it).first.second << " L1 filtered S-RSRP " << avg_s_rsrp_dBm
-                      << " from " << (double) (*it).second.srsrpNum <<" samples");
+                      << it->slssid << " offset "<< it->offset << " L1 filtered S-RSRP " << avg_s_rsrp_dBm
+                      << " from " << it->srsrpNum <<" samples");
 
           LteUeCphySapUser::UeSlssMeasurementsElement newEl;
-          newEl.m_slssid = (*it).first.first;
+          newEl.m_slssid = it->slssid;
           newEl.m_srsrp = avg_s_rsrp_dBm;
-          newEl.m_offset = (*it).first.second;
+          newEl.m_offset = it->offset;
           ret.m_ueSlssMeasurementsList.push_back(newEl);
         }
 
@@ -2686,22 +2820,20 @@ LteUePhy::ReportSlssMeasurements (uint64_t slssid, uint16_t offset)
       NS_LOG_LOGIC ("End of S-RSRP measurement corresponding to the evaluation sub-process");
       NS_LOG_LOGIC ("Reporting L1 filtered S-RSRP values of the SyncRef SLSSID " << slssid <<" offset "<<offset);
 
-      it = m_ueSlssMeasurementsMap.find (std::pair<uint16_t, uint16_t> (slssid, offset));
-      if (it != m_ueSlssMeasurementsMap.end ())
+      it = FindSyncRef (slssid, offset);
+      if (it != m_syncRefTable.end () && it->srsrpNum > 0)
         {
-          //L1 filtering: linear average
-          double avg_s_rsrp_W = (*it).second.srsrpSum / static_cast<double> ((*it).second.srsrpNum);
           //The stored values are in W, the report to the RRC should be in dBm
-          double avg_s_rsrp_dBm = 10 * log10(1000 * (avg_s_rsrp_W));
+          double avg_s_rsrp_dBm = 10 * log10(1000 * (it->filteredSrsrp));
 
           NS_LOG_INFO(Simulator::Now ().GetMilliSeconds ()<< " UE RNTI "<<m_rnti<< " Report SyncRef with SLSSID "
-                      << (*it).first.first << " offset "<< (*it).first.second << " L1 filtered S-RSRP " << avg_s_rsrp_dBm
-                      << " from " << (double) (*it).second.srsrpNum <<" samples");
+                      << it->slssid << " offset "<< it->offset << " L1 filtered S-RSRP " << avg_s_rsrp_dBm
+                      << " from " << it->srsrpNum <<" samples");
 
           LteUeCphySapUser::UeSlssMeasurementsElement newEl;
-          newEl.m_slssid = (*it).first.first;
+          newEl.m_slssid = it->slssid;
           newEl.m_srsrp = avg_s_rsrp_dBm;
-          newEl.m_offset = (*it).first.second;
+          newEl.m_offset = it->offset;
           ret.m_ueSlssMeasurementsList.push_back(newEl);
         }
     }
@@ -2710,7 +2842,11 @@ LteUePhy::ReportSlssMeasurements (uint64_t slssid, uint16_t offset)
   m_ueCphySapUser->ReportSlssMeasurements(ret,slssid,offset);
 
   //Cleaning for next process
-  m_ueSlssMeasurementsMap.clear ();
+  for (it = m_syncRefTable.begin (); it != m_syncRefTable.end (); it++)
+    {
+      it->filteredSrsrp = 0.0;
+      it->srsrpNum = 0;
+    }
   m_ueSlssMeasurementsSched.clear ();
   m_ueSlssMeasurementInProgress = false;
 
@@ -2751,7 +2887,7 @@ LteUePhy::ReportSlssMeasurements (uint64_t slssid, uint16_t offset)
   else
     {
       //End of the selection+evaluation process, reinitialize variables for next process and schedule it
-      m_ueSlssDetectionMap.clear ();
+      m_syncRefTable.clear ();
 
       if (m_currNMeasPeriods ==1)
         {
@@ -34,6 +34,7 @@
 #include <ns3/ptr.h>
 #include <ns3/lte-amc.h>
 #include <set>
+#include <vector>
 #include <ns3/lte-ue-power-control.h>
 
 
@@ -440,6 +441,28 @@ private:
    */
   void ReportUeMeasurements ();
 
+  /**
+   * \param cellId the ID of a cell
+   * \returns the index in m_ueMeasurements of the first cell whose ID is
+   *          not less than cellId
+   */
+  uint32_t FindUeMeasurements (uint16_t cellId) const;
+
+  /**
+   * \brief Store an RSRP sample of a cell for layer-1 filtering.
+   *
+   * If the number of measured cells is limited by the
+   * *UeMeasurementsMaxCells* attribute and all the neighbour cells are
+   * measured, the sample of a new neighbour cell replaces the weakest
+   * measured neighbour cell only if it exceeds its RSRP by the
+   * *UeMeasurementsHysteresis* attribute, and is dropped otherwise.
+   * The serving cell is always measured.
+   *
+   * \param cellId the ID of the cell
+   * \param rsrp the RSRP sample [dBm]
+   */
+  void StoreRsrpSample (uint16_t cellId, double rsrp);
+
   /**
    * Switch the UE PHY to the given state.
    * \param s The destination state
@@ -693,17 +716,32 @@ private:
   /// Summary results of measuring a specific cell. Used for layer-1 filtering.
   struct UeMeasurementsElement
   {
+    uint16_t cellId;  ///< ID of the measured cell.
     double rsrpSum;   ///< Sum of RSRP sample values in linear unit.
     uint8_t rsrpNum;  ///< Number of RSRP samples.
     double rsrqSum;   ///< Sum of RSRQ sample values in linear unit.
     uint8_t rsrqNum;  ///< Number of RSRQ samples.
+    double rsrpLast;  ///< RSRP reported at the end of the previous period.
   };
 
   /**
-   * Store measurement results during the last layer-1 filtering period.
-   * Indexed by the cell ID where the measurements come from.
+   * Store measurement results during the last layer-1 filtering period,
+   * sorted by the cell ID where the measurements come from.  The cells
+   * reported at the end of the previous period are kept with no samples,
+   * and are removed at the end of this period if they were not heard.
+   */
+  std::vector<UeMeasurementsElement> m_ueMeasurements;
+  /**
+   * The `UeMeasurementsMaxCells` attribute. Maximum number of neighbour
+   * cells measured besides the serving cell, 0 for all the cells heard.
+   */
+  uint16_t m_ueMeasurementsMaxCells;
+  /**
+   * The `UeMeasurementsHysteresis` attribute. Margin in dB by which the
+   * RSRP of a cell which is not measured must exceed the RSRP of the
+   * weakest measured neighbour cell to replace it.
    */
-  std::map <uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+  double m_ueMeasurementsHysteresis;
   /**
    * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
    * measurements, i.e., the length of layer-1 filtering (default 200 ms).
@@ -848,29 +886,60 @@ private:
  std::list<uint32_t> m_discRxApps; ///< List of discovery Rx applications
 
  /**
-  * Summary results of measuring a specific SyncRef. Used for layer-1 filtering.
+  * Entry of the SyncRef table. A SyncRef is identified by its SLSSID and the
+  * offset it uses for transmitting the SLSSs
   */
- struct UeSlssMeasurementsElement
+ struct SyncRefEntry
  {
-   double srsrpSum;   ///< Sum of S-RSRP sample values in linear unit.
-   uint8_t srsrpNum;  ///< Number of S-RSRP samples.
+   uint16_t slssid;         ///< SLSSID of the SyncRef
+   uint16_t offset;         ///< Offset of the SLSS transmissions of the SyncRef
+   double detectedSrsrp;    ///< S-RSRP detected during the scanning, in linear unit
+   double filteredSrsrp;    ///< L1 filtered (averaged) S-RSRP of the current measurement, in linear unit
+   uint16_t srsrpNum;       ///< Number of S-RSRP samples of the current measurement
  };
  /**
-  * Stores the S-RSRP information of the SyncRefs detected during the scanning process,
-  * indexed by the SLSSID of the SyncRef and the offset it uses for transmitting the SLSSs
+  * Find a SyncRef in the SyncRef table
+  * \param slssid The SLSSID of the SyncRef
+  * \param offset The offset of the SyncRef
+  * \return The entry of the SyncRef, or m_syncRefTable.end () if not found
   */
- std::map <std::pair<uint16_t,uint16_t>, UeSlssMeasurementsElement> m_ueSlssDetectionMap;
+ std::vector<SyncRefEntry>::iterator FindSyncRef (uint16_t slssid, uint16_t offset);
+ /**
+  * Compare two SyncRefs by their S-RSRP detected during the scanning
+  * \param a The first SyncRef
+  * \param b The second SyncRef
+  * \return True if the S-RSRP of a is higher than the one of b
+  */
+ static bool SyncRefHigherSrsrp (const SyncRefEntry &a, const SyncRefEntry &b);
+ /**
+  * Compare two SyncRefs by their identifiers (SLSSID and offset)
+  * \param a The first SyncRef
+  * \param b The second SyncRef
+  * \return True if the identifier of a is lower than the one of b
+  */
+ static bool SyncRefLowerId (const SyncRefEntry &a, const SyncRefEntry &b);
+ /**
+  * Maximum number of SyncRefs tracked during the SyncRef search/scanning.
+  * When the table is full, a newly detected SyncRef replaces the weakest
+  * one if its S-RSRP is higher
+  */
+ static const uint8_t SYNC_REF_TABLE_CAPACITY = 32;
+ /**
+  * Number of SyncRefs with highest S-RSRP kept for the measurement sub-process
+  */
+ static const uint8_t SYNC_REF_MEASURED = 6;
+ /**
+  * The SyncRefs detected during the scanning process and their S-RSRP
+  * measurements. The S-RSRP samples are averaged incrementally when they are
+  * received, so no sample nor per-SLSS state is stored
+  */
+ std::vector<SyncRefEntry> m_syncRefTable;
  /**
   * Represents the S-RSRP measurement schedule for the current measurement process.
   * It is used for knowing when the UE needs to take samples of the detected SyncRefs S-RSRP.
   * The index is the simulation time and the elements are the SyncRef identifiers (SLSSID and offset)
   */
  std::map <int64_t, std::pair<uint16_t,uint16_t> > m_ueSlssMeasurementsSched;
- /**
-  * Stores the S-RSRP information of the SyncRefs in measurement during the measurement process
-  * indexed by the SLSSID of the SyncRef and the offset it uses for transmitting the SLSSs
-  */
- std::map <std::pair<uint16_t,uint16_t>, UeSlssMeasurementsElement> m_ueSlssMeasurementsMap;
  /**
   * Time period for searching/scanning to detect available SyncRefs (supporting SyncRef selection)
   */
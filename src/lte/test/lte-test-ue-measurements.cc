@@ -1923,3 +1923,148 @@ LteUeMeasurementsHandoverTestCase::RecvMeasurementReportCallback (
     } // end of if (report.measResults.measId == correctMeasId)
 
 } // end of void LteUeMeasurementsHandoverTestCase::RecvMeasurementReportCallback
+
+
+
+// ===== LTE-UE-MEASUREMENTS-PRUNING TEST SUITE ============================ //
+
+/*
+ * Test Suite
+ */
+
+LteUeMeasurementsPruningTestSuite::LteUeMeasurementsPruningTestSuite ()
+  : TestSuite ("lte-ue-measurements-pruning", SYSTEM)
+{
+  std::set<uint16_t> expectedCellIds;
+
+  // all the cells
+  expectedCellIds.insert (1);
+  expectedCellIds.insert (2);
+  expectedCellIds.insert (3);
+  expectedCellIds.insert (4);
+  expectedCellIds.insert (5);
+  AddTestCase (new LteUeMeasurementsPruningTestCase ("Serving cell 1, all cells", 1, 0, expectedCellIds), TestCase::QUICK);
+
+  // the serving cell and the 2 strongest neighbours
+  expectedCellIds.clear ();
+  expectedCellIds.insert (1);
+  expectedCellIds.insert (2);
+  expectedCellIds.insert (3);
+  AddTestCase (new LteUeMeasurementsPruningTestCase ("Serving cell 1, 2 neighbours", 1, 2, expectedCellIds), TestCase::QUICK);
+
+  // the serving cell is kept although it is not among the strongest
+  expectedCellIds.clear ();
+  expectedCellIds.insert (1);
+  expectedCellIds.insert (4);
+  AddTestCase (new LteUeMeasurementsPruningTestCase ("Serving cell 4, 1 neighbour", 4, 1, expectedCellIds), TestCase::QUICK);
+
+} // end of LteUeMeasurementsPruningTestSuite::LteUeMeasurementsPruningTestSuite
+
+static LteUeMeasurementsPruningTestSuite lteUeMeasurementsPruningTestSuite;
+
+
+/*
+ * Test Case
+ */
+
+LteUeMeasurementsPruningTestCase::LteUeMeasurementsPruningTestCase (
+  std::string name, uint16_t servingCellId, uint16_t maxCells,
+  std::set<uint16_t> expectedCellIds)
+  : TestCase (name),
+    m_servingCellId (servingCellId),
+    m_maxCells (maxCells),
+    m_expectedCellIds (expectedCellIds)
+{
+  NS_LOG_INFO (this << " name=" << name);
+}
+
+LteUeMeasurementsPruningTestCase::~LteUeMeasurementsPruningTestCase ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LteUeMeasurementsPruningTestCase::DoRun ()
+{
+  NS_LOG_INFO (this << " " << GetName ());
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel",
+                           StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+
+  //Disable Uplink Power Control
+  Config::SetDefault ("ns3::LteUePhy::EnableUplinkPowerControl", BooleanValue (false));
+
+  // Disable control channel error model
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled",
+                      BooleanValue (false));
+
+  // Create Nodes: eNodeB and UE
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (5);
+  ueNodes.Create (1);
+
+  // the eNodeBs surround the UE, the RSRP of cell i being 6 dB above cell i + 1
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (100.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, -200.0, 0.0));
+  positionAlloc->Add (Vector (-400.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, 800.0, 0.0));
+  positionAlloc->Add (Vector (1600.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0)); // UE
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  // Create Devices and install them in the Nodes (eNB and UE)
+  NetDeviceContainer enbDevs;
+  NetDeviceContainer ueDevs;
+  enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  Ptr<LteUePhy> uePhy = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetPhy ();
+  uePhy->SetAttribute ("UeMeasurementsMaxCells", UintegerValue (m_maxCells));
+
+  // Attach UE to the serving eNodeB
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (m_servingCellId - 1));
+
+  uePhy->TraceConnect ("ReportUeMeasurements", "",
+                       MakeCallback (&LteUeMeasurementsPruningTestCase::ReportUeMeasurementsCallback,
+                                     this));
+
+  // measurements reported at 200, 400, 600, 800 and 1000 ms
+  Simulator::Stop (Seconds (1.050));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // every expected cell is reported in the last 3 periods
+  std::set<uint16_t>::const_iterator it;
+  for (it = m_expectedCellIds.begin (); it != m_expectedCellIds.end (); it++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_numReports[*it], 3u,
+                             "Wrong number of reports of cellId " << *it);
+    }
+
+} // end of void LteUeMeasurementsPruningTestCase::DoRun ()
+
+void
+LteUeMeasurementsPruningTestCase::ReportUeMeasurementsCallback (
+  std::string context, uint16_t rnti, uint16_t cellId, double rsrp, double rsrq,
+  bool servingCell, uint8_t componentCarrierId)
+{
+  NS_LOG_DEBUG (this << " cellId=" << cellId << " rsrp=" << rsrp
+                     << " rsrq=" << rsrq << " servingCell=" << servingCell);
+
+  // need to allow for the first filtering period after attachment
+  if (Simulator::Now () > MilliSeconds (400))
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_expectedCellIds.count (cellId), 1u,
+                             "Unexpected report of cellId " << cellId);
+      NS_TEST_ASSERT_MSG_EQ (servingCell, (cellId == m_servingCellId),
+                             "Wrong serving cell flag of cellId " << cellId);
+      m_numReports[cellId]++;
+    }
+}
@@ -29,6 +29,7 @@
 #include <ns3/lte-rrc-sap.h>
 #include <ns3/nstime.h>
 #include <list>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -543,4 +544,78 @@ private:
 
 }; // end of class LteUeMeasurementsHandoverTestCase
 
+
+
+// ===== LTE-UE-MEASUREMENTS-PRUNING TEST SUITE ============================ //
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for generating calls to UE measurements test case
+ *        ns3::LteUeMeasurementsPruningTestCase.
+ */
+class LteUeMeasurementsPruningTestSuite : public TestSuite
+{
+public:
+  LteUeMeasurementsPruningTestSuite ();
+};
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Testing the number of cells measured by the UE PHY, with 5 eNodeBs
+ *        at 100, 200, 400, 800 and 1600 m of 1 UE, i.e., 6 dB apart.
+ *
+ * The UE is attached to the given eNodeB, and the
+ * `LteUePhy::UeMeasurementsMaxCells` attribute limits the number of
+ * neighbour cells measured.  Every layer-1 filtering period, the UE PHY
+ * must report the serving cell and the strongest neighbour cells only.
+ */
+class LteUeMeasurementsPruningTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the reference name
+   * \param servingCellId the cell ID of the serving eNodeB
+   * \param maxCells the value of the `UeMeasurementsMaxCells` attribute
+   * \param expectedCellIds the cell IDs expected in the reports
+   */
+  LteUeMeasurementsPruningTestCase (std::string name, uint16_t servingCellId,
+                                    uint16_t maxCells,
+                                    std::set<uint16_t> expectedCellIds);
+
+  virtual ~LteUeMeasurementsPruningTestCase ();
+
+  /**
+   * \brief Triggers when the UE PHY reports the measurements of a cell,
+   *        then checks that the cell is expected.
+   *
+   * \param context the context
+   * \param rnti the RNTI
+   * \param cellId the cell ID
+   * \param rsrp the RSRP
+   * \param rsrq the RSRQ
+   * \param servingCell true if the cell is the serving cell
+   * \param componentCarrierId the component carrier ID
+   */
+  void ReportUeMeasurementsCallback (std::string context, uint16_t rnti,
+                                     uint16_t cellId, double rsrp, double rsrq,
+                                     bool servingCell, uint8_t componentCarrierId);
+
+private:
+  virtual void DoRun ();
+
+  uint16_t m_servingCellId; ///< the cell ID of the serving eNodeB
+  uint16_t m_maxCells; ///< the maximum number of neighbour cells measured
+  std::set<uint16_t> m_expectedCellIds; ///< the cell IDs expected in the reports
+  std::map<uint16_t, uint32_t> m_numReports; ///< the number of reports of each cell
+
+}; // end of class LteUeMeasurementsPruningTestCase
+
 #endif /* LTE_TEST_UE_MEASUREMENTS_H */
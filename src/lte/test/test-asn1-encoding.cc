@@ -1115,6 +1115,219 @@ MeasurementReportTestCase::DoRun (void)
   packet = 0;
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Header encoding integers of 1 to 20 bits, each followed by a
+ * boolean, with bitstrings of 32 and 27 bits in the middle, so that
+ * the elements straddle the words of the bit writer and reader.
+ */
+class Asn1BitsTestHeader : public Asn1Header
+{
+public:
+  Asn1BitsTestHeader ();
+  virtual void PreSerialize (void) const;
+  virtual uint32_t Deserialize (Buffer::Iterator bIterator);
+  virtual void Print (std::ostream &os) const;
+
+  static const int NUM_INTEGERS = 20; ///< number of integers
+
+  int m_integers[NUM_INTEGERS]; ///< the integer of i + 1 bits at index i
+  bool m_booleans[NUM_INTEGERS]; ///< the boolean following each integer
+  std::bitset<32> m_bitstring32; ///< bitstring following the 10th integer
+  std::bitset<27> m_bitstring27; ///< bitstring following the 15th integer
+};
+
+Asn1BitsTestHeader::Asn1BitsTestHeader ()
+{
+  for (int i = 0; i < NUM_INTEGERS; i++)
+    {
+      m_integers[i] = 0;
+      m_booleans[i] = false;
+    }
+}
+
+void
+Asn1BitsTestHeader::PreSerialize (void) const
+{
+  for (int i = 0; i < NUM_INTEGERS; i++)
+    {
+      SerializeInteger (m_integers[i], 0, (1 << (i + 1)) - 1);
+      SerializeBoolean (m_booleans[i]);
+      if (i == 9)
+        {
+          SerializeBitstring (m_bitstring32);
+        }
+      if (i == 14)
+        {
+          SerializeBitstring (m_bitstring27);
+        }
+    }
+  FinalizeSerialization ();
+}
+
+uint32_t
+Asn1BitsTestHeader::Deserialize (Buffer::Iterator bIterator)
+{
+  for (int i = 0; i < NUM_INTEGERS; i++)
+    {
+      bIterator = DeserializeInteger (&m_integers[i], 0, (1 << (i + 1)) - 1, bIterator);
+      bIterator = DeserializeBoolean (&m_booleans[i], bIterator);
+      if (i == 9)
+        {
+          bIterator = DeserializeBitstring (&m_bitstring32, bIterator);
+        }
+      if (i == 14)
+        {
+          bIterator = DeserializeBitstring (&m_bitstring27, bIterator);
+        }
+    }
+  return GetSerializedSize ();
+}
+
+void
+Asn1BitsTestHeader::Print (std::ostream &os) const
+{
+  for (int i = 0; i < NUM_INTEGERS; i++)
+    {
+      os << m_integers[i] << " " << m_booleans[i] << " ";
+    }
+  os << m_bitstring32 << " " << m_bitstring27;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the packing of the bits: the encoding of Asn1BitsTestHeader
+ * is compared with a reference encoding written one bit at a time, and
+ * decoded back, and an RRC message decoded then encoded again must give
+ * the same octets.
+ */
+class Asn1BitPackingTestCase : public RrcHeaderTestCase
+{
+public:
+  Asn1BitPackingTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Append the numBits least significant bits of a value to a bit
+   * string, most significant bit first.
+   * \param bits the bit string
+   * \param value the value
+   * \param numBits the number of bits
+   */
+  static void AppendBits (std::vector<bool> &bits, uint32_t value, int numBits);
+  /**
+   * \param pkt the packet
+   * \returns the contents of the packet
+   */
+  static std::vector<uint8_t> GetContents (Ptr<Packet> pkt);
+};
+
+Asn1BitPackingTestCase::Asn1BitPackingTestCase () : RrcHeaderTestCase ("Testing Asn1BitPacking")
+{
+}
+
+void
+Asn1BitPackingTestCase::AppendBits (std::vector<bool> &bits, uint32_t value, int numBits)
+{
+  for (int j = numBits - 1; j >= 0; j--)
+    {
+      bits.push_back ((value >> j) & 1);
+    }
+}
+
+std::vector<uint8_t>
+Asn1BitPackingTestCase::GetContents (Ptr<Packet> pkt)
+{
+  std::vector<uint8_t> contents (pkt->GetSize ());
+  pkt->CopyData (&contents[0], contents.size ());
+  return contents;
+}
+
+void
+Asn1BitPackingTestCase::DoRun (void)
+{
+  NS_LOG_DEBUG ("============= Asn1BitPackingTestCase ===========");
+
+  Asn1BitsTestHeader source;
+  std::vector<bool> bits;
+  for (int i = 0; i < Asn1BitsTestHeader::NUM_INTEGERS; i++)
+    {
+      // alternate all ones and a pattern starting with a one
+      int mask = (1 << (i + 1)) - 1;
+      source.m_integers[i] = (i % 2) ? mask : (0x5a5a5 | (1 << i)) & mask;
+      source.m_booleans[i] = (i % 3 == 0);
+      AppendBits (bits, source.m_integers[i], i + 1);
+      AppendBits (bits, source.m_booleans[i], 1);
+      if (i == 9)
+        {
+          source.m_bitstring32 = std::bitset<32> (0x80c0ffeeUL);
+          AppendBits (bits, source.m_bitstring32.to_ulong (), 32);
+        }
+      if (i == 14)
+        {
+          source.m_bitstring27 = std::bitset<27> (0x5deca1fUL);
+          AppendBits (bits, source.m_bitstring27.to_ulong (), 27);
+        }
+    }
+  std::vector<uint8_t> reference ((bits.size () + 7) / 8, 0);
+  for (uint32_t i = 0; i < bits.size (); i++)
+    {
+      reference[i / 8] |= bits[i] << (7 - i % 8);
+    }
+
+  packet = Create<Packet> ();
+  packet->AddHeader (source);
+  TestUtils::LogPacketContents (packet);
+  std::vector<uint8_t> contents = GetContents (packet);
+  NS_TEST_ASSERT_MSG_EQ (source.GetSerializedSize (), reference.size (), "Different serialized size!");
+  NS_TEST_ASSERT_MSG_EQ (contents.size (), reference.size (), "Different packet size!");
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t) contents[i], (uint32_t) reference[i], "Different octet " << i << "!");
+    }
+
+  // the header encodes the same octets again
+  Ptr<Packet> again = Create<Packet> ();
+  again->AddHeader (source);
+  NS_TEST_ASSERT_MSG_EQ ((GetContents (again) == contents), true, "Different second encoding!");
+
+  Asn1BitsTestHeader destination;
+  packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0u, "Octets left in the packet!");
+  for (int i = 0; i < Asn1BitsTestHeader::NUM_INTEGERS; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (destination.m_integers[i], source.m_integers[i], "Different integer " << i << "!");
+      NS_TEST_ASSERT_MSG_EQ (destination.m_booleans[i], source.m_booleans[i], "Different boolean " << i << "!");
+    }
+  NS_TEST_ASSERT_MSG_EQ (destination.m_bitstring32, source.m_bitstring32, "Different bitstring of 32 bits!");
+  NS_TEST_ASSERT_MSG_EQ (destination.m_bitstring27, source.m_bitstring27, "Different bitstring of 27 bits!");
+
+  // an RRC message is encoded again to the same octets
+  LteRrcSap::RrcConnectionSetup msg;
+  msg.rrcTransactionIdentifier = 3;
+  msg.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  RrcConnectionSetupHeader setupSource;
+  setupSource.SetMessage (msg);
+  packet = Create<Packet> ();
+  packet->AddHeader (setupSource);
+  contents = GetContents (packet);
+  NS_TEST_ASSERT_MSG_EQ (setupSource.GetSerializedSize (), contents.size (), "Different serialized size!");
+  RrcConnectionSetupHeader setupDestination;
+  packet->RemoveHeader (setupDestination);
+  RrcConnectionSetupHeader setupAgain;
+  setupAgain.SetMessage (setupDestination.GetMessage ());
+  again = Create<Packet> ();
+  again->AddHeader (setupAgain);
+  NS_TEST_ASSERT_MSG_EQ ((GetContents (again) == contents), true, "Different encoding of the decoded message!");
+
+  packet = 0;
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -1142,6 +1355,7 @@ Asn1EncodingSuite::Asn1EncodingSuite ()
   AddTestCase (new RrcConnectionReestablishmentCompleteTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionRejectTestCase (), TestCase::QUICK);
   AddTestCase (new MeasurementReportTestCase (), TestCase::QUICK);
+  AddTestCase (new Asn1BitPackingTestCase (), TestCase::QUICK);
 }
 
 Asn1EncodingSuite asn1EncodingSuite;
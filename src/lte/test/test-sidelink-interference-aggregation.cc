@@ -0,0 +1,272 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/object.h"
+#include "ns3/test.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-sidelink-helper.h"
+#include "ns3/lte-sl-preconfig-pool-factory.h"
+#include "ns3/lte-spectrum-value-helper.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-common.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/point-to-point-epc-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/application-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TestSidelinkInterferenceAggregation");
+
+/**
+ * Test case comparing the PSSCH packet reception ratio (PRR) obtained with
+ * the exact Sidelink interference model and with the aggregate interference
+ * approximation (LteSlInterference::AggregateWeakSignals), on the
+ * wns3-2017-pssch scenario extended with far away interfering UEs.
+ */
+class SidelinkInterferenceAggregationTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param interfererDistance The distance of the interfering UEs in meters
+   * \param rxPowerFloor The RX power floor in dBm of the aggregate mode
+   */
+  SidelinkInterferenceAggregationTestCase (double interfererDistance, double rxPowerFloor);
+  virtual ~SidelinkInterferenceAggregationTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the scenario and compute the PRR of the link of interest
+   *
+   * \param aggregate Whether the aggregate interference mode is enabled
+   * \return The PSSCH PRR at the receiving UE for the TBs of the transmitting UE
+   */
+  double RunScenario (bool aggregate);
+  /**
+   * Sidelink PHY reception trace sink of the receiving UE
+   *
+   * \param params The reception statistics
+   */
+  void SlPhyReception (PhyReceptionStatParameters params);
+
+  double m_interfererDistance; ///< distance of the interfering UEs
+  double m_rxPowerFloor; ///< RX power floor of the aggregate mode (dBm)
+  uint16_t m_txRnti; ///< RNTI of the transmitting UE
+  uint32_t m_nTb; ///< number of TBs of the transmitting UE expected at the receiver
+  uint32_t m_nTbOk; ///< number of TBs of the transmitting UE correctly decoded
+};
+
+SidelinkInterferenceAggregationTestCase::SidelinkInterferenceAggregationTestCase (double interfererDistance, double rxPowerFloor)
+  : TestCase ("PSSCH PRR with aggregate interference, interferers at " + std::to_string (interfererDistance) + " m"),
+    m_interfererDistance (interfererDistance),
+    m_rxPowerFloor (rxPowerFloor),
+    m_txRnti (0),
+    m_nTb (0),
+    m_nTbOk (0)
+{
+}
+
+SidelinkInterferenceAggregationTestCase::~SidelinkInterferenceAggregationTestCase ()
+{
+}
+
+void
+SidelinkInterferenceAggregationTestCase::SlPhyReception (PhyReceptionStatParameters params)
+{
+  if (params.m_rnti == m_txRnti)
+    {
+      m_nTb++;
+      m_nTbOk += params.m_correctness;
+    }
+}
+
+double
+SidelinkInterferenceAggregationTestCase::RunScenario (bool aggregate)
+{
+  m_nTb = 0;
+  m_nTbOk = 0;
+
+  Config::SetDefault ("ns3::LteSlInterference::AggregateWeakSignals", BooleanValue (aggregate));
+  Config::SetDefault ("ns3::LteSlInterference::RxPowerFloor", DoubleValue (m_rxPowerFloor));
+
+  // Same configuration as the wns3-2017-pssch example
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlCtrlErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::SlDataErrorModelEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DropRbOnCollisionEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantMcs", UintegerValue (10));
+  Config::SetDefault ("ns3::LteUeMac::SlGrantSize", UintegerValue (2));
+  Config::SetDefault ("ns3::LteUeMac::Ktrp", UintegerValue (2));
+  Config::SetDefault ("ns3::LteUePhy::TxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::Pcmax", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PscchTxPower", DoubleValue (23.0));
+  Config::SetDefault ("ns3::LteUePowerControl::PsschTxPower", DoubleValue (23.0));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetAttribute ("UseSidelink", BooleanValue (true));
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisPropagationLossModel"));
+  lteHelper->DisableEnbPhy (true);
+  lteHelper->Initialize ();
+
+  double ulFreq = LteSpectrumValueHelper::GetCarrierFrequency (23330);
+  lteHelper->GetUplinkPathlossModel ()->SetAttribute ("Frequency", DoubleValue (ulFreq));
+
+  Ptr<LteSidelinkHelper> proseHelper = CreateObject<LteSidelinkHelper> ();
+  proseHelper->SetLteHelper (lteHelper);
+
+  // UE 0 transmits to UE 1 located at 10 m, the other UEs transmit far away
+  NodeContainer ueNodes;
+  ueNodes.Create (4);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (10.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (m_interfererDistance, 0.0, 1.5));
+  positionAlloc->Add (Vector (-m_interfererDistance, 0.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevs);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+  lteHelper->Attach (ueDevs);
+
+  Ipv4Address groupAddress ("225.0.0.0");
+  UdpClientHelper udpClient (groupAddress, 8000);
+  udpClient.SetAttribute ("MaxPackets", UintegerValue (5000000));
+  udpClient.SetAttribute ("Interval", TimeValue (MilliSeconds (10)));
+  udpClient.SetAttribute ("PacketSize", UintegerValue (200));
+  ApplicationContainer clientApps = udpClient.Install (ueNodes);
+  clientApps.Get (1)->SetStartTime (Seconds (1000.0));
+  clientApps.Get (0)->SetStartTime (Seconds (1.5));
+  clientApps.Get (2)->SetStartTime (Seconds (1.5));
+  clientApps.Get (3)->SetStartTime (Seconds (1.5));
+
+  uint32_t groupL2Address = 0xFF;
+  Ptr<LteSlTft> tft = Create<LteSlTft> (LteSlTft::BIDIRECTIONAL, groupAddress, groupL2Address);
+  proseHelper->ActivateSidelinkBearer (Seconds (1.0), ueDevs, tft);
+
+  Ptr<LteSlUeRrc> ueSidelinkConfiguration = CreateObject<LteSlUeRrc> ();
+  ueSidelinkConfiguration->SetSlEnabled (true);
+  LteRrcSap::SlPreconfiguration preconfiguration;
+  preconfiguration.preconfigGeneral.carrierFreq = 23330;
+  preconfiguration.preconfigGeneral.slBandwidth = 50;
+  preconfiguration.preconfigComm.nbPools = 1;
+  LteSlPreconfigPoolFactory pfactory;
+  pfactory.SetControlBitmap (0xFF);
+  pfactory.SetControlPeriod ("sf40");
+  pfactory.SetDataOffset (8);
+  preconfiguration.preconfigComm.pools[0] = pfactory.CreatePool ();
+  ueSidelinkConfiguration->SetSlPreconfiguration (preconfiguration);
+  lteHelper->InstallSidelinkConfiguration (ueDevs, ueSidelinkConfiguration);
+
+  // The Sidelink RNTI of an out-of-coverage UE is derived from its IMSI
+  m_txRnti = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetImsi () & 0xFFFF;
+  // The EPC helper creates its own nodes, so the node ID of UE 1 is not 1
+  std::ostringstream path;
+  path << "/NodeList/" << ueNodes.Get (1)->GetId ()
+       << "/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/SlSpectrumPhy/SlPhyReception";
+  Config::ConnectWithoutContext (path.str (),
+                                 MakeCallback (&SidelinkInterferenceAggregationTestCase::SlPhyReception, this));
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_GT (m_nTb, 0, "no PSSCH TB of the transmitting UE was received");
+  NS_LOG_INFO ("aggregate=" << aggregate << " TBs=" << m_nTb << " OK=" << m_nTbOk);
+  return m_nTb > 0 ? (double) m_nTbOk / m_nTb : 0;
+}
+
+void
+SidelinkInterferenceAggregationTestCase::DoRun (void)
+{
+  double prrExact = RunScenario (false);
+  double prrAggregate = RunScenario (true);
+
+  // restore the default configuration for the other tests
+  Config::SetDefault ("ns3::LteSlInterference::AggregateWeakSignals", BooleanValue (false));
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (prrAggregate, prrExact, 0.02, "PSSCH PRR with aggregate interference differs from the exact model");
+}
+
+
+/**
+ * Test suite for the aggregate interference approximation of LteSlInterference
+ */
+class SidelinkInterferenceAggregationTestSuite : public TestSuite
+{
+public:
+  SidelinkInterferenceAggregationTestSuite ();
+};
+
+SidelinkInterferenceAggregationTestSuite::SidelinkInterferenceAggregationTestSuite ()
+  : TestSuite ("sidelink-interference-aggregation", SYSTEM)
+{
+  // LogComponentEnable ("TestSidelinkInterferenceAggregation", LOG_LEVEL_ALL);
+
+  // interferers received at about -73 dBm, folded below a -70 dBm floor
+  AddTestCase (new SidelinkInterferenceAggregationTestCase (2000, -70), TestCase::QUICK);
+  // interferers received at about -53 dBm, strong enough to affect the PRR
+  AddTestCase (new SidelinkInterferenceAggregationTestCase (200, -50), TestCase::QUICK);
+}
+
+static SidelinkInterferenceAggregationTestSuite staticSidelinkInterferenceAggregationTestSuite;
@@ -0,0 +1,181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/packet.h>
+#include <ns3/packet-burst.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
+#include <ns3/lte-spectrum-signal-parameters-codec.h>
+#include <ns3/lte-control-messages.h>
+#include <ns3/distributed-spectrum-channel.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TestSidelinkSignalCodec");
+
+/**
+ * \ingroup lte-test
+ *
+ * Check that a sidelink frame sent to the remote ranks of a
+ * DistributedSpectrumChannel is received unchanged.
+ */
+class SidelinkSignalCodecTestCase : public TestCase
+{
+public:
+  SidelinkSignalCodecTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SidelinkSignalCodecTestCase::SidelinkSignalCodecTestCase ()
+  : TestCase ("Serialization of the sidelink frames")
+{
+}
+
+void
+SidelinkSignalCodecTestCase::DoRun (void)
+{
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      frequencies.push_back (1.0e9 + i * 180e3);
+    }
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+  (*psd) = 1e-16;
+
+  Ptr<LteSpectrumSignalParametersSlFrame> frame = Create<LteSpectrumSignalParametersSlFrame> ();
+  frame->duration = MicroSeconds (1000);
+  frame->psd = psd;
+  frame->packetBurst = CreateObject<PacketBurst> ();
+  frame->packetBurst->AddPacket (Create<Packet> (300));
+  frame->packetBurst->AddPacket (Create<Packet> (20));
+  frame->nodeId = 12;
+  frame->groupId = 3;
+  frame->slssId = 301;
+
+  SciListElement_s sci;
+  sci.m_rnti = 7;
+  sci.m_resPscch = 2;
+  sci.m_hopping = 0;
+  sci.m_rbStart = 10;
+  sci.m_rbLen = 4;
+  sci.m_hoppingInfo = 0;
+  sci.m_tbSize = 1256;
+  sci.m_trp = 5;
+  sci.m_mcs = 12;
+  sci.m_timing = 0;
+  sci.m_groupDstId = 3;
+  Ptr<SciLteControlMessage> sciMsg = Create<SciLteControlMessage> ();
+  sciMsg->SetSci (sci);
+  frame->ctrlMsgList.push_back (sciMsg);
+
+  LteRrcSap::MasterInformationBlockSL mib;
+  mib.slBandwidth = 50;
+  mib.directFrameNo = 512;
+  mib.directSubframeNo = 3;
+  mib.inCoverage = false;
+  mib.slssid = 301;
+  mib.rxTimestamp = MilliSeconds (40);
+  mib.creationTimestamp = MilliSeconds (39);
+  mib.rxOffset = 9;
+  Ptr<MibSlLteControlMessage> mibMsg = Create<MibSlLteControlMessage> ();
+  mibMsg->SetMibSL (mib);
+  frame->ctrlMsgList.push_back (mibMsg);
+
+  SlDiscMsg disc;
+  disc.m_rnti = 7;
+  disc.m_resPsdch = 1;
+  disc.m_msgType = 0x41;
+  disc.m_proSeAppCode = std::bitset<184> (0xabcdef);
+  disc.m_proSeAppCode[183] = 1;
+  disc.m_mic = 0x12345678;
+  disc.m_utcBasedCounter = 9;
+  Ptr<SlDiscMessage> discMsg = Create<SlDiscMessage> ();
+  discMsg->SetSlDiscMessage (disc);
+  frame->ctrlMsgList.push_back (discMsg);
+
+  Buffer buffer;
+  DistributedSpectrumChannel::SerializeSignal (frame, buffer);
+  Ptr<LteSpectrumSignalParametersSlFrame> rxFrame = DynamicCast<LteSpectrumSignalParametersSlFrame> (
+      DistributedSpectrumChannel::DeserializeSignal (buffer.Begin (), model));
+
+  NS_TEST_ASSERT_MSG_NE (rxFrame, 0, "wrong type of signal parameters");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->duration, frame->duration, "wrong duration");
+  NS_TEST_ASSERT_MSG_EQ ((*rxFrame->psd)[5], (*psd)[5], "wrong power spectral density");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->nodeId, 12, "wrong node id");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxFrame->groupId, 3, "wrong group id");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->slssId, 301, "wrong SLSS id");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->packetBurst->GetNPackets (), 2, "wrong number of packets");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->packetBurst->GetSize (), 320, "wrong size of the packets");
+  NS_TEST_ASSERT_MSG_EQ (rxFrame->ctrlMsgList.size (), 3, "wrong number of control messages");
+
+  std::list<Ptr<LteControlMessage> >::iterator it = rxFrame->ctrlMsgList.begin ();
+  Ptr<SciLteControlMessage> rxSciMsg = DynamicCast<SciLteControlMessage> (*it++);
+  NS_TEST_ASSERT_MSG_NE (rxSciMsg, 0, "wrong type of control message");
+  SciListElement_s rxSci = rxSciMsg->GetSci ();
+  NS_TEST_ASSERT_MSG_EQ (rxSci.m_rnti, sci.m_rnti, "wrong SCI RNTI");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxSci.m_rbStart, (uint32_t) sci.m_rbStart, "wrong SCI RB start");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxSci.m_rbLen, (uint32_t) sci.m_rbLen, "wrong SCI RB length");
+  NS_TEST_ASSERT_MSG_EQ (rxSci.m_tbSize, sci.m_tbSize, "wrong SCI TB size");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxSci.m_trp, (uint32_t) sci.m_trp, "wrong SCI TRP");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxSci.m_mcs, (uint32_t) sci.m_mcs, "wrong SCI MCS");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxSci.m_groupDstId, (uint32_t) sci.m_groupDstId, "wrong SCI group");
+
+  Ptr<MibSlLteControlMessage> rxMibMsg = DynamicCast<MibSlLteControlMessage> (*it++);
+  NS_TEST_ASSERT_MSG_NE (rxMibMsg, 0, "wrong type of control message");
+  LteRrcSap::MasterInformationBlockSL rxMib = rxMibMsg->GetMibSL ();
+  NS_TEST_ASSERT_MSG_EQ (rxMib.slBandwidth, mib.slBandwidth, "wrong MIB-SL bandwidth");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.directFrameNo, mib.directFrameNo, "wrong MIB-SL frame");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.directSubframeNo, mib.directSubframeNo, "wrong MIB-SL subframe");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.inCoverage, mib.inCoverage, "wrong MIB-SL coverage");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.slssid, mib.slssid, "wrong MIB-SL SLSS id");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.rxTimestamp, mib.rxTimestamp, "wrong MIB-SL reception timestamp");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.creationTimestamp, mib.creationTimestamp, "wrong MIB-SL creation timestamp");
+  NS_TEST_ASSERT_MSG_EQ (rxMib.rxOffset, mib.rxOffset, "wrong MIB-SL reception offset");
+
+  Ptr<SlDiscMessage> rxDiscMsg = DynamicCast<SlDiscMessage> (*it++);
+  NS_TEST_ASSERT_MSG_NE (rxDiscMsg, 0, "wrong type of control message");
+  SlDiscMsg rxDisc = rxDiscMsg->GetSlDiscMessage ();
+  NS_TEST_ASSERT_MSG_EQ (rxDisc.m_rnti, disc.m_rnti, "wrong discovery RNTI");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxDisc.m_resPsdch, (uint32_t) disc.m_resPsdch, "wrong discovery resource");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxDisc.m_msgType, (uint32_t) disc.m_msgType, "wrong discovery message type");
+  NS_TEST_ASSERT_MSG_EQ (rxDisc.m_proSeAppCode, disc.m_proSeAppCode, "wrong ProSe application code");
+  NS_TEST_ASSERT_MSG_EQ (rxDisc.m_mic, disc.m_mic, "wrong discovery MIC");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxDisc.m_utcBasedCounter, (uint32_t) disc.m_utcBasedCounter, "wrong discovery counter");
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * Sidelink signal codec test suite
+ */
+class SidelinkSignalCodecTestSuite : public TestSuite
+{
+public:
+  SidelinkSignalCodecTestSuite ();
+};
+
+SidelinkSignalCodecTestSuite::SidelinkSignalCodecTestSuite ()
+  : TestSuite ("sidelink-signal-codec", UNIT)
+{
+  AddTestCase (new SidelinkSignalCodecTestCase, TestCase::QUICK);
+}
+
+static SidelinkSignalCodecTestSuite staticSidelinkSignalCodecTestSuite; //!< the test suite
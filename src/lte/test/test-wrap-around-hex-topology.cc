@@ -224,7 +224,7 @@ WrapAroundTopologyTestCase::DoRun ()
   Ptr<Object> downlinkPathlossModel = lteHelper->GetDownlinkPathlossModel ();
   Ptr<PropagationLossModel> lossModel = downlinkPathlossModel->GetObject<PropagationLossModel> ();
 
-  NS_ASSERT_MSG (lossModel > 0, "No PathLossModel");
+  NS_ASSERT_MSG (lossModel != 0, "No PathLossModel");
   topoHelper->AttachWithWrapAround (lossModel, ueDevs, enbDevs);
   NS_LOG_INFO ("Attached UE's to the eNB with wrap-around");
 
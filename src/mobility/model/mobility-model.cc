@@ -21,6 +21,8 @@
 #include <cmath>
 
 #include "mobility-model.h"
+#include "mobility-snapshot.h"
+#include "ns3/node.h"
 #include "ns3/trace-source-accessor.h"
 
 namespace ns3 {
@@ -53,21 +55,58 @@ MobilityModel::GetTypeId (void)
 }
 
 MobilityModel::MobilityModel ()
+  : m_snapshotIndex (MobilitySnapshot::NONE)
 {
 }
 
 MobilityModel::~MobilityModel ()
 {
+  if (m_snapshotIndex != MobilitySnapshot::NONE)
+    {
+      MobilitySnapshot::Remove (this, m_snapshotIndex);
+    }
+}
+
+void
+MobilityModel::NotifyNewAggregate (void)
+{
+  if (m_snapshotIndex == MobilitySnapshot::NONE)
+    {
+      Ptr<Node> node = GetObject<Node> ();
+      if (node != 0)
+        {
+          MobilitySnapshot::Add (this, node->GetId ());
+        }
+    }
+  Object::NotifyNewAggregate ();
+}
+
+void
+MobilityModel::DoDispose (void)
+{
+  if (m_snapshotIndex != MobilitySnapshot::NONE)
+    {
+      MobilitySnapshot::Remove (this, m_snapshotIndex);
+    }
+  Object::DoDispose ();
 }
 
 Vector
 MobilityModel::GetPosition (void) const
 {
+  if (m_snapshotIndex != MobilitySnapshot::NONE)
+    {
+      return MobilitySnapshot::DoGetPosition (m_snapshotIndex);
+    }
   return DoGetPosition ();
 }
 Vector
 MobilityModel::GetVelocity (void) const
 {
+  if (m_snapshotIndex != MobilitySnapshot::NONE)
+    {
+      return MobilitySnapshot::DoGetVelocity (m_snapshotIndex);
+    }
   return DoGetVelocity ();
 }
 
@@ -75,13 +114,15 @@ void
 MobilityModel::SetPosition (const Vector &position)
 {
   DoSetPosition (position);
+  // not all the models notify a course change at once
+  NotifySnapshotInvalid ();
 }
 
 double 
 MobilityModel::GetDistanceFrom (Ptr<const MobilityModel> other) const
 {
-  Vector oPosition = other->DoGetPosition ();
-  Vector position = DoGetPosition ();
+  Vector oPosition = other->GetPosition ();
+  Vector position = GetPosition ();
   return CalculateDistance (position, oPosition);
 }
 
@@ -94,9 +135,19 @@ MobilityModel::GetRelativeSpeed (Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange (void) const
 {
+  NotifySnapshotInvalid ();
   m_courseChangeTrace (this);
 }
 
+void
+MobilityModel::NotifySnapshotInvalid (void) const
+{
+  if (m_snapshotIndex != MobilitySnapshot::NONE)
+    {
+      MobilitySnapshot::Invalidate (m_snapshotIndex);
+    }
+}
+
 int64_t
 MobilityModel::AssignStreams (int64_t start)
 {
@@ -92,7 +92,20 @@ protected:
    * position changes to notify course change listeners.
    */
   void NotifyCourseChange (void) const;
+  /**
+   * Must be invoked by subclasses when the position or the velocity
+   * at the current time changes without a course change notification,
+   * so that the MobilitySnapshot computes them again.
+   */
+  void NotifySnapshotInvalid (void) const;
+
+  // inherited from Object
+  virtual void NotifyNewAggregate (void);
+  virtual void DoDispose (void);
+
 private:
+  friend class MobilitySnapshot;
+
   /**
    * \return the current position.
    *
@@ -129,6 +142,9 @@ private:
    */
   ns3::TracedCallback<Ptr<const MobilityModel> > m_courseChangeTrace;
 
+  /// Id of the node of this model in the MobilitySnapshot, if tracked
+  uint32_t m_snapshotIndex;
+
 };
 
 } // namespace ns3
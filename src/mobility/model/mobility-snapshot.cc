@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mobility-snapshot.h"
+#include "mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilitySnapshot");
+
+MobilitySnapshot *MobilitySnapshot::m_snapshot = 0;
+bool MobilitySnapshot::m_enabled = true;
+
+MobilitySnapshot *
+MobilitySnapshot::Get (void)
+{
+  if (m_snapshot == 0)
+    {
+      m_snapshot = new MobilitySnapshot ();
+      Simulator::ScheduleDestroy (&MobilitySnapshot::Delete);
+    }
+  return m_snapshot;
+}
+
+void
+MobilitySnapshot::Delete (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  // the models still alive are no longer in the snapshot
+  for (std::vector<MobilityModel *>::const_iterator i = m_snapshot->m_models.begin ();
+       i != m_snapshot->m_models.end (); ++i)
+    {
+      if (*i != 0)
+        {
+          (*i)->m_snapshotIndex = NONE;
+        }
+    }
+  delete m_snapshot;
+  m_snapshot = 0;
+}
+
+void
+MobilitySnapshot::Add (MobilityModel *model, uint32_t nodeId)
+{
+  NS_LOG_FUNCTION (model << nodeId);
+  MobilitySnapshot *snapshot = Get ();
+  if (nodeId >= snapshot->m_models.size ())
+    {
+      uint32_t size = nodeId + 1;
+      snapshot->m_models.resize (size, 0);
+      snapshot->m_x.resize (size);
+      snapshot->m_y.resize (size);
+      snapshot->m_z.resize (size);
+      snapshot->m_positionTs.resize (size, -1);
+      snapshot->m_vx.resize (size);
+      snapshot->m_vy.resize (size);
+      snapshot->m_vz.resize (size);
+      snapshot->m_velocityTs.resize (size, -1);
+    }
+  MobilityModel *previous = snapshot->m_models[nodeId];
+  if (previous != 0 && previous != model)
+    {
+      previous->m_snapshotIndex = NONE;
+    }
+  snapshot->m_models[nodeId] = model;
+  snapshot->m_positionTs[nodeId] = -1;
+  snapshot->m_velocityTs[nodeId] = -1;
+  model->m_snapshotIndex = nodeId;
+}
+
+void
+MobilitySnapshot::Remove (MobilityModel *model, uint32_t nodeId)
+{
+  NS_LOG_FUNCTION (model << nodeId);
+  model->m_snapshotIndex = NONE;
+  if (m_snapshot != 0 && nodeId < m_snapshot->m_models.size ()
+      && m_snapshot->m_models[nodeId] == model)
+    {
+      m_snapshot->m_models[nodeId] = 0;
+    }
+}
+
+void
+MobilitySnapshot::Invalidate (uint32_t nodeId)
+{
+  m_snapshot->m_positionTs[nodeId] = -1;
+  m_snapshot->m_velocityTs[nodeId] = -1;
+}
+
+Vector
+MobilitySnapshot::DoGetPosition (uint32_t nodeId)
+{
+  if (!m_enabled)
+    {
+      return m_snapshot->m_models[nodeId]->DoGetPosition ();
+    }
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  if (m_snapshot->m_positionTs[nodeId] != now)
+    {
+      // the model may notify a course change, which invalidates the
+      // entry, while computing the position: stamp it afterwards.
+      Vector position = m_snapshot->m_models[nodeId]->DoGetPosition ();
+      m_snapshot->m_x[nodeId] = position.x;
+      m_snapshot->m_y[nodeId] = position.y;
+      m_snapshot->m_z[nodeId] = position.z;
+      m_snapshot->m_positionTs[nodeId] = now;
+      return position;
+    }
+  return Vector (m_snapshot->m_x[nodeId], m_snapshot->m_y[nodeId], m_snapshot->m_z[nodeId]);
+}
+
+Vector
+MobilitySnapshot::DoGetVelocity (uint32_t nodeId)
+{
+  if (!m_enabled)
+    {
+      return m_snapshot->m_models[nodeId]->DoGetVelocity ();
+    }
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  if (m_snapshot->m_velocityTs[nodeId] != now)
+    {
+      Vector velocity = m_snapshot->m_models[nodeId]->DoGetVelocity ();
+      m_snapshot->m_vx[nodeId] = velocity.x;
+      m_snapshot->m_vy[nodeId] = velocity.y;
+      m_snapshot->m_vz[nodeId] = velocity.z;
+      m_snapshot->m_velocityTs[nodeId] = now;
+      return velocity;
+    }
+  return Vector (m_snapshot->m_vx[nodeId], m_snapshot->m_vy[nodeId], m_snapshot->m_vz[nodeId]);
+}
+
+bool
+MobilitySnapshot::IsTracked (uint32_t nodeId)
+{
+  return m_snapshot != 0 && nodeId < m_snapshot->m_models.size ()
+         && m_snapshot->m_models[nodeId] != 0;
+}
+
+Vector
+MobilitySnapshot::GetPosition (uint32_t nodeId)
+{
+  NS_ASSERT_MSG (IsTracked (nodeId), "Node " << nodeId << " has no mobility model");
+  return DoGetPosition (nodeId);
+}
+
+Vector
+MobilitySnapshot::GetVelocity (uint32_t nodeId)
+{
+  NS_ASSERT_MSG (IsTracked (nodeId), "Node " << nodeId << " has no mobility model");
+  return DoGetVelocity (nodeId);
+}
+
+void
+MobilitySnapshot::GetPositions (const std::vector<uint32_t> &nodeIds, std::vector<Vector> &positions)
+{
+  positions.resize (nodeIds.size ());
+  for (std::size_t i = 0; i < nodeIds.size (); i++)
+    {
+      positions[i] = GetPosition (nodeIds[i]);
+    }
+}
+
+void
+MobilitySnapshot::GetVelocities (const std::vector<uint32_t> &nodeIds, std::vector<Vector> &velocities)
+{
+  velocities.resize (nodeIds.size ());
+  for (std::size_t i = 0; i < nodeIds.size (); i++)
+    {
+      velocities[i] = GetVelocity (nodeIds[i]);
+    }
+}
+
+void
+MobilitySnapshot::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+}
+
+void
+MobilitySnapshot::Enable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (!m_enabled && m_snapshot != 0)
+    {
+      // the positions were not tracked while disabled
+      for (std::size_t i = 0; i < m_snapshot->m_models.size (); i++)
+        {
+          Invalidate (i);
+        }
+    }
+  m_enabled = true;
+}
+
+bool
+MobilitySnapshot::IsEnabled (void)
+{
+  return m_enabled;
+}
+
+} // namespace ns3
@@ -92,6 +92,7 @@ WaypointMobilityModel::AddWaypoint (const Waypoint &waypoint)
                         "Waypoints must be added in ascending time order");
       m_waypoints.push_back (waypoint);
     }
+  NotifySnapshotInvalid ();
 
   if ( !m_lazyNotify )
     {
@@ -206,6 +207,7 @@ WaypointMobilityModel::EndMobility (void)
   m_current.time = Time(std::numeric_limits<uint64_t>::infinity());
   m_next.time = m_current.time;
   m_first = true;
+  NotifySnapshotInvalid ();
 }
 Vector
 WaypointMobilityModel::DoGetVelocity (void) const
@@ -0,0 +1,305 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/mobility-snapshot.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Constant velocity mobility model counting the computations of
+ * its position and velocity
+ */
+class CountingMobilityModel : public MobilityModel
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+  CountingMobilityModel ();
+  /**
+   * Change the velocity, and notify a course change
+   * \param velocity the new velocity
+   */
+  void SetVelocity (const Vector &velocity);
+
+  mutable uint32_t m_positionCount; ///< number of computations of the position
+  mutable uint32_t m_velocityCount; ///< number of computations of the velocity
+
+private:
+  virtual Vector DoGetPosition (void) const;
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+
+  Vector m_position; ///< position at the last change
+  Vector m_velocity; ///< velocity
+  Time m_time;       ///< time of the last change
+};
+
+TypeId
+CountingMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CountingMobilityModel")
+    .SetParent<MobilityModel> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<CountingMobilityModel> ()
+  ;
+  return tid;
+}
+
+CountingMobilityModel::CountingMobilityModel ()
+  : m_positionCount (0),
+    m_velocityCount (0)
+{
+}
+
+void
+CountingMobilityModel::SetVelocity (const Vector &velocity)
+{
+  m_position = DoGetPosition ();
+  m_positionCount--;
+  m_velocity = velocity;
+  m_time = Simulator::Now ();
+  NotifyCourseChange ();
+}
+
+Vector
+CountingMobilityModel::DoGetPosition (void) const
+{
+  m_positionCount++;
+  double t = (Simulator::Now () - m_time).GetSeconds ();
+  return Vector (m_position.x + m_velocity.x * t, m_position.y + m_velocity.y * t,
+                 m_position.z + m_velocity.z * t);
+}
+
+void
+CountingMobilityModel::DoSetPosition (const Vector &position)
+{
+  // no course change notification: the snapshot must still be updated
+  m_position = position;
+  m_time = Simulator::Now ();
+}
+
+Vector
+CountingMobilityModel::DoGetVelocity (void) const
+{
+  m_velocityCount++;
+  return m_velocity;
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that the MobilitySnapshot computes a position once per
+ * simulation time, and again after a change
+ */
+class MobilitySnapshotCacheTestCase : public TestCase
+{
+public:
+  MobilitySnapshotCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Query the position and velocity at 1 s
+  void CheckFirstTime (void);
+  /// Query the position at 2 s
+  void CheckSecondTime (void);
+
+  Ptr<Node> m_node;                      ///< the node
+  Ptr<CountingMobilityModel> m_model;   ///< the mobility model of the node
+};
+
+MobilitySnapshotCacheTestCase::MobilitySnapshotCacheTestCase ()
+  : TestCase ("Check the reuse and the invalidation of the positions of the MobilitySnapshot")
+{
+}
+
+void
+MobilitySnapshotCacheTestCase::CheckFirstTime (void)
+{
+  uint32_t id = m_node->GetId ();
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (1, 0, 0)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (1, 0, 0)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (MobilitySnapshot::GetPosition (id), Vector (1, 0, 0)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (m_model->GetDistanceFrom (m_model), 0, "wrong distance");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 1, "position computed more than once");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetVelocity (), Vector (1, 0, 0)), 0, "wrong velocity");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (MobilitySnapshot::GetVelocity (id), Vector (1, 0, 0)), 0, "wrong velocity");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_velocityCount, 1, "velocity computed more than once");
+
+  // a course change at the same time
+  m_model->SetVelocity (Vector (0, 2, 0));
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetVelocity (), Vector (0, 2, 0)), 0, "velocity not updated");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (1, 0, 0)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 2, "position not computed again");
+
+  // a new position, without course change notification
+  m_model->SetPosition (Vector (5, 5, 5));
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (MobilitySnapshot::GetPosition (id), Vector (5, 5, 5)), 0, "position not updated");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 5, 5)), 0, "position not updated");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 3, "position not computed again");
+}
+
+void
+MobilitySnapshotCacheTestCase::CheckSecondTime (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 7, 5)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 7, 5)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 4, "position computed more than once");
+
+  MobilitySnapshot::Disable ();
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 7, 5)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 7, 5)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 6, "position reused while disabled");
+  MobilitySnapshot::Enable ();
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (m_model->GetPosition (), Vector (5, 7, 5)), 0, "wrong position");
+  NS_TEST_EXPECT_MSG_EQ (m_model->m_positionCount, 7, "position reused after enabling again");
+}
+
+void
+MobilitySnapshotCacheTestCase::DoRun (void)
+{
+  m_node = CreateObject<Node> ();
+  m_model = CreateObject<CountingMobilityModel> ();
+  NS_TEST_ASSERT_MSG_EQ (MobilitySnapshot::IsTracked (m_node->GetId ()), false,
+                         "node tracked before having a mobility model");
+  m_node->AggregateObject (m_model);
+  NS_TEST_ASSERT_MSG_EQ (MobilitySnapshot::IsTracked (m_node->GetId ()), true,
+                         "mobility model not tracked");
+  m_model->SetVelocity (Vector (1, 0, 0));
+  m_model->m_positionCount = 0;
+  m_model->m_velocityCount = 0;
+
+  Simulator::Schedule (Seconds (1), &MobilitySnapshotCacheTestCase::CheckFirstTime, this);
+  Simulator::Schedule (Seconds (2), &MobilitySnapshotCacheTestCase::CheckSecondTime, this);
+  Simulator::Run ();
+
+  uint32_t id = m_node->GetId ();
+  m_node = 0;
+  m_model = 0;
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (MobilitySnapshot::IsTracked (id), false,
+                         "mobility model still tracked after the simulation");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check the bulk queries of the MobilitySnapshot, and the models
+ * which change without course change notification
+ */
+class MobilitySnapshotBulkTestCase : public TestCase
+{
+public:
+  MobilitySnapshotBulkTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// Query the positions and velocities of all the nodes
+  void Check (void);
+
+  std::vector<Ptr<Node> > m_nodes; ///< the nodes
+};
+
+MobilitySnapshotBulkTestCase::MobilitySnapshotBulkTestCase ()
+  : TestCase ("Check the bulk queries of the MobilitySnapshot")
+{
+}
+
+void
+MobilitySnapshotBulkTestCase::Check (void)
+{
+  std::vector<uint32_t> ids;
+  for (std::size_t i = 0; i < m_nodes.size (); i++)
+    {
+      ids.push_back (m_nodes[i]->GetId ());
+    }
+  std::vector<Vector> positions;
+  std::vector<Vector> velocities;
+  MobilitySnapshot::GetPositions (ids, positions);
+  MobilitySnapshot::GetVelocities (ids, velocities);
+  NS_TEST_ASSERT_MSG_EQ (positions.size (), m_nodes.size (), "wrong number of positions");
+  NS_TEST_ASSERT_MSG_EQ (velocities.size (), m_nodes.size (), "wrong number of velocities");
+  double t = Simulator::Now ().GetSeconds ();
+  for (std::size_t i = 0; i < m_nodes.size (); i++)
+    {
+      Ptr<MobilityModel> model = m_nodes[i]->GetObject<MobilityModel> ();
+      NS_TEST_EXPECT_MSG_EQ (CalculateDistance (positions[i], model->GetPosition ()), 0, "wrong position of node " << i);
+      NS_TEST_EXPECT_MSG_EQ (CalculateDistance (velocities[i], model->GetVelocity ()), 0, "wrong velocity of node " << i);
+      NS_TEST_EXPECT_MSG_EQ (CalculateDistance (positions[i], Vector (i + t * i, 0, 0)), 0, "wrong position of node " << i);
+    }
+}
+
+void
+MobilitySnapshotBulkTestCase::DoRun (void)
+{
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<ConstantVelocityMobilityModel> model = CreateObject<ConstantVelocityMobilityModel> ();
+      node->AggregateObject (model);
+      model->SetPosition (Vector (i, 0, 0));
+      model->SetVelocity (Vector (i, 0, 0));
+      m_nodes.push_back (node);
+    }
+  Simulator::Schedule (Seconds (0), &MobilitySnapshotBulkTestCase::Check, this);
+  Simulator::Schedule (Seconds (1.5), &MobilitySnapshotBulkTestCase::Check, this);
+  Simulator::Schedule (Seconds (3), &MobilitySnapshotBulkTestCase::Check, this);
+
+  // a waypoint added at the current time moves the node at once
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<WaypointMobilityModel> waypoints = CreateObject<WaypointMobilityModel> ();
+  node->AggregateObject (waypoints);
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (waypoints->GetPosition (), Vector (0, 0, 0)), 0, "wrong initial position");
+  waypoints->AddWaypoint (Waypoint (Seconds (0), Vector (10, 20, 30)));
+  NS_TEST_EXPECT_MSG_EQ (CalculateDistance (waypoints->GetPosition (), Vector (10, 20, 30)), 0, "waypoint ignored");
+
+  Simulator::Run ();
+  m_nodes.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief MobilitySnapshot TestSuite
+ */
+class MobilitySnapshotTestSuite : public TestSuite
+{
+public:
+  MobilitySnapshotTestSuite ();
+};
+
+MobilitySnapshotTestSuite::MobilitySnapshotTestSuite ()
+  : TestSuite ("mobility-snapshot", UNIT)
+{
+  AddTestCase (new MobilitySnapshotCacheTestCase, TestCase::QUICK);
+  AddTestCase (new MobilitySnapshotBulkTestCase, TestCase::QUICK);
+}
+
+static MobilitySnapshotTestSuite g_mobilitySnapshotTestSuite; ///< the test suite
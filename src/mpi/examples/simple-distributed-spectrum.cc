@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Nodes placed on a line share a DistributedSpectrumChannel, and are
+ * split in as many contiguous groups as there are logical processors:
+ *
+ *            RANK 0       |       RANK 1
+ *                         |
+ *   n0 ---- n1 ---- n2 ---- n3 ---- n4 ---- n5 ...
+ *          50 m           |
+ *
+ * Each node periodically broadcasts a packet with an
+ * AdhocAlohaNoackIdealPhy device.  The signals of a rank reach the
+ * receivers of the other ranks through MPI messages; the lookahead is the
+ * ProcessingDelay of the channel plus the propagation delay over the
+ * distance between neighbors.
+ *
+ * Each rank prints the number of packets received by its nodes, which
+ * does not depend on the number of logical processors, e.g.
+ *
+ *   mpirun -np 1 ./waf --run simple-distributed-spectrum
+ *   mpirun -np 2 ./waf --run simple-distributed-spectrum
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/mpi-interface.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SimpleDistributedSpectrum");
+
+#ifdef NS3_MPI
+/// Packets received by each node
+static std::map<uint32_t, uint32_t> g_rxPackets;
+
+/**
+ * Packet received by a PHY
+ * \param context the trace context
+ * \param p the packet
+ */
+static void
+RxEndOk (std::string context, Ptr<const Packet> p)
+{
+  // context is /NodeList/<id>/...
+  uint32_t nodeId = std::stoul (context.substr (10, context.find ('/', 10) - 10));
+  g_rxPackets[nodeId]++;
+}
+#endif
+
+int
+main (int argc, char *argv[])
+{
+#ifdef NS3_MPI
+
+  uint32_t nNodes = 8;
+  double distance = 50.0;
+  bool nullmsg = false;
+  double simTime = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nNodes", "Number of nodes", nNodes);
+  cmd.AddValue ("distance", "Distance between neighbors (m)", distance);
+  cmd.AddValue ("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+  cmd.AddValue ("simTime", "Simulation time (s)", simTime);
+  cmd.Parse (argc, argv);
+
+  if (nullmsg)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::NullMessageSimulatorImpl"));
+    }
+  else
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::DistributedSimulatorImpl"));
+    }
+
+  MpiInterface::Enable (&argc, &argv);
+
+  uint32_t systemId = MpiInterface::GetSystemId ();
+  uint32_t systemCount = MpiInterface::GetSize ();
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      nodes.Add (CreateObject<Node> (i * systemCount / nNodes));
+    }
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (distance),
+                                 "GridWidth", UintegerValue (nNodes));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  // The channel is created in the same order by all the ranks, and the
+  // receivers closest to another rank are at the distance between neighbors
+  SpectrumChannelHelper channelHelper;
+  channelHelper.SetChannel ("ns3::DistributedSpectrumChannel",
+                            "ProcessingDelay", TimeValue (MicroSeconds (1)),
+                            "MinimumDistance", DoubleValue (distance));
+  channelHelper.AddSpectrumPropagationLoss ("ns3::FriisSpectrumPropagationLossModel");
+  channelHelper.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  Ptr<SpectrumChannel> channel = channelHelper.Create ();
+
+  WifiSpectrumValue5MhzFactory sf;
+  AdhocAlohaNoackIdealPhyHelper deviceHelper;
+  deviceHelper.SetChannel (channel);
+  deviceHelper.SetTxPowerSpectralDensity (sf.CreateTxPowerSpectralDensity (0.1, 1));
+  deviceHelper.SetNoisePowerSpectralDensity (sf.CreateConstant (1.381e-23 * 290));
+  deviceHelper.SetPhyAttribute ("Rate", DataRateValue (DataRate ("1Mbps")));
+  NetDeviceContainer devices = deviceHelper.Install (nodes);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (nodes);
+
+  // Each rank only installs the applications of its nodes
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      if (nodes.Get (i)->GetSystemId () != systemId)
+        {
+          continue;
+        }
+      PacketSocketAddress socket;
+      socket.SetSingleDevice (devices.Get (i)->GetIfIndex ());
+      socket.SetPhysicalAddress (devices.Get (i)->GetBroadcast ());
+      socket.SetProtocol (1);
+
+      Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+      client->SetRemote (socket);
+      client->SetAttribute ("Interval", TimeValue (MilliSeconds (nNodes)));
+      client->SetAttribute ("PacketSize", UintegerValue (100));
+      client->SetAttribute ("MaxPackets", UintegerValue (0));
+      client->SetStartTime (MilliSeconds (i));
+      client->SetStopTime (Seconds (simTime));
+      nodes.Get (i)->AddApplication (client);
+    }
+
+  Config::Connect ("/NodeList/*/DeviceList/*/Phy/RxEndOk", MakeCallback (&RxEndOk));
+
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < nNodes; ++i)
+    {
+      if (nodes.Get (i)->GetSystemId () == systemId)
+        {
+          std::cout << "node " << i << " (rank " << systemId << ") received "
+                    << g_rxPackets[nodes.Get (i)->GetId ()] << " packets" << std::endl;
+        }
+    }
+
+  Simulator::Destroy ();
+  // Exit the MPI execution environment
+  MpiInterface::Disable ();
+  return 0;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
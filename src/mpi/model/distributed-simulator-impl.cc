@@ -20,11 +20,13 @@
 #include "distributed-simulator-impl.h"
 #include "granted-time-window-mpi-interface.h"
 #include "mpi-interface.h"
+#include "mpi-remote-channel.h"
 
 #include "ns3/simulator.h"
 #include "ns3/scheduler.h"
 #include "ns3/event-impl.h"
 #include "ns3/channel.h"
+#include "ns3/channel-list.h"
 #include "ns3/node-container.h"
 #include "ns3/ptr.h"
 #include "ns3/pointer.h"
@@ -117,6 +119,7 @@ DistributedSimulatorImpl::DistributedSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_eventCount = 0;
   m_events = 0;
 }
 
@@ -229,6 +232,26 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
                 }
             }
         }
+
+      // the other channels connecting local and remote nodes report
+      // their links themselves
+      for (ChannelList::Iterator iter = ChannelList::Begin (); iter != ChannelList::End (); ++iter)
+        {
+          MpiRemoteChannel *remoteChannel = dynamic_cast<MpiRemoteChannel *> (PeekPointer (*iter));
+          if (remoteChannel == 0)
+            {
+              continue;
+            }
+          std::map<uint32_t, Time> links;
+          remoteChannel->GetRemoteLinks (links);
+          for (std::map<uint32_t, Time>::const_iterator link = links.begin (); link != links.end (); ++link)
+            {
+              if (link->second < m_lookAhead)
+                {
+                  m_lookAhead = link->second;
+                }
+            }
+        }
     }
 
   // m_lookAhead is now set
@@ -329,6 +352,7 @@ DistributedSimulatorImpl::ProcessOneEvent (void)
   m_currentUid = next.key.m_uid;
   next.impl->Invoke ();
   next.impl->Unref ();
+  m_eventCount++;
 }
 
 bool
@@ -644,4 +668,10 @@ DistributedSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint64_t
+DistributedSimulatorImpl::GetEventCount (void) const
+{
+  return m_eventCount;
+}
+
 } // namespace ns3
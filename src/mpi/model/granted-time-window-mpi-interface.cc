@@ -35,6 +35,7 @@
 #include "ns3/simulator-impl.h"
 #include "ns3/nstime.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 
 #ifdef NS3_MPI
 #include <mpi.h>
@@ -198,6 +199,8 @@ GrantedTimeWindowMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, ui
   std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
 
   uint32_t serializedSize = p->GetSerializedSize ();
+  NS_ABORT_MSG_IF (serializedSize + 16 > MAX_MPI_MSG_SIZE,
+                   "MPI message of " << serializedSize + 16 << " bytes larger than " << MAX_MPI_MSG_SIZE);
   uint8_t* buffer =  new uint8_t[serializedSize + 16];
   i->SetBuffer (buffer);
   // Add the time, dest node and dest device
@@ -43,7 +43,7 @@ namespace ns3 {
  * maximum MPI message size for easy
  * buffer creation
  */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
+const uint32_t MAX_MPI_MSG_SIZE = 65536;
 
 /**
  * \ingroup mpi
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MPI_REMOTE_CHANNEL_H
+#define NS3_MPI_REMOTE_CHANNEL_H
+
+#include <stdint.h>
+#include <map>
+
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Interface of the channels, other than the point-to-point ones,
+ * that connect nodes of different ranks.
+ *
+ * The distributed simulator implementations find the remote links of the
+ * point-to-point channels from their devices.  Other channels (e.g. a
+ * wireless channel shared by many devices) implement this interface, next
+ * to the Channel base class: when the simulation starts, each channel of
+ * the ChannelList implementing it is asked for the ranks it sends
+ * messages to, and for the minimum delay of these messages, which bounds
+ * the lookahead.
+ *
+ * The links must be symmetric: if a channel reports a link from rank A
+ * to rank B in rank A, the same channel must report a link from rank B
+ * to rank A in rank B.
+ */
+class MpiRemoteChannel
+{
+public:
+  virtual ~MpiRemoteChannel ()
+  {
+  }
+
+  /**
+   * \brief Get the links from the local rank to remote ranks
+   *
+   * Called once, when the simulation starts, after the topology has been
+   * built.
+   *
+   * \param links to be filled with, for each remote rank reached by the
+   * channel, the minimum delay between the time a message is sent to the
+   * rank and the time the message is received
+   */
+  virtual void GetRemoteLinks (std::map<uint32_t, Time> &links) = 0;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MPI_REMOTE_CHANNEL_H */
@@ -32,6 +32,7 @@
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 
 #ifdef NS3_MPI
 #include <mpi.h>
@@ -50,7 +51,7 @@ NS_LOG_COMPONENT_DEFINE ("NullMessageMpiInterface");
  * buffer creation
  */
 #ifdef NS3_MPI
-const uint32_t NULL_MESSAGE_MAX_MPI_MSG_SIZE = 2000;
+const uint32_t NULL_MESSAGE_MAX_MPI_MSG_SIZE = 65536;
 #endif
 
 NullMessageSentBuffer::NullMessageSentBuffer ()
@@ -215,6 +216,8 @@ NullMessageMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t
 
   uint32_t serializedSize = p->GetSerializedSize ();
   uint32_t bufferSize = serializedSize + ( 2 * sizeof (uint64_t) ) + ( 2 * sizeof (uint32_t) );
+  NS_ABORT_MSG_IF (bufferSize > NULL_MESSAGE_MAX_MPI_MSG_SIZE,
+                   "MPI message of " << bufferSize << " bytes larger than " << NULL_MESSAGE_MAX_MPI_MSG_SIZE);
   uint8_t* buffer =  new uint8_t[bufferSize];
   iter->SetBuffer (buffer);
   // Add the time, dest node and dest device
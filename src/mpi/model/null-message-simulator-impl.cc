@@ -25,11 +25,13 @@
 #include "remote-channel-bundle-manager.h"
 #include "remote-channel-bundle.h"
 #include "mpi-interface.h"
+#include "mpi-remote-channel.h"
 
 #include <ns3/simulator.h>
 #include <ns3/scheduler.h>
 #include <ns3/event-impl.h>
 #include <ns3/channel.h>
+#include <ns3/channel-list.h>
 #include <ns3/node-container.h>
 #include <ns3/double.h>
 #include <ns3/ptr.h>
@@ -84,6 +86,7 @@ NullMessageSimulatorImpl::NullMessageSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_eventCount = 0;
   m_events = 0;
 
   m_safeTime = Seconds (0);
@@ -199,6 +202,28 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
               remoteChannelBundle->AddChannel (channel, delay.Get () );
             }
         }
+
+      // the other channels connecting local and remote nodes report
+      // their links themselves
+      for (ChannelList::Iterator iter = ChannelList::Begin (); iter != ChannelList::End (); ++iter)
+        {
+          MpiRemoteChannel *remoteChannel = dynamic_cast<MpiRemoteChannel *> (PeekPointer (*iter));
+          if (remoteChannel == 0)
+            {
+              continue;
+            }
+          std::map<uint32_t, Time> links;
+          remoteChannel->GetRemoteLinks (links);
+          for (std::map<uint32_t, Time>::const_iterator link = links.begin (); link != links.end (); ++link)
+            {
+              Ptr<RemoteChannelBundle> remoteChannelBundle = RemoteChannelBundleManager::Find (link->first);
+              if (!remoteChannelBundle)
+                {
+                  remoteChannelBundle = RemoteChannelBundleManager::Add (link->first);
+                }
+              remoteChannelBundle->AddChannel (*iter, link->second);
+            }
+        }
     }
 
   // Completed setup of remote channel bundles.  Setup send and receive buffers.
@@ -242,6 +267,7 @@ NullMessageSimulatorImpl::ProcessOneEvent (void)
   m_currentUid = next.key.m_uid;
   next.impl->Invoke ();
   next.impl->Unref ();
+  m_eventCount++;
 }
 
 bool
@@ -575,6 +601,12 @@ NullMessageSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+uint64_t
+NullMessageSimulatorImpl::GetEventCount (void) const
+{
+  return m_eventCount;
+}
+
 Time NullMessageSimulatorImpl::CalculateGuaranteeTime (uint32_t nodeSysId)
 {
   Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find (nodeSysId);
@@ -74,6 +74,10 @@ static bool initialized = false; //!< Initialization flag
 AnimationInterface::AnimationInterface (const std::string fn)
   : m_f (0),
     m_routingF (0),
+    m_asyncWrite (false),
+    m_compress (false),
+    m_traceFormat (AnimationTraceWriter::XML),
+    m_headerRecordCount (0),
     m_mobilityPollInterval (Seconds (0.25)), 
     m_outputFileName (fn),
     gAnimUid (0), 
@@ -233,6 +237,37 @@ AnimationInterface::SetMaxPktsPerTraceFile (uint64_t maxPacketsPerFile)
   m_maxPktsPerFile = maxPacketsPerFile;
 }
 
+void
+AnimationInterface::EnableAsyncWrite (bool enable)
+{
+  m_asyncWrite = enable;
+  RestartTraceFile ();
+}
+
+void
+AnimationInterface::EnableCompression (bool enable)
+{
+  if (enable && !AnimationTraceWriter::IsCompressionSupported ())
+    {
+      NS_FATAL_ERROR ("Compressed trace files need ns-3 to be built with zlib");
+    }
+  m_compress = enable;
+  RestartTraceFile ();
+}
+
+void
+AnimationInterface::EnableBinaryTrace (bool enable)
+{
+  m_traceFormat = enable ? AnimationTraceWriter::BINARY : AnimationTraceWriter::XML;
+  RestartTraceFile ();
+}
+
+bool
+AnimationInterface::ConvertBinaryTrace (std::string binaryFileName, std::string xmlFileName)
+{
+  return AnimationTraceWriter::ConvertBinaryTrace (binaryFileName, xmlFileName);
+}
+
 uint32_t 
 AnimationInterface::AddNodeCounter (std::string counterName, CounterType counterType)
 {
@@ -496,7 +531,7 @@ AnimationInterface::GetMovedNodes ()
 }
 
 int 
-AnimationInterface::WriteN (const std::string& st, FILE * f)
+AnimationInterface::WriteN (const std::string& st, AnimationTraceWriter * f)
 {
   if (!f)
     {
@@ -510,28 +545,28 @@ AnimationInterface::WriteN (const std::string& st, FILE * f)
 }
 
 int 
-AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
+AnimationInterface::WriteN (const char* data, uint32_t count, AnimationTraceWriter * f)
 { 
   if (!f)
     {
       return 0;
     }
-  // Write count bytes to h from data
-  uint32_t    nLeft   = count;
-  const char* p       = data;
-  uint32_t    written = 0;
-  while (nLeft)
+  f->Write (data, count);
+  return count;
+}
+
+void 
+AnimationInterface::WriteElement (AnimXmlElement& element, AnimationTraceWriter * f)
+{
+  if (!f)
     {
-      int n = std::fwrite (p, 1,  nLeft, f);
-      if (n <= 0) 
-        {
-          return written;
-        }
-      written += n;
-      nLeft -= n;
-      p += n;
+      return;
+    }
+  if (m_writeCallback)
+    {
+      m_writeCallback (element.ToString ().c_str ());
     }
-  return written;
+  element.Write (f);
 }
 
 void 
@@ -1441,7 +1476,7 @@ AnimationInterface::StopAnimation (bool onlyAnimation)
     {
       // Terminate the anim element
       WriteXmlClose ("anim");
-      std::fclose (m_f);
+      delete m_f;
       m_f = 0;
     }
   if (onlyAnimation)
@@ -1451,11 +1486,30 @@ AnimationInterface::StopAnimation (bool onlyAnimation)
   if (m_routingF)
     {
       WriteXmlClose ("anim", true);
-      std::fclose (m_routingF);
+      delete m_routingF;
       m_routingF = 0;
     }
 }
 
+void 
+AnimationInterface::RestartTraceFile ()
+{
+  if (!m_f)
+    {
+      return;
+    }
+  NS_ABORT_MSG_IF (m_f->GetRecordCount () != m_headerRecordCount,
+                   "The trace writer options must be set before anything is written to the trace");
+  delete m_f;
+  m_f = 0;
+  // The address tables and the remaining energy counter are created
+  // again while writing the header
+  m_nodeIdIpv4Map.clear ();
+  m_nodeIdIpv6Map.clear ();
+  m_nodeCounters.clear ();
+  StartAnimation (true);
+}
+
 void 
 AnimationInterface::StartAnimation (bool restart)
 {
@@ -1470,6 +1524,7 @@ AnimationInterface::StartAnimation (bool restart)
   WriteIpv6Addresses ();
   WriteNodeSizes ();
   WriteNodeEnergies ();
+  m_headerRecordCount = m_f->GetRecordCount ();
   if (!restart)
     {
       Simulator::Schedule (m_mobilityPollInterval, &AnimationInterface::MobilityAutoCheck, this);
@@ -2073,13 +2128,7 @@ AnimationInterface::SetOutputFile (const std::string& fn, bool routing)
     }
 
   NS_LOG_INFO ("Creating new trace file:" << fn.c_str ());
-  FILE * f = 0;
-  f = std::fopen (fn.c_str (), "w");
-  if (!f)
-    {
-      NS_FATAL_ERROR ("Unable to open output file:" << fn.c_str ());
-      return; // Can't open output file
-    }
+  AnimationTraceWriter * f = new AnimationTraceWriter (fn, m_traceFormat, m_compress, m_asyncWrite);
   if (routing)
     {
       m_routingF = f;
@@ -2390,7 +2439,7 @@ AnimationInterface::WriteXmlAnim (bool routing)
 {
   AnimXmlElement element ("anim");
   element.AddAttribute ("ver", GetNetAnimVersion ());
-  FILE * f = m_f;
+  AnimationTraceWriter * f = m_f;
   if (!routing)
     {
       element.AddAttribute ("filetype", "animation");
@@ -2425,7 +2474,7 @@ AnimationInterface::WriteXmlNode (uint32_t id, uint32_t sysId, double locX, doub
   element.AddAttribute ("sysId", sysId);
   element.AddAttribute ("locX", locX);
   element.AddAttribute ("locY", locY);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2436,7 +2485,7 @@ AnimationInterface::WriteXmlUpdateLink (uint32_t fromId, uint32_t toId, std::str
   element.AddAttribute ("fromId", fromId);
   element.AddAttribute ("toId", toId);
   element.AddAttribute ("ld", linkDescription, true);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2465,7 +2514,7 @@ AnimationInterface::WriteXmlLink (uint32_t fromId, uint32_t toLp, uint32_t toId)
   element.AddAttribute ("fd", lprop.fromNodeDescription, true); 
   element.AddAttribute ("td", lprop.toNodeDescription, true); 
   element.AddAttribute ("ld", lprop.linkDescription, true); 
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void
@@ -2481,7 +2530,7 @@ AnimationInterface::WriteXmlIpv4Addresses (uint32_t nodeId, std::vector<std::str
       valueElement.SetText (*i);
       element.AppendChild(valueElement);
     }
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void
@@ -2497,7 +2546,7 @@ AnimationInterface::WriteXmlIpv6Addresses (uint32_t nodeId, std::vector<std::str
       valueElement.SetText (*i);
       element.AppendChild (valueElement);
     }
-  WriteN(element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2507,7 +2556,7 @@ AnimationInterface::WriteXmlRouting (uint32_t nodeId, std::string routingInfo)
   element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
   element.AddAttribute ("id", nodeId);
   element.AddAttribute ("info", routingInfo.c_str (), true);
-  WriteN (element.ToString (), m_routingF);
+  WriteElement (element, m_routingF);
 }
 
 void 
@@ -2529,7 +2578,7 @@ AnimationInterface::WriteXmlRp (uint32_t nodeId, std::string destination, Ipv4Ro
       rpeElement.AddAttribute ("nH", rpElement.nextHop.c_str ());
       element.AppendChild (rpeElement);
     }
-  WriteN (element.ToString (),  m_routingF);
+  WriteElement (element, m_routingF);
 }
 
 
@@ -2544,7 +2593,7 @@ AnimationInterface::WriteXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, s
     {
       element.AddAttribute ("meta-info", metaInfo.c_str (), true);
     }
-  WriteN (element.ToString (),  m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2555,7 +2604,7 @@ AnimationInterface::WriteXmlP (uint64_t animUid, std::string pktType, uint32_t t
   element.AddAttribute ("tId", tId);
   element.AddAttribute ("fbRx", fbRx);
   element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2573,7 +2622,7 @@ AnimationInterface::WriteXmlP (std::string pktType, uint32_t fId, double fbTx, d
   element.AddAttribute ("tId", tId);
   element.AddAttribute ("fbRx", fbRx);
   element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2583,7 +2632,7 @@ AnimationInterface::WriteXmlAddNodeCounter (uint32_t nodeCounterId, std::string
   element.AddAttribute ("ncId", nodeCounterId);
   element.AddAttribute ("n", counterName);
   element.AddAttribute ("t", CounterTypeToString (counterType));
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2592,7 +2641,7 @@ AnimationInterface::WriteXmlAddResource (uint32_t resourceId, std::string resour
   AnimXmlElement element ("res");
   element.AddAttribute ("rid", resourceId);
   element.AddAttribute ("p", resourcePath);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2603,7 +2652,7 @@ AnimationInterface::WriteXmlUpdateNodeImage (uint32_t nodeId, uint32_t resourceI
   element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
   element.AddAttribute ("id", nodeId);
   element.AddAttribute ("rid", resourceId);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2615,7 +2664,7 @@ AnimationInterface::WriteXmlUpdateNodeSize (uint32_t nodeId, double width, doubl
   element.AddAttribute ("id", nodeId);
   element.AddAttribute ("w", width);
   element.AddAttribute ("h", height);
-  WriteN (element.ToString (),  m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2627,7 +2676,7 @@ AnimationInterface::WriteXmlUpdateNodePosition (uint32_t nodeId, double x, doubl
   element.AddAttribute ("id", nodeId);
   element.AddAttribute ("x", x);
   element.AddAttribute ("y", y);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2640,7 +2689,7 @@ AnimationInterface::WriteXmlUpdateNodeColor (uint32_t nodeId, uint8_t r, uint8_t
   element.AddAttribute ("r", (uint32_t) r);
   element.AddAttribute ("g", (uint32_t) g);
   element.AddAttribute ("b", (uint32_t) b);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2654,7 +2703,7 @@ AnimationInterface::WriteXmlUpdateNodeDescription (uint32_t nodeId)
     {
       element.AddAttribute ("descr", m_nodeDescriptions[nodeId], true); 
     }
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 
@@ -2666,7 +2715,7 @@ AnimationInterface::WriteXmlUpdateNodeCounter (uint32_t nodeCounterId, uint32_t
   element.AddAttribute ("i", nodeId);
   element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
   element.AddAttribute ("v", counterValue);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2679,7 +2728,7 @@ AnimationInterface::WriteXmlUpdateBackground (std::string fileName, double x, do
   element.AddAttribute ("sx", scaleX);
   element.AddAttribute ("sy", scaleY);
   element.AddAttribute ("o", opacity);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 void 
@@ -2689,7 +2738,7 @@ AnimationInterface::WriteXmlNonP2pLinkProperties (uint32_t id, std::string ipAdd
   element.AddAttribute ("id", id);
   element.AddAttribute ("ipAddress", ipAddress);
   element.AddAttribute ("channelType", channelType);
-  WriteN (element.ToString (), m_f);
+  WriteElement (element, m_f);
 }
 
 
@@ -2702,49 +2751,105 @@ AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emp
 {
 }
 
+/**
+ * Format an attribute value the way an ostream with a precision of 10 does
+ * \param value the value
+ * \returns the formatted value
+ */
+template <typename T>
+static std::string
+FormatAttributeValue (T value)
+{
+  std::ostringstream oss;
+  oss << std::setprecision (10);
+  oss << value;
+  return oss.str ();
+}
+
+/**
+ * Format a double attribute value without the cost of an ostringstream
+ * \param value the value
+ * \returns the formatted value
+ */
+static std::string
+FormatAttributeValue (double value)
+{
+  char buffer[32];
+  std::snprintf (buffer, sizeof (buffer), "%.10g", value);
+  return buffer;
+}
+
+/**
+ * Format an integer attribute value without the cost of an ostringstream
+ * \param value the value
+ * \returns the formatted value
+ */
+static std::string
+FormatAttributeValue (uint32_t value)
+{
+  return std::to_string (value);
+}
+
+/**
+ * Format an integer attribute value without the cost of an ostringstream
+ * \param value the value
+ * \returns the formatted value
+ */
+static std::string
+FormatAttributeValue (uint64_t value)
+{
+  return std::to_string (value);
+}
+
+/**
+ * Format a string attribute value
+ * \param value the value
+ * \returns the value
+ */
+static std::string
+FormatAttributeValue (const std::string &value)
+{
+  return value;
+}
+
 template <typename T>
 void
 AnimationInterface::AnimXmlElement::AddAttribute(std::string attribute, T value, bool xmlEscape)
 {
-	std::ostringstream oss;
-	oss << std::setprecision(10);
-	oss << value;
-	std::string attributeString = attribute.c_str();
+	std::string attributeValue;
 	if (xmlEscape)
 	{
-		attributeString += "=\"";
-		std::string valueStr = oss.str();
+		std::string valueStr = FormatAttributeValue(value);
 		for (std::string::iterator it = valueStr.begin(); it != valueStr.end(); ++it)
 		{
 			switch (*it)
 			{
 			case '&':
-				attributeString += "&amp;";
+				attributeValue += "&amp;";
 				break;
 			case '\"':
-				attributeString += "&quot;";
+				attributeValue += "&quot;";
 				break;
 			case '\'':
-				attributeString += "&apos;";
+				attributeValue += "&apos;";
 				break;
 			case '<':
-				attributeString += "&lt;";
+				attributeValue += "&lt;";
 				break;
 			case '>':
-				attributeString += "&gt;";
+				attributeValue += "&gt;";
 				break;
 			default:
-				attributeString += *it;
+				attributeValue += *it;
 				break;
 			}
 		}
-		attributeString += "\" ";
 	}
 	else
 	{
-		attributeString += "=\"" + oss.str() + "\" ";
+		attributeValue = FormatAttributeValue(value);
 	}
-	m_attributes.push_back(attributeString);
+	m_attributes.push_back(std::make_pair(attribute, attributeValue));
 }
 
 void
@@ -2760,50 +2865,32 @@ AnimationInterface::AnimXmlElement::SetText(std::string text)
 }
 
 std::string
-AnimationInterface::AnimXmlElement::ToString(bool autoClose)
+AnimationInterface::AnimXmlElement::GetContent()
 {
-	std::string elementString = "<" + m_tagName + " ";
-
-	
-		for (std::vector<std::string>::const_iterator i = m_attributes.begin();
-			i != m_attributes.end();
+	std::string content = m_text;
+	if (!m_children.empty())
+	{
+		content += "\n";
+		for (std::vector<std::string>::const_iterator i = m_children.begin();
+			i != m_children.end();
 			++i)
 		{
-			elementString += *i;
-		}
-		if (m_children.empty() && m_text.empty())
-		{
-			if (autoClose)
-			{ 
-				elementString += "/>";
-			}
+			content += *i + "\n";
 		}
-		else
-		{ 
-			elementString += ">";
-			if (!m_text.empty())
-			{
-				elementString += m_text;
-			}
-			if (!m_children.empty())
-			{
-				elementString += "\n";
-				for (std::vector<std::string>::const_iterator i = m_children.begin();
-					i != m_children.end();
-					++i)
-				{
-					elementString += *i + "\n";
-				}
+	}
+	return content;
+}
 
-			}
-			if (autoClose)
-			{
-				elementString += "</" + m_tagName + ">";
-			}
-		}
+std::string
+AnimationInterface::AnimXmlElement::ToString(bool autoClose)
+{
+	return AnimationTraceWriter::FormatElement(m_tagName, m_attributes, GetContent(), autoClose);
+}
 
-	
-	return elementString + ((autoClose) ?"\n": "");
+void
+AnimationInterface::AnimXmlElement::Write(AnimationTraceWriter * writer, bool autoClose)
+{
+	writer->WriteElement(m_tagName, m_attributes, GetContent(), autoClose);
 }
 
 
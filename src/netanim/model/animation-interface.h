@@ -43,6 +43,7 @@
 #include "ns3/rectangle.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-l3-protocol.h"
+#include "animation-trace-writer.h"
 
 namespace ns3 {
 
@@ -210,6 +211,53 @@ public:
    */
   void SetMaxPktsPerTraceFile (uint64_t maxPktsPerFile);
 
+  /**
+   * \brief Write the trace files on a background thread, so that the
+   * simulation does not wait for the file system.
+   * The trace file is started again: this must be called right after
+   * the constructor, before anything else is written to the trace.
+   *
+   * \param enable true to write the trace files on a background thread
+   *
+   * \returns none
+   */
+  void EnableAsyncWrite (bool enable = true);
+
+  /**
+   * \brief Compress the trace files with gzip; NetAnim needs them to be
+   * uncompressed, e.g. with gunzip, before reading them.
+   * The trace file is started again: this must be called right after
+   * the constructor, before anything else is written to the trace.
+   * Needs ns-3 to be built with zlib.
+   *
+   * \param enable true to compress the trace files
+   *
+   * \returns none
+   */
+  void EnableCompression (bool enable = true);
+
+  /**
+   * \brief Write compact binary trace files instead of XML;
+   * ConvertBinaryTrace turns them into the XML read by NetAnim.
+   * The trace file is started again: this must be called right after
+   * the constructor, before anything else is written to the trace.
+   *
+   * \param enable true to write binary trace files
+   *
+   * \returns none
+   */
+  void EnableBinaryTrace (bool enable = true);
+
+  /**
+   * \brief Convert a binary trace file to the XML read by NetAnim
+   *
+   * \param binaryFileName The binary trace file, compressed or not
+   * \param xmlFileName The XML file to write
+   *
+   * \returns true if the conversion succeeded
+   */
+  static bool ConvertBinaryTrace (std::string binaryFileName, std::string xmlFileName);
+
   /**
    * \brief Set mobility poll interval:WARNING: setting a low interval can 
    * cause slowness
@@ -594,11 +642,23 @@ private:
      * \returns the text
      */
     std::string ToString(bool autoClose = true);
+    /**
+     * Write the element to a trace file
+     * \param writer the writer of the trace file
+     * \param autoClose auto close the element
+     */
+    void Write (AnimationTraceWriter * writer, bool autoClose = true);
 
   private:
+    /**
+     * Get the text and the children of the element
+     * \returns the content
+     */
+    std::string GetContent ();
+
     std::string m_tagName; ///< tag name
     std::string m_text; ///< element string
-    std::vector<std::string> m_attributes; ///< list of attributes
+    AnimationTraceWriter::Attributes m_attributes; ///< list of attributes
     std::vector<std::string> m_children; ///< list of children
 
   };
@@ -607,8 +667,12 @@ private:
 
   // ##### State #####
 
-  FILE * m_f; ///< File handle for output (0 if none)
-  FILE * m_routingF; ///< File handle for routing table output (0 if None);
+  AnimationTraceWriter * m_f; ///< Writer of the output file (0 if none)
+  AnimationTraceWriter * m_routingF; ///< Writer of the routing table output (0 if None);
+  bool m_asyncWrite; ///< write the trace files on a background thread
+  bool m_compress; ///< compress the trace files
+  AnimationTraceWriter::Format m_traceFormat; ///< format of the trace files
+  uint64_t m_headerRecordCount; ///< number of records written when the trace file was started
   Time m_mobilityPollInterval; ///< mobility poll interval
   std::string m_outputFileName; ///< output file name
   uint64_t gAnimUid ;    ///< Packet unique identifier used by AnimationInterface
@@ -735,6 +799,12 @@ private:
    * \param onlyAnimation
    */
   void StopAnimation (bool onlyAnimation = false);
+
+  /**
+   * Start the trace file again with the current writer options,
+   * discarding what was written
+   */
+  void RestartTraceFile ();
   /**
    * Counter type to string function
    * \param counterType the counter type
@@ -760,14 +830,20 @@ private:
    * \param f the file to write to
    * \returns the number of bytes written
    */
-  int WriteN (const char* data, uint32_t count, FILE * f);
+  int WriteN (const char* data, uint32_t count, AnimationTraceWriter * f);
   /**
    * WriteN function
    * \param st the string to output
    * \param f the file to write to
    * \returns the number of bytes written
    */
-  int WriteN (const std::string& st, FILE * f);
+  int WriteN (const std::string& st, AnimationTraceWriter * f);
+  /**
+   * Write an element
+   * \param element the element to output
+   * \param f the file to write to
+   */
+  void WriteElement (AnimXmlElement& element, AnimationTraceWriter * f);
   /**
    * Get MAC address function
    * \param nd the device
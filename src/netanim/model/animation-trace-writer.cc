@@ -0,0 +1,639 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <cstring>
+
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include "ns3/callback.h"
+#include "animation-trace-writer.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+/*
+ * Layout of a binary trace file: the 8 bytes of BINARY_MAGIC, followed
+ * by records made of a type byte and of fields which are unsigned
+ * LEB128 integers, strings prefixed by their length, or bytes:
+ *
+ *   TEXT_RECORD     text
+ *   NAME_RECORD     name (gets the next name index, starting at 0)
+ *   ELEMENT_RECORD  tag name index, number of attributes,
+ *                   (attribute name index, value) for each attribute,
+ *                   content, autoClose byte
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AnimationTraceWriter");
+
+/// Header of a binary trace file
+static const char BINARY_MAGIC[] = "NSANIM01";
+/// Length of the header of a binary trace file
+static const uint32_t BINARY_MAGIC_LENGTH = 8;
+/// Size above which a batch is handed over to the file
+static const uint32_t BATCH_SIZE = 64 * 1024;
+/// Number of batches the writer thread may lag behind before the simulation waits
+static const uint32_t MAX_QUEUED_BATCHES = 16;
+/// Time the threads wait before checking their condition again, in nanoseconds
+static const uint64_t WAIT_NS = 100000000;
+
+/// Types of the records of a binary trace file
+enum BinaryRecordType
+{
+  TEXT_RECORD = 0,
+  NAME_RECORD = 1,
+  ELEMENT_RECORD = 2
+};
+
+AnimationTraceWriter::AnimationTraceWriter (const std::string &fileName, Format format, bool compress, bool async)
+  : m_format (format),
+    m_file (0),
+    m_gzFile (0),
+    m_async (false),
+    m_recordCount (0)
+#ifdef HAVE_PTHREAD_H
+    ,
+    m_stopping (false)
+#endif
+{
+  NS_LOG_FUNCTION (this << fileName << format << compress << async);
+  if (compress)
+    {
+#ifdef HAVE_ZLIB
+      m_gzFile = gzopen (fileName.c_str (), "wb1");
+      if (!m_gzFile)
+        {
+          NS_FATAL_ERROR ("Unable to open output file:" << fileName);
+        }
+#else
+      NS_FATAL_ERROR ("Compressed trace files need ns-3 to be built with zlib");
+#endif
+    }
+  else
+    {
+      m_file = std::fopen (fileName.c_str (), "w");
+      if (!m_file)
+        {
+          NS_FATAL_ERROR ("Unable to open output file:" << fileName);
+        }
+    }
+  m_batch.reserve (BATCH_SIZE + BATCH_SIZE / 4);
+  if (m_format == BINARY)
+    {
+      m_batch.append (BINARY_MAGIC, BINARY_MAGIC_LENGTH);
+    }
+  if (async)
+    {
+#ifdef HAVE_PTHREAD_H
+      m_async = true;
+      m_thread = Create<SystemThread> (MakeCallback (&AnimationTraceWriter::Run, this));
+      m_thread->Start ();
+#else
+      NS_LOG_WARN ("Threads are not supported, the trace file is written synchronously");
+#endif
+    }
+}
+
+AnimationTraceWriter::~AnimationTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+AnimationTraceWriter::Format
+AnimationTraceWriter::GetFormat (void) const
+{
+  return m_format;
+}
+
+uint64_t
+AnimationTraceWriter::GetRecordCount (void) const
+{
+  return m_recordCount;
+}
+
+void
+AnimationTraceWriter::Write (const char *data, uint32_t count)
+{
+  if (m_format == BINARY)
+    {
+      m_batch.push_back (TEXT_RECORD);
+      AppendString (data, count);
+    }
+  else
+    {
+      m_batch.append (data, count);
+    }
+  EndRecord ();
+}
+
+void
+AnimationTraceWriter::WriteElement (const std::string &tagName, const Attributes &attributes,
+                                    const std::string &content, bool autoClose)
+{
+  if (m_format == XML)
+    {
+      m_batch += FormatElement (tagName, attributes, content, autoClose);
+      EndRecord ();
+      return;
+    }
+  // Define the names before the element which uses them
+  uint32_t tagIndex = GetNameIndex (tagName);
+  std::vector<uint32_t> nameIndexes;
+  nameIndexes.reserve (attributes.size ());
+  for (Attributes::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
+    {
+      nameIndexes.push_back (GetNameIndex (i->first));
+    }
+  m_batch.push_back (ELEMENT_RECORD);
+  AppendVarint (tagIndex);
+  AppendVarint (attributes.size ());
+  for (std::size_t i = 0; i < attributes.size (); ++i)
+    {
+      AppendVarint (nameIndexes[i]);
+      AppendString (attributes[i].second.data (), attributes[i].second.size ());
+    }
+  AppendString (content.data (), content.size ());
+  m_batch.push_back (autoClose ? 1 : 0);
+  EndRecord ();
+}
+
+void
+AnimationTraceWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_file && !m_gzFile)
+    {
+      return;
+    }
+  Flush ();
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      m_mutex.Lock ();
+      m_stopping = true;
+      m_mutex.Unlock ();
+      m_queued.SetCondition (true);
+      m_queued.Signal ();
+      m_thread->Join ();
+      m_thread = 0;
+      m_async = false;
+    }
+#endif
+  if (m_file)
+    {
+      std::fclose (m_file);
+      m_file = 0;
+    }
+#ifdef HAVE_ZLIB
+  if (m_gzFile)
+    {
+      gzclose (static_cast<gzFile> (m_gzFile));
+      m_gzFile = 0;
+    }
+#endif
+}
+
+std::string
+AnimationTraceWriter::FormatElement (const std::string &tagName, const Attributes &attributes,
+                                     const std::string &content, bool autoClose)
+{
+  std::string elementString = "<" + tagName + " ";
+  for (Attributes::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
+    {
+      elementString += i->first + "=\"" + i->second + "\" ";
+    }
+  if (content.empty ())
+    {
+      if (autoClose)
+        {
+          elementString += "/>";
+        }
+    }
+  else
+    {
+      elementString += ">" + content;
+      if (autoClose)
+        {
+          elementString += "</" + tagName + ">";
+        }
+    }
+  if (autoClose)
+    {
+      elementString += "\n";
+    }
+  return elementString;
+}
+
+bool
+AnimationTraceWriter::IsCompressionSupported (void)
+{
+#ifdef HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+AnimationTraceWriter::AppendVarint (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_batch.push_back (static_cast<char> ((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+  m_batch.push_back (static_cast<char> (value));
+}
+
+void
+AnimationTraceWriter::AppendString (const char *data, uint64_t count)
+{
+  AppendVarint (count);
+  m_batch.append (data, count);
+}
+
+uint32_t
+AnimationTraceWriter::GetNameIndex (const std::string &name)
+{
+  std::unordered_map<std::string, uint32_t>::const_iterator it = m_names.find (name);
+  if (it != m_names.end ())
+    {
+      return it->second;
+    }
+  uint32_t index = m_names.size ();
+  m_names[name] = index;
+  m_batch.push_back (NAME_RECORD);
+  AppendString (name.data (), name.size ());
+  return index;
+}
+
+void
+AnimationTraceWriter::EndRecord (void)
+{
+  ++m_recordCount;
+  if (m_batch.size () >= BATCH_SIZE)
+    {
+      Flush ();
+    }
+}
+
+void
+AnimationTraceWriter::Flush (void)
+{
+  if (m_batch.empty ())
+    {
+      return;
+    }
+  if (!m_async)
+    {
+      WriteBatch (m_batch);
+      m_batch.clear ();
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  while (true)
+    {
+      m_written.SetCondition (false);
+      m_mutex.Lock ();
+      if (m_queue.size () < MAX_QUEUED_BATCHES)
+        {
+          m_queue.push_back (std::string ());
+          m_queue.back ().swap (m_batch);
+          m_mutex.Unlock ();
+          break;
+        }
+      m_mutex.Unlock ();
+      m_written.TimedWait (WAIT_NS);
+    }
+  m_queued.SetCondition (true);
+  m_queued.Signal ();
+  m_batch.reserve (BATCH_SIZE + BATCH_SIZE / 4);
+#endif
+}
+
+void
+AnimationTraceWriter::WriteBatch (const std::string &batch)
+{
+  if (m_file)
+    {
+      if (std::fwrite (batch.data (), 1, batch.size (), m_file) != batch.size ())
+        {
+          NS_LOG_ERROR ("Unable to write the trace file");
+        }
+    }
+#ifdef HAVE_ZLIB
+  else if (m_gzFile)
+    {
+      if (gzwrite (static_cast<gzFile> (m_gzFile), batch.data (), batch.size ()) != static_cast<int> (batch.size ()))
+        {
+          NS_LOG_ERROR ("Unable to write the trace file");
+        }
+    }
+#endif
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+AnimationTraceWriter::Run (void)
+{
+  std::string batch;
+  while (true)
+    {
+      // Reset the condition before looking at the queue, so that a
+      // batch queued in between wakes the wait below up
+      m_queued.SetCondition (false);
+      m_mutex.Lock ();
+      bool stopping = m_stopping;
+      if (!m_queue.empty ())
+        {
+          batch.swap (m_queue.front ());
+          m_queue.pop_front ();
+        }
+      m_mutex.Unlock ();
+      if (!batch.empty ())
+        {
+          WriteBatch (batch);
+          batch.clear ();
+          m_written.SetCondition (true);
+          m_written.Signal ();
+          continue;
+        }
+      if (stopping)
+        {
+          return;
+        }
+      m_queued.TimedWait (WAIT_NS);
+    }
+}
+#endif
+
+/**
+ * \ingroup netanim
+ *
+ * \brief Reads the fields of a binary trace file
+ */
+class BinaryTraceReader
+{
+public:
+  /**
+   * Open a binary trace file
+   * \param fileName the name of the file
+   */
+  BinaryTraceReader (const std::string &fileName);
+  ~BinaryTraceReader ();
+  /**
+   * \returns true if the file is open
+   */
+  bool IsOpen (void) const;
+  /**
+   * Read a byte
+   * \param byte the byte read
+   * \returns false at the end of the file
+   */
+  bool ReadByte (uint8_t &byte);
+  /**
+   * Read a variable-length unsigned integer
+   * \param value the integer read
+   * \returns false at the end of the file
+   */
+  bool ReadVarint (uint64_t &value);
+  /**
+   * Read a length-prefixed string
+   * \param data the string read
+   * \returns false at the end of the file
+   */
+  bool ReadString (std::string &data);
+
+private:
+  /// Refill the buffer
+  void Fill (void);
+
+  std::FILE *m_file;          //!< uncompressed file, or 0
+  void *m_gzFile;             //!< compressed file, or 0
+  std::vector<char> m_buffer; //!< data read from the file
+  std::size_t m_pos;          //!< position of the next byte in m_buffer
+  std::size_t m_size;         //!< number of bytes in m_buffer
+};
+
+BinaryTraceReader::BinaryTraceReader (const std::string &fileName)
+  : m_file (0),
+    m_gzFile (0),
+    m_buffer (BATCH_SIZE),
+    m_pos (0),
+    m_size (0)
+{
+#ifdef HAVE_ZLIB
+  // gzread also reads uncompressed files
+  m_gzFile = gzopen (fileName.c_str (), "rb");
+#else
+  m_file = std::fopen (fileName.c_str (), "rb");
+#endif
+}
+
+BinaryTraceReader::~BinaryTraceReader ()
+{
+  if (m_file)
+    {
+      std::fclose (m_file);
+    }
+#ifdef HAVE_ZLIB
+  if (m_gzFile)
+    {
+      gzclose (static_cast<gzFile> (m_gzFile));
+    }
+#endif
+}
+
+bool
+BinaryTraceReader::IsOpen (void) const
+{
+  return m_file || m_gzFile;
+}
+
+void
+BinaryTraceReader::Fill (void)
+{
+  int n = 0;
+  if (m_file)
+    {
+      n = std::fread (&m_buffer[0], 1, m_buffer.size (), m_file);
+    }
+#ifdef HAVE_ZLIB
+  else if (m_gzFile)
+    {
+      n = gzread (static_cast<gzFile> (m_gzFile), &m_buffer[0], m_buffer.size ());
+    }
+#endif
+  m_pos = 0;
+  m_size = n > 0 ? n : 0;
+}
+
+bool
+BinaryTraceReader::ReadByte (uint8_t &byte)
+{
+  if (m_pos == m_size)
+    {
+      Fill ();
+      if (m_size == 0)
+        {
+          return false;
+        }
+    }
+  byte = m_buffer[m_pos++];
+  return true;
+}
+
+bool
+BinaryTraceReader::ReadVarint (uint64_t &value)
+{
+  value = 0;
+  uint8_t byte;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      if (!ReadByte (byte))
+        {
+          return false;
+        }
+      value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+bool
+BinaryTraceReader::ReadString (std::string &data)
+{
+  uint64_t count;
+  if (!ReadVarint (count))
+    {
+      return false;
+    }
+  data.clear ();
+  while (data.size () < count)
+    {
+      if (m_pos == m_size)
+        {
+          Fill ();
+          if (m_size == 0)
+            {
+              return false;
+            }
+        }
+      std::size_t n = std::min<uint64_t> (count - data.size (), m_size - m_pos);
+      data.append (&m_buffer[m_pos], n);
+      m_pos += n;
+    }
+  return true;
+}
+
+bool
+AnimationTraceWriter::ConvertBinaryTrace (const std::string &binaryFileName, const std::string &xmlFileName)
+{
+  NS_LOG_FUNCTION (binaryFileName << xmlFileName);
+  BinaryTraceReader reader (binaryFileName);
+  if (!reader.IsOpen ())
+    {
+      NS_LOG_ERROR ("Unable to open " << binaryFileName);
+      return false;
+    }
+  std::string magic;
+  uint8_t byte;
+  while (magic.size () < BINARY_MAGIC_LENGTH && reader.ReadByte (byte))
+    {
+      magic.push_back (byte);
+    }
+  if (magic != std::string (BINARY_MAGIC, BINARY_MAGIC_LENGTH))
+    {
+      NS_LOG_ERROR (binaryFileName << " is not a binary animation trace file");
+      return false;
+    }
+  std::ofstream xml (xmlFileName.c_str (), std::ios::out | std::ios::binary);
+  if (!xml.is_open ())
+    {
+      NS_LOG_ERROR ("Unable to open " << xmlFileName);
+      return false;
+    }
+
+  std::vector<std::string> names;
+  std::string text;
+  Attributes attributes;
+  while (reader.ReadByte (byte))
+    {
+      switch (byte)
+        {
+        case TEXT_RECORD:
+          if (!reader.ReadString (text))
+            {
+              NS_LOG_ERROR ("Truncated text record in " << binaryFileName);
+              return false;
+            }
+          xml << text;
+          break;
+        case NAME_RECORD:
+          if (!reader.ReadString (text))
+            {
+              NS_LOG_ERROR ("Truncated name record in " << binaryFileName);
+              return false;
+            }
+          names.push_back (text);
+          break;
+        case ELEMENT_RECORD:
+          {
+            uint64_t tagIndex;
+            uint64_t nAttributes;
+            if (!reader.ReadVarint (tagIndex) || tagIndex >= names.size ()
+                || !reader.ReadVarint (nAttributes))
+              {
+                NS_LOG_ERROR ("Invalid element record in " << binaryFileName);
+                return false;
+              }
+            attributes.resize (nAttributes);
+            for (uint64_t i = 0; i < nAttributes; ++i)
+              {
+                uint64_t nameIndex;
+                if (!reader.ReadVarint (nameIndex) || nameIndex >= names.size ()
+                    || !reader.ReadString (attributes[i].second))
+                  {
+                    NS_LOG_ERROR ("Invalid attribute in " << binaryFileName);
+                    return false;
+                  }
+                attributes[i].first = names[nameIndex];
+              }
+            uint8_t autoClose;
+            if (!reader.ReadString (text) || !reader.ReadByte (autoClose))
+              {
+                NS_LOG_ERROR ("Truncated element record in " << binaryFileName);
+                return false;
+              }
+            xml << FormatElement (names[tagIndex], attributes, text, autoClose != 0);
+          }
+          break;
+        default:
+          NS_LOG_ERROR ("Unknown record type " << +byte << " in " << binaryFileName);
+          return false;
+        }
+    }
+  return xml.good ();
+}
+
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ANIMATION_TRACE_WRITER_H
+#define ANIMATION_TRACE_WRITER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <unordered_map>
+#include <cstdio>
+#include <stdint.h>
+
+#include "ns3/ptr.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-condition.h"
+#endif
+
+namespace ns3 {
+
+/**
+ * \ingroup netanim
+ *
+ * \brief Writes the records of an animation trace file
+ *
+ * The records are appended to an in-memory batch on the simulation
+ * thread.  Full batches are written to the file either directly, or,
+ * if the writer is asynchronous, by a background thread: the
+ * simulation thread then only synchronizes with the writer thread
+ * once per batch, and never waits for the file system unless the
+ * writer thread falls behind by more than a few batches.
+ *
+ * The file is either the XML read by NetAnim, or a compact binary
+ * file in which the tag and attribute names are replaced by indexes,
+ * which ConvertBinaryTrace turns back into the XML.  Either can be
+ * compressed with gzip when ns-3 is built with zlib.
+ */
+class AnimationTraceWriter
+{
+public:
+  /// Format of the trace file
+  enum Format
+  {
+    XML,    ///< XML read by NetAnim
+    BINARY  ///< Compact binary records, see ConvertBinaryTrace
+  };
+
+  /// The name and the formatted value of each attribute of an element
+  typedef std::vector<std::pair<std::string, std::string> > Attributes;
+
+  /**
+   * Open a trace file
+   * \param fileName the name of the file
+   * \param format the format of the file
+   * \param compress true to compress the file with gzip
+   * \param async true to write the file on a background thread
+   */
+  AnimationTraceWriter (const std::string &fileName, Format format, bool compress, bool async);
+  /// Flush the pending records and close the file
+  ~AnimationTraceWriter ();
+
+  /**
+   * \returns the format of the file
+   */
+  Format GetFormat (void) const;
+  /**
+   * \returns the number of records written so far
+   */
+  uint64_t GetRecordCount (void) const;
+
+  /**
+   * Write XML text verbatim
+   * \param data the text
+   * \param count the number of bytes of the text
+   */
+  void Write (const char *data, uint32_t count);
+  /**
+   * Write an XML element
+   * \param tagName the tag name of the element
+   * \param attributes the attributes of the element
+   * \param content the text and the children of the element
+   * \param autoClose true to close the element
+   */
+  void WriteElement (const std::string &tagName, const Attributes &attributes,
+                     const std::string &content, bool autoClose);
+  /**
+   * Write the pending records and close the file
+   */
+  void Close (void);
+
+  /**
+   * Format an XML element the way NetAnim expects it
+   * \param tagName the tag name of the element
+   * \param attributes the attributes of the element
+   * \param content the text and the children of the element
+   * \param autoClose true to close the element
+   * \returns the XML text of the element
+   */
+  static std::string FormatElement (const std::string &tagName, const Attributes &attributes,
+                                    const std::string &content, bool autoClose);
+  /**
+   * \returns true if ns-3 was built with zlib, so that trace files can be compressed
+   */
+  static bool IsCompressionSupported (void);
+  /**
+   * Convert a binary trace file, compressed or not, to the XML read by NetAnim
+   * \param binaryFileName the name of the binary trace file
+   * \param xmlFileName the name of the XML file to write
+   * \returns true if the conversion succeeded
+   */
+  static bool ConvertBinaryTrace (const std::string &binaryFileName, const std::string &xmlFileName);
+
+private:
+  /**
+   * Append a variable-length unsigned integer to the current batch
+   * \param value the integer
+   */
+  void AppendVarint (uint64_t value);
+  /**
+   * Append a length-prefixed string to the current batch
+   * \param data the string
+   * \param count the length of the string
+   */
+  void AppendString (const char *data, uint64_t count);
+  /**
+   * Get the index of a tag or attribute name, defining it in the file
+   * on first use
+   * \param name the name
+   * \returns the index of the name
+   */
+  uint32_t GetNameIndex (const std::string &name);
+  /// Account for a record, and hand the batch over once it is full
+  void EndRecord (void);
+  /// Hand the current batch over to the file
+  void Flush (void);
+  /**
+   * Write a batch to the file
+   * \param batch the batch
+   */
+  void WriteBatch (const std::string &batch);
+#ifdef HAVE_PTHREAD_H
+  /// Main loop of the writer thread
+  void Run (void);
+#endif
+
+  Format m_format;                //!< format of the file
+  std::FILE *m_file;              //!< uncompressed file, or 0
+  void *m_gzFile;                 //!< compressed file, or 0
+  bool m_async;                   //!< true if a background thread writes the file
+  std::string m_batch;            //!< records not handed over yet
+  uint64_t m_recordCount;         //!< number of records written
+  std::unordered_map<std::string, uint32_t> m_names; //!< indexes of the names of a binary file
+#ifdef HAVE_PTHREAD_H
+  Ptr<SystemThread> m_thread;     //!< the writer thread
+  SystemMutex m_mutex;            //!< protects m_queue and m_stopping
+  SystemCondition m_queued;       //!< signalled when a batch is queued or the writer stops
+  SystemCondition m_written;      //!< signalled when a batch has been written
+  std::deque<std::string> m_queue; //!< batches waiting for the writer thread
+  bool m_stopping;                //!< true when the writer thread must exit
+#endif
+};
+
+} // namespace ns3
+
+#endif /* ANIMATION_TRACE_WRITER_H */
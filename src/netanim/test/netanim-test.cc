@@ -18,6 +18,8 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include "unistd.h"
 
 #include "ns3/core-module.h"
@@ -253,6 +255,127 @@ AnimationRemainingEnergyTestCase::CheckLogic (void)
                             "Wrong remaining energy value was traced");
 }
 
+/**
+ * \ingroup netanim-test
+ * \ingroup tests
+ *
+ * \brief Animation Trace Writer Test Case
+ *
+ * Runs the same simulation twice, writing an XML trace file the first
+ * time, and a binary trace file on a background thread the second time,
+ * compressed if possible, and checks that converting the binary file
+ * gives back the XML file.
+ */
+class AnimationTraceWriterTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationTraceWriterTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the simulation
+   * \param fileName the trace file name
+   * \param binary true to write a binary trace file
+   */
+  void RunSimulation (std::string fileName, bool binary);
+
+  /**
+   * Read a file
+   * \param fileName the file name
+   * \returns the content of the file
+   */
+  std::string ReadFile (std::string fileName);
+};
+
+AnimationTraceWriterTestCase::AnimationTraceWriterTestCase () :
+  TestCase ("Verify binary and asynchronous trace files")
+{
+}
+
+void
+AnimationTraceWriterTestCase::RunSimulation (std::string fileName, bool binary)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+  // Both runs must give the same addresses to the devices
+  devices.Get (0)->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  devices.Get (1)->SetAddress (Mac48Address ("00:00:00:00:00:02"));
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (0.01)));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+
+  AnimationInterface * anim = new AnimationInterface (fileName);
+  if (binary)
+    {
+      anim->EnableBinaryTrace ();
+      anim->EnableAsyncWrite ();
+      anim->EnableCompression (AnimationTraceWriter::IsCompressionSupported ());
+    }
+  anim->UpdateNodeDescription (nodes.Get (0), "client & <echo>");
+  Simulator::Stop (Seconds (11));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (anim->GetTracePktCount (), 200, "Expected 200 packets traced");
+  delete anim;
+  Simulator::Destroy ();
+}
+
+std::string
+AnimationTraceWriterTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str ());
+  std::ostringstream oss;
+  oss << file.rdbuf ();
+  return oss.str ();
+}
+
+void
+AnimationTraceWriterTestCase::DoRun (void)
+{
+  RunSimulation ("netanim-test-reference.xml", false);
+  RunSimulation ("netanim-test-binary.bin", true);
+  NS_TEST_ASSERT_MSG_EQ (AnimationInterface::ConvertBinaryTrace ("netanim-test-binary.bin", "netanim-test-converted.xml"),
+                         true, "Conversion of the binary trace file failed");
+
+  std::string reference = ReadFile ("netanim-test-reference.xml");
+  NS_TEST_EXPECT_MSG_GT (reference.size (), 10000, "The reference trace file is too short");
+  NS_TEST_EXPECT_MSG_EQ ((ReadFile ("netanim-test-converted.xml") == reference), true,
+                         "The converted trace file differs from the XML trace file");
+  NS_TEST_EXPECT_MSG_LT (ReadFile ("netanim-test-binary.bin").size (), reference.size (),
+                         "The binary trace file is not smaller than the XML trace file");
+  NS_TEST_EXPECT_MSG_EQ (AnimationInterface::ConvertBinaryTrace ("netanim-test-reference.xml", "netanim-test-converted.xml"),
+                         false, "An XML trace file was converted");
+  unlink ("netanim-test-reference.xml");
+  unlink ("netanim-test-binary.bin");
+  unlink ("netanim-test-converted.xml");
+}
+
 /**
  * \ingroup netanim-test
  * \ingroup tests
@@ -267,5 +390,6 @@ public:
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
     AddTestCase (new AnimationRemainingEnergyTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationTraceWriterTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite; ///< the test suite
@@ -20,11 +20,17 @@
 
 #include <queue>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
 
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/names.h"
 #include "ns3/ipv4-list-routing.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 
 #include "ipv4-nix-vector-routing.h"
 
@@ -34,7 +40,27 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4NixVectorRouting");
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
-bool Ipv4NixVectorRouting::g_isCacheDirty = false;
+/**
+ * Compares the neighbors by node id
+ * \param a the first neighbor
+ * \param b the second neighbor
+ * \returns true if the node id of a is lower than the one of b
+ */
+static bool
+CompareNeighbor (const std::pair<uint32_t, uint32_t> &a, const std::pair<uint32_t, uint32_t> &b)
+{
+  return a.first < b.first;
+}
+
+uint32_t Ipv4NixVectorRouting::g_cacheVersion = 0;
+bool Ipv4NixVectorRouting::g_isTopologyDirty = true;
+bool Ipv4NixVectorRouting::g_isAddressMapDirty = true;
+std::vector<std::vector<uint32_t> > Ipv4NixVectorRouting::g_predecessors;
+std::vector<std::vector<std::pair<uint32_t, uint32_t> > > Ipv4NixVectorRouting::g_neighborIndexes;
+std::vector<uint32_t> Ipv4NixVectorRouting::g_totalNeighbors;
+std::map<uint32_t, Ipv4NixVectorRouting::RouteTree_t> Ipv4NixVectorRouting::g_routeTrees;
+std::map<Ipv4Address, uint32_t> Ipv4NixVectorRouting::g_nodeByAddress;
+const uint32_t Ipv4NixVectorRouting::NO_NEXT_HOP;
 
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
@@ -48,7 +74,8 @@ Ipv4NixVectorRouting::GetTypeId (void)
 }
 
 Ipv4NixVectorRouting::Ipv4NixVectorRouting ()
-  : m_totalNeighbors (0)
+  : m_cacheVersion (g_cacheVersion),
+    m_totalNeighbors (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -92,18 +119,210 @@ void
 Ipv4NixVectorRouting::FlushGlobalNixRoutingCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
+  InvalidateCaches ();
+}
+
+void
+Ipv4NixVectorRouting::InvalidateCaches (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  NS_LOG_LOGIC ("Flushing route trees and Nix caches.");
+  g_isTopologyDirty = true;
+  g_isAddressMapDirty = true;
+  g_routeTrees.clear ();
+  // the caches of the nodes are flushed when they are next used
+  g_cacheVersion++;
+}
+
+void
+Ipv4NixVectorRouting::InvalidateRouteTrees (uint32_t node)
+{
+  NS_LOG_FUNCTION (node);
+  g_isTopologyDirty = true;
+
+  // Only the links of the node changed, so that the trees in which
+  // the node cannot reach the destination are still valid
+  std::map<uint32_t, RouteTree_t>::iterator it = g_routeTrees.begin ();
+  while (it != g_routeTrees.end ())
+    {
+      const RouteTree_t &tree = it->second;
+      if (it->first == node || (node < tree.size () && tree[node] != NO_NEXT_HOP))
+        {
+          g_routeTrees.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+  g_cacheVersion++;
+}
+
+void
+Ipv4NixVectorRouting::UpdateTopology (void)
+{
+  if (!g_isTopologyDirty && g_predecessors.size () == NodeList::GetNNodes ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION_NOARGS ();
+
+  uint32_t numberOfNodes = NodeList::GetNNodes ();
+  g_predecessors.assign (numberOfNodes, std::vector<uint32_t> ());
+  g_neighborIndexes.assign (numberOfNodes, std::vector<std::pair<uint32_t, uint32_t> > ());
+  g_totalNeighbors.assign (numberOfNodes, 0);
+
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
       Ptr<Node> node = *i;
-      Ptr<Ipv4NixVectorRouting> rp = node->GetObject<Ipv4NixVectorRouting> ();
-      if (!rp)
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      std::vector<std::pair<uint32_t, uint32_t> > &neighborIndexes = g_neighborIndexes[node->GetId ()];
+      uint32_t &totalNeighbors = g_totalNeighbors[node->GetId ()];
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
         {
-          continue;
+          Ptr<NetDevice> localNetDevice = node->GetDevice (j);
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          NetDeviceContainer netDeviceContainer;
+          GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+
+          // The neighbor indexes are those of AddNixHop
+          if (!localNetDevice->IsBridge ())
+            {
+              for (uint32_t k = 0; k < netDeviceContainer.GetN (); k++)
+                {
+                  neighborIndexes.push_back (std::make_pair (netDeviceContainer.Get (k)->GetNode ()->GetId (),
+                                                             totalNeighbors + k));
+                }
+              totalNeighbors += netDeviceContainer.GetN ();
+            }
+
+          // The links are those followed by BFS: a link exists from a node
+          // to each node adjacent to one of its net devices that are up
+          if (ipv4)
+            {
+              int32_t interfaceIndex = ipv4->GetInterfaceForDevice (localNetDevice);
+              if (interfaceIndex == -1 || !(ipv4->IsUp (interfaceIndex)))
+                {
+                  continue;
+                }
+            }
+          if (!(localNetDevice->IsLinkUp ()))
+            {
+              continue;
+            }
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              g_predecessors.at ((*iter)->GetNode ()->GetId ()).push_back (node->GetId ());
+            }
+        }
+      // keep the order of the indexes of a neighbor, as the last one is used
+      std::stable_sort (neighborIndexes.begin (), neighborIndexes.end (), CompareNeighbor);
+    }
+  g_isTopologyDirty = false;
+}
+
+const Ipv4NixVectorRouting::RouteTree_t &
+Ipv4NixVectorRouting::GetRouteTree (uint32_t dest)
+{
+  NS_LOG_FUNCTION (dest);
+
+  UpdateTopology ();
+  std::map<uint32_t, RouteTree_t>::iterator it = g_routeTrees.find (dest);
+  if (it == g_routeTrees.end ())
+    {
+      NS_LOG_LOGIC ("Route tree not in cache, build: ");
+      it = g_routeTrees.insert (std::make_pair (dest, RouteTree_t ())).first;
+      ComputeRouteTree (g_predecessors, dest, it->second);
+    }
+  return it->second;
+}
+
+void
+Ipv4NixVectorRouting::ComputeRouteTree (const std::vector<std::vector<uint32_t> > & predecessors,
+                                        uint32_t dest, RouteTree_t & tree)
+{
+  std::queue<uint32_t> greyNodeList;  // discovered nodes with unexplored predecessors
+
+  tree.assign (predecessors.size (), NO_NEXT_HOP);
+  tree.at (dest) = dest;
+  greyNodeList.push (dest);
+
+  while (greyNodeList.size () != 0)
+    {
+      uint32_t currNode = greyNodeList.front ();
+      greyNodeList.pop ();
+      const std::vector<uint32_t> &nodes = predecessors[currNode];
+      for (std::vector<uint32_t>::const_iterator iter = nodes.begin (); iter != nodes.end (); iter++)
+        {
+          if (tree[*iter] == NO_NEXT_HOP)
+            {
+              tree[*iter] = currNode;
+              greyNodeList.push (*iter);
+            }
         }
-      NS_LOG_LOGIC ("Flushing Nix caches.");
-      rp->FlushNixCache ();
-      rp->FlushIpv4RouteCache ();
+    }
+}
+
+void
+Ipv4NixVectorRouting::ComputeRouteTrees (const std::vector<std::vector<uint32_t> > *predecessors,
+                                         std::vector<std::pair<uint32_t, RouteTree_t *> > *trees)
+{
+  for (std::vector<std::pair<uint32_t, RouteTree_t *> >::iterator it = trees->begin (); it != trees->end (); it++)
+    {
+      ComputeRouteTree (*predecessors, it->first, *(it->second));
+    }
+}
+
+void
+Ipv4NixVectorRouting::PrecomputeRouteTrees (NodeContainer destinations, uint32_t nThreads)
+{
+  NS_LOG_FUNCTION (destinations.GetN () << nThreads);
+
+  UpdateTopology ();
+
+  // Insert the missing trees in the cache, and share them between the
+  // threads; the threads only read the adjacency of the nodes and
+  // write their own trees
+  nThreads = std::max<uint32_t> (nThreads, 1);
+  std::vector<std::vector<std::pair<uint32_t, RouteTree_t *> > > trees (nThreads);
+  uint32_t nTrees = 0;
+  for (NodeContainer::Iterator i = destinations.Begin (); i != destinations.End (); ++i)
+    {
+      std::pair<std::map<uint32_t, RouteTree_t>::iterator, bool> ret =
+        g_routeTrees.insert (std::make_pair ((*i)->GetId (), RouteTree_t ()));
+      if (ret.second)
+        {
+          trees[nTrees % nThreads].push_back (std::make_pair (ret.first->first, &ret.first->second));
+          nTrees++;
+        }
+    }
+  NS_LOG_LOGIC ("Computing " << nTrees << " route trees");
+
+#ifdef HAVE_PTHREAD_H
+  if (nThreads > 1 && nTrees > 1)
+    {
+      std::vector<Ptr<SystemThread> > threads;
+      for (uint32_t t = 0; t < nThreads; t++)
+        {
+          threads.push_back (Create<SystemThread> (MakeBoundCallback (&Ipv4NixVectorRouting::ComputeRouteTrees,
+                                                                      &g_predecessors, &trees[t])));
+          threads.back ()->Start ();
+        }
+      for (uint32_t t = 0; t < nThreads; t++)
+        {
+          threads[t]->Join ();
+        }
+      return;
+    }
+#endif
+  for (uint32_t t = 0; t < nThreads; t++)
+    {
+      ComputeRouteTrees (&g_predecessors, &trees[t]);
     }
 }
 
@@ -150,11 +369,23 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
     {
       // otherwise proceed as normal 
       // and build the nix vector
-      std::vector< Ptr<Node> > parentVector;
+      bool found;
+      if (oif)
+        {
+          // a specific output interface is given, so that the
+          // route tree shared by all the sources cannot be used
+          std::vector< Ptr<Node> > parentVector;
 
-      BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
+          BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
+          found = BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector);
+        }
+      else
+        {
+          found = BuildNixVectorFromTree (GetRouteTree (destNode->GetId ()),
+                                          source->GetId (), destNode->GetId (), nixVector);
+        }
 
-      if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector))
+      if (found)
         {
           return nixVector;
         }
@@ -245,7 +476,54 @@ Ipv4NixVectorRouting::BuildNixVector (const std::vector< Ptr<Node> > & parentVec
     }
 
   Ptr<Node> parentNode = parentVector.at (dest);
+  AddNixHop (parentNode, dest, nixVector);
+
+  // recurse through parent vector, grabbing the path 
+  // and building the nix vector
+  BuildNixVector (parentVector, source, (parentVector.at (dest))->GetId (), nixVector);
+  return true;
+}
+
+bool
+Ipv4NixVectorRouting::BuildNixVectorFromTree (const RouteTree_t & tree, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  if (source >= tree.size () || tree[source] == NO_NEXT_HOP)
+    {
+      return false;
+    }
 
+  std::vector<uint32_t> path (1, source);
+  while (path.back () != dest)
+    {
+      path.push_back (tree[path.back ()]);
+    }
+
+  // the nix vector is built from the destination backwards,
+  // as when recursing through the parent vector of BFS
+  for (std::size_t i = path.size () - 1; i > 0; i--)
+    {
+      // when a node is adjacent through several net devices,
+      // the last neighbor index is used, as in AddNixHop
+      const std::vector<std::pair<uint32_t, uint32_t> > &neighborIndexes = g_neighborIndexes[path[i - 1]];
+      std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it =
+        std::upper_bound (neighborIndexes.begin (), neighborIndexes.end (),
+                          std::make_pair (path[i], std::numeric_limits<uint32_t>::max ()));
+      uint32_t destId = 0;
+      if (it != neighborIndexes.begin () && (it - 1)->first == path[i])
+        {
+          destId = (it - 1)->second;
+        }
+      uint32_t totalNeighbors = g_totalNeighbors[path[i - 1]];
+      nixVector->AddNeighborIndex (destId, nixVector->BitCount (totalNeighbors));
+    }
+  return true;
+}
+
+void
+Ipv4NixVectorRouting::AddNixHop (Ptr<Node> parentNode, uint32_t dest, Ptr<NixVector> nixVector)
+{
   uint32_t numberOfDevices = parentNode->GetNDevices ();
   uint32_t destId = 0;
   uint32_t totalNeighbors = 0;
@@ -295,11 +573,6 @@ Ipv4NixVectorRouting::BuildNixVector (const std::vector< Ptr<Node> > & parentVec
   NS_LOG_LOGIC ("Adding Nix: " << destId << " with " 
                                << nixVector->BitCount (totalNeighbors) << " bits, for node " << parentNode->GetId ());
   nixVector->AddNeighborIndex (destId, nixVector->BitCount (totalNeighbors));
-
-  // recurse through parent vector, grabbing the path 
-  // and building the nix vector
-  BuildNixVector (parentVector, source, (parentVector.at (dest))->GetId (), nixVector);
-  return true;
 }
 
 void
@@ -347,27 +620,38 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
-  NodeContainer allNodes = NodeContainer::GetGlobal ();
-  Ptr<Node> destNode;
-
-  for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
+  if (g_isAddressMapDirty)
     {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      if (ipv4->GetInterfaceForAddress (dest) != -1)
+      // an address assigned to several nodes is mapped
+      // to the first of them in the node list
+      g_nodeByAddress.clear ();
+      NodeList::Iterator listEnd = NodeList::End ();
+      for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
         {
-          destNode = node;
-          break;
+          Ptr<Ipv4> ipv4 = (*i)->GetObject<Ipv4> ();
+          if (!ipv4)
+            {
+              continue;
+            }
+          for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
+            {
+              for (uint32_t k = 0; k < ipv4->GetNAddresses (j); k++)
+                {
+                  g_nodeByAddress.insert (std::make_pair (ipv4->GetAddress (j, k).GetLocal (), (*i)->GetId ()));
+                }
+            }
         }
+      g_isAddressMapDirty = false;
     }
 
-  if (!destNode)
+  std::map<Ipv4Address, uint32_t>::const_iterator it = g_nodeByAddress.find (dest);
+  if (it == g_nodeByAddress.end ())
     {
       NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
       return 0;
     }
 
-  return destNode;
+  return NodeList::GetNode (it->second);
 }
 
 uint32_t
@@ -402,7 +686,7 @@ Ipv4NixVectorRouting::FindTotalNeighbors (void)
 }
 
 Ptr<BridgeNetDevice>
-Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd) const
+Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd)
 {
   NS_LOG_FUNCTION (nd);
 
@@ -752,22 +1036,34 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
 void
 Ipv4NixVectorRouting::NotifyInterfaceUp (uint32_t i)
 {
-  g_isCacheDirty = true;
+  // a new link may shorten any path
+  g_isTopologyDirty = true;
+  g_routeTrees.clear ();
+  g_cacheVersion++;
 }
 void
 Ipv4NixVectorRouting::NotifyInterfaceDown (uint32_t i)
 {
-  g_isCacheDirty = true;
+  if (m_node)
+    {
+      InvalidateRouteTrees (m_node->GetId ());
+    }
+  else
+    {
+      InvalidateCaches ();
+    }
 }
 void
 Ipv4NixVectorRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
-  g_isCacheDirty = true;
+  g_isAddressMapDirty = true;
+  g_cacheVersion++;
 }
 void
 Ipv4NixVectorRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
-  g_isCacheDirty = true;
+  g_isAddressMapDirty = true;
+  g_cacheVersion++;
 }
 
 bool
@@ -921,10 +1217,11 @@ Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source,
 void 
 Ipv4NixVectorRouting::CheckCacheStateAndFlush (void) const
 {
-  if (g_isCacheDirty)
+  if (m_cacheVersion != g_cacheVersion)
     {
-      FlushGlobalNixRoutingCache ();
-      g_isCacheDirty = false;
+      FlushNixCache ();
+      FlushIpv4RouteCache ();
+      m_cacheVersion = g_cacheVersion;
     }
 }
 
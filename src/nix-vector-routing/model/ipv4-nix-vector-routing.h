@@ -22,6 +22,7 @@
 #define IPV4_NIX_VECTOR_ROUTING_H
 
 #include <map>
+#include <vector>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
@@ -78,8 +79,8 @@ public:
 
   /**
    * @brief Called when run-time link topology change occurs
-   * which iterates through the node list and flushes any
-   * nix vector caches
+   * which flushes the route trees and the nix vector caches
+   * of all the nodes
    *
    * \internal
    * \c const is used here due to need to potentially flush the cache
@@ -88,8 +89,78 @@ public:
    */
   void FlushGlobalNixRoutingCache (void) const;
 
+  /**
+   * @brief Compute the route trees towards the given destination nodes
+   *
+   * The route trees are otherwise computed on demand, when a packet is
+   * first sent towards a destination.  Computing them before
+   * Simulator::Run avoids doing so during the simulation; the trees are
+   * computed by \p nThreads threads, if threading is enabled.  The trees
+   * are shared by all the nodes until the next topology change.
+   *
+   * @param destinations the destination nodes
+   * @param nThreads the number of threads used to compute the trees
+   */
+  static void PrecomputeRouteTrees (NodeContainer destinations, uint32_t nThreads = 1);
+
 private:
 
+  /**
+   * Route tree towards a destination node: the node id of the next hop
+   * of each node, or NO_NEXT_HOP if the destination is not reachable.
+   */
+  typedef std::vector<uint32_t> RouteTree_t;
+
+  /// Marker of the nodes without a path to the destination in a RouteTree_t
+  static const uint32_t NO_NEXT_HOP = 0xffffffff;
+
+  /**
+   * Rebuilds, if needed, the adjacency of the nodes that is used to
+   * compute the route trees, and the neighbor indexes of the nodes
+   * that are used to build the nix vectors.
+   */
+  static void UpdateTopology (void);
+
+  /**
+   * Gets the route tree towards a destination node, computing it if
+   * it is not in the cache
+   * \param dest the destination node id
+   * \returns the route tree
+   */
+  static const RouteTree_t & GetRouteTree (uint32_t dest);
+
+  /**
+   * Breadth first search from the destination node, over the links
+   * in reverse direction.  Only uses the adjacency of the nodes, so that
+   * trees can be computed concurrently.
+   * \param [in] predecessors the nodes with a link towards each node
+   * \param [in] dest the destination node id
+   * \param [out] tree the route tree
+   */
+  static void ComputeRouteTree (const std::vector<std::vector<uint32_t> > & predecessors,
+                                uint32_t dest, RouteTree_t & tree);
+
+  /**
+   * Computes a set of route trees; the body of the threads of
+   * PrecomputeRouteTrees
+   * \param predecessors the nodes with a link towards each node
+   * \param trees the destination node ids and their route trees
+   */
+  static void ComputeRouteTrees (const std::vector<std::vector<uint32_t> > *predecessors,
+                                 std::vector<std::pair<uint32_t, RouteTree_t *> > *trees);
+
+  /**
+   * Invalidates the route trees in which a node can reach the destination,
+   * after a change of its interfaces.
+   * \param node the node id
+   */
+  static void InvalidateRouteTrees (uint32_t node);
+
+  /**
+   * Invalidates the caches of all the nodes
+   */
+  static void InvalidateCaches (void);
+
   /**
    * Flushes the cache which stores nix-vector based on
    * destination IP
@@ -142,11 +213,11 @@ private:
    * \param [in] channel the channel to check
    * \param [out] netDeviceContainer the NetDeviceContainer of the NetDevices in the channel.
    */
-  void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
+  static void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
 
   /**
-   * Iterates through the node list and finds the one
-   * corresponding to the given Ipv4Address
+   * Finds the node corresponding to the given Ipv4Address, from a
+   * map of the addresses of all the nodes
    * \param dest destination node IP
    * \return The node with the specified IP.
    */
@@ -162,6 +233,25 @@ private:
    */
   bool BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
 
+  /**
+   * Follows the route tree from the source to the destination and builds
+   * the nixvector from the neighbor indexes of the nodes
+   * \param [in] tree Route tree towards the destination
+   * \param [in] source Source Node index
+   * \param [in] dest Destination Node index
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns true on success, false otherwise.
+   */
+  static bool BuildNixVectorFromTree (const RouteTree_t & tree, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
+
+  /**
+   * Adds to the nixvector the neighbor index of a node from its parent
+   * \param [in] parentNode the parent node
+   * \param [in] dest the node id of the neighbor
+   * \param [out] nixVector the NixVector to be used for routing
+   */
+  void AddNixHop (Ptr<Node> parentNode, uint32_t dest, Ptr<NixVector> nixVector);
+
   /**
    * Special variation of BuildNixVector for when a node is sending to itself
    * \param [out] nixVector the NixVector to be used for routing
@@ -181,7 +271,7 @@ private:
    * \param nd the NetDevice to check
    * \returns the bridging NetDevice (or null if the NetDevice is not bridged)
    */
-  Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd) const;
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
 
 
   /**
@@ -228,10 +318,37 @@ private:
   void CheckCacheStateAndFlush (void) const;
 
   /**
-   * Flag to mark when caches are dirty and need to be flushed.  
+   * Version of the caches, incremented when they need to be flushed.
    * Used for lazy cleanup of caches when there are many topology changes.
    */
-  static bool g_isCacheDirty;
+  static uint32_t g_cacheVersion;
+
+  /** Flag to mark when the adjacency of the nodes needs to be rebuilt */
+  static bool g_isTopologyDirty;
+
+  /** Flag to mark when the map of the addresses needs to be rebuilt */
+  static bool g_isAddressMapDirty;
+
+  /** Nodes with a link towards each node, indexed by node id */
+  static std::vector<std::vector<uint32_t> > g_predecessors;
+
+  /**
+   * Neighbor index of the neighbors of each node, as in the nix vectors,
+   * sorted by neighbor node id and indexed by node id
+   */
+  static std::vector<std::vector<std::pair<uint32_t, uint32_t> > > g_neighborIndexes;
+
+  /** Total neighbors of each node, indexed by node id */
+  static std::vector<uint32_t> g_totalNeighbors;
+
+  /** Route trees shared by all the nodes, indexed by destination node id */
+  static std::map<uint32_t, RouteTree_t> g_routeTrees;
+
+  /** Node id of each address */
+  static std::map<Ipv4Address, uint32_t> g_nodeByAddress;
+
+  /** Version of the caches of this node */
+  mutable uint32_t m_cacheVersion;
 
   /** Cache stores nix-vectors based on destination ip */
   mutable NixMap_t m_nixCache;
@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/socket.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv4-nix-vector-routing.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup nix-vector-routing
+ * \defgroup nix-vector-routing-test Nix-Vector Routing module tests
+ */
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Base class of the tests, which builds a ring of four nodes with a
+ * fifth node attached to node 2:
+ *
+ *   n0 -- n1
+ *   |     |
+ *   n3 -- n2 -- n4
+ *
+ * Each link is a SimpleChannel with its own subnet 10.0.<link>.0/24.
+ */
+class NixVectorRoutingTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param name The name of the test case
+   */
+  NixVectorRoutingTestCase (std::string name);
+
+protected:
+  /// Builds the topology and installs the stack with nix-vector routing
+  void BuildTopology (void);
+
+  /**
+   * Gets the route from a node to an address
+   * \param node The source node
+   * \param dest The destination address
+   * \returns The route, or null if there is no route
+   */
+  Ptr<Ipv4Route> GetRoute (uint32_t node, Ipv4Address dest);
+
+  /**
+   * Sends a packet from node 0 to node 4 and runs the simulation
+   * \returns true if node 4 received the packet
+   */
+  bool SendToNode4 (void);
+
+  /**
+   * Gets the address of a node on a link
+   * \param link The link
+   * \param end 0 for the first node of the link, 1 for the second one
+   * \returns The address
+   */
+  Ipv4Address GetAddress (uint32_t link, uint32_t end) const;
+
+  NodeContainer m_nodes;                            //!< The nodes
+  std::vector<Ipv4InterfaceContainer> m_interfaces; //!< The interfaces of each link
+
+private:
+  /**
+   * Receives the packets of a socket
+   * \param socket The receiving socket
+   */
+  void ReceivePkt (Ptr<Socket> socket);
+
+  /**
+   * Sends a packet
+   * \param socket The sending socket
+   * \param to The destination address
+   */
+  void DoSendData (Ptr<Socket> socket, Ipv4Address to);
+
+  uint32_t m_received; //!< Number of packets received by node 4
+};
+
+NixVectorRoutingTestCase::NixVectorRoutingTestCase (std::string name)
+  : TestCase (name),
+    m_received (0)
+{
+}
+
+void
+NixVectorRoutingTestCase::BuildTopology (void)
+{
+  m_nodes.Create (5);
+
+  Ipv4NixVectorHelper nixRouting;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (nixRouting);
+  stack.Install (m_nodes);
+
+  uint32_t ends[5][2] = { {0, 1}, {1, 2}, {2, 3}, {3, 0}, {2, 4} };
+  SimpleNetDeviceHelper devices;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.0");
+  for (uint32_t link = 0; link < 5; link++)
+    {
+      NetDeviceContainer linkDevices = devices.Install (NodeContainer (m_nodes.Get (ends[link][0]),
+                                                                       m_nodes.Get (ends[link][1])));
+      m_interfaces.push_back (address.Assign (linkDevices));
+      address.NewNetwork ();
+    }
+}
+
+Ipv4Address
+NixVectorRoutingTestCase::GetAddress (uint32_t link, uint32_t end) const
+{
+  return m_interfaces[link].GetAddress (end);
+}
+
+Ptr<Ipv4Route>
+NixVectorRoutingTestCase::GetRoute (uint32_t node, Ipv4Address dest)
+{
+  Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get (node)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Socket::SocketErrno sockerr;
+  return routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+}
+
+void
+NixVectorRoutingTestCase::ReceivePkt (Ptr<Socket> socket)
+{
+  while (socket->Recv ())
+    {
+      m_received++;
+    }
+}
+
+void
+NixVectorRoutingTestCase::DoSendData (Ptr<Socket> socket, Ipv4Address to)
+{
+  socket->SendTo (Create<Packet> (100), 0, InetSocketAddress (to, 1234));
+}
+
+bool
+NixVectorRoutingTestCase::SendToNode4 (void)
+{
+  Ptr<Socket> rxSocket = Socket::CreateSocket (m_nodes.Get (4), UdpSocketFactory::GetTypeId ());
+  rxSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 1234));
+  rxSocket->SetRecvCallback (MakeCallback (&NixVectorRoutingTestCase::ReceivePkt, this));
+  Ptr<Socket> txSocket = Socket::CreateSocket (m_nodes.Get (0), UdpSocketFactory::GetTypeId ());
+
+  uint32_t received = m_received;
+  Simulator::ScheduleWithContext (m_nodes.Get (0)->GetId (), Seconds (0),
+                                  &NixVectorRoutingTestCase::DoSendData, this, txSocket, GetAddress (4, 1));
+  Simulator::Run ();
+  rxSocket->Close ();
+  txSocket->Close ();
+  return m_received == received + 1;
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Checks that the shared route trees are invalidated when interfaces
+ * go down and up.
+ */
+class NixVectorRoutingInterfaceDownTestCase : public NixVectorRoutingTestCase
+{
+public:
+  NixVectorRoutingInterfaceDownTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+NixVectorRoutingInterfaceDownTestCase::NixVectorRoutingInterfaceDownTestCase ()
+  : NixVectorRoutingTestCase ("Route trees after interface changes")
+{
+}
+
+void
+NixVectorRoutingInterfaceDownTestCase::DoRun (void)
+{
+  BuildTopology ();
+
+  Ptr<Ipv4Route> route = GetRoute (0, GetAddress (1, 0));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route from n0 to n1");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), GetAddress (0, 1), "n0 does not route to n1 directly");
+  NS_TEST_ASSERT_MSG_EQ (SendToNode4 (), true, "n4 did not receive the packet of n0");
+
+  // n2 reaches n4 directly whatever the links of n0
+  route = GetRoute (2, GetAddress (4, 1));
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), GetAddress (4, 1), "n2 does not route to n4 directly");
+
+  // n0 - n1 down: n0 goes through n3 and n2
+  Ptr<Ipv4> ipv4 = m_nodes.Get (0)->GetObject<Ipv4> ();
+  uint32_t ifToN1 = ipv4->GetInterfaceForAddress (GetAddress (0, 0));
+  uint32_t ifToN3 = ipv4->GetInterfaceForAddress (GetAddress (3, 1));
+  ipv4->SetDown (ifToN1);
+  route = GetRoute (0, GetAddress (1, 0));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route from n0 to n1");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), GetAddress (3, 0), "n0 does not route to n1 through n3");
+  NS_TEST_ASSERT_MSG_EQ (SendToNode4 (), true, "n4 did not receive the packet of n0");
+
+  // n0 - n3 down too: n0 is isolated, but the other nodes still reach n4
+  ipv4->SetDown (ifToN3);
+  route = GetRoute (0, GetAddress (4, 1));
+  NS_TEST_ASSERT_MSG_EQ (route, 0, "route from an isolated node");
+  route = GetRoute (1, GetAddress (4, 1));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route from n1 to n4");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), GetAddress (1, 1), "n1 does not route to n4 through n2");
+
+  // n0 - n1 up again: direct route
+  ipv4->SetUp (ifToN1);
+  route = GetRoute (0, GetAddress (1, 0));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "no route from n0 to n1");
+  NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), GetAddress (0, 1), "n0 does not route to n1 directly");
+  NS_TEST_ASSERT_MSG_EQ (SendToNode4 (), true, "n4 did not receive the packet of n0");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Checks that the route trees computed before the simulation by several
+ * threads give the same routes as those computed on demand.
+ */
+class NixVectorRoutingPrecomputeTestCase : public NixVectorRoutingTestCase
+{
+public:
+  NixVectorRoutingPrecomputeTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Gets the gateways of the routes between all the pairs of nodes
+   * \returns The gateways
+   */
+  std::vector<Ipv4Address> GetAllGateways (void);
+};
+
+NixVectorRoutingPrecomputeTestCase::NixVectorRoutingPrecomputeTestCase ()
+  : NixVectorRoutingTestCase ("Precomputed route trees")
+{
+}
+
+std::vector<Ipv4Address>
+NixVectorRoutingPrecomputeTestCase::GetAllGateways (void)
+{
+  std::vector<Ipv4Address> gateways;
+  for (uint32_t source = 0; source < m_nodes.GetN (); source++)
+    {
+      for (uint32_t link = 0; link < m_interfaces.size (); link++)
+        {
+          for (uint32_t end = 0; end < 2; end++)
+            {
+              Ptr<Ipv4Route> route = GetRoute (source, GetAddress (link, end));
+              gateways.push_back (route ? route->GetGateway () : Ipv4Address ());
+            }
+        }
+    }
+  return gateways;
+}
+
+void
+NixVectorRoutingPrecomputeTestCase::DoRun (void)
+{
+  BuildTopology ();
+
+  std::vector<Ipv4Address> onDemand = GetAllGateways ();
+  m_nodes.Get (0)->GetObject<Ipv4NixVectorRouting> ()->FlushGlobalNixRoutingCache ();
+  Ipv4NixVectorRouting::PrecomputeRouteTrees (m_nodes, 3);
+  std::vector<Ipv4Address> precomputed = GetAllGateways ();
+
+  NS_TEST_ASSERT_MSG_EQ (onDemand.size (), precomputed.size (), "wrong number of routes");
+  for (uint32_t i = 0; i < onDemand.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (onDemand[i], precomputed[i], "different gateway for route " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (SendToNode4 (), true, "n4 did not receive the packet of n0");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * Nix-vector routing test suite
+ */
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ();
+};
+
+NixVectorRoutingTestSuite::NixVectorRoutingTestSuite ()
+  : TestSuite ("nix-vector-routing", UNIT)
+{
+  AddTestCase (new NixVectorRoutingInterfaceDownTestCase, TestCase::QUICK);
+  AddTestCase (new NixVectorRoutingPrecomputeTestCase, TestCase::QUICK);
+}
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite; //!< Static variable for test initialization
@@ -48,6 +48,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-packet-info-tag.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
 
 /********** Useful macros **********/
 
@@ -957,31 +960,51 @@ RoutingProtocol::RoutingTableComputation ()
   NS_LOG_DEBUG (Simulator::Now ().GetSeconds () << " s: Node " << m_mainAddress
                                                 << ": RoutingTableComputation begin...");
 
-  // 1. All the entries from the routing table are removed.
-  Clear ();
+  // 1. All the entries from the routing table are removed.  The previous
+  // table is kept aside: if the entries to the one and two-hop neighbors
+  // do not change, the entries derived from the topology set are only
+  // updated for the destinations whose topology tuples changed.
+  std::map<Ipv4Address, RoutingTableEntry> previousTable;
+  previousTable.swap (m_table);
 
   // 2. The new routing entries are added starting with the
   // symmetric neighbors (h=1) as the destination nodes.
+  const LinkSet &linkSet = m_state.GetLinks ();
+  std::map<Ipv4Address, std::vector<const LinkTuple *> > neighborLinks;
+  for (LinkSet::const_iterator it = linkSet.begin ();
+       it != linkSet.end (); it++)
+    {
+      NS_LOG_DEBUG ("Looking at link tuple: " << *it
+                                              << (it->time >= Simulator::Now () ? "" : " (expired)"));
+      if (it->time >= Simulator::Now ())
+        {
+          neighborLinks[GetMainAddress (it->neighborIfaceAddr)].push_back (&(*it));
+        }
+    }
+
   const NeighborSet &neighborSet = m_state.GetNeighbors ();
+  std::set<Ipv4Address> willingNeighbors;
   for (NeighborSet::const_iterator it = neighborSet.begin ();
        it != neighborSet.end (); it++)
     {
       NeighborTuple const &nb_tuple = *it;
       NS_LOG_DEBUG ("Looking at neighbor tuple: " << nb_tuple);
+      if (nb_tuple.willingness != OLSR_WILL_NEVER)
+        {
+          willingNeighbors.insert (nb_tuple.neighborMainAddr);
+        }
       if (nb_tuple.status == NeighborTuple::STATUS_SYM)
         {
           bool nb_main_addr = false;
           const LinkTuple *lt = NULL;
-          const LinkSet &linkSet = m_state.GetLinks ();
-          for (LinkSet::const_iterator it2 = linkSet.begin ();
-               it2 != linkSet.end (); it2++)
+          std::map<Ipv4Address, std::vector<const LinkTuple *> >::const_iterator links =
+            neighborLinks.find (nb_tuple.neighborMainAddr);
+          if (links != neighborLinks.end ())
             {
-              LinkTuple const &link_tuple = *it2;
-              NS_LOG_DEBUG ("Looking at link tuple: " << link_tuple
-                                                      << (link_tuple.time >= Simulator::Now () ? "" : " (expired)"));
-              if ((GetMainAddress (link_tuple.neighborIfaceAddr) == nb_tuple.neighborMainAddr)
-                  && link_tuple.time >= Simulator::Now ())
+              for (std::vector<const LinkTuple *>::const_iterator it2 = links->second.begin ();
+                   it2 != links->second.end (); it2++)
                 {
+                  LinkTuple const &link_tuple = **it2;
                   NS_LOG_LOGIC ("Link tuple matches neighbor " << nb_tuple.neighborMainAddr
                                                                << " => adding routing table entry to neighbor");
                   lt = &link_tuple;
@@ -994,13 +1017,6 @@ RoutingProtocol::RoutingTableComputation ()
                       nb_main_addr = true;
                     }
                 }
-              else
-                {
-                  NS_LOG_LOGIC ("Link tuple: linkMainAddress= " << GetMainAddress (link_tuple.neighborIfaceAddr)
-                                                                << "; neighborMainAddr =  " << nb_tuple.neighborMainAddr
-                                                                << "; expired=" << int (link_tuple.time < Simulator::Now ())
-                                                                << " => IGNORE");
-                }
             }
 
           // If, in the above, no R_dest_addr is equal to the main
@@ -1053,18 +1069,7 @@ RoutingProtocol::RoutingTableComputation ()
       // ...and such that there exist at least one entry in the 2-hop
       // neighbor set where N_neighbor_main_addr correspond to a
       // neighbor node with willingness different of WILL_NEVER...
-      bool nb2hopOk = false;
-      for (NeighborSet::const_iterator neighbor = neighborSet.begin ();
-           neighbor != neighborSet.end (); neighbor++)
-        {
-          if (neighbor->neighborMainAddr == nb2hop_tuple.neighborMainAddr
-              && neighbor->willingness != OLSR_WILL_NEVER)
-            {
-              nb2hopOk = true;
-              break;
-            }
-        }
-      if (!nb2hopOk)
+      if (willingNeighbors.find (nb2hop_tuple.neighborMainAddr) == willingNeighbors.end ())
         {
           NS_LOG_LOGIC ("Two-hop neighbor tuple skipped: 2-hop neighbor "
                         << nb2hop_tuple.twoHopNeighborAddr
@@ -1102,60 +1107,42 @@ RoutingProtocol::RoutingTableComputation ()
         }
     }
 
-  for (uint32_t h = 2;; h++)
+  // The one and two-hop entries are unchanged if they all are in the
+  // previous table, which held as many of them.
+  bool unchanged = (m_table.size () + m_topologyParents.size () + m_ifaceAssocEntries.size ()
+                    == previousTable.size ());
+  for (std::map<Ipv4Address, RoutingTableEntry>::const_iterator it = m_table.begin ();
+       unchanged && it != m_table.end (); it++)
     {
-      bool added = false;
+      std::map<Ipv4Address, RoutingTableEntry>::const_iterator previous = previousTable.find (it->first);
+      unchanged = previous != previousTable.end ()
+        && m_ifaceAssocEntries.find (it->first) == m_ifaceAssocEntries.end ()
+        && previous->second.nextAddr == it->second.nextAddr
+        && previous->second.interface == it->second.interface
+        && previous->second.distance == it->second.distance;
+    }
 
-      // 3.1. For each topology entry in the topology table, if its
-      // T_dest_addr does not correspond to R_dest_addr of any
-      // route entry in the routing table AND its T_last_addr
-      // corresponds to R_dest_addr of a route entry whose R_dist
-      // is equal to h, then a new route entry MUST be recorded in
-      // the routing table (if it does not already exist)
-      const TopologySet &topology = m_state.GetTopologySet ();
-      for (TopologySet::const_iterator it = topology.begin ();
-           it != topology.end (); it++)
+  if (unchanged)
+    {
+      m_table.swap (previousTable);
+      for (std::set<Ipv4Address>::const_iterator it = m_ifaceAssocEntries.begin ();
+           it != m_ifaceAssocEntries.end (); it++)
         {
-          const TopologyTuple &topology_tuple = *it;
-          NS_LOG_LOGIC ("Looking at topology tuple: " << topology_tuple);
-
-          RoutingTableEntry destAddrEntry, lastAddrEntry;
-          bool have_destAddrEntry = Lookup (topology_tuple.destAddr, destAddrEntry);
-          bool have_lastAddrEntry = Lookup (topology_tuple.lastAddr, lastAddrEntry);
-          if (!have_destAddrEntry && have_lastAddrEntry && lastAddrEntry.distance == h)
-            {
-              NS_LOG_LOGIC ("Adding routing table entry based on the topology tuple.");
-              // then a new route entry MUST be recorded in
-              //                the routing table (if it does not already exist) where:
-              //                     R_dest_addr  = T_dest_addr;
-              //                     R_next_addr  = R_next_addr of the recorded
-              //                                    route entry where:
-              //                                    R_dest_addr == T_last_addr
-              //                     R_dist       = h+1; and
-              //                     R_iface_addr = R_iface_addr of the recorded
-              //                                    route entry where:
-              //                                       R_dest_addr == T_last_addr.
-              AddEntry (topology_tuple.destAddr,
-                        lastAddrEntry.nextAddr,
-                        lastAddrEntry.interface,
-                        h + 1);
-              added = true;
-            }
-          else
-            {
-              NS_LOG_LOGIC ("NOT adding routing table entry based on the topology tuple: "
-                            "have_destAddrEntry=" << have_destAddrEntry
-                                                  << " have_lastAddrEntry=" << have_lastAddrEntry
-                                                  << " lastAddrEntry.distance=" << (int) lastAddrEntry.distance
-                                                  << " (h=" << h << ")");
-            }
+          RemoveEntry (*it);
         }
-
-      if (!added)
+      if (!m_state.GetTopologyChanges ().empty ())
         {
-          break;
+          NS_LOG_LOGIC ("Updating the routing entries of " << m_state.GetTopologyChanges ().size ()
+                                                           << " destinations with changed topology tuples.");
+          TopologyRoutingTableUpdate (m_state.GetTopologyChanges ());
         }
     }
+  else
+    {
+      TopologyRoutingTableComputation ();
+    }
+  m_state.ClearTopologyChanges ();
+  m_ifaceAssocEntries.clear ();
 
   // 4. For each entry in the multiple interface association base
   // where there exists a routing entry such that:
@@ -1182,6 +1169,7 @@ RoutingProtocol::RoutingTableComputation ()
                     entry1.nextAddr,
                     entry1.interface,
                     entry1.distance);
+          m_ifaceAssocEntries.insert (tuple.ifaceAddr);
         }
     }
 
@@ -1267,6 +1255,218 @@ RoutingProtocol::RoutingTableComputation ()
   m_routingTableChanged (GetSize ());
 }
 
+void
+RoutingProtocol::TopologyRoutingTableComputation ()
+{
+  m_topologyParents.clear ();
+
+  const TopologySet &topology = m_state.GetTopologySet ();
+  std::vector<Ipv4Address> frontier;
+  for (std::map<Ipv4Address, RoutingTableEntry>::const_iterator it = m_table.begin ();
+       it != m_table.end (); it++)
+    {
+      if (it->second.distance == 2)
+        {
+          frontier.push_back (it->first);
+        }
+    }
+
+  for (uint32_t h = 2; !frontier.empty (); h++)
+    {
+      // 3.1. For each topology entry in the topology table, if its
+      // T_dest_addr does not correspond to R_dest_addr of any
+      // route entry in the routing table AND its T_last_addr
+      // corresponds to R_dest_addr of a route entry whose R_dist
+      // is equal to h, then a new route entry MUST be recorded in
+      // the routing table (if it does not already exist)
+      //
+      // The entries whose R_dist is equal to h are the ones added at
+      // the previous iteration.  Their topology tuples are looked at in
+      // topology set order, so that the same tuple is selected when
+      // several of them lead to a destination.
+      std::vector<uint32_t> positions;
+      for (std::vector<Ipv4Address>::const_iterator it = frontier.begin ();
+           it != frontier.end (); it++)
+        {
+          const std::vector<uint32_t> &lastAddrPositions = m_state.FindTopologyTuplesByLastAddr (*it);
+          positions.insert (positions.end (), lastAddrPositions.begin (), lastAddrPositions.end ());
+        }
+      std::sort (positions.begin (), positions.end ());
+
+      std::vector<Ipv4Address> added;
+      for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+           it != positions.end (); it++)
+        {
+          const TopologyTuple &topology_tuple = topology[*it];
+          NS_LOG_LOGIC ("Looking at topology tuple: " << topology_tuple);
+          if (m_table.find (topology_tuple.destAddr) == m_table.end ())
+            {
+              NS_LOG_LOGIC ("Adding routing table entry based on the topology tuple.");
+              // then a new route entry MUST be recorded in
+              //                the routing table (if it does not already exist) where:
+              //                     R_dest_addr  = T_dest_addr;
+              //                     R_next_addr  = R_next_addr of the recorded
+              //                                    route entry where:
+              //                                    R_dest_addr == T_last_addr
+              //                     R_dist       = h+1; and
+              //                     R_iface_addr = R_iface_addr of the recorded
+              //                                    route entry where:
+              //                                       R_dest_addr == T_last_addr.
+              RoutingTableEntry lastAddrEntry;
+              Lookup (topology_tuple.lastAddr, lastAddrEntry);
+              AddEntry (topology_tuple.destAddr,
+                        lastAddrEntry.nextAddr,
+                        lastAddrEntry.interface,
+                        h + 1);
+              m_topologyParents[topology_tuple.destAddr] = topology_tuple.lastAddr;
+              added.push_back (topology_tuple.destAddr);
+            }
+        }
+      frontier.swap (added);
+    }
+}
+
+void
+RoutingProtocol::TopologyRoutingTableUpdate (const std::set<Ipv4Address> &changed)
+{
+  // Destinations to (re)compute, by distance; the candidate distances
+  // are checked again when a destination is popped.
+  typedef std::pair<uint32_t, Ipv4Address> Candidate;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate> > candidates;
+
+  // The entries of the changed destinations, and the ones reached
+  // through them, are removed.
+  std::vector<Ipv4Address> removed;
+  for (std::set<Ipv4Address>::const_iterator it = changed.begin ();
+       it != changed.end (); it++)
+    {
+      if (m_table.find (*it) == m_table.end ())
+        {
+          removed.push_back (*it);
+        }
+      else
+        {
+          RemoveTopologyEntries (*it, removed);
+        }
+    }
+
+  const TopologySet &topology = m_state.GetTopologySet ();
+  uint32_t distance;
+  Ipv4Address lastAddr;
+  while (true)
+    {
+      for (std::vector<Ipv4Address>::const_iterator it = removed.begin ();
+           it != removed.end (); it++)
+        {
+          if (FindTopologyRoute (*it, distance, lastAddr))
+            {
+              candidates.push (Candidate (distance, *it));
+            }
+        }
+      removed.clear ();
+
+      if (candidates.empty ())
+        {
+          break;
+        }
+      Candidate candidate = candidates.top ();
+      candidates.pop ();
+      const Ipv4Address &dest = candidate.second;
+      if (m_table.find (dest) != m_table.end ()
+          || !FindTopologyRoute (dest, distance, lastAddr))
+        {
+          continue;
+        }
+      if (distance > candidate.first)
+        {
+          candidates.push (Candidate (distance, dest));
+          continue;
+        }
+
+      // All the entries with a smaller distance are final, so the route
+      // is the one the full computation would select.
+      RoutingTableEntry lastAddrEntry;
+      Lookup (lastAddr, lastAddrEntry);
+      AddEntry (dest, lastAddrEntry.nextAddr, lastAddrEntry.interface, distance);
+      m_topologyParents[dest] = lastAddr;
+
+      // The destinations advertised by this one may now be reached
+      // through it, over a shorter path or an earlier topology tuple.
+      const std::vector<uint32_t> &positions = m_state.FindTopologyTuplesByLastAddr (dest);
+      for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+           it != positions.end (); it++)
+        {
+          const Ipv4Address &next = topology[*it].destAddr;
+          std::map<Ipv4Address, RoutingTableEntry>::const_iterator entry = m_table.find (next);
+          if (entry == m_table.end ())
+            {
+              candidates.push (Candidate (distance + 1, next));
+            }
+          else if (entry->second.distance > distance)
+            {
+              RemoveTopologyEntries (next, removed);
+            }
+        }
+    }
+}
+
+bool
+RoutingProtocol::FindTopologyRoute (const Ipv4Address &dest,
+                                    uint32_t &distance,
+                                    Ipv4Address &lastAddr) const
+{
+  const TopologySet &topology = m_state.GetTopologySet ();
+  const std::vector<uint32_t> &positions = m_state.FindTopologyTuplesByDestAddr (dest);
+  bool found = false;
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
+    {
+      std::map<Ipv4Address, RoutingTableEntry>::const_iterator entry =
+        m_table.find (topology[*it].lastAddr);
+      if (entry != m_table.end () && entry->second.distance >= 2
+          && (!found || entry->second.distance + 1 < distance))
+        {
+          found = true;
+          distance = entry->second.distance + 1;
+          lastAddr = entry->first;
+        }
+    }
+  return found;
+}
+
+void
+RoutingProtocol::RemoveTopologyEntries (const Ipv4Address &dest,
+                                        std::vector<Ipv4Address> &removed)
+{
+  const TopologySet &topology = m_state.GetTopologySet ();
+  std::vector<Ipv4Address> pending (1, dest);
+  while (!pending.empty ())
+    {
+      Ipv4Address addr = pending.back ();
+      pending.pop_back ();
+      std::map<Ipv4Address, Ipv4Address>::iterator parent = m_topologyParents.find (addr);
+      if (parent == m_topologyParents.end ())
+        {
+          continue;
+        }
+      m_topologyParents.erase (parent);
+      RemoveEntry (addr);
+      removed.push_back (addr);
+
+      const std::vector<uint32_t> &positions = m_state.FindTopologyTuplesByLastAddr (addr);
+      for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+           it != positions.end (); it++)
+        {
+          const Ipv4Address &child = topology[*it].destAddr;
+          parent = m_topologyParents.find (child);
+          if (parent != m_topologyParents.end () && parent->second == addr)
+            {
+              pending.push_back (child);
+            }
+        }
+    }
+}
+
 
 void
 RoutingProtocol::ProcessHello (const olsr::MessageHeader &msg,
@@ -1466,13 +1666,13 @@ RoutingProtocol::ProcessMid (const olsr::MessageHeader &msg,
   // 3. (not part of the RFC) iterate over all NeighborTuple's and
   // TwoHopNeighborTuples, update the neighbor addresses taking into account
   // the new MID information.
-  NeighborSet &neighbors = m_state.GetNeighbors ();
+  NeighborSet &neighbors = m_state.GetNeighborsMutable ();
   for (NeighborSet::iterator neighbor = neighbors.begin (); neighbor != neighbors.end (); neighbor++)
     {
       neighbor->neighborMainAddr = GetMainAddress (neighbor->neighborMainAddr);
     }
 
-  TwoHopNeighborSet &twoHopNeighbors = m_state.GetTwoHopNeighbors ();
+  TwoHopNeighborSet &twoHopNeighbors = m_state.GetTwoHopNeighborsMutable ();
   for (TwoHopNeighborSet::iterator twoHopNeighbor = twoHopNeighbors.begin ();
        twoHopNeighbor != twoHopNeighbors.end (); twoHopNeighbor++)
     {
@@ -1591,6 +1791,8 @@ RoutingProtocol::ForwardDefault (olsr::MessageHeader olsrMessage,
       duplicated->expirationTime = now + OLSR_DUP_HOLD_TIME;
       duplicated->retransmitted = retransmitted;
       duplicated->ifaceList.push_back (localIface);
+      // The Duplicate Set drops the tuple at its new expiration time
+      m_state.InsertDuplicateTuple (*duplicated);
     }
   // ...or create a new one
   else
@@ -1602,10 +1804,6 @@ RoutingProtocol::ForwardDefault (olsr::MessageHeader olsrMessage,
       newDup.retransmitted = retransmitted;
       newDup.ifaceList.push_back (localIface);
       AddDuplicateTuple (newDup);
-      // Schedule dup tuple deletion
-      Simulator::Schedule (OLSR_DUP_HOLD_TIME,
-                           &RoutingProtocol::DupTupleTimerExpire, this,
-                           newDup.address, newDup.sequenceNumber);
     }
 }
 
@@ -2654,27 +2852,6 @@ RoutingProtocol::HnaTimerExpire ()
   m_hnaTimer.Schedule (m_hnaInterval);
 }
 
-void
-RoutingProtocol::DupTupleTimerExpire (Ipv4Address address, uint16_t sequenceNumber)
-{
-  DuplicateTuple *tuple =
-    m_state.FindDuplicateTuple (address, sequenceNumber);
-  if (tuple == NULL)
-    {
-      return;
-    }
-  if (tuple->expirationTime < Simulator::Now ())
-    {
-      RemoveDuplicateTuple (*tuple);
-    }
-  else
-    {
-      m_events.Track (Simulator::Schedule (DELAY (tuple->expirationTime),
-                                           &RoutingProtocol::DupTupleTimerExpire, this,
-                                           address, sequenceNumber));
-    }
-}
-
 void
 RoutingProtocol::LinkTupleTimerExpire (Ipv4Address neighborIfaceAddr)
 {
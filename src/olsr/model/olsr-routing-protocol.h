@@ -45,6 +45,7 @@
 
 /// Testcase for MPR computation mechanism
 class OlsrMprTestCase;
+class OlsrRoutingTableTestCase;
 
 namespace ns3 {
 namespace olsr {
@@ -84,6 +85,10 @@ public:
    * Declared friend to enable unit tests.
    */
   friend class ::OlsrMprTestCase;
+  /**
+   * Declared friend to enable unit tests.
+   */
+  friend class ::OlsrRoutingTableTestCase;
 
   /**
    * \brief Get the type ID.
@@ -201,6 +206,8 @@ protected:
   virtual void DoInitialize (void);
 private:
   std::map<Ipv4Address, RoutingTableEntry> m_table; //!< Data structure for the routing table.
+  std::map<Ipv4Address, Ipv4Address> m_topologyParents; //!< T_last_addr used for each routing entry derived from the topology set, by destination.
+  std::set<Ipv4Address> m_ifaceAssocEntries; //!< Destinations of the routing entries derived from the interface association set.
 
   Ptr<Ipv4StaticRouting> m_hnaRoutingTable; //!< Routing table for HNA routes
 
@@ -350,9 +357,51 @@ private:
 
   /**
    * \brief Creates the routing table of the node following \RFC{3626} hints.
+   *
+   * The entries derived from the topology set are only updated for the
+   * destinations whose topology tuples changed, unless the entries to the
+   * one and two-hop neighbors changed too.
    */
   void RoutingTableComputation ();
 
+  /**
+   * \brief Adds the routing entries derived from the topology set
+   * (\RFC{3626}, section 10, step 3) to a table holding the one and
+   * two-hop entries.
+   */
+  void TopologyRoutingTableComputation ();
+
+  /**
+   * \brief Updates the routing entries derived from the topology set after
+   * topology tuples were inserted or erased.
+   *
+   * The result is the same as with TopologyRoutingTableComputation ().
+   *
+   * \param changed The destinations of the inserted and erased tuples.
+   */
+  void TopologyRoutingTableUpdate (const std::set<Ipv4Address> &changed);
+
+  /**
+   * \brief Finds the topology tuple to use for a route to a destination,
+   * given the current routing table.
+   * \param [in] dest The destination address.
+   * \param [out] distance The distance of the route.
+   * \param [out] lastAddr The T_last_addr of the tuple.
+   * \return true if a route is found, false if not.
+   */
+  bool FindTopologyRoute (const Ipv4Address &dest,
+                          uint32_t &distance,
+                          Ipv4Address &lastAddr) const;
+
+  /**
+   * \brief Removes the routing entry derived from the topology set for a
+   * destination, and the ones of the destinations reached through it.
+   * \param [in] dest The destination address.
+   * \param [out] removed The destinations of the removed entries are appended to it.
+   */
+  void RemoveTopologyEntries (const Ipv4Address &dest,
+                              std::vector<Ipv4Address> &removed);
+
   /**
    * \brief Gets the main address associated with a given interface address.
    * \param iface_addr the interface address.
@@ -392,16 +441,6 @@ private:
    */
   void HnaTimerExpire ();
 
-  /**
-   * \brief Removes tuple if expired. Else timer is rescheduled to expire at tuple.expirationTime.
-   *
-   * The task of actually removing the tuple is left to the OLSR agent.
-   *
-   * \param address The address of the tuple.
-   * \param sequenceNumber The sequence number of the tuple.
-   */
-  void DupTupleTimerExpire (Ipv4Address address, uint16_t sequenceNumber);
-
   bool m_linkTupleTimerFirstTime; //!< Flag to indicate if it is the first time the LinkTupleTimer fires.
   /**
    * \brief Removes tuple_ if expired. Else if symmetric time
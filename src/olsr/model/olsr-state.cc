@@ -32,31 +32,34 @@
 namespace ns3 {
 namespace olsr {
 
+const std::vector<uint32_t> OlsrAddressIndex::m_none;
+
 /********** MPR Selector Set Manipulation **********/
 
 MprSelectorTuple*
 OlsrState::FindMprSelectorTuple (Ipv4Address const &mainAddr)
 {
-  for (MprSelectorSet::iterator it = m_mprSelectorSet.begin ();
-       it != m_mprSelectorSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_mprSelectorIndex.Find (m_mprSelectorSet, &MprSelectorTuple::mainAddr, mainAddr);
+  if (positions.empty ())
     {
-      if (it->mainAddr == mainAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_mprSelectorSet[positions.front ()];
 }
 
 void
 OlsrState::EraseMprSelectorTuple (const MprSelectorTuple &tuple)
 {
-  for (MprSelectorSet::iterator it = m_mprSelectorSet.begin ();
-       it != m_mprSelectorSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_mprSelectorIndex.Find (m_mprSelectorSet, &MprSelectorTuple::mainAddr, tuple.mainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_mprSelectorSet[*it] == tuple)
         {
-          m_mprSelectorSet.erase (it);
+          m_mprSelectorSet.erase (m_mprSelectorSet.begin () + *it);
+          m_mprSelectorIndex.Invalidate ();
           break;
         }
     }
@@ -65,6 +68,10 @@ OlsrState::EraseMprSelectorTuple (const MprSelectorTuple &tuple)
 void
 OlsrState::EraseMprSelectorTuples (const Ipv4Address &mainAddr)
 {
+  if (m_mprSelectorIndex.Find (m_mprSelectorSet, &MprSelectorTuple::mainAddr, mainAddr).empty ())
+    {
+      return;
+    }
   for (MprSelectorSet::iterator it = m_mprSelectorSet.begin ();
        it != m_mprSelectorSet.end (); )
     {
@@ -77,12 +84,14 @@ OlsrState::EraseMprSelectorTuples (const Ipv4Address &mainAddr)
           it++;
         }
     }
+  m_mprSelectorIndex.Invalidate ();
 }
 
 void
 OlsrState::InsertMprSelectorTuple (MprSelectorTuple const &tuple)
 {
   m_mprSelectorSet.push_back (tuple);
+  m_mprSelectorIndex.Append (m_mprSelectorSet.back ().mainAddr, m_mprSelectorSet.size () - 1);
 }
 
 std::string
@@ -111,26 +120,26 @@ OlsrState::PrintMprSelectorSet () const
 NeighborTuple*
 OlsrState::FindNeighborTuple (Ipv4Address const &mainAddr)
 {
-  for (NeighborSet::iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, mainAddr);
+  if (positions.empty ())
     {
-      if (it->neighborMainAddr == mainAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_neighborSet[positions.front ()];
 }
 
 const NeighborTuple*
 OlsrState::FindSymNeighborTuple (Ipv4Address const &mainAddr) const
 {
-  for (NeighborSet::const_iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, mainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->neighborMainAddr == mainAddr && it->status == NeighborTuple::STATUS_SYM)
+      if (m_neighborSet[*it].status == NeighborTuple::STATUS_SYM)
         {
-          return &(*it);
+          return &m_neighborSet[*it];
         }
     }
   return NULL;
@@ -139,12 +148,14 @@ OlsrState::FindSymNeighborTuple (Ipv4Address const &mainAddr) const
 NeighborTuple*
 OlsrState::FindNeighborTuple (Ipv4Address const &mainAddr, uint8_t willingness)
 {
-  for (NeighborSet::iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, mainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->neighborMainAddr == mainAddr && it->willingness == willingness)
+      if (m_neighborSet[*it].willingness == willingness)
         {
-          return &(*it);
+          return &m_neighborSet[*it];
         }
     }
   return NULL;
@@ -153,12 +164,15 @@ OlsrState::FindNeighborTuple (Ipv4Address const &mainAddr, uint8_t willingness)
 void
 OlsrState::EraseNeighborTuple (const NeighborTuple &tuple)
 {
-  for (NeighborSet::iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, tuple.neighborMainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_neighborSet[*it] == tuple)
         {
-          m_neighborSet.erase (it);
+          m_neighborSet.erase (m_neighborSet.begin () + *it);
+          m_neighborIndex.Invalidate ();
           break;
         }
     }
@@ -167,31 +181,28 @@ OlsrState::EraseNeighborTuple (const NeighborTuple &tuple)
 void
 OlsrState::EraseNeighborTuple (const Ipv4Address &mainAddr)
 {
-  for (NeighborSet::iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, mainAddr);
+  if (!positions.empty ())
     {
-      if (it->neighborMainAddr == mainAddr)
-        {
-          it = m_neighborSet.erase (it);
-          break;
-        }
+      m_neighborSet.erase (m_neighborSet.begin () + positions.front ());
+      m_neighborIndex.Invalidate ();
     }
 }
 
 void
 OlsrState::InsertNeighborTuple (NeighborTuple const &tuple)
 {
-  for (NeighborSet::iterator it = m_neighborSet.begin ();
-       it != m_neighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_neighborIndex.Find (m_neighborSet, &NeighborTuple::neighborMainAddr, tuple.neighborMainAddr);
+  if (!positions.empty ())
     {
-      if (it->neighborMainAddr == tuple.neighborMainAddr)
-        {
-          // Update it
-          *it = tuple;
-          return;
-        }
+      // Update it
+      m_neighborSet[positions.front ()] = tuple;
+      return;
     }
   m_neighborSet.push_back (tuple);
+  m_neighborIndex.Append (m_neighborSet.back ().neighborMainAddr, m_neighborSet.size () - 1);
 }
 
 /********** Neighbor 2 Hop Set Manipulation **********/
@@ -200,13 +211,14 @@ TwoHopNeighborTuple*
 OlsrState::FindTwoHopNeighborTuple (Ipv4Address const &neighborMainAddr,
                                     Ipv4Address const &twoHopNeighborAddr)
 {
-  for (TwoHopNeighborSet::iterator it = m_twoHopNeighborSet.begin ();
-       it != m_twoHopNeighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_twoHopNeighborIndex.Find (m_twoHopNeighborSet, &TwoHopNeighborTuple::neighborMainAddr, neighborMainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->neighborMainAddr == neighborMainAddr
-          && it->twoHopNeighborAddr == twoHopNeighborAddr)
+      if (m_twoHopNeighborSet[*it].twoHopNeighborAddr == twoHopNeighborAddr)
         {
-          return &(*it);
+          return &m_twoHopNeighborSet[*it];
         }
     }
   return NULL;
@@ -215,12 +227,15 @@ OlsrState::FindTwoHopNeighborTuple (Ipv4Address const &neighborMainAddr,
 void
 OlsrState::EraseTwoHopNeighborTuple (const TwoHopNeighborTuple &tuple)
 {
-  for (TwoHopNeighborSet::iterator it = m_twoHopNeighborSet.begin ();
-       it != m_twoHopNeighborSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_twoHopNeighborIndex.Find (m_twoHopNeighborSet, &TwoHopNeighborTuple::neighborMainAddr, tuple.neighborMainAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_twoHopNeighborSet[*it] == tuple)
         {
-          m_twoHopNeighborSet.erase (it);
+          m_twoHopNeighborSet.erase (m_twoHopNeighborSet.begin () + *it);
+          m_twoHopNeighborIndex.Invalidate ();
           break;
         }
     }
@@ -230,6 +245,10 @@ void
 OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr,
                                       const Ipv4Address &twoHopNeighborAddr)
 {
+  if (FindTwoHopNeighborTuple (neighborMainAddr, twoHopNeighborAddr) == NULL)
+    {
+      return;
+    }
   for (TwoHopNeighborSet::iterator it = m_twoHopNeighborSet.begin ();
        it != m_twoHopNeighborSet.end (); )
     {
@@ -243,11 +262,16 @@ OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr,
           it++;
         }
     }
+  m_twoHopNeighborIndex.Invalidate ();
 }
 
 void
 OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr)
 {
+  if (m_twoHopNeighborIndex.Find (m_twoHopNeighborSet, &TwoHopNeighborTuple::neighborMainAddr, neighborMainAddr).empty ())
+    {
+      return;
+    }
   for (TwoHopNeighborSet::iterator it = m_twoHopNeighborSet.begin ();
        it != m_twoHopNeighborSet.end (); )
     {
@@ -260,12 +284,14 @@ OlsrState::EraseTwoHopNeighborTuples (const Ipv4Address &neighborMainAddr)
           it++;
         }
     }
+  m_twoHopNeighborIndex.Invalidate ();
 }
 
 void
 OlsrState::InsertTwoHopNeighborTuple (TwoHopNeighborTuple const &tuple)
 {
   m_twoHopNeighborSet.push_back (tuple);
+  m_twoHopNeighborIndex.Append (m_twoHopNeighborSet.back ().neighborMainAddr, m_twoHopNeighborSet.size () - 1);
 }
 
 /********** MPR Set Manipulation **********/
@@ -293,35 +319,19 @@ OlsrState::GetMprSet () const
 DuplicateTuple*
 OlsrState::FindDuplicateTuple (Ipv4Address const &addr, uint16_t sequenceNumber)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
-    {
-      if (it->address == addr && it->sequenceNumber == sequenceNumber)
-        {
-          return &(*it);
-        }
-    }
-  return NULL;
+  return m_duplicateSet.Find (addr, sequenceNumber);
 }
 
 void
 OlsrState::EraseDuplicateTuple (const DuplicateTuple &tuple)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
-    {
-      if (*it == tuple)
-        {
-          m_duplicateSet.erase (it);
-          break;
-        }
-    }
+  m_duplicateSet.Erase (tuple.address, tuple.sequenceNumber);
 }
 
 void
 OlsrState::InsertDuplicateTuple (DuplicateTuple const &tuple)
 {
-  m_duplicateSet.push_back (tuple);
+  m_duplicateSet.Insert (tuple.address, tuple.sequenceNumber, tuple, tuple.expirationTime);
 }
 
 /********** Link Set Manipulation **********/
@@ -329,34 +339,22 @@ OlsrState::InsertDuplicateTuple (DuplicateTuple const &tuple)
 LinkTuple*
 OlsrState::FindLinkTuple (Ipv4Address const & ifaceAddr)
 {
-  for (LinkSet::iterator it = m_linkSet.begin ();
-       it != m_linkSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_linkIndex.Find (m_linkSet, &LinkTuple::neighborIfaceAddr, ifaceAddr);
+  if (positions.empty ())
     {
-      if (it->neighborIfaceAddr == ifaceAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_linkSet[positions.front ()];
 }
 
 LinkTuple*
 OlsrState::FindSymLinkTuple (Ipv4Address const &ifaceAddr, Time now)
 {
-  for (LinkSet::iterator it = m_linkSet.begin ();
-       it != m_linkSet.end (); it++)
+  LinkTuple *tuple = FindLinkTuple (ifaceAddr);
+  if (tuple != NULL && tuple->symTime > now)
     {
-      if (it->neighborIfaceAddr == ifaceAddr)
-        {
-          if (it->symTime > now)
-            {
-              return &(*it);
-            }
-          else
-            {
-              break;
-            }
-        }
+      return tuple;
     }
   return NULL;
 }
@@ -364,12 +362,15 @@ OlsrState::FindSymLinkTuple (Ipv4Address const &ifaceAddr, Time now)
 void
 OlsrState::EraseLinkTuple (const LinkTuple &tuple)
 {
-  for (LinkSet::iterator it = m_linkSet.begin ();
-       it != m_linkSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_linkIndex.Find (m_linkSet, &LinkTuple::neighborIfaceAddr, tuple.neighborIfaceAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_linkSet[*it] == tuple)
         {
-          m_linkSet.erase (it);
+          m_linkSet.erase (m_linkSet.begin () + *it);
+          m_linkIndex.Invalidate ();
           break;
         }
     }
@@ -379,6 +380,7 @@ LinkTuple&
 OlsrState::InsertLinkTuple (LinkTuple const &tuple)
 {
   m_linkSet.push_back (tuple);
+  m_linkIndex.Append (m_linkSet.back ().neighborIfaceAddr, m_linkSet.size () - 1);
   return m_linkSet.back ();
 }
 
@@ -388,12 +390,13 @@ TopologyTuple*
 OlsrState::FindTopologyTuple (Ipv4Address const &destAddr,
                               Ipv4Address const &lastAddr)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  const std::vector<uint32_t> &positions = FindTopologyTuplesByLastAddr (lastAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->destAddr == destAddr && it->lastAddr == lastAddr)
+      if (m_topologySet[*it].destAddr == destAddr)
         {
-          return &(*it);
+          return &m_topologySet[*it];
         }
     }
   return NULL;
@@ -402,12 +405,13 @@ OlsrState::FindTopologyTuple (Ipv4Address const &destAddr,
 TopologyTuple*
 OlsrState::FindNewerTopologyTuple (Ipv4Address const & lastAddr, uint16_t ansn)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  const std::vector<uint32_t> &positions = FindTopologyTuplesByLastAddr (lastAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (it->lastAddr == lastAddr && it->sequenceNumber > ansn)
+      if (m_topologySet[*it].sequenceNumber > ansn)
         {
-          return &(*it);
+          return &m_topologySet[*it];
         }
     }
   return NULL;
@@ -416,12 +420,16 @@ OlsrState::FindNewerTopologyTuple (Ipv4Address const & lastAddr, uint16_t ansn)
 void
 OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  const std::vector<uint32_t> &positions = FindTopologyTuplesByLastAddr (tuple.lastAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_topologySet[*it] == tuple)
         {
-          m_topologySet.erase (it);
+          m_topologyChanges.insert (tuple.destAddr);
+          m_topologySet.erase (m_topologySet.begin () + *it);
+          m_topologyLastIndex.Invalidate ();
+          m_topologyDestIndex.Invalidate ();
           break;
         }
     }
@@ -430,11 +438,23 @@ OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
 void
 OlsrState::EraseOlderTopologyTuples (const Ipv4Address &lastAddr, uint16_t ansn)
 {
+  const std::vector<uint32_t> &positions = FindTopologyTuplesByLastAddr (lastAddr);
+  bool found = false;
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end () && !found; it++)
+    {
+      found = m_topologySet[*it].sequenceNumber < ansn;
+    }
+  if (!found)
+    {
+      return;
+    }
   for (TopologySet::iterator it = m_topologySet.begin ();
        it != m_topologySet.end (); )
     {
       if (it->lastAddr == lastAddr && it->sequenceNumber < ansn)
         {
+          m_topologyChanges.insert (it->destAddr);
           it = m_topologySet.erase (it);
         }
       else
@@ -442,12 +462,30 @@ OlsrState::EraseOlderTopologyTuples (const Ipv4Address &lastAddr, uint16_t ansn)
           it++;
         }
     }
+  m_topologyLastIndex.Invalidate ();
+  m_topologyDestIndex.Invalidate ();
 }
 
 void
 OlsrState::InsertTopologyTuple (TopologyTuple const &tuple)
 {
   m_topologySet.push_back (tuple);
+  const TopologyTuple &inserted = m_topologySet.back ();
+  m_topologyLastIndex.Append (inserted.lastAddr, m_topologySet.size () - 1);
+  m_topologyDestIndex.Append (inserted.destAddr, m_topologySet.size () - 1);
+  m_topologyChanges.insert (inserted.destAddr);
+}
+
+const std::vector<uint32_t> &
+OlsrState::FindTopologyTuplesByLastAddr (const Ipv4Address &lastAddr) const
+{
+  return m_topologyLastIndex.Find (m_topologySet, &TopologyTuple::lastAddr, lastAddr);
+}
+
+const std::vector<uint32_t> &
+OlsrState::FindTopologyTuplesByDestAddr (const Ipv4Address &destAddr) const
+{
+  return m_topologyDestIndex.Find (m_topologySet, &TopologyTuple::destAddr, destAddr);
 }
 
 /********** Interface Association Set Manipulation **********/
@@ -455,40 +493,39 @@ OlsrState::InsertTopologyTuple (TopologyTuple const &tuple)
 IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple (Ipv4Address const &ifaceAddr)
 {
-  for (IfaceAssocSet::iterator it = m_ifaceAssocSet.begin ();
-       it != m_ifaceAssocSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_ifaceAssocIndex.Find (m_ifaceAssocSet, &IfaceAssocTuple::ifaceAddr, ifaceAddr);
+  if (positions.empty ())
     {
-      if (it->ifaceAddr == ifaceAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_ifaceAssocSet[positions.front ()];
 }
 
 const IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple (Ipv4Address const &ifaceAddr) const
 {
-  for (IfaceAssocSet::const_iterator it = m_ifaceAssocSet.begin ();
-       it != m_ifaceAssocSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_ifaceAssocIndex.Find (m_ifaceAssocSet, &IfaceAssocTuple::ifaceAddr, ifaceAddr);
+  if (positions.empty ())
     {
-      if (it->ifaceAddr == ifaceAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_ifaceAssocSet[positions.front ()];
 }
 
 void
 OlsrState::EraseIfaceAssocTuple (const IfaceAssocTuple &tuple)
 {
-  for (IfaceAssocSet::iterator it = m_ifaceAssocSet.begin ();
-       it != m_ifaceAssocSet.end (); it++)
+  const std::vector<uint32_t> &positions =
+    m_ifaceAssocIndex.Find (m_ifaceAssocSet, &IfaceAssocTuple::ifaceAddr, tuple.ifaceAddr);
+  for (std::vector<uint32_t>::const_iterator it = positions.begin ();
+       it != positions.end (); it++)
     {
-      if (*it == tuple)
+      if (m_ifaceAssocSet[*it] == tuple)
         {
-          m_ifaceAssocSet.erase (it);
+          m_ifaceAssocSet.erase (m_ifaceAssocSet.begin () + *it);
+          m_ifaceAssocIndex.Invalidate ();
           break;
         }
     }
@@ -498,6 +535,7 @@ void
 OlsrState::InsertIfaceAssocTuple (const IfaceAssocTuple &tuple)
 {
   m_ifaceAssocSet.push_back (tuple);
+  m_ifaceAssocIndex.Append (m_ifaceAssocSet.back ().ifaceAddr, m_ifaceAssocSet.size () - 1);
 }
 
 std::vector<Ipv4Address>
@@ -25,10 +25,84 @@
 #define OLSR_STATE_H
 
 #include "olsr-repositories.h"
+#include "ns3/duplicate-cache.h"
+#include <unordered_map>
 
 namespace ns3 {
 namespace olsr {
 
+/// \ingroup olsr
+/// Index of the tuples of a set by one of their address fields.
+///
+/// The index follows the tuples appended at the end of the set.  Any other
+/// change to the set must invalidate it, and it is then rebuilt on the next
+/// lookup.
+class OlsrAddressIndex
+{
+public:
+  OlsrAddressIndex ()
+    : m_valid (false)
+  {
+  }
+
+  /**
+   * Finds the tuples of a set with a given address.
+   * \param set The indexed set.
+   * \param field The indexed address field of the tuples.
+   * \param addr The address to look for.
+   * \returns The positions of the matching tuples in the set, in set order.
+   */
+  template <typename Set>
+  const std::vector<uint32_t> & Find (const Set &set,
+                                      Ipv4Address Set::value_type::*field,
+                                      const Ipv4Address &addr)
+  {
+    if (!m_valid)
+      {
+        m_positions.clear ();
+        for (uint32_t i = 0; i < set.size (); i++)
+          {
+            m_positions[set[i].*field].push_back (i);
+          }
+        m_valid = true;
+      }
+    PositionMap::const_iterator it = m_positions.find (addr);
+    if (it == m_positions.end ())
+      {
+        return m_none;
+      }
+    return it->second;
+  }
+
+  /**
+   * Records a tuple appended at the end of the set.
+   * \param addr The indexed address of the tuple.
+   * \param position The position of the tuple in the set.
+   */
+  void Append (const Ipv4Address &addr, uint32_t position)
+  {
+    if (m_valid)
+      {
+        m_positions[addr].push_back (position);
+      }
+  }
+
+  /**
+   * Invalidates the index after a change other than an append.
+   */
+  void Invalidate ()
+  {
+    m_valid = false;
+  }
+
+private:
+  /// Container of the tuple positions, by address.
+  typedef std::unordered_map<Ipv4Address, std::vector<uint32_t>, Ipv4AddressHash> PositionMap;
+  PositionMap m_positions;      //!< Tuple positions, by address.
+  bool m_valid;                 //!< Whether m_positions matches the set.
+  static const std::vector<uint32_t> m_none; //!< Result of a lookup without match.
+};
+
 /// \ingroup olsr
 /// This class encapsulates all data structures needed for maintaining internal state of an OLSR node.
 class OlsrState
@@ -42,11 +116,20 @@ protected:
   TopologySet m_topologySet;    //!< Topology Set (\RFC{3626}, section 4.4).
   MprSet m_mprSet;      //!< MPR Set (\RFC{3626}, section 4.3.3).
   MprSelectorSet m_mprSelectorSet;      //!< MPR Selector Set (\RFC{3626}, section 4.3.4).
-  DuplicateSet m_duplicateSet;  //!< Duplicate Set (\RFC{3626}, section 3.4).
+  DuplicateCache<DuplicateTuple> m_duplicateSet;  //!< Duplicate Set (\RFC{3626}, section 3.4), by (D_addr, D_seq_num).
   IfaceAssocSet m_ifaceAssocSet;        //!< Interface Association Set (\RFC{3626}, section 4.1).
   AssociationSet m_associationSet; //!<	Association Set (\RFC{3626}, section12.2). Associations obtained from HNA messages generated by other nodes.
   Associations m_associations;  //!< The node's local Host Network Associations that will be advertised using HNA messages.
 
+  mutable OlsrAddressIndex m_linkIndex;         //!< Link Set, by L_neighbor_iface_addr.
+  mutable OlsrAddressIndex m_neighborIndex;     //!< Neighbor Set, by N_neighbor_main_addr.
+  mutable OlsrAddressIndex m_twoHopNeighborIndex; //!< 2-hop Neighbor Set, by N_neighbor_main_addr.
+  mutable OlsrAddressIndex m_topologyLastIndex; //!< Topology Set, by T_last_addr.
+  mutable OlsrAddressIndex m_topologyDestIndex; //!< Topology Set, by T_dest_addr.
+  mutable OlsrAddressIndex m_mprSelectorIndex;  //!< MPR Selector Set, by MS_main_addr.
+  mutable OlsrAddressIndex m_ifaceAssocIndex;   //!< Interface Association Set, by I_iface_addr.
+  std::set<Ipv4Address> m_topologyChanges;      //!< Destinations of the topology tuples inserted or erased since the last ClearTopologyChanges ().
+
 public:
   OlsrState ()
   {
@@ -105,11 +188,15 @@ public:
     return m_neighborSet;
   }
   /**
-   * Gets the neighbor set.
+   * Gets a mutable reference to the neighbor set.
+   *
+   * The neighbor set index is rebuilt on the next lookup.
+   *
    * \returns The neighbor set.
    */
-  NeighborSet & GetNeighbors ()
+  NeighborSet & GetNeighborsMutable ()
   {
+    m_neighborIndex.Invalidate ();
     return m_neighborSet;
   }
 
@@ -164,11 +251,15 @@ public:
     return m_twoHopNeighborSet;
   }
   /**
-   * Gets the 2-hop neighbor set.
+   * Gets a mutable reference to the 2-hop neighbor set.
+   *
+   * The 2-hop neighbor set index is rebuilt on the next lookup.
+   *
    * \returns The 2-hop neighbor set.
    */
-  TwoHopNeighborSet & GetTwoHopNeighbors ()
+  TwoHopNeighborSet & GetTwoHopNeighborsMutable ()
   {
+    m_twoHopNeighborIndex.Invalidate ();
     return m_twoHopNeighborSet;
   }
 
@@ -231,7 +322,8 @@ public:
    * Finds a duplicate tuple.
    * \param address The duplicate tuple address.
    * \param sequenceNumber The duplicate tuple sequence number.
-   * \returns The duplicate tuple, or a null pointer if no match.
+   * \returns The duplicate tuple, or a null pointer if no match or if the
+   * tuple has expired.
    */
   DuplicateTuple* FindDuplicateTuple (const Ipv4Address &address,
                                       uint16_t sequenceNumber);
@@ -242,7 +334,8 @@ public:
    */
   void EraseDuplicateTuple (const DuplicateTuple &tuple);
   /**
-   * Inserts a duplicate tuple.
+   * Inserts a duplicate tuple, or replaces the tuple with the same address
+   * and sequence number.  The tuple is dropped after its expiration time.
    * \param tuple The tuple to insert.
    */
   void InsertDuplicateTuple (const DuplicateTuple &tuple);
@@ -325,6 +418,34 @@ public:
    * \param tuple The tuple to insert.
    */
   void InsertTopologyTuple (const TopologyTuple &tuple);
+  /**
+   * Finds the topology tuples with a given last address.
+   * \param lastAddr The address of the node previous to the destination.
+   * \returns The positions of the tuples in the topology set, in set order.
+   */
+  const std::vector<uint32_t> & FindTopologyTuplesByLastAddr (const Ipv4Address &lastAddr) const;
+  /**
+   * Finds the topology tuples with a given destination address.
+   * \param destAddr The destination address.
+   * \returns The positions of the tuples in the topology set, in set order.
+   */
+  const std::vector<uint32_t> & FindTopologyTuplesByDestAddr (const Ipv4Address &destAddr) const;
+  /**
+   * Gets the destinations of the topology tuples inserted or erased
+   * since the last call to ClearTopologyChanges ().
+   * \returns The destination addresses.
+   */
+  const std::set<Ipv4Address> & GetTopologyChanges () const
+  {
+    return m_topologyChanges;
+  }
+  /**
+   * Forgets the recorded topology set changes.
+   */
+  void ClearTopologyChanges ()
+  {
+    m_topologyChanges.clear ();
+  }
 
   // Interface association
 
@@ -338,10 +459,14 @@ public:
   }
   /**
    * Gets a mutable reference to the interface association set.
+   *
+   * The interface association set index is rebuilt on the next lookup.
+   *
    * \returns The interface association set.
    */
   IfaceAssocSet & GetIfaceAssocSetMutable ()
   {
+    m_ifaceAssocIndex.Invalidate ();
     return m_ifaceAssocSet;
   }
 
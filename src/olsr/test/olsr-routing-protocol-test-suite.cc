@@ -23,6 +23,13 @@
 #include "ns3/test.h"
 #include "ns3/olsr-routing-protocol.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include <sstream>
 
 /**
  * \ingroup olsr
@@ -178,6 +185,175 @@ OlsrMprTestCase::DoRun ()
   NS_TEST_EXPECT_MSG_EQ ((mpr.find ("10.0.0.9") == mpr.end ()), true, "Node 1 must NOT select node 8 as MPR");
 }
 
+/**
+ * \ingroup olsr-test
+ * \ingroup tests
+ *
+ * Testcase for the incremental update of the routing table: after random
+ * changes to the topology set, the routing table must be the same as the
+ * one computed from scratch.
+ */
+class OlsrRoutingTableTestCase : public TestCase
+{
+public:
+  OlsrRoutingTableTestCase ();
+  ~OlsrRoutingTableTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Prints the routing table of a protocol instance.
+   * \param protocol The protocol instance.
+   * \returns The routing table entries.
+   */
+  static std::string GetRoutes (Ptr<RoutingProtocol> protocol);
+};
+
+
+OlsrRoutingTableTestCase::OlsrRoutingTableTestCase ()
+  : TestCase ("Check OLSR incremental routing table computation")
+{
+}
+OlsrRoutingTableTestCase::~OlsrRoutingTableTestCase ()
+{
+}
+
+std::string
+OlsrRoutingTableTestCase::GetRoutes (Ptr<RoutingProtocol> protocol)
+{
+  std::ostringstream os;
+  std::vector<RoutingTableEntry> entries = protocol->GetRoutingTableEntries ();
+  for (std::vector<RoutingTableEntry>::const_iterator it = entries.begin ();
+       it != entries.end (); it++)
+    {
+      os << it->destAddr << " " << it->nextAddr << " " << it->interface
+         << " " << it->distance << std::endl;
+    }
+  return os.str ();
+}
+
+void
+OlsrRoutingTableTestCase::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+  SimpleNetDeviceHelper simple;
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.0.0.0", "255.255.0.0");
+  ipv4.Assign (simple.Install (node));
+  Ptr<Ipv4> nodeIpv4 = node->GetObject<Ipv4> ();
+
+  Ptr<RoutingProtocol> protocol = CreateObject<RoutingProtocol> ();
+  protocol->m_mainAddress = Ipv4Address ("10.0.0.1");
+  protocol->SetIpv4 (nodeIpv4);
+  OlsrState &state = protocol->m_state;
+
+  /*
+   * Node 10.0.0.1 has four symmetric neighbors, 10.0.0.2 to 10.0.0.5, and
+   * three 2-hop neighbors.  The topology tuples are drawn among these
+   * addresses and 30 other ones, 10.0.1.1 to 10.0.1.30.
+   */
+  std::vector<Ipv4Address> addresses;
+  for (uint32_t i = 2; i <= 5; i++)
+    {
+      std::ostringstream addr;
+      addr << "10.0.0." << i;
+      addresses.push_back (Ipv4Address (addr.str ().c_str ()));
+
+      LinkTuple link;
+      link.localIfaceAddr = Ipv4Address ("10.0.0.1");
+      link.neighborIfaceAddr = addresses.back ();
+      link.symTime = Seconds (3600);
+      link.asymTime = Seconds (3600);
+      link.time = Seconds (3600);
+      state.InsertLinkTuple (link);
+
+      NeighborTuple neighbor;
+      neighbor.neighborMainAddr = addresses.back ();
+      neighbor.status = NeighborTuple::STATUS_SYM;
+      neighbor.willingness = OLSR_WILL_DEFAULT;
+      state.InsertNeighborTuple (neighbor);
+    }
+  for (uint32_t i = 1; i <= 30; i++)
+    {
+      std::ostringstream addr;
+      addr << "10.0.1." << i;
+      addresses.push_back (Ipv4Address (addr.str ().c_str ()));
+    }
+  TwoHopNeighborTuple twoHop;
+  twoHop.expirationTime = Seconds (3600);
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      twoHop.neighborMainAddr = addresses[i];
+      twoHop.twoHopNeighborAddr = addresses[4 + i];
+      state.InsertTwoHopNeighborTuple (twoHop);
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  uint32_t nAddresses = addresses.size ();
+  for (uint32_t step = 0; step < 300; step++)
+    {
+      uint32_t changes = random->GetInteger (1, 3);
+      for (uint32_t i = 0; i < changes; i++)
+        {
+          uint32_t action = random->GetInteger (0, 19);
+          if (action < 12)
+            {
+              TopologyTuple topology;
+              topology.destAddr = addresses[random->GetInteger (0, nAddresses - 1)];
+              topology.lastAddr = addresses[random->GetInteger (0, nAddresses - 1)];
+              topology.sequenceNumber = random->GetInteger (0, 3);
+              topology.expirationTime = Seconds (3600);
+              if (topology.destAddr != topology.lastAddr
+                  && state.FindTopologyTuple (topology.destAddr, topology.lastAddr) == NULL)
+                {
+                  state.InsertTopologyTuple (topology);
+                }
+            }
+          else if (action < 18 && !state.GetTopologySet ().empty ())
+            {
+              TopologyTuple topology = state.GetTopologySet ()[random->GetInteger (0, state.GetTopologySet ().size () - 1)];
+              state.EraseTopologyTuple (topology);
+            }
+          else if (action == 18)
+            {
+              state.EraseOlderTopologyTuples (addresses[random->GetInteger (0, nAddresses - 1)],
+                                              random->GetInteger (0, 3));
+            }
+          else
+            {
+              // Changes the 2-hop neighbors, which requires a full computation
+              twoHop.neighborMainAddr = addresses[random->GetInteger (0, 3)];
+              twoHop.twoHopNeighborAddr = addresses[random->GetInteger (4, nAddresses - 1)];
+              if (state.FindTwoHopNeighborTuple (twoHop.neighborMainAddr, twoHop.twoHopNeighborAddr) == NULL)
+                {
+                  state.InsertTwoHopNeighborTuple (twoHop);
+                }
+              else
+                {
+                  state.EraseTwoHopNeighborTuple (twoHop);
+                }
+            }
+        }
+      protocol->RoutingTableComputation ();
+
+      Ptr<RoutingProtocol> reference = CreateObject<RoutingProtocol> ();
+      reference->m_mainAddress = protocol->m_mainAddress;
+      reference->SetIpv4 (nodeIpv4);
+      reference->m_state = state;
+      reference->RoutingTableComputation ();
+      NS_TEST_EXPECT_MSG_EQ (GetRoutes (protocol), GetRoutes (reference),
+                             "Incremental routing table differs from the full computation at step " << step);
+      reference->Dispose ();
+    }
+  NS_TEST_EXPECT_MSG_GT (protocol->GetSize (), 7, "No route was derived from the topology set");
+
+  protocol->Dispose ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup olsr-test
  * \ingroup tests
@@ -194,6 +370,7 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite ()
   : TestSuite ("routing-olsr", UNIT)
 {
   AddTestCase (new OlsrMprTestCase (), TestCase::QUICK);
+  AddTestCase (new OlsrRoutingTableTestCase (), TestCase::QUICK);
 }
 
 static OlsrProtocolTestSuite g_olsrProtocolTestSuite; //!< Static variable for test initialization
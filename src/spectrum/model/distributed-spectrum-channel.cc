@@ -0,0 +1,696 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/simulator.h>
+#include <ns3/packet.h>
+#include <ns3/node.h>
+#include <ns3/node-list.h>
+#include <ns3/channel-list.h>
+#include <ns3/net-device.h>
+#include <ns3/double.h>
+#include <ns3/nstime.h>
+#include <ns3/mobility-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/mpi-interface.h>
+#include <ns3/mpi-receiver.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/half-duplex-ideal-phy-signal-parameters.h>
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
+
+#include "distributed-spectrum-channel.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DistributedSpectrumChannel");
+
+NS_OBJECT_ENSURE_REGISTERED (DistributedSpectrumChannel);
+
+
+/**
+ * \ingroup spectrum
+ * Codec of the SpectrumSignalParameters base class, which has no other field.
+ */
+class SpectrumSignalParametersBaseCodec : public SpectrumSignalParametersCodec
+{
+public:
+  virtual std::string GetName (void) const
+  {
+    return "SpectrumSignalParameters";
+  }
+  virtual bool CanSerialize (Ptr<const SpectrumSignalParameters> params) const
+  {
+    return typeid (*params) == typeid (SpectrumSignalParameters);
+  }
+  virtual uint32_t GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const
+  {
+    return 0;
+  }
+  virtual void Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator start) const
+  {
+  }
+  virtual Ptr<SpectrumSignalParameters> Deserialize (Buffer::Iterator start) const
+  {
+    return Create<SpectrumSignalParameters> ();
+  }
+};
+
+/**
+ * \ingroup spectrum
+ * Codec of HalfDuplexIdealPhySignalParameters.
+ */
+class HalfDuplexIdealPhySignalParametersCodec : public SpectrumSignalParametersCodec
+{
+public:
+  virtual std::string GetName (void) const
+  {
+    return "HalfDuplexIdealPhySignalParameters";
+  }
+  virtual bool CanSerialize (Ptr<const SpectrumSignalParameters> params) const
+  {
+    return typeid (*params) == typeid (HalfDuplexIdealPhySignalParameters);
+  }
+  virtual uint32_t GetSerializedSize (Ptr<const SpectrumSignalParameters> params) const
+  {
+    Ptr<const HalfDuplexIdealPhySignalParameters> p = DynamicCast<const HalfDuplexIdealPhySignalParameters> (params);
+    return GetSerializedPacketSize (p->data);
+  }
+  virtual void Serialize (Ptr<const SpectrumSignalParameters> params, Buffer::Iterator start) const
+  {
+    Ptr<const HalfDuplexIdealPhySignalParameters> p = DynamicCast<const HalfDuplexIdealPhySignalParameters> (params);
+    SerializePacket (p->data, start);
+  }
+  virtual Ptr<SpectrumSignalParameters> Deserialize (Buffer::Iterator start) const
+  {
+    Ptr<HalfDuplexIdealPhySignalParameters> p = Create<HalfDuplexIdealPhySignalParameters> ();
+    p->data = DeserializePacket (start);
+    return p;
+  }
+};
+
+
+/**
+ * \param a a band
+ * \param b another band
+ * \return true if the bands are identical
+ */
+static bool
+BandEqual (const BandInfo &a, const BandInfo &b)
+{
+  return a.fl == b.fl && a.fc == b.fc && a.fh == b.fh;
+}
+
+
+SpectrumSignalParametersCodec::~SpectrumSignalParametersCodec ()
+{
+}
+
+uint32_t
+SpectrumSignalParametersCodec::GetSerializedPacketSize (Ptr<const Packet> p)
+{
+  return 4 + (p ? p->GetSerializedSize () : 0);
+}
+
+void
+SpectrumSignalParametersCodec::SerializePacket (Ptr<const Packet> p, Buffer::Iterator &i)
+{
+  if (p == 0)
+    {
+      i.WriteU32 (0);
+      return;
+    }
+  // the serialized size of a packet is never zero, its size being part of it
+  uint32_t size = p->GetSerializedSize ();
+  uint8_t *buffer = new uint8_t[size];
+  uint32_t ok = p->Serialize (buffer, size);
+  NS_ASSERT (ok);
+  i.WriteU32 (size);
+  i.Write (buffer, size);
+  delete [] buffer;
+}
+
+Ptr<Packet>
+SpectrumSignalParametersCodec::DeserializePacket (Buffer::Iterator &i)
+{
+  uint32_t size = i.ReadU32 ();
+  if (size == 0)
+    {
+      return 0;
+    }
+  uint8_t *buffer = new uint8_t[size];
+  i.Read (buffer, size);
+  Ptr<Packet> p = Create<Packet> (buffer, size, true);
+  delete [] buffer;
+  return p;
+}
+
+
+/**
+ * The replica of a remote transmitting device, whose PHY is not attached
+ * to the channel: its mobility is the one of the node, and it has no
+ * antenna.
+ */
+class DistributedSpectrumChannel::RemotePhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param device the device of the transmitter
+   */
+  RemotePhy (Ptr<NetDevice> device)
+    : m_device (device)
+  {
+    m_mobility = device->GetNode ()->GetObject<MobilityModel> ();
+  }
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+    m_device = d;
+  }
+  virtual Ptr<NetDevice> GetDevice () const
+  {
+    return m_device;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return 0;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    NS_FATAL_ERROR ("the replica of a remote transmitter cannot receive");
+  }
+
+protected:
+  virtual void DoDispose (void)
+  {
+    m_device = 0;
+    m_mobility = 0;
+    SpectrumPhy::DoDispose ();
+  }
+
+private:
+  Ptr<NetDevice> m_device;  //!< device of the transmitter
+  Ptr<MobilityModel> m_mobility;  //!< mobility of its node
+};
+
+
+DistributedSpectrumChannel::DistributedSpectrumChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+DistributedSpectrumChannel::~DistributedSpectrumChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+DistributedSpectrumChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DistributedSpectrumChannel")
+    .SetParent<MultiModelSpectrumChannel> ()
+    .SetGroupName ("Spectrum")
+    .AddConstructor<DistributedSpectrumChannel> ()
+    .AddAttribute ("ProcessingDelay",
+                   "Delay added to the propagation delay of every reception, "
+                   "modeling the processing of the signal by the PHYs.  "
+                   "Part of the lookahead of the distributed simulation.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&DistributedSpectrumChannel::m_processingDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("MinimumDistance",
+                   "Minimum distance (m) between a transmitter and a receiver "
+                   "of different ranks.  The propagation delay at this distance "
+                   "is part of the lookahead of the distributed simulation; "
+                   "a receiver closer than this distance to a transmitter "
+                   "of another rank receives its signals late.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&DistributedSpectrumChannel::m_minimumDistance),
+                   MakeDoubleChecker<double> (0.0))
+  ;
+  return tid;
+}
+
+void
+DistributedSpectrumChannel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_phys.clear ();
+  m_unclassifiedPhys.clear ();
+  m_devicePhys.clear ();
+  for (std::map<DeviceId, Ptr<SpectrumPhy> >::iterator it = m_remotePhys.begin ();
+       it != m_remotePhys.end (); ++it)
+    {
+      it->second->Dispose ();
+    }
+  m_remotePhys.clear ();
+  m_remoteModels.clear ();
+  MultiModelSpectrumChannel::DoDispose ();
+}
+
+bool
+DistributedSpectrumChannel::IsLocal (Ptr<const SpectrumPhy> phy) const
+{
+  if (!MpiInterface::IsEnabled ())
+    {
+      return true;
+    }
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device == 0 || device->GetNode () == 0)
+    {
+      return true;
+    }
+  return device->GetNode ()->GetSystemId () == MpiInterface::GetSystemId ();
+}
+
+bool
+DistributedSpectrumChannel::Classify (Ptr<SpectrumPhy> phy)
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device == 0 || device->GetNode () == 0)
+    {
+      return false;
+    }
+  Ptr<Node> node = device->GetNode ();
+  m_devicePhys.insert (std::make_pair (DeviceId (node->GetId (), device->GetIfIndex ()), phy));
+  m_rankReceivers[node->GetSystemId ()]++;
+  return true;
+}
+
+void
+DistributedSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  if (m_phys.insert (phy).second && !Classify (phy))
+    {
+      // the helpers may attach the device to its node after the PHY to
+      // the channel, in which case the rank of the PHY is known when the
+      // simulation starts
+      m_unclassifiedPhys.push_back (phy);
+    }
+  if (IsLocal (phy))
+    {
+      MultiModelSpectrumChannel::AddRx (phy);
+    }
+  else
+    {
+      NS_LOG_LOGIC ("receiver of a remote node, propagated to by its rank");
+    }
+}
+
+Time
+DistributedSpectrumChannel::GetLookahead (void) const
+{
+  Time lookahead = m_processingDelay;
+  if (m_propagationDelay)
+    {
+      Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+      Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+      b->SetPosition (Vector (m_minimumDistance, 0, 0));
+      lookahead += m_propagationDelay->GetDelay (a, b);
+    }
+  return lookahead;
+}
+
+void
+DistributedSpectrumChannel::GetRemoteLinks (std::map<uint32_t, Time> &links)
+{
+  NS_LOG_FUNCTION (this);
+  if (!MpiInterface::IsEnabled ())
+    {
+      return;
+    }
+
+  for (std::vector<Ptr<SpectrumPhy> >::const_iterator it = m_unclassifiedPhys.begin ();
+       it != m_unclassifiedPhys.end (); ++it)
+    {
+      if (Classify (*it) && !IsLocal (*it))
+        {
+          NS_LOG_LOGIC ("receiver " << *it << " of a remote node, propagated to by its rank");
+          RemoveRx (*it);
+        }
+    }
+  m_unclassifiedPhys.clear ();
+
+  // The messages of a rank are received by a device of the first node of
+  // the rank having one, which is the same on all the ranks.  The
+  // point-to-point devices are skipped since the remote ones already
+  // receive the messages of their channel.
+  std::map<uint32_t, Ptr<NetDevice> > gateways;
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      if (gateways.find (node->GetSystemId ()) != gateways.end ())
+        {
+          continue;
+        }
+      for (uint32_t i = 0; i < node->GetNDevices (); ++i)
+        {
+          if (!node->GetDevice (i)->IsPointToPoint ())
+            {
+              gateways[node->GetSystemId ()] = node->GetDevice (i);
+              break;
+            }
+        }
+    }
+
+  uint32_t localRank = MpiInterface::GetSystemId ();
+  std::map<uint32_t, Ptr<NetDevice> >::iterator local = gateways.find (localRank);
+  if (local == gateways.end () || gateways.size () == 1)
+    {
+      NS_LOG_LOGIC ("no remote link");
+      return;
+    }
+
+  m_lookahead = GetLookahead ();
+  NS_ABORT_MSG_IF (m_lookahead.IsZero (),
+                   "DistributedSpectrumChannel spanning several ranks without lookahead, "
+                   "set its ProcessingDelay or MinimumDistance attributes");
+
+  Ptr<MpiReceiver> receiver = local->second->GetObject<MpiReceiver> ();
+  if (receiver == 0)
+    {
+      receiver = CreateObject<MpiReceiver> ();
+      receiver->SetReceiveCallback (MakeCallback (&DistributedSpectrumChannel::ReceiveRemote));
+      local->second->AggregateObject (receiver);
+    }
+
+  m_gateways.clear ();
+  for (std::map<uint32_t, Ptr<NetDevice> >::iterator it = gateways.begin (); it != gateways.end (); ++it)
+    {
+      if (it->first != localRank)
+        {
+          m_gateways[it->first] = DeviceId (it->second->GetNode ()->GetId (), it->second->GetIfIndex ());
+          links[it->first] = m_lookahead;
+        }
+    }
+}
+
+void
+DistributedSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  NS_ASSERT (txParams->txPhy);
+  NS_ASSERT (txParams->psd);
+  if (!IsLocal (txParams->txPhy))
+    {
+      NS_LOG_LOGIC ("transmission of a remote node replica, propagated by its rank");
+      return;
+    }
+
+  Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
+  m_txSigParamsTrace (txParamsTrace);
+
+  StartPropagation (txParams, m_processingDelay);
+
+  if (m_gateways.empty ())
+    {
+      return;
+    }
+  if (txParams->txPhy->GetDevice () == 0)
+    {
+      NS_LOG_WARN ("transmitter without device, not propagated to the remote ranks");
+      return;
+    }
+  Buffer signal;
+  SerializeSignal (txParams, signal);
+  for (std::map<uint32_t, DeviceId>::const_iterator it = m_gateways.begin (); it != m_gateways.end (); ++it)
+    {
+      std::map<uint32_t, uint32_t>::const_iterator receivers = m_rankReceivers.find (it->first);
+      if (receivers == m_rankReceivers.end () || receivers->second == 0)
+        {
+          continue;
+        }
+      NS_LOG_LOGIC ("sending to rank " << it->first);
+      MpiInterface::SendPacket (CreateMessage (txParams, it->first, signal),
+                                Simulator::Now () + m_lookahead,
+                                it->second.first, it->second.second);
+    }
+}
+
+Ptr<Packet>
+DistributedSpectrumChannel::CreateMessage (Ptr<const SpectrumSignalParameters> params, uint32_t rank, const Buffer &signal) const
+{
+  Ptr<const SpectrumModel> model = params->psd->GetSpectrumModel ();
+  // the bands of a spectrum model are only sent the first time it is used
+  // with a rank, the messages of a rank being received in order
+  bool sendBands = m_sentModels.insert (std::make_pair (rank, model->GetUid ())).second;
+  Ptr<NetDevice> device = params->txPhy->GetDevice ();
+
+  uint32_t size = 6 * 4 + 1 + (sendBands ? model->GetNumBands () * 3 * 8 : 0);
+  Buffer message;
+  message.AddAtStart (size + signal.GetSize ());
+  Buffer::Iterator i = message.Begin ();
+  i.WriteU32 (GetId ());
+  i.WriteU32 (MpiInterface::GetSystemId ());
+  i.WriteU32 (device->GetNode ()->GetId ());
+  i.WriteU32 (device->GetIfIndex ());
+  i.WriteU32 (model->GetUid ());
+  i.WriteU32 (model->GetNumBands ());
+  i.WriteU8 (sendBands ? 1 : 0);
+  if (sendBands)
+    {
+      for (Bands::const_iterator band = model->Begin (); band != model->End (); ++band)
+        {
+          double values[3] = {band->fl, band->fc, band->fh};
+          for (uint32_t j = 0; j < 3; ++j)
+            {
+              uint64_t bits;
+              std::memcpy (&bits, &values[j], sizeof (bits));
+              i.WriteU64 (bits);
+            }
+        }
+    }
+  i.Write (signal.Begin (), signal.End ());
+  return Create<Packet> (message.PeekData (), message.GetSize ());
+}
+
+void
+DistributedSpectrumChannel::ReceiveRemote (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (p);
+  uint32_t size = p->GetSize ();
+  uint8_t *data = new uint8_t[size];
+  p->CopyData (data, size);
+  Buffer message;
+  message.AddAtStart (size);
+  message.Begin ().Write (data, size);
+  delete [] data;
+
+  Buffer::Iterator i = message.Begin ();
+  uint32_t channelId = i.ReadU32 ();
+  Ptr<DistributedSpectrumChannel> channel = DynamicCast<DistributedSpectrumChannel> (ChannelList::GetChannel (channelId));
+  NS_ABORT_MSG_IF (channel == 0, "message for channel " << channelId << ", which is not a DistributedSpectrumChannel");
+  channel->DeliverRemote (i);
+}
+
+void
+DistributedSpectrumChannel::DeliverRemote (Buffer::Iterator i)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t rank = i.ReadU32 ();
+  uint32_t nodeId = i.ReadU32 ();
+  uint32_t ifIndex = i.ReadU32 ();
+  SpectrumModelUid_t uid = i.ReadU32 ();
+  uint32_t numBands = i.ReadU32 ();
+  bool hasBands = i.ReadU8 ();
+
+  std::pair<uint32_t, SpectrumModelUid_t> modelId (rank, uid);
+  if (hasBands)
+    {
+      Bands bands;
+      for (uint32_t j = 0; j < numBands; ++j)
+        {
+          double values[3];
+          for (uint32_t k = 0; k < 3; ++k)
+            {
+              uint64_t bits = i.ReadU64 ();
+              std::memcpy (&values[k], &bits, sizeof (bits));
+            }
+          BandInfo band;
+          band.fl = values[0];
+          band.fc = values[1];
+          band.fh = values[2];
+          bands.push_back (band);
+        }
+      // reuse the identical model of a local receiver, if any, to avoid
+      // the conversions
+      Ptr<const SpectrumModel> model;
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator it = m_phys.begin (); it != m_phys.end () && model == 0; ++it)
+        {
+          Ptr<const SpectrumModel> rxModel = (*it)->GetRxSpectrumModel ();
+          if (rxModel != 0 && rxModel->GetNumBands () == numBands
+              && std::equal (bands.begin (), bands.end (), rxModel->Begin (), BandEqual))
+            {
+              model = rxModel;
+            }
+        }
+      if (model == 0)
+        {
+          model = Create<SpectrumModel> (bands);
+        }
+      m_remoteModels[modelId] = model;
+    }
+  std::map<std::pair<uint32_t, SpectrumModelUid_t>, Ptr<const SpectrumModel> >::const_iterator model = m_remoteModels.find (modelId);
+  NS_ABORT_MSG_IF (model == m_remoteModels.end (), "unknown spectrum model " << uid << " of rank " << rank);
+
+  Ptr<SpectrumSignalParameters> params = DeserializeSignal (i, model->second);
+
+  DeviceId deviceId (nodeId, ifIndex);
+  Ptr<SpectrumPhy> txPhy;
+  std::map<DeviceId, Ptr<SpectrumPhy> >::const_iterator phy = m_devicePhys.find (deviceId);
+  if (phy != m_devicePhys.end ())
+    {
+      txPhy = phy->second;
+    }
+  else
+    {
+      phy = m_remotePhys.find (deviceId);
+      if (phy != m_remotePhys.end ())
+        {
+          txPhy = phy->second;
+        }
+      else
+        {
+          Ptr<NetDevice> device = NodeList::GetNode (nodeId)->GetDevice (ifIndex);
+          txPhy = CreateObject<RemotePhy> (device);
+          m_remotePhys[deviceId] = txPhy;
+        }
+    }
+  params->txPhy = txPhy;
+  params->txAntenna = txPhy->GetRxAntenna ();
+
+  // the message is received a lookahead after the transmission, which
+  // includes the propagation delay at the minimum distance
+  StartPropagation (params, m_processingDelay - m_lookahead);
+}
+
+std::vector<Ptr<SpectrumSignalParametersCodec> > &
+DistributedSpectrumChannel::GetCodecs (void)
+{
+  static std::vector<Ptr<SpectrumSignalParametersCodec> > codecs;
+  if (codecs.empty ())
+    {
+      codecs.push_back (Create<SpectrumSignalParametersBaseCodec> ());
+      codecs.push_back (Create<HalfDuplexIdealPhySignalParametersCodec> ());
+    }
+  return codecs;
+}
+
+void
+DistributedSpectrumChannel::AddSignalCodec (Ptr<SpectrumSignalParametersCodec> codec)
+{
+  GetCodecs ().push_back (codec);
+}
+
+Ptr<SpectrumSignalParametersCodec>
+DistributedSpectrumChannel::FindCodec (Ptr<const SpectrumSignalParameters> params)
+{
+  std::vector<Ptr<SpectrumSignalParametersCodec> > &codecs = GetCodecs ();
+  for (std::vector<Ptr<SpectrumSignalParametersCodec> >::const_iterator it = codecs.begin ();
+       it != codecs.end (); ++it)
+    {
+      if ((*it)->CanSerialize (params))
+        {
+          return *it;
+        }
+    }
+  NS_FATAL_ERROR ("no SpectrumSignalParametersCodec for " << typeid (*params).name ());
+  return 0;
+}
+
+void
+DistributedSpectrumChannel::SerializeSignal (Ptr<const SpectrumSignalParameters> params, Buffer &buffer)
+{
+  Ptr<SpectrumSignalParametersCodec> codec = FindCodec (params);
+  std::string name = codec->GetName ();
+  uint32_t numValues = params->psd->GetSpectrumModel ()->GetNumBands ();
+  uint32_t codecSize = codec->GetSerializedSize (params);
+  uint32_t size = 8 + 4 + numValues * 8 + 4 + name.size () + codecSize;
+
+  buffer.AddAtEnd (size);
+  Buffer::Iterator i = buffer.End ();
+  i.Prev (size);
+  i.WriteU64 (params->duration.GetTimeStep ());
+  i.WriteU32 (numValues);
+  for (Values::const_iterator value = params->psd->ConstValuesBegin (); value != params->psd->ConstValuesEnd (); ++value)
+    {
+      uint64_t bits;
+      double v = *value;
+      std::memcpy (&bits, &v, sizeof (bits));
+      i.WriteU64 (bits);
+    }
+  i.WriteU32 (name.size ());
+  i.Write (reinterpret_cast<const uint8_t *> (name.data ()), name.size ());
+  codec->Serialize (params, i);
+}
+
+Ptr<SpectrumSignalParameters>
+DistributedSpectrumChannel::DeserializeSignal (Buffer::Iterator i, Ptr<const SpectrumModel> model)
+{
+  Time duration = TimeStep (i.ReadU64 ());
+  uint32_t numValues = i.ReadU32 ();
+  NS_ABORT_MSG_IF (numValues != model->GetNumBands (),
+                   "power spectral density of " << numValues << " values for a spectrum model of "
+                                                << model->GetNumBands () << " bands");
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+  for (Values::iterator value = psd->ValuesBegin (); value != psd->ValuesEnd (); ++value)
+    {
+      uint64_t bits = i.ReadU64 ();
+      std::memcpy (&*value, &bits, sizeof (bits));
+    }
+  uint32_t nameSize = i.ReadU32 ();
+  std::string name (nameSize, '\0');
+  for (uint32_t j = 0; j < nameSize; ++j)
+    {
+      name[j] = i.ReadU8 ();
+    }
+
+  std::vector<Ptr<SpectrumSignalParametersCodec> > &codecs = GetCodecs ();
+  Ptr<SpectrumSignalParameters> params;
+  for (std::vector<Ptr<SpectrumSignalParametersCodec> >::const_iterator it = codecs.begin ();
+       it != codecs.end () && params == 0; ++it)
+    {
+      if ((*it)->GetName () == name)
+        {
+          params = (*it)->Deserialize (i);
+        }
+    }
+  NS_ABORT_MSG_IF (params == 0, "no SpectrumSignalParametersCodec named " << name);
+  params->duration = duration;
+  params->psd = psd;
+  return params;
+}
+
+} // namespace ns3
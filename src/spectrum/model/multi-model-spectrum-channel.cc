@@ -121,21 +121,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
   SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
 
   // remove a previous entry of this phy if it exists
-  // we need to scan for all rxSpectrumModel values since we don't
-  // know which spectrum model the phy had when it was previously added
-  // (it's probably different than the current one)
-  for (RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
-       rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
-       ++rxInfoIterator)
-    {
-      std::set<Ptr<SpectrumPhy> >::iterator phyIt = rxInfoIterator->second.m_rxPhySet.find (phy);
-      if (phyIt !=  rxInfoIterator->second.m_rxPhySet.end ())
-        {
-          rxInfoIterator->second.m_rxPhySet.erase (phyIt);
-          --m_numDevices;
-          break; // there should be at most one entry
-        }       
-    }
+  RemoveRx (phy);
 
   ++m_numDevices;
 
@@ -179,6 +165,27 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 }
 
 
+void
+MultiModelSpectrumChannel::RemoveRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  // we need to scan for all rxSpectrumModel values since we don't
+  // know which spectrum model the phy had when it was previously added
+  // (it's probably different than the current one)
+  for (RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+       rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
+       ++rxInfoIterator)
+    {
+      std::set<Ptr<SpectrumPhy> >::iterator phyIt = rxInfoIterator->second.m_rxPhySet.find (phy);
+      if (phyIt !=  rxInfoIterator->second.m_rxPhySet.end ())
+        {
+          rxInfoIterator->second.m_rxPhySet.erase (phyIt);
+          --m_numDevices;
+          break; // there should be at most one entry
+        }
+    }
+}
+
 TxSpectrumModelInfoMap_t::const_iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel)
 {
@@ -233,6 +240,14 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
   m_txSigParamsTrace (txParamsTrace);
 
+  StartPropagation (txParams, Time (0));
+}
+
+void
+MultiModelSpectrumChannel::StartPropagation (Ptr<SpectrumSignalParameters> txParams, Time offset)
+{
+  NS_LOG_FUNCTION (this << txParams << offset);
+
   Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
   NS_LOG_LOGIC (" txSpectrumModelUid " << txSpectrumModelUid);
@@ -342,6 +357,12 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                     }
                 }
+              delay += offset;
+              if (delay.IsStrictlyNegative ())
+                {
+                  NS_LOG_LOGIC ("receiver closer than the offset allows, signal received without delay");
+                  delay = Seconds (0);
+                }
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
@@ -128,6 +128,24 @@ public:
 protected:
   void DoDispose ();
 
+  /**
+   * Propagate a signal to the receivers attached to the channel, other
+   * than its transmitter.
+   *
+   * \param txParams The signal parameters.
+   * \param offset The time added to the propagation delay of each receiver,
+   * the signal being received after delay + offset, or without delay if
+   * this sum is negative.
+   */
+  void StartPropagation (Ptr<SpectrumSignalParameters> txParams, Time offset);
+
+  /**
+   * Remove a receiver attached to the channel, if it is.
+   *
+   * \param phy The receiver.
+   */
+  void RemoveRx (Ptr<SpectrumPhy> phy);
+
 private:
   /**
    * This method checks if m_rxSpectrumModelInfoMap contains an entry
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/packet.h>
+#include <ns3/config.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/spectrum-helper.h>
+#include <ns3/adhoc-aloha-noack-ideal-phy-helper.h>
+#include <ns3/wifi-spectrum-value-helper.h>
+#include <ns3/distributed-spectrum-channel.h>
+#include <ns3/half-duplex-ideal-phy-signal-parameters.h>
+#include <ns3/data-rate.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumDistributedChannelTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the signal parameters sent to the remote ranks are
+ * received unchanged.
+ */
+class DistributedSpectrumSignalSerializationTestCase : public TestCase
+{
+public:
+  DistributedSpectrumSignalSerializationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DistributedSpectrumSignalSerializationTestCase::DistributedSpectrumSignalSerializationTestCase ()
+  : TestCase ("Serialization of the signal parameters")
+{
+}
+
+void
+DistributedSpectrumSignalSerializationTestCase::DoRun (void)
+{
+  WifiSpectrumValue5MhzFactory sf;
+  Ptr<SpectrumValue> psd = sf.CreateTxPowerSpectralDensity (0.1, 1);
+
+  Ptr<SpectrumSignalParameters> base = Create<SpectrumSignalParameters> ();
+  base->duration = MicroSeconds (1234);
+  base->psd = psd;
+  Buffer buffer;
+  DistributedSpectrumChannel::SerializeSignal (base, buffer);
+  Ptr<SpectrumSignalParameters> rxBase = DistributedSpectrumChannel::DeserializeSignal (buffer.Begin (), psd->GetSpectrumModel ());
+  NS_TEST_ASSERT_MSG_EQ (rxBase->duration, base->duration, "wrong duration");
+  NS_TEST_ASSERT_MSG_EQ (rxBase->psd->GetSpectrumModelUid (), psd->GetSpectrumModelUid (), "wrong spectrum model");
+  for (uint32_t i = 0; i < psd->GetSpectrumModel ()->GetNumBands (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*rxBase->psd)[i], (*psd)[i], "wrong power spectral density in band " << i);
+    }
+
+  uint8_t data[100];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i;
+    }
+  Ptr<HalfDuplexIdealPhySignalParameters> ideal = Create<HalfDuplexIdealPhySignalParameters> ();
+  ideal->duration = MilliSeconds (1);
+  ideal->psd = psd;
+  ideal->data = Create<Packet> (data, sizeof (data));
+  Buffer idealBuffer;
+  DistributedSpectrumChannel::SerializeSignal (ideal, idealBuffer);
+  Ptr<HalfDuplexIdealPhySignalParameters> rxIdeal = DynamicCast<HalfDuplexIdealPhySignalParameters> (
+      DistributedSpectrumChannel::DeserializeSignal (idealBuffer.Begin (), psd->GetSpectrumModel ()));
+  NS_TEST_ASSERT_MSG_NE (rxIdeal, 0, "wrong type of signal parameters");
+  NS_TEST_ASSERT_MSG_EQ (rxIdeal->duration, ideal->duration, "wrong duration");
+  NS_TEST_ASSERT_MSG_EQ (rxIdeal->data->GetSize (), sizeof (data), "wrong packet size");
+  uint8_t rxData[100];
+  rxIdeal->data->CopyData (rxData, sizeof (rxData));
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t) rxData[i], (uint32_t) data[i], "wrong packet byte " << i);
+    }
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that, without MPI, a DistributedSpectrumChannel delivers the
+ * signals as a MultiModelSpectrumChannel, delayed by its ProcessingDelay.
+ */
+class DistributedSpectrumChannelDelayTestCase : public TestCase
+{
+public:
+  /**
+   * \param processingDelay the ProcessingDelay of the channel
+   */
+  DistributedSpectrumChannelDelayTestCase (Time processingDelay);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Transmission started
+   * \param p the packet
+   */
+  void TxStart (Ptr<const Packet> p);
+  /**
+   * Reception started
+   * \param p the packet
+   */
+  void RxStart (Ptr<const Packet> p);
+  /**
+   * Reception ended
+   * \param p the packet
+   */
+  void RxEndOk (Ptr<const Packet> p);
+
+  Time m_processingDelay;  //!< ProcessingDelay of the channel
+  Time m_txStart;  //!< start of the transmission
+  Time m_rxStart;  //!< start of the reception
+  uint32_t m_rxOk;  //!< number of packets received
+};
+
+DistributedSpectrumChannelDelayTestCase::DistributedSpectrumChannelDelayTestCase (Time processingDelay)
+  : TestCase ("Reception delay with a ProcessingDelay of " + std::to_string (processingDelay.GetMicroSeconds ()) + " us"),
+    m_processingDelay (processingDelay),
+    m_rxOk (0)
+{
+}
+
+void
+DistributedSpectrumChannelDelayTestCase::TxStart (Ptr<const Packet> p)
+{
+  m_txStart = Simulator::Now ();
+}
+
+void
+DistributedSpectrumChannelDelayTestCase::RxStart (Ptr<const Packet> p)
+{
+  m_rxStart = Simulator::Now ();
+}
+
+void
+DistributedSpectrumChannelDelayTestCase::RxEndOk (Ptr<const Packet> p)
+{
+  m_rxOk++;
+}
+
+/**
+ * Send a packet
+ * \param device the sending device
+ * \param destination the destination address
+ */
+static void
+SendPacket (Ptr<NetDevice> device, Address destination)
+{
+  device->Send (Create<Packet> (100), destination, 1);
+}
+
+void
+DistributedSpectrumChannelDelayTestCase::DoRun (void)
+{
+  NodeContainer c;
+  c.Create (2);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (300.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (c);
+
+  SpectrumChannelHelper channelHelper;
+  channelHelper.SetChannel ("ns3::DistributedSpectrumChannel",
+                            "ProcessingDelay", TimeValue (m_processingDelay));
+  channelHelper.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  Ptr<SpectrumChannel> channel = channelHelper.Create ();
+
+  WifiSpectrumValue5MhzFactory sf;
+  AdhocAlohaNoackIdealPhyHelper deviceHelper;
+  deviceHelper.SetChannel (channel);
+  deviceHelper.SetTxPowerSpectralDensity (sf.CreateTxPowerSpectralDensity (0.1, 1));
+  deviceHelper.SetNoisePowerSpectralDensity (sf.CreateConstant (1.381e-23 * 290));
+  deviceHelper.SetPhyAttribute ("Rate", DataRateValue (DataRate ("1Mbps")));
+  NetDeviceContainer devices = deviceHelper.Install (c);
+
+  Config::ConnectWithoutContext ("/NodeList/" + std::to_string (c.Get (0)->GetId ()) + "/DeviceList/0/Phy/TxStart",
+                                 MakeCallback (&DistributedSpectrumChannelDelayTestCase::TxStart, this));
+  Config::ConnectWithoutContext ("/NodeList/" + std::to_string (c.Get (1)->GetId ()) + "/DeviceList/0/Phy/RxStart",
+                                 MakeCallback (&DistributedSpectrumChannelDelayTestCase::RxStart, this));
+  Config::ConnectWithoutContext ("/NodeList/" + std::to_string (c.Get (1)->GetId ()) + "/DeviceList/0/Phy/RxEndOk",
+                                 MakeCallback (&DistributedSpectrumChannelDelayTestCase::RxEndOk, this));
+
+  Simulator::Schedule (Seconds (0.1), &SendPacket, devices.Get (0), devices.Get (1)->GetAddress ());
+  Simulator::Stop (Seconds (0.2));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxOk, 1, "the packet was not received");
+  Time propagationDelay = CreateObject<ConstantSpeedPropagationDelayModel> ()->GetDelay (c.Get (0)->GetObject<MobilityModel> (),
+                                                                                         c.Get (1)->GetObject<MobilityModel> ());
+  NS_TEST_ASSERT_MSG_EQ (m_rxStart - m_txStart, propagationDelay + m_processingDelay, "wrong reception delay");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief DistributedSpectrumChannel test suite
+ */
+class DistributedSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  DistributedSpectrumChannelTestSuite ();
+};
+
+DistributedSpectrumChannelTestSuite::DistributedSpectrumChannelTestSuite ()
+  : TestSuite ("spectrum-distributed-channel", UNIT)
+{
+  AddTestCase (new DistributedSpectrumSignalSerializationTestCase, TestCase::QUICK);
+  AddTestCase (new DistributedSpectrumChannelDelayTestCase (Seconds (0)), TestCase::QUICK);
+  AddTestCase (new DistributedSpectrumChannelDelayTestCase (MicroSeconds (10)), TestCase::QUICK);
+}
+
+static DistributedSpectrumChannelTestSuite g_distributedSpectrumChannelTestSuite; //!< the test suite
@@ -21,10 +21,13 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cstdio>
 
 #include "file-aggregator.h"
 #include "ns3/abort.h"
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 
 namespace ns3 {
 
@@ -38,6 +41,20 @@ FileAggregator::GetTypeId ()
   static TypeId tid = TypeId ("ns3::FileAggregator")
     .SetParent<DataCollectionObject> ()
     .SetGroupName ("Stats")
+    .AddAttribute ("BufferSize",
+                   "The size of the buffer in which the lines are gathered "
+                   "before they are written to the file, in bytes. "
+                   "With 0, each line is written and flushed immediately.",
+                   UintegerValue (64 * 1024),
+                   MakeUintegerAccessor (&FileAggregator::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FlushInterval",
+                   "The maximum simulation time between two writes of the "
+                   "buffered lines to the file. With 0, the lines are only "
+                   "written when the buffer is full.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&FileAggregator::m_flushInterval),
+                   MakeTimeChecker ())
   ;
 
   return tid;
@@ -48,6 +65,7 @@ FileAggregator::FileAggregator (const std::string &outputFileName,
   : m_outputFileName    (outputFileName),
     m_fileType          (fileType),
     m_hasHeadingBeenSet (false),
+    m_bufferSize        (64 * 1024),
     m_1dFormat          ("%e"),
     m_2dFormat          ("%e %e"),
     m_3dFormat          ("%e %e %e"),
@@ -77,11 +95,17 @@ FileAggregator::FileAggregator (const std::string &outputFileName,
     }
 
   m_file.open (m_outputFileName.c_str ());
+
+  // the buffered lines must reach the file even if the aggregator
+  // outlives the simulation
+  m_destroyEvent = Simulator::ScheduleDestroy (&FileAggregator::Flush, this);
 }
 
 FileAggregator::~FileAggregator ()
 {
   NS_LOG_FUNCTION (this);
+  m_destroyEvent.Cancel ();
+  Flush ();
   m_file.close ();
 }
 
@@ -102,7 +126,7 @@ FileAggregator::SetHeading (const std::string &heading)
       m_hasHeadingBeenSet = true;
 
       // Print the heading to the file.
-      m_file << m_heading << std::endl;
+      WriteLine (m_heading.c_str ());
     }
 }
 
@@ -204,12 +228,12 @@ FileAggregator::Write1d (std::string context,
             }
 
           // Write the formatted value.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the value.
-          m_file << v1 << std::endl;
+          WriteValues (&v1, 1);
         }
     }
 }
@@ -244,13 +268,13 @@ FileAggregator::Write2d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << std::endl;
+          double values[] = {v1, v2};
+          WriteValues (values, 2);
         }
     }
 }
@@ -287,14 +311,13 @@ FileAggregator::Write3d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << std::endl;
+          double values[] = {v1, v2, v3};
+          WriteValues (values, 3);
         }
     }
 }
@@ -333,15 +356,13 @@ FileAggregator::Write4d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << std::endl;
+          double values[] = {v1, v2, v3, v4};
+          WriteValues (values, 4);
         }
     }
 }
@@ -382,16 +403,13 @@ FileAggregator::Write5d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5};
+          WriteValues (values, 5);
         }
     }
 }
@@ -434,17 +452,13 @@ FileAggregator::Write6d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << m_separator
-                 << v6 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5, v6};
+          WriteValues (values, 6);
         }
     }
 }
@@ -489,18 +503,13 @@ FileAggregator::Write7d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << m_separator
-                 << v6 << m_separator
-                 << v7 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5, v6, v7};
+          WriteValues (values, 7);
         }
     }
 }
@@ -547,19 +556,13 @@ FileAggregator::Write8d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << m_separator
-                 << v6 << m_separator
-                 << v7 << m_separator
-                 << v8 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5, v6, v7, v8};
+          WriteValues (values, 8);
         }
     }
 }
@@ -607,20 +610,13 @@ FileAggregator::Write9d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << m_separator
-                 << v6 << m_separator
-                 << v7 << m_separator
-                 << v8 << m_separator
-                 << v9 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5, v6, v7, v8, v9};
+          WriteValues (values, 9);
         }
     }
 }
@@ -670,22 +666,66 @@ FileAggregator::Write10d (std::string context,
             }
 
           // Write the formatted values.
-          m_file << buffer << std::endl;
+          WriteLine (buffer);
         }
       else
         {
           // Write the values with the proper separator.
-          m_file << v1 << m_separator
-                 << v2 << m_separator
-                 << v3 << m_separator
-                 << v4 << m_separator
-                 << v5 << m_separator
-                 << v6 << m_separator
-                 << v7 << m_separator
-                 << v8 << m_separator
-                 << v9 << m_separator
-                 << v10 << std::endl;
+          double values[] = {v1, v2, v3, v4, v5, v6, v7, v8, v9, v10};
+          WriteValues (values, 10);
+        }
+    }
+}
+
+void
+FileAggregator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_buffer.empty ())
+    {
+      m_file.write (m_buffer.data (), m_buffer.size ());
+      m_buffer.clear ();
+    }
+  m_file.flush ();
+}
+
+void
+FileAggregator::WriteValues (const double *values, uint32_t n)
+{
+  // Format the values as the default output stream format would.
+  char buffer[32];
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (i > 0)
+        {
+          m_buffer += m_separator;
         }
+      snprintf (buffer, sizeof (buffer), "%g", values[i]);
+      m_buffer += buffer;
+    }
+  EndLine ();
+}
+
+void
+FileAggregator::WriteLine (const char *line)
+{
+  m_buffer += line;
+  EndLine ();
+}
+
+void
+FileAggregator::EndLine (void)
+{
+  m_buffer += '\n';
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+  else if (m_flushInterval.IsStrictlyPositive ()
+           && Simulator::Now () - m_lastFlushTime >= m_flushInterval)
+    {
+      m_lastFlushTime = Simulator::Now ();
+      Flush ();
     }
 }
 
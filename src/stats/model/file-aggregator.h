@@ -28,6 +28,8 @@
 #include <map>
 #include <string>
 #include "ns3/data-collection-object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 
 namespace ns3 {
 
@@ -35,6 +37,12 @@ namespace ns3 {
  * \ingroup aggregator
  *
  * This aggregator sends values it receives to a file.
+ *
+ * The lines are gathered in a buffer of BufferSize bytes, which is
+ * written to the file when it is full, when FlushInterval has elapsed
+ * since the last write, at Simulator::Destroy and when the aggregator
+ * is deleted.  The file thus only holds complete lines; with a
+ * BufferSize of 0, each line is written and flushed as it arrives.
  **/
 class FileAggregator : public DataCollectionObject
 {
@@ -351,7 +359,33 @@ public:
                  double v9,
                  double v10);
 
+  /**
+   * \brief Writes the buffered lines to the file and flushes it.
+   */
+  void Flush (void);
+
 private:
+  /**
+   * \param values the values of the data point.
+   * \param n the number of values.
+   *
+   * \brief Writes the values, with the proper separator, as a line.
+   */
+  void WriteValues (const double *values, uint32_t n);
+
+  /**
+   * \param line the line, without the end of line.
+   *
+   * \brief Writes a line.
+   */
+  void WriteLine (const char *line);
+
+  /**
+   * \brief Ends the line in the buffer, and writes the buffer to the
+   * file if it is full or if FlushInterval has elapsed.
+   */
+  void EndLine (void);
+
   /// The file name.
   std::string m_outputFileName;
 
@@ -370,6 +404,21 @@ private:
   /// Heading line for the outputfile.
   std::string m_heading;
 
+  /// Lines not yet written to the file.
+  std::string m_buffer;
+
+  /// Size of the buffer, in bytes.
+  uint32_t m_bufferSize;
+
+  /// Maximum time between the writes of the buffer to the file.
+  Time m_flushInterval;
+
+  /// Time of the last write of the buffer to the file.
+  Time m_lastFlushTime;
+
+  /// Writes the buffer at Simulator::Destroy.
+  EventId m_destroyEvent;
+
   std::string m_1dFormat;  //!< Format string for 1D C-style sprintf() function.
   std::string m_2dFormat;  //!< Format string for 2D C-style sprintf() function.
   std::string m_3dFormat;  //!< Format string for 3D C-style sprintf() function.
@@ -280,26 +280,27 @@ Gnuplot2dDataset::Data2d::PrintExpression (std::ostream &os,
 void
 Gnuplot2dDataset::Data2d::PrintDataFile (std::ostream &os, bool generateOneOutputFile) const
 {
+  // the stream is only flushed at the end of the data set
   for (PointSet::const_iterator i = m_pointset.begin ();
        i != m_pointset.end (); ++i)
     {
       if (i->empty) {
-          os << std::endl;
+          os << '\n';
           continue;
         }
 
       switch (m_errorBars) {
         case NONE:
-          os << i->x << " " << i->y << std::endl;
+          os << i->x << " " << i->y << '\n';
           break;
         case X:
-          os << i->x << " " << i->y << " " << i->dx << std::endl;
+          os << i->x << " " << i->y << " " << i->dx << '\n';
           break;
         case Y:
-          os << i->x << " " << i->y << " " << i->dy << std::endl;
+          os << i->x << " " << i->y << " " << i->dy << '\n';
           break;
         case XY:
-          os << i->x << " " << i->y << " " << i->dx << " " << i->dy << std::endl;
+          os << i->x << " " << i->y << " " << i->dx << " " << i->dy << '\n';
           break;
         }
     }
@@ -550,15 +551,16 @@ Gnuplot3dDataset::Data3d::PrintExpression (std::ostream &os,
 void
 Gnuplot3dDataset::Data3d::PrintDataFile (std::ostream &os, bool generateOneOutputFile) const
 {
+  // the stream is only flushed at the end of the data set
   for (PointSet::const_iterator i = m_pointset.begin ();
        i != m_pointset.end (); ++i)
     {
       if (i->empty) {
-          os << std::endl;
+          os << '\n';
           continue;
         }
 
-      os << i->x << " " << i->y << " " << i->z << std::endl;
+      os << i->x << " " << i->y << " " << i->z << '\n';
     }
   os << "e" << std::endl;
 }
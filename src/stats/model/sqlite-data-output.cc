@@ -24,6 +24,7 @@
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 #include "data-collector.h"
 #include "data-calculator.h"
@@ -36,6 +37,8 @@ NS_LOG_COMPONENT_DEFINE ("SqliteDataOutput");
 //--------------------------------------------------------------
 //----------------------------------------------
 SqliteDataOutput::SqliteDataOutput()
+  : m_insertBatchSize (64),
+    m_transactionSize (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -52,7 +55,18 @@ SqliteDataOutput::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SqliteDataOutput")
     .SetParent<DataOutputInterface> ()
     .SetGroupName ("Stats")
-    .AddConstructor<SqliteDataOutput> ();
+    .AddConstructor<SqliteDataOutput> ()
+    .AddAttribute ("InsertBatchSize",
+                   "The number of singletons inserted by a single statement.",
+                   UintegerValue (64),
+                   MakeUintegerAccessor (&SqliteDataOutput::m_insertBatchSize),
+                   MakeUintegerChecker<uint32_t> (1, 200))
+    .AddAttribute ("TransactionSize",
+                   "The number of singletons committed by a transaction. "
+                   "With 0, all the singletons are committed at the end of the output.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&SqliteDataOutput::m_transactionSize),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
   
@@ -173,11 +187,15 @@ SqliteDataOutput::Output (DataCollector &dc)
   sqlite3_finalize (stmt);
 
   Exec ("BEGIN");
-  SqliteOutputCallback callback (this, run);
-  for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
-       i != dc.DataCalculatorEnd (); i++) {
-      (*i)->Output (callback);
-    }
+  {
+    // the callback inserts its last rows and finalizes its statements
+    // when it is destroyed, before the transaction is committed
+    SqliteOutputCallback callback (this, run);
+    for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
+         i != dc.DataCalculatorEnd (); i++) {
+        (*i)->Output (callback);
+      }
+  }
   Exec ("COMMIT");
 
   sqlite3_close (m_db);
@@ -188,7 +206,10 @@ SqliteDataOutput::Output (DataCollector &dc)
 SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
   (Ptr<SqliteDataOutput> owner, std::string run) :
   m_owner (owner),
-  m_runLabel (run)
+  m_runLabel (run),
+  m_insertBatchStatement (0),
+  m_pendingRows (0),
+  m_rowsInTransaction (0)
 {
   NS_LOG_FUNCTION (this << owner << run);
 
@@ -202,12 +223,108 @@ SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
   );
   sqlite3_bind_text (m_insertSingletonStatement, 1, m_runLabel.c_str (), m_runLabel.length (), SQLITE_TRANSIENT);
 
+  uint32_t batchSize = m_owner->m_insertBatchSize;
+  if (batchSize > 1)
+    {
+      std::ostringstream sql;
+      sql << "insert into Singletons (run, name, variable, value) values (?, ?, ?, ?)";
+      for (uint32_t i = 1; i < batchSize; i++)
+        {
+          sql << ", (?, ?, ?, ?)";
+        }
+      sqlite3_prepare_v2 (m_owner->m_db, sql.str ().c_str (), -1,
+                          &m_insertBatchStatement, NULL);
+      for (uint32_t i = 0; i < batchSize; i++)
+        {
+          sqlite3_bind_text (m_insertBatchStatement, 4 * i + 1, m_runLabel.c_str (),
+                             m_runLabel.length (), SQLITE_TRANSIENT);
+        }
+    }
+  m_rows.resize (batchSize);
+
   // end SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
 }
 
 SqliteDataOutput::SqliteOutputCallback::~SqliteOutputCallback ()
 {
+  InsertRows ();
   sqlite3_finalize (m_insertSingletonStatement);
+  sqlite3_finalize (m_insertBatchStatement);
+}
+
+SqliteDataOutput::SqliteOutputCallback::SingletonRow &
+SqliteDataOutput::SqliteOutputCallback::AddRow (const std::string &key,
+                                                const std::string &variable,
+                                                int type)
+{
+  if (m_pendingRows == m_rows.size ())
+    {
+      InsertRows ();
+    }
+  SingletonRow &row = m_rows[m_pendingRows++];
+  row.key = key;
+  row.variable = variable;
+  row.type = type;
+  return row;
+}
+
+void
+SqliteDataOutput::SqliteOutputCallback::BindRow (sqlite3_stmt *stmt, int first,
+                                                 const SingletonRow &row)
+{
+  sqlite3_bind_text (stmt, first, row.key.c_str (), row.key.length (), SQLITE_TRANSIENT);
+  sqlite3_bind_text (stmt, first + 1, row.variable.c_str (), row.variable.length (), SQLITE_TRANSIENT);
+  switch (row.type)
+    {
+    case SQLITE_INTEGER:
+      sqlite3_bind_int64 (stmt, first + 2, row.intValue);
+      break;
+    case SQLITE_FLOAT:
+      sqlite3_bind_double (stmt, first + 2, row.doubleValue);
+      break;
+    default:
+      sqlite3_bind_text (stmt, first + 2, row.textValue.c_str (), row.textValue.length (), SQLITE_TRANSIENT);
+      break;
+    }
+}
+
+void
+SqliteDataOutput::SqliteOutputCallback::InsertRows (void)
+{
+  NS_LOG_FUNCTION (this << m_pendingRows);
+
+  int res = SQLITE_DONE;
+  if (m_pendingRows == m_rows.size () && m_insertBatchStatement != 0)
+    {
+      sqlite3_reset (m_insertBatchStatement);
+      for (uint32_t i = 0; i < m_pendingRows; i++)
+        {
+          BindRow (m_insertBatchStatement, 4 * i + 2, m_rows[i]);
+        }
+      res = sqlite3_step (m_insertBatchStatement);
+    }
+  else
+    {
+      for (uint32_t i = 0; i < m_pendingRows && res == SQLITE_DONE; i++)
+        {
+          sqlite3_reset (m_insertSingletonStatement);
+          BindRow (m_insertSingletonStatement, 2, m_rows[i]);
+          res = sqlite3_step (m_insertSingletonStatement);
+        }
+    }
+  if (res != SQLITE_DONE)
+    {
+      NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_owner->m_db) << "\"");
+    }
+
+  m_rowsInTransaction += m_pendingRows;
+  m_pendingRows = 0;
+  if (m_owner->m_transactionSize > 0 && m_rowsInTransaction >= m_owner->m_transactionSize)
+    {
+      m_owner->Exec ("COMMIT");
+      m_owner->Exec ("BEGIN");
+      m_rowsInTransaction = 0;
+    }
 }
 
 void
@@ -238,11 +355,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  sqlite3_reset (m_insertSingletonStatement);
-  sqlite3_bind_text (m_insertSingletonStatement, 2, key.c_str (), key.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 3, variable.c_str (), variable.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_int (m_insertSingletonStatement, 4, val);
-  sqlite3_step (m_insertSingletonStatement);
+  AddRow (key, variable, SQLITE_INTEGER).intValue = val;
 }
 void
 SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
@@ -251,11 +364,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  sqlite3_reset (m_insertSingletonStatement);
-  sqlite3_bind_text (m_insertSingletonStatement, 2, key.c_str (), key.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 3, variable.c_str (), variable.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_int64 (m_insertSingletonStatement, 4, val);
-  sqlite3_step (m_insertSingletonStatement);
+  AddRow (key, variable, SQLITE_INTEGER).intValue = val;
 }
 
 void
@@ -265,11 +374,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  sqlite3_reset (m_insertSingletonStatement);
-  sqlite3_bind_text (m_insertSingletonStatement, 2, key.c_str (), key.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 3, variable.c_str (), variable.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_double (m_insertSingletonStatement, 4, val);
-  sqlite3_step (m_insertSingletonStatement);
+  AddRow (key, variable, SQLITE_FLOAT).doubleValue = val;
 }
 
 void
@@ -279,11 +384,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  sqlite3_reset (m_insertSingletonStatement);
-  sqlite3_bind_text (m_insertSingletonStatement, 2, key.c_str (), key.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 3, variable.c_str (), variable.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 4, val.c_str (), val.length (), SQLITE_TRANSIENT);
-  sqlite3_step (m_insertSingletonStatement);
+  AddRow (key, variable, SQLITE_TEXT).textValue = val;
 }
 
 void
@@ -293,9 +394,5 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  sqlite3_reset (m_insertSingletonStatement);
-  sqlite3_bind_text (m_insertSingletonStatement, 2, key.c_str (), key.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_text (m_insertSingletonStatement, 3, variable.c_str (), variable.length (), SQLITE_TRANSIENT);
-  sqlite3_bind_int64 (m_insertSingletonStatement, 4, val.GetTimeStep ());
-  sqlite3_step (m_insertSingletonStatement);
+  AddRow (key, variable, SQLITE_INTEGER).intValue = val.GetTimeStep ();
 }
@@ -25,6 +25,8 @@
 
 #include "data-output-interface.h"
 
+#include <vector>
+
 #define STATS_HAS_SQLITE3
 
 #include <sqlite3.h>
@@ -37,6 +39,10 @@ namespace ns3 {
  * \ingroup dataoutput
  * \class SqliteDataOutput
  * \brief Outputs data in a format compatible with SQLite
+ *
+ * The singletons are inserted InsertBatchSize rows at a time, with a
+ * prepared statement inserting that many rows, and committed every
+ * TransactionSize rows, or at the end of the output.
  */
 class SqliteDataOutput : public DataOutputInterface {
 public:
@@ -134,16 +140,56 @@ public:
                           std::string variable,
                           Time val);
 
+    /**
+     * \brief Inserts the pending rows in the database
+     */
+    void InsertRows (void);
+
 private:
+    /// A row of the Singletons table waiting to be inserted
+    struct SingletonRow
+    {
+      std::string key;      //!< the SQL key
+      std::string variable; //!< the variable name
+      int type;             //!< the SQLite type of the value
+      int64_t intValue;     //!< the value, if it is an integer
+      double doubleValue;   //!< the value, if it is a floating point number
+      std::string textValue; //!< the value, if it is a text
+    };
+
+    /**
+     * \brief Adds a row to the pending rows, and inserts them when a
+     * batch is complete
+     * \param key the SQL key to use
+     * \param variable the variable name
+     * \param type the SQLite type of the value
+     * \returns the row, whose value must be set
+     */
+    SingletonRow &AddRow (const std::string &key, const std::string &variable, int type);
+
+    /**
+     * \brief Binds a row to a statement
+     * \param stmt the statement
+     * \param first the index of the first parameter of the row
+     * \param row the row
+     */
+    void BindRow (sqlite3_stmt *stmt, int first, const SingletonRow &row);
+
     Ptr<SqliteDataOutput> m_owner; //!< the instance this object belongs to
     std::string m_runLabel; //!< Run label
     sqlite3_stmt *m_insertSingletonStatement; //!< Prepared singleton insert statement
+    sqlite3_stmt *m_insertBatchStatement; //!< Prepared statement inserting a batch of singletons
+    std::vector<SingletonRow> m_rows; //!< Rows waiting to be inserted
+    uint32_t m_pendingRows; //!< Number of rows waiting to be inserted
+    uint32_t m_rowsInTransaction; //!< Number of rows inserted in the current transaction
 
     // end class SqliteOutputCallback
   };
 
 
   sqlite3 *m_db; //!< pointer to the SQL database
+  uint32_t m_insertBatchSize; //!< Number of rows inserted by a statement
+  uint32_t m_transactionSize; //!< Number of rows committed by a transaction
 
   /**
    * \brief Execute a sqlite3 query
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <limits>
+
+#include "ns3/file-aggregator.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief FileAggregator buffered output test
+ *
+ * The same values are written by an unbuffered aggregator, a buffered
+ * aggregator and a buffered aggregator with a flush interval.  The
+ * files must be identical once the simulation is destroyed, and match
+ * the values written by an output stream.  Before, the buffered
+ * aggregator must only have written the lines of its full buffers,
+ * and the one with a flush interval the lines up to the last interval.
+ */
+class FileAggregatorBufferTestCase : public TestCase
+{
+public:
+  FileAggregatorBufferTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write a data point to all the aggregators
+   * \param i the index of the data point
+   */
+  void Write (uint32_t i);
+  /**
+   * Check the size of the files during the simulation
+   */
+  void CheckSizes (void);
+  /**
+   * Read a file
+   * \param fileName the file name
+   * \returns the file contents
+   */
+  static std::string ReadFile (std::string fileName);
+
+  std::vector<Ptr<FileAggregator> > m_aggregators; //!< the aggregators
+  std::vector<std::string> m_fileNames;            //!< the file names
+  std::ostringstream m_expected;                   //!< the expected contents
+};
+
+FileAggregatorBufferTestCase::FileAggregatorBufferTestCase ()
+  : TestCase ("FileAggregator buffered output")
+{
+}
+
+std::string
+FileAggregatorBufferTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream file (fileName.c_str ());
+  std::ostringstream contents;
+  contents << file.rdbuf ();
+  return contents.str ();
+}
+
+void
+FileAggregatorBufferTestCase::Write (uint32_t i)
+{
+  double v1 = i * 0.001;
+  double v2 = std::sqrt (i) * 1e10;
+  double v3 = (i % 7 == 0) ? std::numeric_limits<double>::infinity () : -1.0 / (i + 1);
+  for (uint32_t j = 0; j < m_aggregators.size (); j++)
+    {
+      m_aggregators[j]->Write3d ("context", v1, v2, v3);
+    }
+  m_expected << v1 << "," << v2 << "," << v3 << std::endl;
+}
+
+void
+FileAggregatorBufferTestCase::CheckSizes (void)
+{
+  // about 50 bytes per line, a line every ms
+  uint32_t written = m_expected.str ().size ();
+  uint32_t unbuffered = ReadFile (m_fileNames[0]).size ();
+  uint32_t buffered = ReadFile (m_fileNames[1]).size ();
+  uint32_t interval = ReadFile (m_fileNames[2]).size ();
+  NS_TEST_EXPECT_MSG_EQ (unbuffered, written, "the unbuffered aggregator must write each line");
+  NS_TEST_EXPECT_MSG_LT (written - buffered, 4096u + 100, "the buffer is bigger than its size");
+  NS_TEST_EXPECT_MSG_GT (written - buffered, 0u, "the buffered aggregator did not buffer");
+  NS_TEST_EXPECT_MSG_LT (written - interval, 100u * 50, "the buffer was not flushed for 100 ms");
+  NS_TEST_EXPECT_MSG_EQ (ReadFile (m_fileNames[1]).back (), '\n', "incomplete line in the file");
+  NS_TEST_EXPECT_MSG_EQ (ReadFile (m_fileNames[2]).back (), '\n', "incomplete line in the file");
+}
+
+void
+FileAggregatorBufferTestCase::DoRun (void)
+{
+  uint32_t bufferSizes[] = {0, 4096, 1 << 20};
+  Time flushIntervals[] = {Seconds (0), Seconds (0), MilliSeconds (100)};
+  for (uint32_t j = 0; j < 3; j++)
+    {
+      std::ostringstream fileName;
+      fileName << "file-aggregator-" << j << ".txt";
+      m_fileNames.push_back (CreateTempDirFilename (fileName.str ()));
+      Ptr<FileAggregator> aggregator = CreateObject<FileAggregator> (m_fileNames.back (),
+                                                                     FileAggregator::COMMA_SEPARATED);
+      aggregator->SetAttribute ("BufferSize", UintegerValue (bufferSizes[j]));
+      aggregator->SetAttribute ("FlushInterval", TimeValue (flushIntervals[j]));
+      aggregator->SetHeading ("v1,v2,v3");
+      aggregator->Enable ();
+      m_aggregators.push_back (aggregator);
+    }
+  m_expected << "v1,v2,v3" << std::endl;
+
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &FileAggregatorBufferTestCase::Write, this, i);
+    }
+  Simulator::Schedule (MilliSeconds (999) + MicroSeconds (1), &FileAggregatorBufferTestCase::CheckSizes, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the aggregators are still alive, but their files must be complete
+  for (uint32_t j = 0; j < 3; j++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (ReadFile (m_fileNames[j]), m_expected.str (),
+                             "wrong contents of " << m_fileNames[j]);
+    }
+  m_aggregators.clear ();
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief FileAggregator TestSuite
+ */
+class FileAggregatorTestSuite : public TestSuite
+{
+public:
+  FileAggregatorTestSuite ();
+};
+
+FileAggregatorTestSuite::FileAggregatorTestSuite ()
+  : TestSuite ("file-aggregator", UNIT)
+{
+  AddTestCase (new FileAggregatorBufferTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static FileAggregatorTestSuite g_fileAggregatorTestSuite;
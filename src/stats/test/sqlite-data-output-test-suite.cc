@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <cstdio>
+
+#include <sqlite3.h>
+
+#include "ns3/sqlite-data-output.h"
+#include "ns3/data-collector.h"
+#include "ns3/data-calculator.h"
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief A data calculator outputting many singletons of all the types
+ */
+class ManySingletonsCalculator : public DataCalculator
+{
+public:
+  /**
+   * Constructor
+   * \param n the number of singletons of each type
+   */
+  ManySingletonsCalculator (uint32_t n)
+    : m_n (n)
+  {
+  }
+
+  virtual void Output (DataOutputCallback &callback) const
+  {
+    for (uint32_t i = 0; i < m_n; i++)
+      {
+        std::ostringstream variable;
+        variable << i;
+        callback.OutputSingleton ("int", variable.str (), -static_cast<int> (i));
+        callback.OutputSingleton ("uint32", variable.str (), i + 4000000000u);
+        callback.OutputSingleton ("double", variable.str (), i * 0.5);
+        callback.OutputSingleton ("string", variable.str (), "s" + variable.str ());
+        callback.OutputSingleton ("time", variable.str (), NanoSeconds (i));
+      }
+  }
+
+private:
+  uint32_t m_n; //!< the number of singletons of each type
+};
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SqliteDataOutput batched insertion test
+ *
+ * A calculator outputs 5 x 1003 singletons, which are inserted in
+ * batches of 64 rows, then one by one, and committed every 100 rows or
+ * at the end.  The database must contain all the singletons, with the
+ * same values and types as with one insertion per row.
+ */
+class SqliteDataOutputBatchTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param insertBatchSize the InsertBatchSize of the output
+   * \param transactionSize the TransactionSize of the output
+   */
+  SqliteDataOutputBatchTestCase (uint32_t insertBatchSize, uint32_t transactionSize);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run a query returning a single value
+   * \param db the database
+   * \param query the query
+   * \returns the value, as a text
+   */
+  static std::string Query (sqlite3 *db, std::string query);
+
+  uint32_t m_insertBatchSize; //!< the InsertBatchSize of the output
+  uint32_t m_transactionSize; //!< the TransactionSize of the output
+};
+
+SqliteDataOutputBatchTestCase::SqliteDataOutputBatchTestCase (uint32_t insertBatchSize,
+                                                              uint32_t transactionSize)
+  : TestCase ("SqliteDataOutput with batches of " + std::to_string (insertBatchSize)
+              + " rows and transactions of " + std::to_string (transactionSize) + " rows"),
+    m_insertBatchSize (insertBatchSize),
+    m_transactionSize (transactionSize)
+{
+}
+
+std::string
+SqliteDataOutputBatchTestCase::Query (sqlite3 *db, std::string query)
+{
+  sqlite3_stmt *stmt;
+  std::string value;
+  sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, NULL);
+  if (sqlite3_step (stmt) == SQLITE_ROW && sqlite3_column_text (stmt, 0) != 0)
+    {
+      value = reinterpret_cast<const char *> (sqlite3_column_text (stmt, 0));
+    }
+  sqlite3_finalize (stmt);
+  return value;
+}
+
+void
+SqliteDataOutputBatchTestCase::DoRun (void)
+{
+  std::string prefix = CreateTempDirFilename ("sqlite-data-output-"
+                                              + std::to_string (m_insertBatchSize)
+                                              + "-" + std::to_string (m_transactionSize));
+  std::remove ((prefix + ".db").c_str ());
+
+  DataCollector data;
+  data.DescribeRun ("experiment", "strategy", "input", "run");
+  data.AddDataCalculator (CreateObject<ManySingletonsCalculator> (1003));
+
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetAttribute ("InsertBatchSize", UintegerValue (m_insertBatchSize));
+  output->SetAttribute ("TransactionSize", UintegerValue (m_transactionSize));
+  output->SetFilePrefix (prefix);
+  output->Output (data);
+
+  sqlite3 *db;
+  NS_TEST_ASSERT_MSG_EQ (sqlite3_open ((prefix + ".db").c_str (), &db), SQLITE_OK, "cannot open the database");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from Singletons where run = 'run'"), "5015",
+                         "wrong number of singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(distinct variable) from Singletons"), "1003",
+                         "wrong variables");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from Singletons where name = 'int' and typeof(value) = 'integer'"),
+                         "-502503", "wrong int singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from Singletons where name = 'uint32' and typeof(value) = 'integer'"),
+                         "4012000502503", "wrong uint32_t singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from Singletons where name = 'double' and typeof(value) = 'real'"),
+                         "251251.5", "wrong double singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select count(*) from Singletons where name = 'string' and value = 's' || variable"),
+                         "1003", "wrong string singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select sum(value) from Singletons where name = 'time' and typeof(value) = 'integer'"),
+                         "502503", "wrong Time singletons");
+  NS_TEST_EXPECT_MSG_EQ (Query (db, "select value from Singletons where name = 'double' and variable = '1002'"),
+                         "501.0", "wrong last singleton");
+  sqlite3_close (db);
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SqliteDataOutput TestSuite
+ */
+class SqliteDataOutputTestSuite : public TestSuite
+{
+public:
+  SqliteDataOutputTestSuite ();
+};
+
+SqliteDataOutputTestSuite::SqliteDataOutputTestSuite ()
+  : TestSuite ("sqlite-data-output", UNIT)
+{
+  AddTestCase (new SqliteDataOutputBatchTestCase (1, 0), TestCase::QUICK);
+  AddTestCase (new SqliteDataOutputBatchTestCase (64, 0), TestCase::QUICK);
+  AddTestCase (new SqliteDataOutputBatchTestCase (64, 100), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SqliteDataOutputTestSuite g_sqliteDataOutputTestSuite;
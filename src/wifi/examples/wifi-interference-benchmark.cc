@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the cost of a frame reception in the InterferenceHelper as the
+// number of overlapping transmitters grows.
+//
+// Each transmitter sends back to back frames of the same duration, with
+// the transmitters evenly staggered in time, so that the given number of
+// signals overlap at any time and the medium is never idle. The receiver
+// locks on the first frame that arrives while it is idle and, at the end
+// of the frame, computes the SNR and PER of the header and of the payload,
+// the same way as WifiPhy does. The mean wall clock time per received frame
+// is printed for each number of transmitters.
+//
+// Command line arguments:
+// --frames (number of received frames for each number of transmitters)
+// --frameDuration (duration of a frame, in microseconds)
+
+#include "ns3/log.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiInterferenceBenchmark");
+
+/// Receiver of the benchmark, locking on frames while it is idle
+class InterferenceBenchmark
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param transmitters the number of overlapping transmitters
+   * \param frameDuration the duration of a frame
+   */
+  InterferenceBenchmark (uint32_t transmitters, Time frameDuration);
+  /**
+   * Run the benchmark until the given number of frames is received
+   *
+   * \param frames the number of frames to receive
+   */
+  void Run (uint32_t frames);
+
+private:
+  /**
+   * A frame of the given transmitter arrives at the receiver
+   *
+   * \param transmitter the transmitter index
+   */
+  void Arrive (uint32_t transmitter);
+  /**
+   * End of the reception of a frame
+   *
+   * \param event the event of the frame
+   */
+  void EndReceive (Ptr<Event> event);
+
+  InterferenceHelper m_interference; ///< interference helper of the receiver
+  WifiTxVector m_txVector; ///< TXVECTOR of all the frames
+  Ptr<const Packet> m_packet; ///< packet of all the frames
+  uint32_t m_transmitters; ///< number of transmitters
+  Time m_frameDuration; ///< duration of a frame
+  uint32_t m_frames; ///< number of frames to receive
+  uint32_t m_received; ///< number of frames received so far
+  bool m_rxing; ///< whether a frame is being received
+};
+
+InterferenceBenchmark::InterferenceBenchmark (uint32_t transmitters, Time frameDuration)
+  : m_txVector (WifiPhy::GetOfdmRate6Mbps (), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false, false),
+    m_packet (Create<Packet> (1000)),
+    m_transmitters (transmitters),
+    m_frameDuration (frameDuration),
+    m_frames (0),
+    m_received (0),
+    m_rxing (false)
+{
+  m_interference.SetNoiseFigure (5.01187);
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+}
+
+void
+InterferenceBenchmark::Run (uint32_t frames)
+{
+  m_frames = frames;
+  for (uint32_t i = 0; i < m_transmitters; i++)
+    {
+      Simulator::Schedule (m_frameDuration * i / m_transmitters, &InterferenceBenchmark::Arrive, this, i);
+    }
+  Simulator::Run ();
+}
+
+void
+InterferenceBenchmark::Arrive (uint32_t transmitter)
+{
+  // The first transmitter is the strongest one so that frames are decoded
+  double rxPowerW = (transmitter == 0 ? 1e-8 : 1e-11);
+  Ptr<Event> event = m_interference.Add (m_packet, m_txVector, m_frameDuration, rxPowerW);
+  if (!m_rxing)
+    {
+      m_rxing = true;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (m_frameDuration, &InterferenceBenchmark::EndReceive, this, event);
+    }
+  if (m_received < m_frames)
+    {
+      Simulator::Schedule (m_frameDuration, &InterferenceBenchmark::Arrive, this, transmitter);
+    }
+}
+
+void
+InterferenceBenchmark::EndReceive (Ptr<Event> event)
+{
+  m_interference.CalculatePlcpHeaderSnrPer (event);
+  m_interference.CalculatePlcpPayloadSnrPer (event);
+  m_interference.NotifyRxEnd ();
+  m_rxing = false;
+  m_received++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t frames = 100000;
+  uint32_t frameDuration = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue ("frames", "Number of received frames for each number of transmitters", frames);
+  cmd.AddValue ("frameDuration", "Duration of a frame (us)", frameDuration);
+  cmd.Parse (argc, argv);
+
+  uint32_t transmitterCounts[] = {1, 2, 5, 10, 20, 50, 100};
+  std::cout << "transmitters,usPerFrame" << std::endl;
+  for (uint32_t t = 0; t < sizeof (transmitterCounts) / sizeof (transmitterCounts[0]); t++)
+    {
+      InterferenceBenchmark benchmark (transmitterCounts[t], MicroSeconds (frameDuration));
+      SystemWallClockMs clock;
+      clock.Start ();
+      benchmark.Run (frames);
+      int64_t elapsedMs = clock.End ();
+
+      std::cout << transmitterCounts[t] << "," << elapsedMs * 1e3 / frames << std::endl;
+      Simulator::Destroy ();
+    }
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the per-packet cost of the remote station lookup of a wifi manager
+// as the number of known stations grows.
+//
+// For each number of stations, the manager of a single device learns about
+// the given number of remote stations, and the TX vector of a data frame is
+// then requested for packets sent to these stations in a round robin
+// fashion. The mean wall clock time per packet is printed for each number
+// of stations; with the hash index of the stations, it should not depend on
+// the number of stations.
+//
+// Command line arguments:
+// --wifiManager (Aarf, Aarfcd, Amrr, Arf, Cara, Constant, Ideal, Minstrel, MinstrelHt, Onoe, Rraa)
+// --packets (number of packets for each number of stations)
+// --tids (number of TIDs used per station, QoS data frames are used if larger than 1)
+
+#include "ns3/log.h"
+#include "ns3/command-line.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/abort.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiManagerLookupBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  std::string wifiManager ("Constant");
+  uint32_t packets = 1000000;
+  uint32_t tids = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("wifiManager", "Name of the wifi manager, without the ns3:: prefix and the WifiManager suffix", wifiManager);
+  cmd.AddValue ("packets", "Number of packets for each number of stations", packets);
+  cmd.AddValue ("tids", "Number of TIDs used per station", tids);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (tids == 0 || tids > 8, "The number of TIDs should be between 1 and 8");
+
+  uint32_t stationCounts[] = {10, 30, 100, 300, 1000};
+  std::cout << "stations,nsPerPacket" << std::endl;
+  for (uint32_t s = 0; s < sizeof (stationCounts) / sizeof (stationCounts[0]); s++)
+    {
+      NodeContainer nodes;
+      nodes.Create (1);
+      MobilityHelper mobility;
+      mobility.Install (nodes);
+
+      YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+      YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+      phy.SetChannel (channel.Create ());
+      WifiHelper wifi;
+      wifi.SetStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+      wifi.SetRemoteStationManager ("ns3::" + wifiManager + "WifiManager");
+      WifiMacHelper mac;
+      mac.SetType ("ns3::AdhocWifiMac", "QosSupported", BooleanValue (tids > 1));
+      NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+      Ptr<WifiRemoteStationManager> manager = DynamicCast<WifiNetDevice> (devices.Get (0))->GetRemoteStationManager ();
+
+      std::vector<Mac48Address> addresses;
+      for (uint32_t i = 0; i < stationCounts[s]; i++)
+        {
+          addresses.push_back (Mac48Address::Allocate ());
+        }
+      Ptr<Packet> packet = Create<Packet> (1000);
+      WifiMacHeader header;
+      header.SetType (tids > 1 ? WIFI_MAC_QOSDATA : WIFI_MAC_DATA);
+
+      // Create the stations before measuring
+      for (uint32_t i = 0; i < stationCounts[s] * tids; i++)
+        {
+          header.SetQosTid (i % tids);
+          manager->GetDataTxVector (addresses[i % stationCounts[s]], &header, packet);
+        }
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      for (uint32_t i = 0; i < packets; i++)
+        {
+          header.SetQosTid (i % tids);
+          manager->GetDataTxVector (addresses[i % stationCounts[s]], &header, packet);
+        }
+      int64_t elapsedMs = clock.End ();
+
+      std::cout << stationCounts[s] << "," << elapsedMs * 1e6 / packets << std::endl;
+      Simulator::Destroy ();
+    }
+  return 0;
+}
@@ -25,6 +25,7 @@
 #include "interference-helper.h"
 #include "wifi-phy.h"
 #include "error-rate-model.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -122,6 +123,7 @@ InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
     m_firstPower (0),
+    m_maxEventDuration (Seconds (0)),
     m_rxing (false)
 {
   // Always have a zero power noise event in the list
@@ -203,18 +205,46 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
   previousPowerStart = GetPreviousPosition (event->GetStartTime ())->second.GetPower ();
   previousPowerEnd = GetPreviousPosition (event->GetEndTime ())->second.GetPower ();
 
+  m_maxEventDuration = std::max (m_maxEventDuration, event->GetEndTime () - event->GetStartTime ());
   if (!m_rxing)
     {
       m_firstPower = previousPowerStart;
       // Always leave the first zero power noise event in the list
       m_niChanges.erase (++(m_niChanges.begin ()),
-                         GetNextPosition (event->GetStartTime ()));
+                         m_niChanges.begin () + (GetNextPosition (event->GetStartTime ()) - m_niChanges.begin ()));
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  else
     {
-      i->second.AddPower (event->GetRxPowerW ());
+      CollectGarbage ();
+    }
+  // Inserting a NiChange invalidates the iterators, so positions are kept
+  // instead.  The position of the first NiChange is not modified by the
+  // insertion of the last one since the last one is after it.
+  NiChanges::iterator it = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
+  NiChanges::size_type first = it - m_niChanges.begin ();
+  it = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
+  NiChanges::size_type last = it - m_niChanges.begin ();
+  for (NiChanges::size_type i = first; i != last; ++i)
+    {
+      m_niChanges[i].second.AddPower (event->GetRxPowerW ());
+    }
+}
+
+void
+InterferenceHelper::CollectGarbage (void)
+{
+  Time limit = Simulator::Now () - m_maxEventDuration;
+  if (!limit.IsStrictlyPositive ())
+    {
+      return;
+    }
+  // Keep the last NiChange strictly before the limit, which holds the power
+  // at the limit, and the first zero power noise event
+  NiChanges::size_type stale = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), limit, &InterferenceHelper::IsBefore) - m_niChanges.begin () - 1;
+  if (stale > 1 && 2 * stale >= m_niChanges.size ())
+    {
+      NS_LOG_DEBUG ("Removing " << stale - 1 << " stale NiChanges out of " << m_niChanges.size ());
+      m_niChanges.erase (m_niChanges.begin () + 1, m_niChanges.begin () + stale);
     }
 }
 
@@ -237,17 +267,18 @@ double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
 {
   double noiseInterference = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
+  auto it = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), event->GetStartTime (), &InterferenceHelper::IsBefore);
   for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it)
     {
       noiseInterference = it->second.GetPower ();
     }
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
+  // The NiChanges are visited in time order, so the copy stays sorted
+  ni->emplace_back (event->GetStartTime (), NiChange (0, event));
   while (++it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      ni->insert (*it);
+      ni->push_back (*it);
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  ni->emplace_back (event->GetEndTime (), NiChange (0, event));
   return noiseInterference;
 }
 
@@ -784,12 +815,25 @@ InterferenceHelper::EraseEvents (void)
   AddNiChangeEvent (Time (0), NiChange (0.0, 0));
   m_rxing = false;
   m_firstPower = 0;
+  m_maxEventDuration = Seconds (0);
+}
+
+bool
+InterferenceHelper::IsBefore (const std::pair<Time, NiChange> &change, Time moment)
+{
+  return change.first < moment;
+}
+
+bool
+InterferenceHelper::IsAfter (Time moment, const std::pair<Time, NiChange> &change)
+{
+  return moment < change.first;
 }
 
 InterferenceHelper::NiChanges::const_iterator
 InterferenceHelper::GetNextPosition (Time moment) const
 {
-  return m_niChanges.upper_bound (moment);
+  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), moment, &InterferenceHelper::IsAfter);
 }
 
 InterferenceHelper::NiChanges::const_iterator
@@ -805,7 +849,8 @@ InterferenceHelper::GetPreviousPosition (Time moment) const
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
 {
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  return m_niChanges.insert (m_niChanges.begin () + (GetNextPosition (moment) - m_niChanges.begin ()),
+                             std::make_pair (moment, change));
 }
 
 void
@@ -821,7 +866,7 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
+  auto it = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), Simulator::Now (), &InterferenceHelper::IsBefore);
   it--;
   m_firstPower = it->second.GetPower ();
 }
@@ -23,7 +23,7 @@
 
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
-#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -244,9 +244,10 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a timeline of NiChanges, sorted by time.  NiChanges
+   * with the same time are kept in insertion order.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
 
   /**
    * Append the given Event.
@@ -313,6 +314,7 @@ private:
   /// Experimental: needed for energy duration calculation
   NiChanges m_niChanges;
   double m_firstPower; ///< first power
+  Time m_maxEventDuration; ///< longest duration of the events added since the last EraseEvents
   bool m_rxing; ///< flag whether it is in receiving state
 
   /**
@@ -336,6 +338,24 @@ private:
    * \returns an iterator to the list of NiChanges
    */
   NiChanges::const_iterator GetPreviousPosition (Time moment) const;
+  /**
+   * Compare the time of a NiChange with a given time, for searches in the
+   * sorted timeline.
+   *
+   * \param change the NiChange
+   * \param moment the time
+   * \returns true if the NiChange is strictly before the given time
+   */
+  static bool IsBefore (const std::pair<Time, NiChange> &change, Time moment);
+  /**
+   * Compare a given time with the time of a NiChange, for searches in the
+   * sorted timeline.
+   *
+   * \param moment the time
+   * \param change the NiChange
+   * \returns true if the given time is strictly before the NiChange
+   */
+  static bool IsAfter (Time moment, const std::pair<Time, NiChange> &change);
 
   /**
    * Add NiChange to the list at the appropriate position and
@@ -346,6 +366,14 @@ private:
    * \returns the iterator of the new event
    */
   NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change);
+  /**
+   * Remove the NiChanges that can no longer be used by an event in
+   * flight, i.e., those that are older than the longest event and are
+   * followed by another NiChange older than the longest event.  The
+   * removal is only done once at least half of the timeline is stale,
+   * so that its cost is amortized over the insertions.
+   */
+  void CollectGarbage (void);
 };
 
 } //namespace ns3
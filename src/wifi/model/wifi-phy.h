@@ -27,6 +27,7 @@
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
 #include "wifi-phy-state-helper.h"
+#include <map>
 
 namespace ns3 {
 
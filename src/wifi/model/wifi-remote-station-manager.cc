@@ -34,6 +34,7 @@
 #include "ht-capabilities.h"
 #include "vht-capabilities.h"
 #include "he-capabilities.h"
+#include <algorithm>
 
 /***************************************************************
  *           Packet Mode Tagger
@@ -1637,16 +1638,96 @@ WifiRemoteStationManager::GetInfo (Mac48Address address)
   return state->m_info;
 }
 
+uint32_t
+WifiRemoteStationManager::HashStation (Mac48Address address, uint8_t tid)
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t key = tid;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  // 64-bit finalizer of MurmurHash3, so that consecutive addresses
+  // do not fall in consecutive slots
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return static_cast<uint32_t> (key);
+}
+
+void
+WifiRemoteStationManager::IndexState (WifiRemoteStationState *state)
+{
+  // Keep the load factor below 1/2
+  if (m_states.size () * 2 > m_stateIndex.size ())
+    {
+      m_stateIndex.assign (std::max<size_t> (16, m_stateIndex.size () * 2), 0);
+      uint32_t mask = m_stateIndex.size () - 1;
+      for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+        {
+          uint32_t slot = HashStation ((*i)->m_address, 0) & mask;
+          while (m_stateIndex[slot] != 0)
+            {
+              slot = (slot + 1) & mask;
+            }
+          m_stateIndex[slot] = *i;
+        }
+      return;
+    }
+  uint32_t mask = m_stateIndex.size () - 1;
+  uint32_t slot = HashStation (state->m_address, 0) & mask;
+  while (m_stateIndex[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+  m_stateIndex[slot] = state;
+}
+
+void
+WifiRemoteStationManager::IndexStation (WifiRemoteStation *station)
+{
+  // Keep the load factor below 1/2
+  if (m_stations.size () * 2 > m_stationIndex.size ())
+    {
+      m_stationIndex.assign (std::max<size_t> (16, m_stationIndex.size () * 2), 0);
+      uint32_t mask = m_stationIndex.size () - 1;
+      for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+        {
+          uint32_t slot = HashStation ((*i)->m_state->m_address, (*i)->m_tid) & mask;
+          while (m_stationIndex[slot] != 0)
+            {
+              slot = (slot + 1) & mask;
+            }
+          m_stationIndex[slot] = *i;
+        }
+      return;
+    }
+  uint32_t mask = m_stationIndex.size () - 1;
+  uint32_t slot = HashStation (station->m_state->m_address, station->m_tid) & mask;
+  while (m_stationIndex[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+  m_stationIndex[slot] = station;
+}
+
 WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  if (!m_stateIndex.empty ())
     {
-      if ((*i)->m_address == address)
+      uint32_t mask = m_stateIndex.size () - 1;
+      for (uint32_t slot = HashStation (address, 0) & mask; m_stateIndex[slot] != 0; slot = (slot + 1) & mask)
         {
-          NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
-          return (*i);
+          if (m_stateIndex[slot]->m_address == address)
+            {
+              NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
+              return m_stateIndex[slot];
+            }
         }
     }
   WifiRemoteStationState *state = new WifiRemoteStationState ();
@@ -1668,6 +1749,7 @@ WifiRemoteStationManager::LookupState (Mac48Address address) const
   state->m_vhtSupported = false;
   state->m_heSupported = false;
   const_cast<WifiRemoteStationManager *> (this)->m_states.push_back (state);
+  const_cast<WifiRemoteStationManager *> (this)->IndexState (state);
   NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning new state");
   return state;
 }
@@ -1691,12 +1773,16 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << address << +tid);
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  if (!m_stationIndex.empty ())
     {
-      if ((*i)->m_tid == tid
-          && (*i)->m_state->m_address == address)
+      uint32_t mask = m_stationIndex.size () - 1;
+      for (uint32_t slot = HashStation (address, tid) & mask; m_stationIndex[slot] != 0; slot = (slot + 1) & mask)
         {
-          return (*i);
+          if (m_stationIndex[slot]->m_tid == tid
+              && m_stationIndex[slot]->m_state->m_address == address)
+            {
+              return m_stationIndex[slot];
+            }
         }
     }
   WifiRemoteStationState *state = LookupState (address);
@@ -1707,6 +1793,7 @@ WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
   station->m_ssrc = 0;
   station->m_slrc = 0;
   const_cast<WifiRemoteStationManager *> (this)->m_stations.push_back (station);
+  const_cast<WifiRemoteStationManager *> (this)->IndexStation (station);
   return station;
 }
 
@@ -1872,11 +1959,13 @@ WifiRemoteStationManager::Reset (void)
       delete (*i);
     }
   m_states.clear ();
+  m_stateIndex.clear ();
   for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
     {
       delete (*i);
     }
   m_stations.clear ();
+  m_stationIndex.clear ();
   m_bssBasicRateSet.clear ();
   m_bssBasicMcsSet.clear ();
 }
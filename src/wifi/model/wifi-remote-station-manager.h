@@ -1395,6 +1395,31 @@ private:
    */
   typedef std::vector <WifiRemoteStationState *> StationStates;
 
+  /**
+   * Compute the hash of a station address and TID, used to index the
+   * stations and station states.
+   *
+   * \param address the address of the station
+   * \param tid the TID (0 for station states)
+   *
+   * \return the hash of the address and TID
+   */
+  static uint32_t HashStation (Mac48Address address, uint8_t tid);
+  /**
+   * Insert a station state in the open addressing index of the station
+   * states, growing the index if needed.
+   *
+   * \param state the station state, which must already be in m_states
+   */
+  void IndexState (WifiRemoteStationState *state);
+  /**
+   * Insert a station in the open addressing index of the stations,
+   * growing the index if needed.
+   *
+   * \param station the station, which must already be in m_stations
+   */
+  void IndexStation (WifiRemoteStation *station);
+
   /**
    * This is a pointer to the WifiPhy associated with this
    * WifiRemoteStationManager that is set on call to
@@ -1426,6 +1451,18 @@ private:
 
   StationStates m_states;  //!< States of known stations
   Stations m_stations;     //!< Information for each known stations
+  /**
+   * Open addressing (linear probing) hash index of m_states, keyed by the
+   * station address. Its size is zero or a power of two, and empty slots
+   * are null.
+   */
+  StationStates m_stateIndex;
+  /**
+   * Open addressing (linear probing) hash index of m_stations, keyed by the
+   * station address and TID. Its size is zero or a power of two, and empty
+   * slots are null.
+   */
+  Stations m_stationIndex;
 
   WifiMode m_defaultTxMode; //!< The default transmission mode
   WifiMode m_defaultTxMcs;   //!< The default transmission modulation-coding scheme (MCS)
@@ -22,6 +22,8 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
@@ -30,6 +32,8 @@
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -52,11 +56,33 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("Culling",
+                   "If true, a signal is not delivered to a PHY if its received power is "
+                   "lower than the energy detection threshold of the PHY minus CullingMargin.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_culling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CullingMargin",
+                   "The margin (dB) below the energy detection threshold of a PHY under which "
+                   "signals are culled, if Culling is true.",
+                   DoubleValue (10.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_cullingMargin),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("CullingRange",
+                   "If positive, signals are not delivered to the PHYs located farther than "
+                   "this distance (m) from the sender, which are found with a grid of cells "
+                   "of that size. The range must be larger than the distance at which the "
+                   "signals become negligible.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_cullingRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_nDelivered (0),
+    m_nCulled (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -64,6 +90,10 @@ YansWifiChannel::YansWifiChannel ()
 YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION (this);
+  for (std::map<Ptr<const MobilityModel>, std::vector<uint32_t> >::const_iterator i = m_mobilityPhys.begin (); i != m_mobilityPhys.end (); i++)
+    {
+      ConstCast<MobilityModel> (i->first)->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&YansWifiChannel::CourseChanged, this));
+    }
   m_phyList.clear ();
 }
 
@@ -87,45 +117,165 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  if (m_cullingRange <= 0)
     {
-      if (sender != (*i))
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (sender != (*i))
             {
-              continue;
+              Deliver (sender, *i, senderMobility, packet, txPowerDbm, duration);
             }
+        }
+      return;
+    }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
+  IndexPhys ();
+  std::vector<uint32_t> candidates (m_moving);
+  Vector position = senderMobility->GetPosition ();
+  for (int32_t dx = -1; dx <= 1; dx++)
+    {
+      for (int32_t dy = -1; dy <= 1; dy++)
+        {
+          auto it = m_grid.find (GetCell (position, dx, dy));
+          if (it != m_grid.end ())
             {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
+              candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
             }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
         }
     }
+  // Deliver in the order of the PHY list, as without the grid, so that
+  // the receptions happening at the same time keep the same order
+  std::sort (candidates.begin (), candidates.end ());
+  uint32_t visited = 0;
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[*i];
+      if (sender == receiver)
+        {
+          continue;
+        }
+      visited++;
+      Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+      if (senderMobility->GetDistanceFrom (receiverMobility) > m_cullingRange)
+        {
+          NS_LOG_DEBUG ("culling signal to " << receiver << " out of range");
+          m_nCulled++;
+          continue;
+        }
+      Deliver (sender, receiver, senderMobility, packet, txPowerDbm, duration);
+    }
+  m_nCulled += m_phyList.size () - 1 - visited;
+}
+
+void
+YansWifiChannel::Deliver (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> senderMobility,
+                          Ptr<const Packet> packet, double txPowerDbm, Time duration) const
+{
+  //For now don't account for inter channel interference nor channel bonding
+  if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  if (m_culling && rxPowerDbm + receiver->GetRxGain () < receiver->GetEdThreshold () - m_cullingMargin)
+    {
+      NS_LOG_DEBUG ("culling signal to " << receiver << " below threshold");
+      m_nCulled++;
+      return;
+    }
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  m_nDelivered++;
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, packet, rxPowerDbm, duration);
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<Packet> packet, double rxPowerDbm, Time duration)
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const Packet> packet, double rxPowerDbm, Time duration)
 {
   NS_LOG_FUNCTION (phy << packet << rxPowerDbm << duration.GetSeconds ());
-  phy->StartReceivePreambleAndHeader (packet, DbmToW (rxPowerDbm + phy->GetRxGain ()), duration);
+  // The packet is only copied once the signal reaches the PHY, which
+  // removes the PHY tag from its copy
+  phy->StartReceivePreambleAndHeader (packet->Copy (), DbmToW (rxPowerDbm + phy->GetRxGain ()), duration);
+}
+
+uint64_t
+YansWifiChannel::GetCell (Vector position, int32_t dx, int32_t dy) const
+{
+  int32_t x = static_cast<int32_t> (std::floor (position.x / m_cullingRange)) + dx;
+  int32_t y = static_cast<int32_t> (std::floor (position.y / m_cullingRange)) + dy;
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+void
+YansWifiChannel::IndexPhys (void) const
+{
+  for (uint32_t i = m_gridEntries.size (); i < m_phyList.size (); i++)
+    {
+      Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility ();
+      NS_ASSERT (mobility != 0);
+      std::vector<uint32_t> &phys = m_mobilityPhys[mobility];
+      if (phys.empty ())
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&YansWifiChannel::CourseChanged, this));
+        }
+      phys.push_back (i);
+      m_gridEntries.push_back (GridEntry ());
+      PlacePhy (i, mobility);
+    }
+}
+
+void
+YansWifiChannel::PlacePhy (uint32_t index, Ptr<const MobilityModel> mobility) const
+{
+  Vector velocity = mobility->GetVelocity ();
+  GridEntry &entry = m_gridEntries[index];
+  entry.moving = (velocity.x != 0 || velocity.y != 0 || velocity.z != 0);
+  if (entry.moving)
+    {
+      m_moving.push_back (index);
+    }
+  else
+    {
+      entry.cell = GetCell (mobility->GetPosition (), 0, 0);
+      m_grid[entry.cell].push_back (index);
+    }
+}
+
+void
+YansWifiChannel::RemovePhy (uint32_t index) const
+{
+  const GridEntry &entry = m_gridEntries[index];
+  std::vector<uint32_t> &phys = entry.moving ? m_moving : m_grid[entry.cell];
+  phys.erase (std::find (phys.begin (), phys.end (), index));
+}
+
+void
+YansWifiChannel::CourseChanged (Ptr<const MobilityModel> mobility) const
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::map<Ptr<const MobilityModel>, std::vector<uint32_t> >::const_iterator it = m_mobilityPhys.find (mobility);
+  NS_ASSERT (it != m_mobilityPhys.end ());
+  for (std::vector<uint32_t>::const_iterator i = it->second.begin (); i != it->second.end (); i++)
+    {
+      RemovePhy (*i);
+      PlacePhy (*i, mobility);
+    }
 }
 
 std::size_t
@@ -147,6 +297,18 @@ YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
   m_phyList.push_back (phy);
 }
 
+uint64_t
+YansWifiChannel::GetNDelivered (void) const
+{
+  return m_nDelivered;
+}
+
+uint64_t
+YansWifiChannel::GetNCulled (void) const
+{
+  return m_nCulled;
+}
+
 int64_t
 YansWifiChannel::AssignStreams (int64_t stream)
 {
@@ -43,6 +43,12 @@
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/mgt-headers.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 
 using namespace ns3;
 
@@ -1690,6 +1696,99 @@ StaWifiMacScanningTestCase::DoRun (void)
   }
 }
 
+/**
+ * Make sure that YansWifiChannel culls the signals received below the
+ * culling threshold or sent from farther than the culling range, including
+ * after a course change, and delivers the other ones.
+ */
+class YansWifiChannelCullingTest : public TestCase
+{
+public:
+  YansWifiChannelCullingTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Create a PHY attached to the channel
+   * \param channel the channel
+   * \param mobility the mobility model of the PHY
+   * \return the PHY
+   */
+  Ptr<YansWifiPhy> CreatePhy (Ptr<YansWifiChannel> channel, Ptr<MobilityModel> mobility) const;
+  /**
+   * Send a packet from the given PHY
+   * \param phy the PHY
+   */
+  void Send (Ptr<YansWifiPhy> phy) const;
+};
+
+YansWifiChannelCullingTest::YansWifiChannelCullingTest ()
+  : TestCase ("Test case for YansWifiChannel culling")
+{
+}
+
+Ptr<YansWifiPhy>
+YansWifiChannelCullingTest::CreatePhy (Ptr<YansWifiChannel> channel, Ptr<MobilityModel> mobility) const
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetChannel (channel);
+  return phy;
+}
+
+void
+YansWifiChannelCullingTest::Send (Ptr<YansWifiPhy> phy) const
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetOfdmRate6Mbps (), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false, false);
+  phy->SendPacket (Create<Packet> (1000), txVector);
+}
+
+void
+YansWifiChannelCullingTest::DoRun (void)
+{
+  // Positions for the default log distance loss model with a 16 dBm TX
+  // power: the receiver at 10 m is above the threshold (-96 - 3 dBm), the
+  // one at 300 m is below it, and the one at 5000 m is out of range
+  double positions[] = {0, 10, 300, 5000};
+  for (uint32_t range = 0; range <= 1000; range += 1000)
+    {
+      Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+      channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+      channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+      channel->SetAttribute ("Culling", BooleanValue (true));
+      channel->SetAttribute ("CullingMargin", DoubleValue (3));
+      channel->SetAttribute ("CullingRange", DoubleValue (range));
+
+      std::vector<Ptr<YansWifiPhy> > phys;
+      std::vector<Ptr<MobilityModel> > mobilities;
+      for (uint32_t i = 0; i < 4; i++)
+        {
+          Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (Vector (positions[i], 0, 0));
+          mobilities.push_back (mobility);
+          phys.push_back (CreatePhy (channel, mobility));
+        }
+      // A moving receiver, 20 m away at the time of the first transmission
+      Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+      moving->SetPosition (Vector (0, 19, 0));
+      moving->SetVelocity (Vector (0, 1, 0));
+      phys.push_back (CreatePhy (channel, moving));
+
+      Simulator::Schedule (Seconds (1), &YansWifiChannelCullingTest::Send, this, phys[0]);
+      // Move the farthest receiver next to the sender
+      Simulator::Schedule (Seconds (2), &MobilityModel::SetPosition, mobilities[3], Vector (0, 5, 0));
+      Simulator::Schedule (Seconds (3), &ConstantVelocityMobilityModel::SetVelocity, moving, Vector (0, 0, 0));
+      Simulator::Schedule (Seconds (4), &YansWifiChannelCullingTest::Send, this, phys[0]);
+      Simulator::Run ();
+      Simulator::Destroy ();
+
+      NS_TEST_EXPECT_MSG_EQ (channel->GetNDelivered (), 5, "Unexpected number of delivered signals with range " << range);
+      NS_TEST_EXPECT_MSG_EQ (channel->GetNCulled (), 3, "Unexpected number of culled signals with range " << range);
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1715,6 +1814,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2483TestCase, TestCase::QUICK); //Bug 2483
   AddTestCase (new Bug2831TestCase, TestCase::QUICK); //Bug 2831
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
+  AddTestCase (new YansWifiChannelCullingTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the trace file writing of the
+// AnimationInterface.  It builds a grid of 'side' x 'side' nodes, in
+// which each node of the first column sends UDP packets to the node at
+// the other end of its row, and runs it without animation, or with an
+// AnimationInterface configured by 'mode':
+//  - xml: XML trace file written on the simulation thread
+//  - async: XML trace file written on a background thread
+//  - binary: binary trace file written on a background thread
+//  - compressed: compressed binary trace file written on a background thread
+// Sample usage:  ./waf --run 'bench-animation-interface --side=20 --mode=binary'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/netanim-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include <iostream>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t side = 10;
+  double duration = 10.0;
+  std::string mode = "xml";
+  std::string animFile = "bench-animation-interface.anim";
+
+  CommandLine cmd;
+  cmd.AddValue ("side", "Number of nodes on a side of the grid", side);
+  cmd.AddValue ("duration", "Simulated time (s)", duration);
+  cmd.AddValue ("mode", "none, xml, async, binary or compressed", mode);
+  cmd.AddValue ("animFile", "File Name for Animation Output", animFile);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::OnOffApplication::PacketSize", UintegerValue (512));
+  Config::SetDefault ("ns3::OnOffApplication::DataRate", StringValue ("500kb/s"));
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  PointToPointGridHelper grid (side, side, pointToPoint);
+  InternetStackHelper stack;
+  grid.InstallStack (stack);
+  grid.AssignIpv4Addresses (Ipv4AddressHelper ("10.1.1.0", "255.255.255.0"),
+                            Ipv4AddressHelper ("10.128.1.0", "255.255.255.0"));
+
+  OnOffHelper clientHelper ("ns3::UdpSocketFactory", Address ());
+  clientHelper.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+  clientHelper.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+  ApplicationContainer clientApps;
+  for (uint32_t row = 0; row < side; row++)
+    {
+      AddressValue remoteAddress (InetSocketAddress (grid.GetIpv4Address (row, side - 1), 1000));
+      clientHelper.SetAttribute ("Remote", remoteAddress);
+      clientApps.Add (clientHelper.Install (grid.GetNode (row, 0)));
+    }
+  clientApps.Start (Seconds (0.0));
+  clientApps.Stop (Seconds (duration));
+  grid.BoundingBox (1, 1, 100, 100);
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  AnimationInterface *anim = 0;
+  if (mode != "none")
+    {
+      anim = new AnimationInterface (animFile);
+      anim->SetMaxPktsPerTraceFile (UINT64_MAX);
+      if (mode != "xml")
+        {
+          anim->EnableAsyncWrite ();
+        }
+      if (mode == "binary" || mode == "compressed")
+        {
+          anim->EnableBinaryTrace ();
+        }
+      if (mode == "compressed")
+        {
+          anim->EnableCompression ();
+        }
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  // The pending records are written when the AnimationInterface is deleted
+  delete anim;
+  int64_t ms = clock.End ();
+  std::cout << "mode " << mode << " time(ms) " << ms << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
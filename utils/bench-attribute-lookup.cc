@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the lookup of attributes and
+// trace sources by name.  It looks up every attribute and trace source
+// of LteUePhy and LteSpectrumPhy 'iterations' times with a linear scan
+// of the TypeId and of its parents, with TypeId::LookupAttributeByName
+// and TypeId::LookupTraceSourceByName, and sets an attribute on an
+// object by name and through an attribute handle.
+// Sample usage:  ./waf --run 'bench-attribute-lookup --iterations=100000'
+
+#include "ns3/core-module.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/lte-spectrum-phy.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Find an attribute by a linear scan of a TypeId and of its parents.
+ * \param tid The TypeId.
+ * \param name The attribute name.
+ * \param info The attribute information.
+ * \returns true if the attribute was found.
+ */
+static bool
+LinearLookupAttribute (TypeId tid, std::string name, struct TypeId::AttributeInformation *info)
+{
+  TypeId nextTid = tid;
+  do {
+      tid = nextTid;
+      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
+          if (tmp.name == name)
+            {
+              *info = tmp;
+              return true;
+            }
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+  return false;
+}
+
+/**
+ * Find a trace source by a linear scan of a TypeId and of its parents.
+ * \param tid The TypeId.
+ * \param name The trace source name.
+ * \returns The trace source accessor.
+ */
+static Ptr<const TraceSourceAccessor>
+LinearLookupTraceSource (TypeId tid, std::string name)
+{
+  TypeId nextTid = tid;
+  do {
+      tid = nextTid;
+      for (std::size_t i = 0; i < tid.GetTraceSourceN (); i++)
+        {
+          struct TypeId::TraceSourceInformation tmp = tid.GetTraceSource (i);
+          if (tmp.name == name)
+            {
+              return tmp.accessor;
+            }
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+  return 0;
+}
+
+/**
+ * Print a result line.
+ * \param tid The TypeId.
+ * \param what The benchmarked operation.
+ * \param lookups The number of lookups.
+ * \param ms The elapsed time.
+ */
+static void
+Report (TypeId tid, std::string what, uint64_t lookups, int64_t ms)
+{
+  std::cout << std::setw (16) << tid.GetName ().substr (5) << std::setw (24) << what
+            << std::setw (12) << ms
+            << std::setw (14) << (ms > 0 ? lookups / 1000.0 / ms : 0) << std::endl;
+}
+
+/**
+ * Benchmark the lookups of all the attributes and trace sources of a TypeId.
+ * \param tid The TypeId.
+ * \param iterations The number of lookups of each name.
+ */
+static void
+BenchLookups (TypeId tid, uint32_t iterations)
+{
+  std::vector<std::string> attributes;
+  std::vector<std::string> traceSources;
+  for (TypeId t = tid; ; t = t.GetParent ())
+    {
+      for (std::size_t i = 0; i < t.GetAttributeN (); i++)
+        {
+          attributes.push_back (t.GetAttribute (i).name);
+        }
+      for (std::size_t i = 0; i < t.GetTraceSourceN (); i++)
+        {
+          traceSources.push_back (t.GetTraceSource (i).name);
+        }
+      if (t == t.GetParent ())
+        {
+          break;
+        }
+    }
+
+  SystemWallClockMs clock;
+  struct TypeId::AttributeInformation info;
+  uint64_t found = 0;
+
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      for (std::vector<std::string>::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
+        {
+          found += LinearLookupAttribute (tid, *i, &info);
+        }
+    }
+  Report (tid, "attribute (linear)", found, clock.End ());
+
+  found = 0;
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      for (std::vector<std::string>::const_iterator i = attributes.begin (); i != attributes.end (); ++i)
+        {
+          found += tid.LookupAttributeByName (*i, &info);
+        }
+    }
+  Report (tid, "attribute (index)", found, clock.End ());
+
+  found = 0;
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      for (std::vector<std::string>::const_iterator i = traceSources.begin (); i != traceSources.end (); ++i)
+        {
+          found += (LinearLookupTraceSource (tid, *i) != 0);
+        }
+    }
+  Report (tid, "trace source (linear)", found, clock.End ());
+
+  found = 0;
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      for (std::vector<std::string>::const_iterator i = traceSources.begin (); i != traceSources.end (); ++i)
+        {
+          found += (tid.LookupTraceSourceByName (*i) != 0);
+        }
+    }
+  Report (tid, "trace source (index)", found, clock.End ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t iterations = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue ("iterations", "Number of lookups of each name", iterations);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (16) << "tid" << std::setw (24) << "lookup"
+            << std::setw (12) << "time(ms)" << std::setw (14) << "Mlookups/s" << std::endl;
+  BenchLookups (LteUePhy::GetTypeId (), iterations);
+  BenchLookups (LteSpectrumPhy::GetTypeId (), iterations);
+
+  Ptr<LteSpectrumPhy> phy = CreateObject<LteSpectrumPhy> ();
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      phy->SetAttribute ("DataErrorModelEnabled", BooleanValue (n % 2));
+    }
+  Report (LteSpectrumPhy::GetTypeId (), "SetAttribute (name)", iterations, clock.End ());
+
+  TypeId::AttributeHandle handle;
+  LteSpectrumPhy::GetTypeId ().LookupAttributeHandle ("DataErrorModelEnabled", &handle);
+  clock.Start ();
+  for (uint32_t n = 0; n < iterations; n++)
+    {
+      phy->SetAttribute (handle, BooleanValue (n % 2));
+    }
+  Report (LteSpectrumPhy::GetTypeId (), "SetAttribute (handle)", iterations, clock.End ());
+
+  phy->Dispose ();
+  return 0;
+}
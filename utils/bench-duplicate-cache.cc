@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the duplicate detection of
+// flooding routing protocols.  It replays, at a single node, the RREQs
+// flooded by 'originators' nodes, each one sending a RREQ every 'interval'
+// seconds and each RREQ being received from 'copies' neighbors, and checks
+// every received RREQ against a duplicate cache with the given 'lifetime'.
+// The DuplicateCache used by AODV and OLSR is compared to a linear search
+// in a vector of the cached identifiers.
+// Sample usage:  ./waf --run 'bench-duplicate-cache --originators=500'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/duplicate-cache.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// Duplicate detection by linear search in a vector of the cached identifiers.
+class LinearIdCache
+{
+public:
+  /**
+   * Constructor.
+   * \param lifetime The lifetime of the entries.
+   */
+  LinearIdCache (Time lifetime)
+    : m_lifetime (lifetime)
+  {
+  }
+  /**
+   * \param addr The originator address.
+   * \param id The RREQ identifier.
+   * \returns true if the RREQ is a duplicate.
+   */
+  bool IsDuplicate (Ipv4Address addr, uint32_t id)
+  {
+    Time now = Simulator::Now ();
+    std::vector<Entry>::iterator out = m_entries.begin ();
+    for (std::vector<Entry>::iterator i = m_entries.begin (); i != m_entries.end (); ++i)
+      {
+        if (!(i->expire < now))
+          {
+            *out++ = *i;
+          }
+      }
+    m_entries.erase (out, m_entries.end ());
+    for (std::vector<Entry>::const_iterator i = m_entries.begin (); i != m_entries.end (); ++i)
+      {
+        if (i->addr == addr && i->id == id)
+          {
+            return true;
+          }
+      }
+    Entry entry = {addr, id, now + m_lifetime};
+    m_entries.push_back (entry);
+    return false;
+  }
+  /**
+   * \returns The number of entries.
+   */
+  uint32_t GetSize () const
+  {
+    return m_entries.size ();
+  }
+
+private:
+  /// A cached identifier.
+  struct Entry
+  {
+    Ipv4Address addr; //!< The originator address.
+    uint32_t id;      //!< The RREQ identifier.
+    Time expire;      //!< The expiration time.
+  };
+  std::vector<Entry> m_entries; //!< The cached identifiers.
+  Time m_lifetime;              //!< The lifetime of the entries.
+};
+
+/**
+ * Receive the copies of a RREQ.
+ * \param cache The duplicate cache.
+ * \param addr The originator address.
+ * \param id The RREQ identifier.
+ * \param copies The number of copies.
+ * \param duplicates The number of duplicates detected.
+ */
+template <typename Cache>
+static void
+ReceiveRreq (Cache *cache, Ipv4Address addr, uint32_t id, uint32_t copies, uint64_t *duplicates)
+{
+  for (uint32_t i = 0; i < copies; i++)
+    {
+      if (cache->IsDuplicate (addr, id))
+        {
+          (*duplicates)++;
+        }
+    }
+}
+
+/**
+ * Run the RREQ flood against a duplicate cache.
+ * \param name The name of the cache.
+ * \param cache The duplicate cache.
+ * \param originators The number of RREQ originators.
+ * \param rreqs The number of RREQs sent by each originator.
+ * \param copies The number of copies of each RREQ received.
+ * \param interval The interval between the RREQs of an originator (s).
+ */
+template <typename Cache>
+static void
+RunBench (const char *name, Cache *cache, uint32_t originators, uint32_t rreqs,
+          uint32_t copies, double interval)
+{
+  uint64_t duplicates = 0;
+  for (uint32_t id = 0; id < rreqs; id++)
+    {
+      for (uint32_t o = 0; o < originators; o++)
+        {
+          Time t = Seconds (interval * (id + static_cast<double> (o) / originators));
+          Simulator::Schedule (t, &ReceiveRreq<Cache>, cache,
+                               Ipv4Address (0x0a000001 + o), id, copies, &duplicates);
+        }
+    }
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t ms = time.End ();
+  uint64_t ops = static_cast<uint64_t> (originators) * rreqs * copies;
+  std::cout << name << ": " << ops << " lookups in " << ms << " ms";
+  if (ms > 0)
+    {
+      std::cout << " (" << ops * 1000 / ms << " lookups/s)";
+    }
+  std::cout << ", " << duplicates << " duplicates, "
+            << cache->GetSize () << " cached ids at end" << std::endl;
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t originators = 200;
+  uint32_t rreqs = 50;
+  uint32_t copies = 4;
+  double interval = 1.0;
+  double lifetime = 5.6;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the duplicate detection of a RREQ flood");
+  cmd.AddValue ("originators", "number of RREQ originators", originators);
+  cmd.AddValue ("rreqs", "number of RREQs sent by each originator", rreqs);
+  cmd.AddValue ("copies", "number of copies of each RREQ received", copies);
+  cmd.AddValue ("interval", "interval between the RREQs of an originator (s)", interval);
+  cmd.AddValue ("lifetime", "lifetime of the cached ids (s)", lifetime);
+  cmd.Parse (argc, argv);
+
+  DuplicateCache<> duplicateCache (Seconds (lifetime));
+  RunBench ("DuplicateCache", &duplicateCache, originators, rreqs, copies, interval);
+  LinearIdCache linearCache (Seconds (lifetime));
+  RunBench ("linear search", &linearCache, originators, rreqs, copies, interval);
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the packet tracking of the
+// FlowMonitor.  Every millisecond, each of 'flows' flows transmits a
+// packet, and receives the packet transmitted 'delay' milliseconds
+// before, except one out of 'lossInterval' packets which is lost.
+// The FlowMonitor thus tracks about flows * delay packets, and checks
+// them for losses every second.
+// Sample usage:  ./waf --run 'bench-flow-monitor --flows=10000'
+
+#include "ns3/core-module.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * A probe reporting the packets of the benchmark
+ */
+class BenchFlowProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  BenchFlowProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+static Ptr<FlowMonitor> g_monitor; //!< The FlowMonitor
+static Ptr<FlowProbe> g_probe;     //!< The probe
+static uint32_t g_flows;           //!< Number of flows
+static uint32_t g_delay;           //!< Delay of the packets, in milliseconds
+static uint32_t g_lossInterval;    //!< One out of this number of packets is lost
+
+/**
+ * Transmit and receive the packets of one millisecond.
+ * \param tick The number of milliseconds since the start.
+ */
+static void
+Tick (uint32_t tick)
+{
+  for (uint32_t flow = 1; flow <= g_flows; flow++)
+    {
+      g_monitor->ReportFirstTx (g_probe, flow, tick, 100);
+      if (tick >= g_delay && (tick - g_delay) % g_lossInterval != 0)
+        {
+          g_monitor->ReportLastRx (g_probe, flow, tick - g_delay, 100);
+        }
+    }
+  Simulator::Schedule (MilliSeconds (1), &Tick, tick + 1);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_flows = 1000;
+  g_delay = 50;
+  g_lossInterval = 97;
+  double duration = 5.0;
+  uint32_t samplingInterval = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("flows", "Number of flows", g_flows);
+  cmd.AddValue ("delay", "Delay of the packets (ms)", g_delay);
+  cmd.AddValue ("lossInterval", "One out of this number of packets is lost", g_lossInterval);
+  cmd.AddValue ("duration", "Simulated time (s)", duration);
+  cmd.AddValue ("samplingInterval", "SamplingInterval of the FlowMonitor", samplingInterval);
+  cmd.Parse (argc, argv);
+
+  g_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1)),
+                                                       "SamplingInterval", UintegerValue (samplingInterval));
+  g_monitor->StartRightNow ();
+  g_probe = CreateObject<BenchFlowProbe> (g_monitor);
+
+  Simulator::Schedule (MilliSeconds (1), &Tick, 0);
+  Simulator::Stop (Seconds (duration));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t ms = clock.End ();
+
+  uint64_t lost = 0;
+  const FlowMonitor::FlowStatsContainer &stats = g_monitor->GetFlowStats ();
+  for (FlowMonitor::FlowStatsContainerCI i = stats.begin (); i != stats.end (); ++i)
+    {
+      lost += i->second.lostPackets;
+    }
+  std::cout << "time(ms) " << ms << " lost " << lost << std::endl;
+
+  g_monitor->Dispose ();
+  g_monitor = 0;
+  g_probe = 0;
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the MobilitySnapshot.  'nodes'
+// nodes move in a square with a RandomWalk2dMobilityModel; every
+// millisecond, each node transmits in turn, and the receive power at
+// all the other nodes is computed as the channels do: the positions of
+// the transmitter and receiver for the antenna gains, then a
+// LogDistancePropagationLossModel.  The run is repeated with the
+// snapshot disabled.
+// Sample usage:  ./waf --run 'bench-mobility-snapshot --nodes=200'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mobility-snapshot.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/angles.h"
+#include <iostream>
+
+using namespace ns3;
+
+static NodeContainer g_nodes;                        //!< The nodes
+static Ptr<PropagationLossModel> g_loss;             //!< The propagation loss model
+static std::vector<Ptr<MobilityModel> > g_mobility;  //!< The mobility models of the nodes
+static double g_sum;                                 //!< Sum of the receive powers
+
+/**
+ * Transmit from one node to all the others.
+ * \param tx The index of the transmitter.
+ */
+static void
+Transmit (uint32_t tx)
+{
+  Ptr<MobilityModel> txMobility = g_mobility[tx];
+  for (uint32_t rx = 0; rx < g_mobility.size (); rx++)
+    {
+      if (rx != tx)
+        {
+          Ptr<MobilityModel> rxMobility = g_mobility[rx];
+          Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+          Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+          g_sum += txAngles.phi + rxAngles.phi + g_loss->CalcRxPower (0, txMobility, rxMobility);
+        }
+    }
+  Simulator::Schedule (MicroSeconds (1000 / g_mobility.size ()), &Transmit, (tx + 1) % g_mobility.size ());
+}
+
+/**
+ * Run the simulation.
+ * \param nodes The number of nodes.
+ * \param duration The simulated time.
+ * \param enabled True to enable the MobilitySnapshot.
+ */
+static void
+Run (uint32_t nodes, double duration, bool enabled)
+{
+  if (enabled)
+    {
+      MobilitySnapshot::Enable ();
+    }
+  else
+    {
+      MobilitySnapshot::Disable ();
+    }
+  g_nodes.Create (nodes);
+  MobilityHelper mobility;
+  Ptr<PositionAllocator> allocator = CreateObjectWithAttributes<RandomRectanglePositionAllocator>
+    ("X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"),
+    "Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"));
+  // same positions and walks in both runs
+  allocator->AssignStreams (0);
+  mobility.SetPositionAllocator (allocator);
+  mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                             "Bounds", RectangleValue (Rectangle (0, 1000, 0, 1000)),
+                             "Time", TimeValue (Seconds (0.5)),
+                             "Mode", StringValue ("Time"));
+  mobility.Install (g_nodes);
+  mobility.AssignStreams (g_nodes, 2);
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      g_mobility.push_back (g_nodes.Get (i)->GetObject<MobilityModel> ());
+    }
+  g_loss = CreateObject<LogDistancePropagationLossModel> ();
+  g_sum = 0;
+
+  Simulator::Schedule (Seconds (0), &Transmit, 0);
+  Simulator::Stop (Seconds (duration));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t ms = clock.End ();
+  std::cout << (enabled ? "snapshot enabled " : "snapshot disabled") << " time(ms) " << ms
+            << " sum " << g_sum << std::endl;
+
+  g_mobility.clear ();
+  g_loss = 0;
+  g_nodes = NodeContainer ();
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodes = 100;
+  double duration = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes", nodes);
+  cmd.AddValue ("duration", "Simulated time (s)", duration);
+  cmd.Parse (argc, argv);
+
+  Run (nodes, duration, true);
+  Run (nodes, duration, false);
+  MobilitySnapshot::Enable ();
+  return 0;
+}
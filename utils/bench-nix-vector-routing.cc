@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the computation of the routes
+// of Ipv4NixVectorRouting.  It builds a grid of 'side' x 'side' nodes,
+// and routes a packet from every node to 'destinations' nodes, first
+// with route trees computed on demand, then with route trees computed
+// before by Ipv4NixVectorRouting::PrecomputeRouteTrees with 'threads'
+// threads.
+// Sample usage:  ./waf --run 'bench-nix-vector-routing --side=100 --threads=4'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/nix-vector-routing-module.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace ns3;
+
+/**
+ * Route a packet from every node to each destination.
+ * \param nodes The nodes.
+ * \param destinations The destination addresses.
+ * \returns The number of routes found.
+ */
+static uint32_t
+RouteAll (NodeContainer nodes, std::vector<Ipv4Address> destinations)
+{
+  uint32_t found = 0;
+  Socket::SocketErrno sockerr;
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Ptr<Ipv4RoutingProtocol> routing = (*i)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+      for (std::vector<Ipv4Address>::const_iterator dest = destinations.begin (); dest != destinations.end (); ++dest)
+        {
+          Ipv4Header header;
+          header.SetDestination (*dest);
+          found += (routing->RouteOutput (Create<Packet> (), header, 0, sockerr) != 0);
+        }
+    }
+  return found;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t side = 50;
+  uint32_t nDestinations = 20;
+  uint32_t threads = 4;
+
+  CommandLine cmd;
+  cmd.AddValue ("side", "Number of nodes on a side of the grid", side);
+  cmd.AddValue ("destinations", "Number of destination nodes", nDestinations);
+  cmd.AddValue ("threads", "Number of threads computing the route trees", threads);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (side * side);
+  Ipv4NixVectorHelper nixRouting;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (nixRouting);
+  stack.Install (nodes);
+
+  SimpleNetDeviceHelper devices;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.252");
+  for (uint32_t row = 0; row < side; row++)
+    {
+      for (uint32_t col = 0; col < side; col++)
+        {
+          Ptr<Node> node = nodes.Get (row * side + col);
+          if (col + 1 < side)
+            {
+              address.Assign (devices.Install (NodeContainer (node, nodes.Get (row * side + col + 1))));
+              address.NewNetwork ();
+            }
+          if (row + 1 < side)
+            {
+              address.Assign (devices.Install (NodeContainer (node, nodes.Get ((row + 1) * side + col))));
+              address.NewNetwork ();
+            }
+        }
+    }
+
+  NodeContainer destinationNodes;
+  std::vector<Ipv4Address> destinations;
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < nDestinations; i++)
+    {
+      Ptr<Node> node = nodes.Get (rng->GetInteger (0, nodes.GetN () - 1));
+      destinationNodes.Add (node);
+      destinations.push_back (node->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+    }
+
+  std::cout << std::setw (24) << "phase" << std::setw (12) << "time(ms)"
+            << std::setw (12) << "routes" << std::endl;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  uint32_t found = RouteAll (nodes, destinations);
+  std::cout << std::setw (24) << "on demand" << std::setw (12) << clock.End ()
+            << std::setw (12) << found << std::endl;
+
+  nodes.Get (0)->GetObject<Ipv4NixVectorRouting> ()->FlushGlobalNixRoutingCache ();
+  clock.Start ();
+  Ipv4NixVectorRouting::PrecomputeRouteTrees (destinationNodes, threads);
+  std::cout << std::setw (24) << "precompute" << std::setw (12) << clock.End ()
+            << std::setw (12) << destinationNodes.GetN () << std::endl;
+
+  clock.Start ();
+  found = RouteAll (nodes, destinations);
+  std::cout << std::setw (24) << "precomputed" << std::setw (12) << clock.End ()
+            << std::setw (12) << found << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the outputs of the stats
+// module.  It writes 'samples' 2D data points to a FileAggregator,
+// flushed at each line and buffered, and to a GnuplotAggregator, and
+// inserts 'samples' singletons in a SqliteDataOutput database, one by
+// one and in batches.  The files are written in the 'directory'
+// directory.
+// Sample usage:  ./waf --run 'bench-stats-output --samples=10000000'
+
+#include "ns3/core-module.h"
+#include "ns3/stats-module.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * A data calculator outputting many singletons
+ */
+class BenchCalculator : public DataCalculator
+{
+public:
+  /**
+   * Constructor
+   * \param n The number of singletons.
+   */
+  BenchCalculator (uint32_t n)
+    : m_n (n)
+  {
+  }
+
+  virtual void Output (DataOutputCallback &callback) const
+  {
+    for (uint32_t i = 0; i < m_n; i++)
+      {
+        callback.OutputSingleton ("bench", "sample", i * 0.001);
+      }
+  }
+
+private:
+  uint32_t m_n; //!< The number of singletons.
+};
+
+/**
+ * Print a result line.
+ * \param what The benchmarked output.
+ * \param samples The number of samples.
+ * \param ms The elapsed time.
+ */
+static void
+Report (std::string what, uint32_t samples, int64_t ms)
+{
+  std::cout << std::setw (32) << what << std::setw (12) << ms
+            << std::setw (14) << (ms > 0 ? samples / 1000.0 / ms : 0) << std::endl;
+}
+
+/**
+ * Write data points to a FileAggregator.
+ * \param fileName The file name.
+ * \param bufferSize The BufferSize of the aggregator.
+ * \param samples The number of data points.
+ */
+static void
+BenchFileAggregator (std::string fileName, uint32_t bufferSize, uint32_t samples)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+  {
+    Ptr<FileAggregator> aggregator = CreateObject<FileAggregator> (fileName);
+    aggregator->SetAttribute ("BufferSize", UintegerValue (bufferSize));
+    aggregator->Enable ();
+    for (uint32_t i = 0; i < samples; i++)
+      {
+        aggregator->Write2d ("bench", i * 0.001, i % 1000);
+      }
+  }
+  std::ostringstream what;
+  what << "FileAggregator (" << bufferSize << " B)";
+  Report (what.str (), samples, clock.End ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t samples = 10000000;
+  std::string directory = ".";
+
+  CommandLine cmd;
+  cmd.AddValue ("samples", "Number of samples written to each output", samples);
+  cmd.AddValue ("directory", "Directory of the output files", directory);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (32) << "output" << std::setw (12) << "time(ms)"
+            << std::setw (14) << "Msamples/s" << std::endl;
+
+  BenchFileAggregator (directory + "/bench-stats-output-0.txt", 0, samples);
+  BenchFileAggregator (directory + "/bench-stats-output-1.txt", 64 * 1024, samples);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  {
+    Ptr<GnuplotAggregator> aggregator = CreateObject<GnuplotAggregator> (directory + "/bench-stats-output");
+    aggregator->Add2dDataset ("bench", "bench");
+    aggregator->Enable ();
+    for (uint32_t i = 0; i < samples; i++)
+      {
+        aggregator->Write2d ("bench", i * 0.001, i % 1000);
+      }
+  }
+  Report ("GnuplotAggregator", samples, clock.End ());
+
+#ifdef STATS_HAS_SQLITE3
+  DataCollector data;
+  data.DescribeRun ("bench", "bench", "bench", "bench");
+  data.AddDataCalculator (CreateObject<BenchCalculator> (samples));
+  uint32_t batchSizes[] = {1, 64};
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      std::ostringstream prefix;
+      prefix << directory << "/bench-stats-output-" << batchSizes[i];
+      std::remove ((prefix.str () + ".db").c_str ());
+      Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+      output->SetAttribute ("InsertBatchSize", UintegerValue (batchSizes[i]));
+      output->SetFilePrefix (prefix.str ());
+      clock.Start ();
+      output->Output (data);
+      std::ostringstream what;
+      what << "SqliteDataOutput (" << batchSizes[i] << " rows)";
+      Report (what.str (), samples, clock.End ());
+    }
+#endif
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the TCP transmission and reception
+// buffers with large windows.  For each window size (in segments), a full
+// window is sent, its first segment is lost, and:
+//  - the TcpTxBuffer processes one ACK per following segment, with a SACK
+//    block covering all the segments received so far, asking NextSeg and
+//    BytesInFlight after each of them as TcpSocketBase does, and
+//    retransmits the lost segment;
+//  - the TcpRxBuffer receives the window out of order, then the lost
+//    segment, and the application reads the whole window.
+// The wall clock time per segment and the resident set size are reported.
+// Sample usage:  ./waf --run 'bench-tcp-buffers --maxWindow=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "ns3/tcp-rx-buffer.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \returns The resident set size of the process (kB), or 0 if unknown.
+ */
+static uint64_t
+GetRss (void)
+{
+  std::ifstream status ("/proc/self/status");
+  std::string line;
+  while (std::getline (status, line))
+    {
+      if (line.compare (0, 6, "VmRSS:") == 0)
+        {
+          return std::stoull (line.substr (6));
+        }
+    }
+  return 0;
+}
+
+/**
+ * Recover a window whose first segment is lost with a TcpTxBuffer.
+ * \param window The window size (segments).
+ * \param segmentSize The segment size (bytes).
+ * \returns The wall clock time (ms).
+ */
+static int64_t
+BenchTxBuffer (uint32_t window, uint32_t segmentSize)
+{
+  Ptr<TcpTxBuffer> txBuffer = CreateObject<TcpTxBuffer> ();
+  SequenceNumber32 head (1);
+  txBuffer->SetHeadSequence (head);
+  txBuffer->SetMaxBufferSize (window * segmentSize);
+  txBuffer->SetSegmentSize (segmentSize);
+  txBuffer->SetDupAckThresh (3);
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < window; i++)
+    {
+      txBuffer->Add (Create<Packet> (segmentSize));
+      txBuffer->CopyFromSequence (segmentSize, head + segmentSize * i);
+    }
+  bool retransmitted = false;
+  for (uint32_t i = 1; i < window; i++)
+    {
+      TcpOptionSack::SackList sackList;
+      sackList.push_back (TcpOptionSack::SackBlock (head + segmentSize, head + segmentSize * (i + 1)));
+      txBuffer->Update (sackList);
+      SequenceNumber32 next;
+      if (txBuffer->NextSeg (&next, true) && !retransmitted && next == head)
+        {
+          txBuffer->CopyFromSequence (segmentSize, next);
+          retransmitted = true;
+        }
+      txBuffer->BytesInFlight ();
+    }
+  txBuffer->DiscardUpTo (head + segmentSize * window);
+  return time.End ();
+}
+
+/**
+ * Receive a window whose first segment is lost with a TcpRxBuffer.
+ * \param window The window size (segments).
+ * \param segmentSize The segment size (bytes).
+ * \returns The wall clock time (ms).
+ */
+static int64_t
+BenchRxBuffer (uint32_t window, uint32_t segmentSize)
+{
+  Ptr<TcpRxBuffer> rxBuffer = CreateObject<TcpRxBuffer> ();
+  SequenceNumber32 head (1);
+  rxBuffer->SetNextRxSequence (head);
+  rxBuffer->SetMaxBufferSize (window * segmentSize);
+
+  SystemWallClockMs time;
+  time.Start ();
+  TcpHeader tcpHeader;
+  for (uint32_t i = 1; i < window; i++)
+    {
+      tcpHeader.SetSequenceNumber (head + segmentSize * i);
+      rxBuffer->Add (Create<Packet> (segmentSize), tcpHeader);
+    }
+  tcpHeader.SetSequenceNumber (head);
+  rxBuffer->Add (Create<Packet> (segmentSize), tcpHeader);
+  while (rxBuffer->Available () > 0)
+    {
+      rxBuffer->Extract (segmentSize);
+    }
+  return time.End ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minWindow = 1000;
+  uint32_t maxWindow = 32000;
+  uint32_t segmentSize = 536;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark TcpTxBuffer and TcpRxBuffer with large windows");
+  cmd.AddValue ("minWindow", "smallest window (segments)", minWindow);
+  cmd.AddValue ("maxWindow", "largest window (segments), the window is doubled up to it", maxWindow);
+  cmd.AddValue ("segmentSize", "segment size (bytes)", segmentSize);
+  cmd.Parse (argc, argv);
+
+  std::cout << "window(segments)\ttx(ms)\ttx(us/segment)\trx(ms)\trx(us/segment)\tRSS(kB)" << std::endl;
+  for (uint32_t window = minWindow; window <= maxWindow; window *= 2)
+    {
+      int64_t tx = BenchTxBuffer (window, segmentSize);
+      int64_t rx = BenchRxBuffer (window, segmentSize);
+      std::cout << window << "\t" << tx << "\t" << tx * 1000.0 / window
+                << "\t" << rx << "\t" << rx * 1000.0 / window
+                << "\t" << GetRss () << std::endl;
+    }
+  return 0;
+}
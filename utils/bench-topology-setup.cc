@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup of a large topology,
+// which is dominated by the construction of the objects and of their
+// attributes.  It installs 'enbs' eNBs and 'ues' UEs with the LteHelper,
+// 'runs' times, and reports the wall clock time of each step.  With
+// 'setDefault', a default value is changed with Config::SetDefault before
+// each run, so that the construction plans of the TypeIds are rebuilt.
+// Sample usage:  ./waf --run 'bench-topology-setup --ues=10000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t enbs = 10;
+  uint32_t ues = 1000;
+  uint32_t runs = 3;
+  bool setDefault = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("enbs", "Number of eNBs", enbs);
+  cmd.AddValue ("ues", "Number of UEs", ues);
+  cmd.AddValue ("runs", "Number of topologies to build", runs);
+  cmd.AddValue ("setDefault", "Change a default value before each run", setDefault);
+  cmd.Parse (argc, argv);
+
+  std::cout << "run" << std::setw (12) << "nodes(ms)"
+            << std::setw (12) << "enbs(ms)" << std::setw (12) << "ues(ms)"
+            << std::setw (14) << "nodes/s" << std::endl;
+
+  for (uint32_t run = 0; run < runs; run++)
+    {
+      if (setDefault)
+        {
+          Config::SetDefault ("ns3::LteUePhy::TxPower", DoubleValue (10.0 + run));
+        }
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      NodeContainer enbNodes;
+      enbNodes.Create (enbs);
+      NodeContainer ueNodes;
+      ueNodes.Create (ues);
+      MobilityHelper mobility;
+      mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+      mobility.Install (enbNodes);
+      mobility.Install (ueNodes);
+      int64_t nodesMs = clock.End ();
+
+      Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+      clock.Start ();
+      NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+      int64_t enbsMs = clock.End ();
+
+      clock.Start ();
+      NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+      int64_t uesMs = clock.End ();
+
+      double totalMs = nodesMs + enbsMs + uesMs;
+      std::cout << std::setw (3) << run << std::setw (12) << nodesMs
+                << std::setw (12) << enbsMs << std::setw (12) << uesMs
+                << std::setw (14) << (totalMs > 0 ? (enbs + ues) * 1000.0 / totalMs : 0)
+                << std::endl;
+
+      Simulator::Destroy ();
+    }
+  return 0;
+}
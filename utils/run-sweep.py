@@ -0,0 +1,322 @@
+#! /usr/bin/env python
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+# Run a program over a grid of command line parameters and of RngRun
+# values, as independent processes executed in parallel by a bounded
+# number of workers.
+#
+# Each run is executed in its own directory, OUTPUT/run-NNNN, so the trace
+# files written in the current directory by the program are kept per run,
+# along with its command line (cmdline.txt), standard output (stdout.txt)
+# and standard error (stderr.txt).  The wall clock time, CPU time and
+# maximum resident set size of every run are written in OUTPUT/summary.txt.
+#
+# The seed is the same for all the runs, and the run number is the RngRun
+# value, so that any run of the sweep can be reproduced on its own from its
+# cmdline.txt.  The program must have been built, and the sweep must be
+# started from the top directory of ns-3:
+#
+#   ./utils/run-sweep.py --program=wns3-2017-pssch --jobs=64 --runs=10 \
+#       --param=rbSize=2,4,6,8 --param=mcs=10,12 --output=pssch-sweep \
+#       -- --period=sf40 --pscchLength=8 --ktrp=2 --simTime=10
+#
+from __future__ import print_function
+import os
+import sys
+import time
+import optparse
+import subprocess
+import threading
+import itertools
+import glob
+
+try:
+    import queue
+except ImportError:
+    import Queue as queue
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+from utils import get_list_from_file
+
+#
+# Read the build directory and the library paths from the waf state, the
+# same way test.py does.
+#
+def read_waf_config():
+    out_dir = None
+    lock_files = glob.glob(".lock-waf_*_build")
+    if not lock_files:
+        raise IOError("waf lock file not found, the sweep must be run from the top directory of a built ns-3")
+    for line in open(lock_files[0], "rt"):
+        if line.startswith("out_dir ="):
+            key, val = line.split('=')
+            out_dir = eval(val.strip())
+    config = {}
+    for line in open("%s/c4che/_cache.py" % out_dir).readlines():
+        for item in ("NS3_MODULE_PATH", "VERSION", "BUILD_PROFILE"):
+            if line.startswith(item + " ="):
+                key, val = line.split('=', 1)
+                config[item] = eval(val.strip())
+    return out_dir, config
+
+def make_env(module_path):
+    env = dict(os.environ)
+    if sys.platform == "darwin":
+        var = "DYLD_LIBRARY_PATH"
+    else:
+        var = "LD_LIBRARY_PATH"
+    paths = [p for p in env.get(var, "").split(":") if p]
+    env[var] = ":".join(paths + [str(p) for p in module_path])
+    return env
+
+def find_program(out_dir, config, name):
+    # The programs are named ns<version>-<name>-<profile>
+    basename = "ns%s-%s-%s" % (config["VERSION"], name, config["BUILD_PROFILE"])
+    programs = get_list_from_file(os.path.join(out_dir, 'build-status.py'),
+                                  "ns3_runnable_programs")
+    for program in programs:
+        if os.path.basename(program) == basename:
+            return os.path.abspath(program)
+    return None
+
+def parse_params(specs):
+    """! Parse the --param options
+    @param specs list of name=value1,value2,... strings
+    @return list of (name, [values]) pairs
+    """
+    params = []
+    for spec in specs:
+        if "=" not in spec:
+            raise ValueError("invalid parameter '%s', expected name=value1,value2,..." % spec)
+        name, values = spec.split("=", 1)
+        params.append((name, values.split(",")))
+    return params
+
+## A run of the sweep
+class Job:
+    ## @var index
+    #  index of the run
+    ## @var values
+    #  values of the swept parameters
+    ## @var rng_run
+    #  RngRun value
+    ## @var argv
+    #  command line
+    ## @var directory
+    #  directory where the run is executed
+    ## @var status
+    #  exit status
+    ## @var wall
+    #  wall clock time (s)
+    ## @var cpu
+    #  user and system CPU time (s)
+    ## @var maxrss
+    #  maximum resident set size
+    def __init__(self, index, values, rng_run, argv, directory):
+        """! Initializer
+        @param self this object
+        @param index index of the run
+        @param values values of the swept parameters
+        @param rng_run RngRun value
+        @param argv command line
+        @param directory directory where the run is executed
+        @return none
+        """
+        self.index = index
+        self.values = values
+        self.rng_run = rng_run
+        self.argv = argv
+        self.directory = directory
+        self.status = None
+        self.wall = 0.0
+        self.cpu = 0.0
+        self.maxrss = 0
+
+def run_job(job, env):
+    """! Execute a run and collect its resource usage
+    @param job the run
+    @param env the environment of the process
+    @return none
+    """
+    os.makedirs(job.directory)
+    with open(os.path.join(job.directory, "cmdline.txt"), "w") as f:
+        f.write(" ".join(job.argv) + "\n")
+    stdout = open(os.path.join(job.directory, "stdout.txt"), "w")
+    stderr = open(os.path.join(job.directory, "stderr.txt"), "w")
+    start = time.time()
+    try:
+        proc = subprocess.Popen(job.argv, cwd=job.directory, env=env,
+                                stdout=stdout, stderr=stderr)
+        # wait4 gives the resource usage of this child only, while the
+        # other workers keep running theirs
+        pid, status, rusage = os.wait4(proc.pid, 0)
+        proc.returncode = status
+        job.wall = time.time() - start
+        job.cpu = rusage.ru_utime + rusage.ru_stime
+        job.maxrss = rusage.ru_maxrss
+        if os.WIFSIGNALED(status):
+            job.status = -os.WTERMSIG(status)
+        else:
+            job.status = os.WEXITSTATUS(status)
+    except OSError as e:
+        print("Run %d: %s" % (job.index, e), file=sys.stderr)
+        job.status = -1
+    finally:
+        stdout.close()
+        stderr.close()
+
+## Worker thread, executing runs until the queue is empty
+class worker_thread(threading.Thread):
+    def __init__(self, input_queue, output_queue, env):
+        """! Initializer
+        @param self this object
+        @param input_queue queue of the runs to execute
+        @param output_queue queue of the completed runs
+        @param env the environment of the processes
+        @return none
+        """
+        threading.Thread.__init__(self)
+        self.input_queue = input_queue
+        self.output_queue = output_queue
+        self.env = env
+
+    def run(self):
+        """! Worker loop
+        @param self this object
+        @return none
+        """
+        while True:
+            job = self.input_queue.get()
+            if job is None:
+                return
+            run_job(job, self.env)
+            self.output_queue.put(job)
+
+def run_sweep(options, extra_args):
+    out_dir, config = read_waf_config()
+    program = find_program(out_dir, config, options.program)
+    if program is None:
+        print("Program '%s' not found, it must be built before running the sweep" % options.program,
+              file=sys.stderr)
+        return 2
+    params = parse_params(options.params)
+    names = [name for name, values in params]
+    if os.path.exists(options.output):
+        print("ERROR: %s already exists. Overwriting old results is not allowed!" % options.output,
+              file=sys.stderr)
+        return 2
+
+    jobs = []
+    points = list(itertools.product(*[values for name, values in params]))
+    for values in points:
+        for rng_run in range(options.run_start, options.run_start + options.runs):
+            index = len(jobs)
+            argv = [program, "--RngSeed=%d" % options.seed, "--RngRun=%d" % rng_run]
+            argv += ["--%s=%s" % (name, value) for name, value in zip(names, values)]
+            argv += extra_args
+            directory = os.path.abspath(os.path.join(options.output, "run-%04d" % index))
+            jobs.append(Job(index, values, rng_run, argv, directory))
+
+    if options.dry_run:
+        for job in jobs:
+            print(" ".join(job.argv))
+        return 0
+
+    os.makedirs(options.output)
+    print("Running %d points x %d runs = %d processes with %d workers" %
+          (len(points), options.runs, len(jobs), options.jobs))
+
+    input_queue = queue.Queue(0)
+    output_queue = queue.Queue(0)
+    env = make_env(config.get("NS3_MODULE_PATH", []))
+    for job in jobs:
+        input_queue.put(job)
+    threads = []
+    for i in range(min(options.jobs, len(jobs))):
+        input_queue.put(None)
+        thread = worker_thread(input_queue, output_queue, env)
+        thread.daemon = True
+        thread.start()
+        threads.append(thread)
+
+    start = time.time()
+    failed = 0
+    for i in range(len(jobs)):
+        # A timeout lets the main thread see a KeyboardInterrupt
+        while True:
+            try:
+                job = output_queue.get(timeout=1)
+                break
+            except queue.Empty:
+                pass
+        if job.status != 0:
+            failed += 1
+        state = "PASS" if job.status == 0 else "FAIL (%d)" % job.status
+        print("[%d/%d] %s: run-%04d %s RngRun=%d (%.1f s)" %
+              (i + 1, len(jobs), state, job.index,
+               " ".join("%s=%s" % p for p in zip(names, job.values)), job.rng_run, job.wall))
+    wall = time.time() - start
+    for thread in threads:
+        thread.join()
+
+    with open(os.path.join(options.output, "summary.txt"), "w") as f:
+        f.write("\t".join(["run"] + names + ["RngRun", "status", "wall(s)", "cpu(s)", "maxrss(kB)"]) + "\n")
+        for job in jobs:
+            f.write("\t".join(["run-%04d" % job.index] + list(job.values) +
+                              ["%d" % job.rng_run, "%d" % job.status, "%.3f" % job.wall,
+                               "%.3f" % job.cpu, "%d" % job.maxrss]) + "\n")
+
+    cpu = sum(job.cpu for job in jobs)
+    print("%d runs, %d failed, in %.1f s (%.1f s of CPU, speedup %.1f), "
+          "mean run %.1f s, largest maxrss %d kB" %
+          (len(jobs), failed, wall, cpu, cpu / wall if wall > 0 else 0,
+           sum(job.wall for job in jobs) / len(jobs), max(job.maxrss for job in jobs)))
+    print("Results in %s" % os.path.join(options.output, "summary.txt"))
+    return 1 if failed else 0
+
+def main(argv):
+    parser = optparse.OptionParser(usage="%prog --program=NAME [options] [-- fixed program arguments]")
+    parser.add_option("-p", "--program", action="store", type="string", dest="program", default="",
+                      metavar="NAME",
+                      help="name of the program to run, e.g. wns3-2017-pssch")
+    parser.add_option("-P", "--param", action="append", type="string", dest="params", default=[],
+                      metavar="NAME=V1,V2,...",
+                      help="command line parameter to sweep, may be repeated; the grid is the cartesian product")
+    parser.add_option("-r", "--runs", action="store", type="int", dest="runs", default=1,
+                      help="number of runs (RngRun values) per point of the grid")
+    parser.add_option("--run-start", action="store", type="int", dest="run_start", default=1,
+                      help="first RngRun value")
+    parser.add_option("--seed", action="store", type="int", dest="seed", default=1,
+                      help="RngSeed value, common to all the runs")
+    parser.add_option("-j", "--jobs", action="store", type="int", dest="jobs", default=0,
+                      help="number of runs executed in parallel (default: number of processors)")
+    parser.add_option("-o", "--output", action="store", type="string", dest="output", default="sweep",
+                      metavar="DIR",
+                      help="directory of the results, must not exist")
+    parser.add_option("-n", "--dry-run", action="store_true", dest="dry_run", default=False,
+                      help="print the command lines without running them")
+    (options, args) = parser.parse_args(argv)
+    if not options.program:
+        parser.error("--program is required")
+    if options.runs < 1:
+        parser.error("--runs must be positive")
+    if options.jobs <= 0:
+        import multiprocessing
+        options.jobs = multiprocessing.cpu_count()
+    return run_sweep(options, args)
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))